@@ -0,0 +1,88 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *
+ * @section DESCRIPTION
+ * Kernel benchmarks of EDGE.
+ **/
+#include "parallel/Mpi.h"
+#include "parallel/Shared.h"
+
+#include "io/logging.h"
+INITIALIZE_EASYLOGGINGPP
+
+#include <string>
+#include "dg/Basis.h"
+#include "dg/QuadratureEval.hpp"
+#include "data/Internal.hpp"
+#include "linalg/Matrix.h"
+
+#if defined PP_T_EQUATIONS_ELASTIC
+#include "impl/elastic/setups/MmKernels.hpp"
+#include "impl/elastic/solvers/AderDg.hpp"
+#include "impl/elastic/bench/Kernels.hpp"
+#endif
+
+int main( int i_argc, char *i_argv[] ) {
+  // disable logging file-IO
+  edge::io::logging::config();
+
+  // start shared memory parallelization
+  edge::parallel::Shared l_shared;
+  l_shared.init();
+
+  // start MPI
+  edge::parallel::Mpi l_mpi;
+  l_mpi.start( i_argc, i_argv );
+
+  // reconfigure the logging interface with rank and thread id
+  edge::io::logging::config();
+
+  // output file of the results, given as first argument
+  std::string l_path = (i_argc > 1) ? i_argv[1] : "bench_kernels.json";
+
+#if defined PP_T_EQUATIONS_ELASTIC
+  // scratch memory and global data of the kernels
+  edge::data::Internal l_internal;
+  l_internal.initScratch();
+
+  EDGE_LOG_INFO << "setting up basis and DG-structure";
+  edge::dg::Basis l_basis( T_SDISC.ELEMENT, ORDER );
+
+#include "dg/setup_ader.inc"
+#include "impl/elastic/setup_mm.inc"
+
+  // run benchmarks, single-threaded
+  edge::elastic::bench::Kernels l_bench;
+  l_bench.run( l_internal.m_globalShared1[0],
+               l_internal.m_mm );
+
+  if( edge::parallel::g_rank == 0 ) {
+    EDGE_LOG_INFO << "writing results to " << l_path;
+    l_bench.write( l_path );
+  }
+#else
+  EDGE_LOG_FATAL << "kernel benchmarks are only available for the elastic wave equations";
+#endif
+
+  l_mpi.fin();
+
+  return 0;
+}
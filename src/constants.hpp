@@ -225,6 +225,8 @@ constexpr unsigned short CE_N_FLUXN_MATRICES( t_entityType i_enType ) {
  *
  * N_STEPS_PER_UPDATE Number of steps per DOF-update.
  * N_ENTRIES_CONTROL_FLOW Number of entries in the control flow of the simulation.
+ * N_STEP_TYPES Number of step types (ids of the steps in the work regions).
+ * STEP_NAMES Names of the step types.
  *
  * --- Element related definitions ---
  * N_ELEMENT_MODES:          Number of modes per element.
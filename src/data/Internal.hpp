@@ -30,6 +30,7 @@
 #include "common.hpp"
 #include "io/logging.h"
 #include "parallel/Shared.h"
+#include "mesh/regular/Implicit.hpp"
 
 #if defined PP_T_KERNELS_VANILLA
 #include "data/MmVanilla.hpp"
@@ -338,6 +339,9 @@ class edge::data::Internal {
     // connectivity information
     t_connect m_connect;
 
+    //! implicit connectivity of regular meshes, disabled if the connectivity is explicit
+    mesh::regular::Implicit< T_SDISC.ELEMENT > m_implicit;
+
     /**
      * Constructor.
      **/
@@ -822,6 +826,25 @@ class edge::data::Internal {
 #endif
     }
 
+    /**
+     * Releases the explicit connectivity and the face characteristics, which are not required by the time stepping
+     * of regular meshes with implicit connectivity. The element-vertex adjacency and the vertex characteristics are kept
+     * for output and error norms.
+     * The data is released after the setup, which requires the explicit connectivity; the peak memory is not reduced.
+     **/
+    void releaseImplicit() {
+      EDGE_CHECK( m_implicit.enabled() );
+
+      common::release(m_connect.elFa);      m_connect.elFa      = nullptr;
+      common::release(m_connect.faEl);      m_connect.faEl      = nullptr;
+      common::release(m_connect.faVe);      m_connect.faVe      = nullptr;
+      common::release(m_connect.elFaEl);    m_connect.elFaEl    = nullptr;
+      common::release(m_connect.fIdElFaEl); m_connect.fIdElFaEl = nullptr;
+      common::release(m_connect.vIdElFaEl); m_connect.vIdElFaEl = nullptr;
+
+      common::release(m_faceChars);         m_faceChars         = nullptr;
+    }
+
     /**
      * Finalizes the data structures.
      **/
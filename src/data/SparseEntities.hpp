@@ -370,6 +370,109 @@ class edge::data::SparseEntities {
       }
     }
 
+    /**
+     * Derives the dense ids of the sparse entities.
+     *
+     * Example (sparse type: 01):
+     *
+     *   de | bits    sp | de
+     *   0  | 00      0  | 1
+     *   1  | 11      1  | 3
+     *   2  | 10      2  | 4
+     *   3  | 01
+     *   4  | 11
+     *
+     * @param i_nEn number of dense entities.
+     * @param i_spType sparse type used for the bit comparisons.
+     * @param i_chars characteristics of the dense entities (having a member .spType).
+     * @param o_spDe will be set to the dense ids of the sparse entities; nullptr if only the number of sparse entities is requested.
+     * @return number of sparse entities.
+     *
+     * @paramt TL_T_INT_LID integer type of local ids.
+     * @paramt TL_T_INT_SP integer type of the sparse type.
+     * @paramt TL_T_CHARS struct of the entities' characteristics. Offers a member .spType for comparison with i_spType.
+     **/
+    template< typename TL_T_INT_LID,
+              typename TL_T_INT_SP,
+              typename TL_T_CHARS >
+    static TL_T_INT_LID spDe( TL_T_INT_LID         i_nEn,
+                              TL_T_INT_SP          i_spType,
+                              TL_T_CHARS   const * i_chars,
+                              TL_T_INT_LID       * o_spDe = nullptr ) {
+      TL_T_INT_LID l_nSp = 0;
+
+      for( TL_T_INT_LID l_de = 0; l_de < i_nEn; l_de++ ) {
+        if( (i_chars[l_de].spType & i_spType) == i_spType ) {
+          if( o_spDe != nullptr ) o_spDe[l_nSp] = l_de;
+          l_nSp++;
+        }
+      }
+
+      return l_nSp;
+    }
+
+    /**
+     * Derives the dense ids of entities, which have at least one adjacent entity of one of the given sparse types.
+     *
+     * Example (sparse types: 01, 10):
+     *
+     *   Adjacency of    Bits of adjacent    Result:
+     *   entities:       entities:
+     *
+     *   en | ae         ae | bits           id | en
+     *   0  | 0-1        0  | 00             0  | 1
+     *   1  | 1-2        1  | 00             1  | 2
+     *   2  | 3-x        2  | 10             2  | 3
+     *   3  | 0-3        3  | 01
+     *   4  | 4-0        4  | 00
+     *
+     * @param i_nEn number of dense entities.
+     * @param i_nAdjPerEn number of adjacent entities for each of the dense entities.
+     * @param i_enEn adjacency information. Assumed is a flat array, meaning: [de*i_nAdjPerEn + ae] gives the de's adjacent entity ae. Adjacency information with std::numeric_limits< TL_T_INT_LID >::max() is ignored.
+     * @param i_nSpTypes number of sparse types.
+     * @param i_spTypes sparse types used for the bit comparisons.
+     * @param i_charsAdj characteristics of the adjacent entities (having a member .spType).
+     * @param o_de will be set to the dense ids of the entities; nullptr if only the number of entities is requested.
+     * @return number of entities having at least one adjacent entity of the sparse types.
+     *
+     * @paramt TL_T_INT_LID integer type of local ids.
+     * @paramt TL_T_INT_SP integer type of the sparse type.
+     * @paramt TL_T_ADJ_CHARS struct of the adjacent entities' characteristics. Offers a member .spType for comparison with i_spTypes.
+     **/
+    template< typename TL_T_INT_LID,
+              typename TL_T_INT_SP,
+              typename TL_T_ADJ_CHARS >
+    static TL_T_INT_LID adjDe( TL_T_INT_LID             i_nEn,
+                               unsigned short           i_nAdjPerEn,
+                               TL_T_INT_LID     const * i_enEn,
+                               unsigned short           i_nSpTypes,
+                               TL_T_INT_SP      const * i_spTypes,
+                               TL_T_ADJ_CHARS   const * i_charsAdj,
+                               TL_T_INT_LID           * o_de = nullptr ) {
+      TL_T_INT_LID l_nDe = 0;
+
+      for( TL_T_INT_LID l_de = 0; l_de < i_nEn; l_de++ ) {
+        bool l_adj = false;
+
+        for( unsigned short l_ae = 0; l_ae < i_nAdjPerEn; l_ae++ ) {
+          TL_T_INT_LID l_aeId = i_enEn[ l_de * i_nAdjPerEn + l_ae ];
+
+          // ignore undefined adjacencies
+          if( l_aeId == std::numeric_limits< TL_T_INT_LID >::max() ) continue;
+
+          for( unsigned short l_st = 0; l_st < i_nSpTypes; l_st++ )
+            l_adj = l_adj || ( (i_charsAdj[l_aeId].spType & i_spTypes[l_st]) == i_spTypes[l_st] );
+        }
+
+        if( l_adj ) {
+          if( o_de != nullptr ) o_de[l_nDe] = l_de;
+          l_nDe++;
+        }
+      }
+
+      return l_nDe;
+    }
+
     /**
      * Links sparse entities based on adjacency information (single sparse type).
      *
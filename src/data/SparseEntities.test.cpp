@@ -793,3 +793,78 @@ TEST_CASE( "SparseEnts: Propagate sparse information to adjacent entities.", "[p
   REQUIRE( l_en1Chars[3].spType == 1 );
   REQUIRE( l_en1Chars[4].spType == 3 );
 }
+
+TEST_CASE( "SparseEnts: Dense ids of sparse entities.", "[spDe][SparseEnts]" ) {
+  /*
+   * Our setup (sparse type: 01)
+   *
+   *   de | bits    sp | de
+   *   0  | 00      0  | 1
+   *   1  | 11      1  | 3
+   *   2  | 10      2  | 4
+   *   3  | 01
+   *   4  | 11
+   */
+  typedef struct { unsigned short spType; } t_enChars;
+
+  t_enChars l_chars[5];
+  l_chars[0].spType = 0;
+  l_chars[1].spType = 3;
+  l_chars[2].spType = 2;
+  l_chars[3].spType = 1;
+  l_chars[4].spType = 3;
+
+  // only derive the number of sparse entities
+  REQUIRE( edge::data::SparseEntities::spDe( 5, 1, l_chars ) == 3 );
+
+  int l_spDe[3];
+  REQUIRE( edge::data::SparseEntities::spDe( 5, 1, l_chars, l_spDe ) == 3 );
+
+  REQUIRE( l_spDe[0] == 1 );
+  REQUIRE( l_spDe[1] == 3 );
+  REQUIRE( l_spDe[2] == 4 );
+}
+
+TEST_CASE( "SparseEnts: Dense ids of entities with adjacent sparse entities.", "[adjDe][SparseEnts]" ) {
+  /*
+   * Our setup (sparse types: 01, 10)
+   *
+   *   Adjacency of    Bits of adjacent    Result:
+   *   entities:       entities:
+   *
+   *   en | ae         ae | bits           id | en
+   *   0  | 0-1        0  | 00             0  | 1
+   *   1  | 1-2        1  | 00             1  | 2
+   *   2  | 3-x        2  | 10             2  | 3
+   *   3  | 0-3        3  | 01
+   *   4  | 4-0        4  | 00
+   */
+  typedef struct { unsigned short spType; } t_enChars;
+
+  t_enChars l_chars[5];
+  l_chars[0].spType = 0;
+  l_chars[1].spType = 0;
+  l_chars[2].spType = 2;
+  l_chars[3].spType = 1;
+  l_chars[4].spType = 0;
+
+  int l_x = std::numeric_limits< int >::max();
+  int l_enEn[5][2] = { {0,1}, {1,2}, {3,l_x}, {0,3}, {4,0} };
+
+  unsigned short l_spTypes[2] = { 1, 2 };
+
+  // only derive the number of entities
+  REQUIRE( edge::data::SparseEntities::adjDe( 5, 2, l_enEn[0], 2, l_spTypes, l_chars ) == 3 );
+
+  int l_de[3];
+  REQUIRE( edge::data::SparseEntities::adjDe( 5, 2, l_enEn[0], 2, l_spTypes, l_chars, l_de ) == 3 );
+
+  REQUIRE( l_de[0] == 1 );
+  REQUIRE( l_de[1] == 2 );
+  REQUIRE( l_de[2] == 3 );
+
+  // single sparse type
+  REQUIRE( edge::data::SparseEntities::adjDe( 5, 2, l_enEn[0], 1, l_spTypes, l_chars, l_de ) == 2 );
+  REQUIRE( l_de[0] == 2 );
+  REQUIRE( l_de[1] == 3 );
+}
@@ -26,6 +26,7 @@
 #include "parallel/Mpi.h"
 #include "constants.hpp"
 #include <io/logging.h>
+#include <chrono>
 
 #ifdef PP_USE_MEMKIND
 #include <hbwmalloc.h>
@@ -84,10 +85,58 @@ class edge::data::common {
 #endif
 
   public:
+    /**
+     * Measures the sustained memory bandwidth of the rank through a STREAM-like triad a = b + s*c.
+     * As in STREAM, 24 bytes are counted per iteration (no write-allocate).
+     * The arrays are allocated in regular memory and released before returning.
+     *
+     * @param i_size number of entries per array.
+     * @param i_nReps number of repetitions, the fastest one is used.
+     * @return bandwidth in GB/s.
+     **/
+    static double streamTriad( std::size_t    i_size = std::size_t(1) << 23,
+                               unsigned short i_nReps = 5 ) {
+      double *l_a = (double*) allocate( i_size * sizeof(double) );
+      double *l_b = (double*) allocate( i_size * sizeof(double) );
+      double *l_c = (double*) allocate( i_size * sizeof(double) );
+
+      // first touch by the computing threads
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
+      for( std::size_t l_en = 0; l_en < i_size; l_en++ ) {
+        l_a[l_en] = 0;
+        l_b[l_en] = 1;
+        l_c[l_en] = 2;
+      }
+
+      double l_min = std::numeric_limits< double >::max();
+      for( unsigned short l_re = 0; l_re < i_nReps; l_re++ ) {
+        std::chrono::steady_clock::time_point l_beg = std::chrono::steady_clock::now();
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
+        for( std::size_t l_en = 0; l_en < i_size; l_en++ ) {
+          l_a[l_en] = l_b[l_en] + 3.0 * l_c[l_en];
+        }
+        l_min = std::min( l_min, std::chrono::duration< double >( std::chrono::steady_clock::now() - l_beg ).count() );
+      }
+      EDGE_CHECK_EQ( l_a[i_size-1], 7.0 );
+
+      release( l_a );
+      release( l_b );
+      release( l_c );
+
+      return ( 3 * sizeof(double) * i_size ) / l_min * 1E-9;
+    }
+
     /**
      * Prints memory statistics.
+     *
+     * @param i_stream if true, the sustained memory bandwidth is measured (all ranks concurrently) and printed; temporarily allocates 3x64MiB per rank.
+     * @return sustained memory bandwidth of the rank in GB/s if measured, 0 otherwise.
      **/
-    static void printMemStats() {
+    static double printMemStats( bool i_stream = false ) {
       unsigned long l_mem[3] = {0,0,0}; // 0: total, 1: free: 2: available
 
       // open meminfo
@@ -141,6 +190,70 @@ class edge::data::common {
         EDGE_LOG_INFO << "  avail (min/ave/max): "
                       << l_stats[0][2] << " / " << l_stats[1][2] << " / " << l_stats[2][2] << " GiB";
       }
+
+      double l_bw = 0;
+      if( i_stream ) {
+        l_bw = streamTriad();
+
+        double l_bwStats[3] = { l_bw, l_bw, l_bw };
+#ifdef PP_USE_MPI
+        int l_err;
+        l_err = MPI_Allreduce( &l_bw, l_bwStats+0, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD );
+        EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+        l_err = MPI_Allreduce( &l_bw, l_bwStats+1, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+        EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+        l_err = MPI_Allreduce( &l_bw, l_bwStats+2, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
+        EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+        l_bwStats[1] /= parallel::g_nRanks;
+#endif
+        EDGE_LOG_INFO << "  triad bandwidth per rank (min/ave/max): "
+                      << l_bwStats[0] << " / " << l_bwStats[1] << " / " << l_bwStats[2] << " GB/s";
+      }
+
+      return l_bw;
+    }
+
+    /**
+     * Prints the high-water mark of the resident memory (VmHWM) of the process.
+     **/
+    static void printMemHwm() {
+      unsigned long l_hwm = 0;
+
+      // parse status of the process
+      std::ifstream l_status("/proc/self/status");
+      if( l_status.is_open() ) {
+        std::string l_line;
+        while( l_status >> l_line ) {
+          if( l_line == "VmHWM:" ) {
+            l_status >> l_hwm;
+            break;
+          }
+        }
+      }
+
+      // stats: min, ave, max, sum
+      double l_gib = 1024 * 1024;
+      double l_stats[4];
+#ifdef PP_USE_MPI
+      unsigned long l_tmp[3];
+      int l_err;
+      l_err = MPI_Allreduce( &l_hwm, l_tmp+0, 1, MPI_UNSIGNED_LONG, MPI_MIN, MPI_COMM_WORLD );
+      EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+      l_err = MPI_Allreduce( &l_hwm, l_tmp+1, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD );
+      EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+      l_err = MPI_Allreduce( &l_hwm, l_tmp+2, 1, MPI_UNSIGNED_LONG, MPI_MAX, MPI_COMM_WORLD );
+      EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+
+      l_stats[0] = l_tmp[0] / l_gib;
+      l_stats[1] = l_tmp[1] / ( parallel::g_nRanks*l_gib );
+      l_stats[2] = l_tmp[2] / l_gib;
+      l_stats[3] = l_tmp[1] / l_gib;
+#else
+      for( unsigned short l_st = 0; l_st < 4; l_st++ ) l_stats[l_st] = l_hwm / l_gib;
+#endif
+
+      EDGE_LOG_INFO << "memory high-water mark (min/ave/max/sum): "
+                    << l_stats[0] << " / " << l_stats[1] << " / " << l_stats[2] << " / " << l_stats[3] << " GiB";
     }
 
     /**
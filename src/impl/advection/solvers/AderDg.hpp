@@ -27,6 +27,7 @@
 #include <cassert>
 #include "constants.hpp"
 #include "mesh/common.hpp"
+#include "mesh/regular/Implicit.hpp"
 #include "linalg/Matrix.h"
 #include "linalg/Mappings.hpp"
 #include "TimePred.hpp"
@@ -145,29 +146,29 @@ class edge::advection::solvers::AderDg {
          */
          for( unsigned int l_di = 0; l_di < N_DIM; l_di++ ) {
 #if defined PP_T_KERNELS_VANILLA
-            linalg::Matrix::matMulFusedAC( N_CRUNS,                     // #fused
-                                           1,                           // m
-                                           N_ELEMENT_MODES,             // n
-                                           N_ELEMENT_MODES,             // k
-                                           N_ELEMENT_MODES,             // ldA
-                                           N_ELEMENT_MODES,             // ldB
-                                           N_ELEMENT_MODES,             // ldC
-                                           static_cast<real_base>(0.0), // beta
-                                           o_tInt[l_el][0][0],          // A
-                                           i_dg.mat.stiff[l_di][0],     // B
-                                           l_tmpProd[0]  );             // C
+            linalg::Matrix::matMulFusedAC< real_base,
+                                           N_CRUNS,
+                                           1,                // m
+                                           N_ELEMENT_MODES,  // n
+                                           N_ELEMENT_MODES,  // k
+                                           N_ELEMENT_MODES,  // ldA
+                                           N_ELEMENT_MODES,  // ldB
+                                           N_ELEMENT_MODES,  // ldC
+                                           false >( o_tInt[l_el][0][0],
+                                                    i_dg.mat.stiff[l_di][0],
+                                                    l_tmpProd[0] );
 
-            linalg::Matrix::matMulFusedBC( N_CRUNS,                     // #fused
-                                           1,                           // m
-                                           N_ELEMENT_MODES,             // n
-                                           1,                           // k
-                                           1,                           // ldA
-                                           N_ELEMENT_MODES,             // ldB
-                                           N_ELEMENT_MODES,             // ldC
-                                           static_cast<real_base>(1.0), // beta
-                                           i_starM[l_el]+l_di,          // A
-                                           l_tmpProd[0],                // B
-                                           io_dofs[l_el][0][0] );       // C
+            linalg::Matrix::matMulFusedBC< real_base,
+                                           N_CRUNS,
+                                           1,                // m
+                                           N_ELEMENT_MODES,  // n
+                                           1,                // k
+                                           1,                // ldA
+                                           N_ELEMENT_MODES,  // ldB
+                                           N_ELEMENT_MODES,  // ldC
+                                           true >( i_starM[l_el]+l_di,
+                                                   l_tmpProd[0],
+                                                   io_dofs[l_el][0][0] );
 #else
            EDGE_LOG_FATAL << "not implemented;"
 #endif
@@ -181,41 +182,41 @@ class edge::advection::solvers::AderDg {
            // scratch space for three-way product
            real_base l_scratch[2][N_FACE_MODES][N_CRUNS];
 
-           linalg::Matrix::matMulFusedAC( N_CRUNS,                     // #fused
-                                          1,                           // m
-                                          N_FACE_MODES,                // n
-                                          N_ELEMENT_MODES,             // k
-                                          N_ELEMENT_MODES,             // ldA
-                                          N_FACE_MODES,                // ldB
-                                          N_FACE_MODES,                // ldC
-                                          static_cast<real_base>(0.0), // beta
-                                          o_tInt[l_el][0][0],          // A
-                                          i_dg.mat.fluxL[l_fa][0],     // B
-                                          l_scratch[0][0]  );          // C
+           linalg::Matrix::matMulFusedAC< real_base,
+                                          N_CRUNS,
+                                          1,                // m
+                                          N_FACE_MODES,     // n
+                                          N_ELEMENT_MODES,  // k
+                                          N_ELEMENT_MODES,  // ldA
+                                          N_FACE_MODES,     // ldB
+                                          N_FACE_MODES,     // ldC
+                                          false >( o_tInt[l_el][0][0],
+                                                   i_dg.mat.fluxL[l_fa][0],
+                                                   l_scratch[0][0] );
 
-           linalg::Matrix::matMulFusedBC( N_CRUNS,                     // #fused
-                                          1,                           // m
-                                          N_FACE_MODES,                // n
-                                          1,                           // k
-                                          1,                           // ldA
-                                          N_FACE_MODES,                // ldB
-                                          N_FACE_MODES,                // ldC
-                                          static_cast<real_base>(0.0), // beta
-                                          i_fluxSolvers[l_el]+l_fa,    // A
-                                          l_scratch[0][0],             // B
-                                          l_scratch[1][0] );           // C
+           linalg::Matrix::matMulFusedBC< real_base,
+                                          N_CRUNS,
+                                          1,                // m
+                                          N_FACE_MODES,     // n
+                                          1,                // k
+                                          1,                // ldA
+                                          N_FACE_MODES,     // ldB
+                                          N_FACE_MODES,     // ldC
+                                          false >( i_fluxSolvers[l_el]+l_fa,
+                                                   l_scratch[0][0],
+                                                   l_scratch[1][0] );
 
-           linalg::Matrix::matMulFusedAC( N_CRUNS,                     // #fused
-                                          1,                           // m
-                                          N_ELEMENT_MODES,             // n
-                                          N_FACE_MODES,                // k
-                                          N_FACE_MODES,                // ldA
-                                          N_ELEMENT_MODES,             // ldB
-                                          N_ELEMENT_MODES,             // ldC
-                                          static_cast<real_base>(1.0), // beta
-                                          l_scratch[1][0],             // A
-                                          i_dg.mat.fluxT[l_fa][0],     // B
-                                          io_dofs[l_el][0][0]  );      // C
+           linalg::Matrix::matMulFusedAC< real_base,
+                                          N_CRUNS,
+                                          1,                // m
+                                          N_ELEMENT_MODES,  // n
+                                          N_FACE_MODES,     // k
+                                          N_FACE_MODES,     // ldA
+                                          N_ELEMENT_MODES,  // ldB
+                                          N_ELEMENT_MODES,  // ldC
+                                          true >( l_scratch[1][0],
+                                                  i_dg.mat.fluxT[l_fa][0],
+                                                  io_dofs[l_el][0][0] );
 #else
            EDGE_LOG_FATAL << "not implemented;"
 #endif
@@ -276,44 +277,123 @@ class edge::advection::solvers::AderDg {
           // scratch space for three-way product
           real_base l_scratch[2][N_FACE_MODES][N_CRUNS];
 
-          linalg::Matrix::matMulFusedAC( N_CRUNS,                                                                          // #fused
-                                         1,                                                                                // m
-                                         N_FACE_MODES,                                                                     // n
-                                         N_ELEMENT_MODES,                                                                  // k
-                                         N_ELEMENT_MODES,                                                                  // ldA
-                                         N_FACE_MODES,                                                                     // ldB
-                                         N_FACE_MODES,                                                                     // ldC
-                                         static_cast<real_base>(0.0),                                                      // beta
-                                         i_tInt[l_ne][0][0],                                                               // A
-                                         ( (i_faChars[l_faId].spType & OUTFLOW) != OUTFLOW ) ? i_dg.mat.fluxN[l_fId][0] :
-                                                                                               i_dg.mat.fluxL[l_fa][0],    // B
-                                         l_scratch[0][0]  );                                                               // C
+          linalg::Matrix::matMulFusedAC< real_base,
+                                         N_CRUNS,
+                                         1,                // m
+                                         N_FACE_MODES,     // n
+                                         N_ELEMENT_MODES,  // k
+                                         N_ELEMENT_MODES,  // ldA
+                                         N_FACE_MODES,     // ldB
+                                         N_FACE_MODES,     // ldC
+                                         false >( i_tInt[l_ne][0][0],
+                                                  ( (i_faChars[l_faId].spType & OUTFLOW) != OUTFLOW ) ? i_dg.mat.fluxN[l_fId][0] :
+                                                                                                        i_dg.mat.fluxL[l_fa][0],
+                                                  l_scratch[0][0] );
 
-          linalg::Matrix::matMulFusedBC( N_CRUNS,                           // #fused
-                                         1,                                 // m
-                                         N_FACE_MODES,                      // n
-                                         1,                                 // k
-                                         1,                                 // ldA
-                                         N_FACE_MODES,                      // ldB
-                                         N_FACE_MODES,                      // ldC
-                                         static_cast<real_base>(0.0),       // beta
-                                         i_fluxSolvers[l_el] +
-                                           C_ENT[T_SDISC.ELEMENT].N_FACES +
-                                           l_fa,                            // A
-                                         l_scratch[0][0],                   // B
-                                         l_scratch[1][0] );                 // C
+          linalg::Matrix::matMulFusedBC< real_base,
+                                         N_CRUNS,
+                                         1,                // m
+                                         N_FACE_MODES,     // n
+                                         1,                // k
+                                         1,                // ldA
+                                         N_FACE_MODES,     // ldB
+                                         N_FACE_MODES,     // ldC
+                                         false >( i_fluxSolvers[l_el] +
+                                                    C_ENT[T_SDISC.ELEMENT].N_FACES +
+                                                    l_fa,
+                                                  l_scratch[0][0],
+                                                  l_scratch[1][0] );
 
-          linalg::Matrix::matMulFusedAC( N_CRUNS,                           // #fused
-                                         1,                                 // m
-                                         N_ELEMENT_MODES,                   // n
-                                         N_FACE_MODES,                      // k
-                                         N_FACE_MODES,                      // ldA
-                                         N_ELEMENT_MODES,                   // ldB
-                                         N_ELEMENT_MODES,                   // ldC
-                                         static_cast<real_base>(1.0),       // beta
-                                         l_scratch[1][0],                   // A
-                                         i_dg.mat.fluxT[l_fa][0],           // B
-                                         io_dofs[l_el][0][0]  );            // C
+          linalg::Matrix::matMulFusedAC< real_base,
+                                         N_CRUNS,
+                                         1,                // m
+                                         N_ELEMENT_MODES,  // n
+                                         N_FACE_MODES,     // k
+                                         N_FACE_MODES,     // ldA
+                                         N_ELEMENT_MODES,  // ldB
+                                         N_ELEMENT_MODES,  // ldC
+                                         true >( l_scratch[1][0],
+                                                 i_dg.mat.fluxT[l_fa][0],
+                                                 io_dofs[l_el][0][0] );
+        }
+      }
+    }
+
+    /**
+     * Performs the neighboring updates of the ADER-DG scheme for regular meshes with implicit connectivity.
+     * All faces are periodic, the face-neighboring elements and their local face ids are derived on the fly.
+     *
+     * @param i_first first element considered.
+     * @param i_nElements number of elements.
+     * @param i_dT time step.
+     * @param i_dg constant DG data.
+     * @param i_implicit implicit connectivity of the regular mesh.
+     * @param i_fluxSolvers flux solvers.
+     * @param i_tInt time integrated degrees of freedom.
+     * @param io_dofs DOFs which will be updated with neighboring elements' contribution.
+     **/
+    static void neigh(       int_el                                        i_first,
+                             int_el                                        i_nElements,
+                             real_base                                     i_dT,
+                       const t_dg                                         &i_dg,
+                       const mesh::regular::Implicit< T_SDISC.ELEMENT >   &i_implicit,
+                       const real_base                                   (*i_fluxSolvers)[ C_ENT[T_SDISC.ELEMENT].N_FACES*2 ],
+                       const real_base                                   (*i_tInt)[1][N_ELEMENT_MODES][N_CRUNS],
+                             real_base                                   (*io_dofs)[1][N_ELEMENT_MODES][N_CRUNS] ) {
+      // iterate over elements
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
+      for( int_el l_el = i_first; l_el < i_first+i_nElements; l_el++ ) {
+        // derive neighbors
+        int_el l_elFaEl[C_ENT[T_SDISC.ELEMENT].N_FACES];
+        i_implicit.elFaEl( l_el, l_elFaEl );
+
+        // add neighboring contribution
+        for( unsigned short l_fa = 0; l_fa < C_ENT[T_SDISC.ELEMENT].N_FACES; l_fa++ ) {
+          unsigned short l_fId =  i_implicit.vIdElFaEl( l_fa ) * C_ENT[T_SDISC.ELEMENT].N_FACES;
+                         l_fId += i_implicit.fIdElFaEl( l_fa );
+
+          // scratch space for three-way product
+          real_base l_scratch[2][N_FACE_MODES][N_CRUNS];
+
+          linalg::Matrix::matMulFusedAC< real_base,
+                                         N_CRUNS,
+                                         1,                // m
+                                         N_FACE_MODES,     // n
+                                         N_ELEMENT_MODES,  // k
+                                         N_ELEMENT_MODES,  // ldA
+                                         N_FACE_MODES,     // ldB
+                                         N_FACE_MODES,     // ldC
+                                         false >( i_tInt[ l_elFaEl[l_fa] ][0][0],
+                                                  i_dg.mat.fluxN[l_fId][0],
+                                                  l_scratch[0][0] );
+
+          linalg::Matrix::matMulFusedBC< real_base,
+                                         N_CRUNS,
+                                         1,                // m
+                                         N_FACE_MODES,     // n
+                                         1,                // k
+                                         1,                // ldA
+                                         N_FACE_MODES,     // ldB
+                                         N_FACE_MODES,     // ldC
+                                         false >( i_fluxSolvers[l_el] +
+                                                    C_ENT[T_SDISC.ELEMENT].N_FACES +
+                                                    l_fa,
+                                                  l_scratch[0][0],
+                                                  l_scratch[1][0] );
+
+          linalg::Matrix::matMulFusedAC< real_base,
+                                         N_CRUNS,
+                                         1,                // m
+                                         N_ELEMENT_MODES,  // n
+                                         N_FACE_MODES,     // k
+                                         N_FACE_MODES,     // ldA
+                                         N_ELEMENT_MODES,  // ldB
+                                         N_ELEMENT_MODES,  // ldC
+                                         true >( l_scratch[1][0],
+                                                 i_dg.mat.fluxT[l_fa][0],
+                                                 io_dofs[l_el][0][0] );
         }
       }
     }
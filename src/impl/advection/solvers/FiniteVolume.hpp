@@ -26,6 +26,7 @@
 #include <limits>
 #include <cassert>
 #include "constants.hpp"
+#include "mesh/regular/Implicit.hpp"
 
 namespace edge {
   namespace advection {
@@ -106,6 +107,37 @@ class edge::advection::solvers::FiniteVolume {
           }
       }
     }
+
+    /**
+     * Performs a single time step of the advection solver for regular meshes with implicit connectivity.
+     *
+     * @param i_first first element considered.
+     * @param i_nElement number of elements.
+     * @param i_implicit implicit connectivity of the regular mesh.
+     * @param i_fluxSolvers flux solvers.
+     * @param i_tInt time integrated DOFs.
+     * @param io_dofs DOFs.
+     **/
+    static void update(       int_el                                       i_first,
+                              int_el                                       i_nElements,
+                        const mesh::regular::Implicit< T_SDISC.ELEMENT >  &i_implicit,
+                        const t_elementShared2                           (*i_fluxSolvers)[ C_ENT[T_SDISC.ELEMENT].N_FACES*2 ],
+                        const real_base                                  (*i_tInt)[1][1][N_CRUNS],
+                              real_base                                  (*io_dofs)[1][1][N_CRUNS] ) {
+      // iterate over elements
+      for( int_el l_el = i_first; l_el < i_first+i_nElements; l_el++ ) {
+        // derive neighbors
+        int_el l_elFaEl[C_ENT[T_SDISC.ELEMENT].N_FACES];
+        i_implicit.elFaEl( l_el, l_elFaEl );
+
+        for( unsigned short l_fa = 0; l_fa < C_ENT[T_SDISC.ELEMENT].N_FACES; l_fa++ ) {
+          for( int_cfr l_run = 0; l_run < N_CRUNS; l_run++ ) {
+            io_dofs[l_el][0][0][l_run] += i_fluxSolvers[l_el][l_fa] * i_tInt[l_el][0][0][l_run];
+            io_dofs[l_el][0][0][l_run] += i_fluxSolvers[l_el][C_ENT[T_SDISC.ELEMENT].N_FACES+l_fa] * i_tInt[ l_elFaEl[l_fa] ][0][0][l_run];
+          }
+        }
+      }
+    }
 };
 
 #endif
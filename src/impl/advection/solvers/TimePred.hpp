@@ -58,6 +58,105 @@ class edge::advection::solvers::TimePred {
     //! number of element modes.
     static unsigned short const TL_N_MDS = CE_N_ELEMENT_MODES( TL_T_EL, TL_O_SP );
 
+    /**
+     * Computes the time derivative TL_DE and its contribution to the time integrated DOFs,
+     * then recurses to the next derivative.
+     * The kernels only cover the non-zero modes: in a hierarchical basis, the input derivative
+     * TL_DE-1 has CE_N_ELEMENT_MODES_CK( TL_T_EL, TL_O_SP, TL_DE-1 ) non-zero modes and the result
+     * CE_N_ELEMENT_MODES_CK( TL_T_EL, TL_O_SP, TL_DE ). Modes beyond are not touched.
+     *
+     * @paramt TL_T_REAL floating point precision.
+     * @paramt TL_DE derivative which is computed.
+     * @paramt TL_END true if all derivatives have been computed.
+     **/
+    template< typename       TL_T_REAL,
+              unsigned short TL_DE,
+              bool           TL_END = (TL_DE >= TL_O_TI) >
+    struct CkDer {
+      //! number of non-zero modes of the previous derivative
+      static unsigned short const TL_N_MDS_IN  = CE_N_ELEMENT_MODES_CK( TL_T_EL, TL_O_SP, TL_DE-1 );
+      //! number of non-zero modes of this derivative
+      static unsigned short const TL_N_MDS_OUT = CE_N_ELEMENT_MODES_CK( TL_T_EL, TL_O_SP, TL_DE );
+
+      /**
+       * Computes the derivative and updates the time integrated DOFs.
+       *
+       * @param i_dT time step.
+       * @param i_scalar scalar of the previous derivative in the taylor expansion.
+       * @param i_stiffT transposed stiffness matrix (multiplied with inverse mass matrix).
+       * @param i_star star matrices.
+       * @param o_scratch will be used as scratch memory.
+       * @param io_der time derivatives, previous ones are input, this one will be set.
+       * @param io_tInt time integrated DOFs, to which the contribution is added.
+       **/
+      static void inline apply( TL_T_REAL       i_dT,
+                                TL_T_REAL       i_scalar,
+                                TL_T_REAL const i_stiffT[TL_N_DIM][TL_N_MDS][TL_N_MDS],
+                                TL_T_REAL const i_star[TL_N_DIM],
+                                TL_T_REAL       o_scratch[TL_N_MDS][TL_N_CRS],
+                                TL_T_REAL       io_der[TL_O_TI][TL_N_MDS][TL_N_CRS],
+                                TL_T_REAL       io_tInt[TL_N_MDS][TL_N_CRS] ) {
+        // reset non-zero block of the derivative
+        for( unsigned short l_md = 0; l_md < TL_N_MDS_OUT; l_md++ )
+          for( unsigned short l_cr = 0; l_cr < TL_N_CRS; l_cr++ ) io_der[TL_DE][l_md][l_cr] = 0;
+
+        for( unsigned int l_di = 0; l_di < TL_N_DIM; l_di++ ) {
+          // multiply with transposed stiffness matrices and inverse mass matrix
+          linalg::Matrix::matMulFusedAC< TL_T_REAL,
+                                         TL_N_CRS,
+                                         1,            // m
+                                         TL_N_MDS_OUT, // n
+                                         TL_N_MDS_IN,  // k
+                                         TL_N_MDS,     // ldA
+                                         TL_N_MDS,     // ldB
+                                         TL_N_MDS,     // ldC
+                                         false >( io_der[TL_DE-1][0],
+                                                  i_stiffT[l_di][0],
+                                                  o_scratch[0] );
+
+          // multiply with star "matrices"
+          linalg::Matrix::matMulFusedBC< TL_T_REAL,
+                                         TL_N_CRS,
+                                         1,            // m
+                                         TL_N_MDS_OUT, // n
+                                         1,            // k
+                                         1,            // ldA
+                                         TL_N_MDS,     // ldB
+                                         TL_N_MDS,     // ldC
+                                         true >( i_star+l_di,
+                                                 o_scratch[0],
+                                                 io_der[TL_DE][0] );
+        }
+
+        // update scalar
+        TL_T_REAL l_scalar = i_scalar * ( -i_dT / (TL_DE+1) );
+
+        // update time integrated dofs
+        for( unsigned short l_md = 0; l_md < TL_N_MDS_OUT; l_md++ )
+          for( unsigned short l_cr = 0; l_cr < TL_N_CRS; l_cr++ ) io_tInt[l_md][l_cr] += l_scalar * io_der[TL_DE][l_md][l_cr];
+
+        CkDer< TL_T_REAL, TL_DE+1 >::apply( i_dT, l_scalar, i_stiffT, i_star, o_scratch, io_der, io_tInt );
+      }
+    };
+
+    /**
+     * Terminates the recursion over the time derivatives.
+     *
+     * @paramt TL_T_REAL floating point precision.
+     * @paramt TL_DE first derivative which is not computed.
+     **/
+    template< typename       TL_T_REAL,
+              unsigned short TL_DE >
+    struct CkDer< TL_T_REAL, TL_DE, true > {
+      static void inline apply( TL_T_REAL,
+                                TL_T_REAL,
+                                TL_T_REAL const [TL_N_DIM][TL_N_MDS][TL_N_MDS],
+                                TL_T_REAL const [TL_N_DIM],
+                                TL_T_REAL       [TL_N_MDS][TL_N_CRS],
+                                TL_T_REAL       [TL_O_TI][TL_N_MDS][TL_N_CRS],
+                                TL_T_REAL       [TL_N_MDS][TL_N_CRS] ) {}
+    };
+
   public:
     /**
      * Applies the Cauchy–Kowalevski procedure (vanilla implementation) and computes time derivatives and time integrated DOFs.
@@ -67,7 +166,7 @@ class edge::advection::solvers::TimePred {
      * @param i_star star matrices.
      * @param i_dofs DOFs.
      * @param o_scratch will be used as scratch memory.
-     * @param o_der will be set to time derivatives.
+     * @param o_der will be set to time derivatives; only the non-zero modes CE_N_ELEMENT_MODES_CK of every derivative are written.
      * @param o_tInt will be set to time integrated DOFs.
      *
      * @paramt TL_T_REAL float point precision.
@@ -91,40 +190,8 @@ class edge::advection::solvers::TimePred {
         }
       }
 
-      // iterate over time derivatives
-      for( unsigned int l_de = 1; l_de < TL_O_TI; l_de++ ) {
-        // reset derivative
-        for( unsigned short l_md = 0; l_md < TL_N_MDS; l_md++ )
-          for( unsigned short l_cr = 0; l_cr < TL_N_CRS; l_cr++ ) o_der[l_de][l_md][l_cr] = 0;
-
-        for( unsigned int l_di = 0; l_di < TL_N_DIM; l_di++ ) {
-          // multiply with transposed stiffness matrices and inverse mass matrix
-          linalg::Matrix::matMulB0FusedAC( TL_N_CRS,
-                                           1,
-                                           TL_N_MDS,
-                                           TL_N_MDS,
-                                           o_der[l_de-1][0],
-                                           i_stiffT[l_di][0],
-                                           o_scratch[0] );
-
-          // multiply with star "matrices"
-          linalg::Matrix::matMulB1FusedBC( TL_N_CRS,
-                                           1,
-                                           TL_N_MDS,
-                                           1,
-                                           i_star+l_di,
-                                           o_scratch[0],
-                                           o_der[l_de][0] );
-        }
-
-        // update scalar
-        l_scalar *= -i_dT / (l_de+1);
-
-        // update time integrated dofs
-        for( unsigned short l_md = 0; l_md < TL_N_MDS; l_md++ )
-          for( unsigned short l_cr = 0; l_cr < TL_N_CRS; l_cr++ ) o_tInt[l_md][l_cr] += l_scalar * o_der[l_de][l_md][l_cr];
-      }
-
+      // compute the time derivatives with shrinking, fixed-size kernels
+      CkDer< TL_T_REAL, 1 >::apply( i_dT, l_scalar, i_stiffT, i_star, o_scratch, o_der, o_tInt );
     }
 };
 
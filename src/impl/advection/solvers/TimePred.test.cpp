@@ -0,0 +1,241 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Tests the ADER time prediction of the advection equation.
+ **/
+
+#include <catch.hpp>
+#include <random>
+#include <vector>
+#include <iostream>
+#include "TimePred.hpp"
+#include "monitor/Timer.hpp"
+
+namespace edge {
+  namespace advection {
+    namespace solvers {
+      namespace test {
+        /**
+         * Reference Cauchy–Kowalevski procedure, which uses the runtime-sized matrix kernels.
+         *
+         * @param i_nDim number of dimensions.
+         * @param i_nMds number of modes.
+         * @param i_nCrs number of fused runs.
+         * @param i_order order of the time prediction.
+         * @param i_dT time step.
+         * @param i_stiffT transposed stiffness matrices.
+         * @param i_star star matrices.
+         * @param i_dofs DOFs.
+         * @param o_scratch scratch memory.
+         * @param o_der will be set to the time derivatives.
+         * @param o_tInt will be set to the time integrated DOFs.
+         **/
+        static void ckGeneric( unsigned short         i_nDim,
+                               unsigned short         i_nMds,
+                               unsigned short         i_nCrs,
+                               unsigned short         i_order,
+                               double                 i_dT,
+                               double         const * i_stiffT,
+                               double         const * i_star,
+                               double         const * i_dofs,
+                               double               * o_scratch,
+                               double               * o_der,
+                               double               * o_tInt ) {
+          double l_scalar = i_dT;
+          unsigned int l_size = i_nMds * i_nCrs;
+
+          for( unsigned int l_en = 0; l_en < l_size; l_en++ ) {
+            o_der[l_en]  = i_dofs[l_en];
+            o_tInt[l_en] = l_scalar * i_dofs[l_en];
+          }
+
+          for( unsigned short l_de = 1; l_de < i_order; l_de++ ) {
+            for( unsigned int l_en = 0; l_en < l_size; l_en++ ) o_der[l_de*l_size + l_en] = 0;
+
+            for( unsigned short l_di = 0; l_di < i_nDim; l_di++ ) {
+              linalg::Matrix::matMulFusedAC( i_nCrs, 1, i_nMds, i_nMds,
+                                             i_nMds, i_nMds, i_nMds,
+                                             0.0,
+                                             o_der+(l_de-1)*l_size,
+                                             i_stiffT+l_di*i_nMds*i_nMds,
+                                             o_scratch );
+              linalg::Matrix::matMulFusedBC( i_nCrs, 1, i_nMds, 1,
+                                             1, i_nMds, i_nMds,
+                                             1.0,
+                                             i_star+l_di,
+                                             o_scratch,
+                                             o_der+l_de*l_size );
+            }
+
+            l_scalar *= -i_dT / (l_de+1);
+            for( unsigned int l_en = 0; l_en < l_size; l_en++ ) o_tInt[l_en] += l_scalar * o_der[l_de*l_size + l_en];
+          }
+        }
+
+        /**
+         * Runs the fixed-size and generic time prediction on random data with the sparsity pattern of a hierarchical basis.
+         * Checks the results for equality and, if requested, reports the throughput of both versions.
+         *
+         * @param i_nReps number of repetitions; 0 disables the throughput measurements.
+         *
+         * @paramt TL_T_EL element type.
+         * @paramt TL_O order.
+         * @paramt TL_N_CRS number of fused runs.
+         **/
+        template< t_entityType   TL_T_EL,
+                  unsigned short TL_O,
+                  unsigned short TL_N_CRS >
+        static void run( unsigned int i_nReps ) {
+          unsigned short const l_nDim = C_ENT[TL_T_EL].N_DIM;
+          unsigned short const l_nMds = CE_N_ELEMENT_MODES( TL_T_EL, TL_O );
+          unsigned int   const l_size = l_nMds * TL_N_CRS;
+
+          std::mt19937 l_gen( TL_O );
+          std::uniform_real_distribution< double > l_dist( -1.0, 1.0 );
+
+          std::vector< double > l_stiffT( l_nDim * l_nMds * l_nMds );
+          std::vector< double > l_star( l_nDim );
+          std::vector< double > l_dofs( l_size );
+          // the derivative of a mode only has contributions in modes of lower order (hierarchical bases)
+          for( unsigned short l_di = 0; l_di < l_nDim; l_di++ ) {
+            for( unsigned short l_k = 0; l_k < l_nMds; l_k++ ) {
+              unsigned short l_oK = 1;
+              while( CE_N_ELEMENT_MODES( TL_T_EL, l_oK ) <= l_k ) l_oK++;
+
+              for( unsigned short l_n = 0; l_n < l_nMds; l_n++ ) {
+                bool l_nz = l_n < CE_N_ELEMENT_MODES_CK( TL_T_EL, l_oK, 1 );
+                l_stiffT[ (l_di*l_nMds + l_k)*l_nMds + l_n ] = l_nz ? l_dist( l_gen ) / l_nMds : 0;
+              }
+            }
+          }
+          for( std::size_t l_en = 0; l_en < l_star.size();   l_en++ ) l_star[l_en]   = l_dist( l_gen );
+          for( std::size_t l_en = 0; l_en < l_dofs.size();   l_en++ ) l_dofs[l_en]   = l_dist( l_gen );
+
+          std::vector< double > l_scratch( l_size ), l_der( TL_O * l_size );
+          std::vector< double > l_tIntFix( l_size ), l_tIntGen( l_size );
+
+          typedef TimePred< TL_T_EL, TL_O, TL_O, TL_N_CRS > t_tp;
+
+          t_tp::ckVanilla( 0.1,
+                           (double (*)[l_nMds][l_nMds]) l_stiffT.data(),
+                           l_star.data(),
+                           (double (*)[TL_N_CRS]) l_dofs.data(),
+                           (double (*)[TL_N_CRS]) l_scratch.data(),
+                           (double (*)[l_nMds][TL_N_CRS]) l_der.data(),
+                           (double (*)[TL_N_CRS]) l_tIntFix.data() );
+
+          ckGeneric( l_nDim, l_nMds, TL_N_CRS, TL_O, 0.1,
+                     l_stiffT.data(), l_star.data(), l_dofs.data(),
+                     l_scratch.data(), l_der.data(), l_tIntGen.data() );
+
+          for( unsigned int l_en = 0; l_en < l_size; l_en++ )
+            REQUIRE( l_tIntFix[l_en] == Approx( l_tIntGen[l_en] ) );
+
+          if( i_nReps == 0 ) return;
+
+          edge::monitor::Timer l_timer;
+          double l_time[2];
+
+          for( unsigned short l_ve = 0; l_ve < 2; l_ve++ ) {
+            l_timer.start();
+            for( unsigned int l_re = 0; l_re < i_nReps; l_re++ ) {
+              if( l_ve == 0 ) {
+                ckGeneric( l_nDim, l_nMds, TL_N_CRS, TL_O, 0.1,
+                           l_stiffT.data(), l_star.data(), l_dofs.data(),
+                           l_scratch.data(), l_der.data(), l_tIntGen.data() );
+              }
+              else {
+                t_tp::ckVanilla( 0.1,
+                                 (double (*)[l_nMds][l_nMds]) l_stiffT.data(),
+                                 l_star.data(),
+                                 (double (*)[TL_N_CRS]) l_dofs.data(),
+                                 (double (*)[TL_N_CRS]) l_scratch.data(),
+                                 (double (*)[l_nMds][TL_N_CRS]) l_der.data(),
+                                 (double (*)[TL_N_CRS]) l_tIntFix.data() );
+              }
+            }
+            l_timer.end();
+            l_time[l_ve] = l_timer.elapsed();
+          }
+
+          // non-zero flops of the time prediction
+          double l_flops = 0;
+          for( unsigned short l_de = 1; l_de < TL_O; l_de++ ) {
+            double l_nIn  = CE_N_ELEMENT_MODES_CK( TL_T_EL, TL_O, l_de-1 );
+            double l_nOut = CE_N_ELEMENT_MODES_CK( TL_T_EL, TL_O, l_de );
+            l_flops += l_nDim * ( 2.0 * l_nIn * l_nOut + 2.0 * l_nOut ) * TL_N_CRS;
+          }
+          l_flops *= i_nReps;
+
+          std::cout << C_ENT[TL_T_EL].N_DIM << "D element type " << TL_T_EL
+                    << ", order " << TL_O << ", #modes " << l_nMds << ": "
+                    << "generic " << l_flops / l_time[0] * 1.0E-9 << " GFLOPS, "
+                    << "fixed " << l_flops / l_time[1] * 1.0E-9 << " GFLOPS, "
+                    << "speedup " << l_time[0] / l_time[1] << std::endl;
+        }
+
+        /**
+         * Runs the comparison for all orders up to the given one.
+         *
+         * @param i_nReps number of repetitions.
+         *
+         * @paramt TL_T_EL element type.
+         * @paramt TL_O maximum order.
+         **/
+        template< t_entityType   TL_T_EL,
+                  unsigned short TL_O >
+        struct Orders {
+          static void run( unsigned int i_nReps ) {
+            Orders< TL_T_EL, TL_O-1 >::run( i_nReps );
+            // keep the amount of work per order roughly constant
+            unsigned int l_nMds = CE_N_ELEMENT_MODES( TL_T_EL, TL_O );
+            test::run< TL_T_EL, TL_O, 1 >( (i_nReps == 0) ? 0 : i_nReps / (l_nMds * l_nMds) + 1 );
+          }
+        };
+
+        template< t_entityType TL_T_EL >
+        struct Orders< TL_T_EL, 0 > {
+          static void run( unsigned int ) {}
+        };
+      }
+    }
+  }
+}
+
+TEST_CASE( "TimePred: Fixed-size against generic matrix kernels.", "[TimePred][ck]" ) {
+  edge::advection::solvers::test::Orders< LINE,   9 >::run( 0 );
+  edge::advection::solvers::test::Orders< QUAD4R, 5 >::run( 0 );
+  edge::advection::solvers::test::Orders< TRIA3,  5 >::run( 0 );
+  edge::advection::solvers::test::Orders< HEX8R,  4 >::run( 0 );
+  edge::advection::solvers::test::Orders< TET4,   4 >::run( 0 );
+
+  edge::advection::solvers::test::run< TET4,  3, 8 >( 0 );
+  edge::advection::solvers::test::run< HEX8R, 2, 4 >( 0 );
+}
+
+TEST_CASE( "TimePred: Throughput of fixed-size and generic kernels for orders 1-9.", "[.][TimePred][bench]" ) {
+  unsigned int l_nReps = 100000000;
+
+  edge::advection::solvers::test::Orders< LINE,   9 >::run( l_nReps );
+  edge::advection::solvers::test::Orders< QUAD4R, 9 >::run( l_nReps );
+  edge::advection::solvers::test::Orders< TRIA3,  9 >::run( l_nReps );
+  edge::advection::solvers::test::Orders< HEX8R,  9 >::run( l_nReps );
+  edge::advection::solvers::test::Orders< TET4,   9 >::run( l_nReps );
+}
@@ -0,0 +1,801 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *
+ * @section DESCRIPTION
+ * Microbenchmarks of the elastic kernels.
+ **/
+
+#ifndef EDGE_ELASTIC_BENCH_KERNELS_HPP
+#define EDGE_ELASTIC_BENCH_KERNELS_HPP
+
+#include <unistd.h>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include "constants.hpp"
+#include "io/logging.h"
+#include "data/common.hpp"
+#include "parallel/global.h"
+#include "monitor/KernelModel.hpp"
+#include "monitor/PerfCounters.h"
+#include "impl/elastic/solvers/AderDg.hpp"
+#include "impl/elastic/solvers/FusedTiles.hpp"
+#include "impl/elastic/solvers/TimePred.hpp"
+#include "impl/elastic/solvers/VolInt.hpp"
+#include "impl/elastic/solvers/SurfInt.hpp"
+#include "impl/elastic/solvers/Kinematics.hpp"
+#include "impl/elastic/solvers/FrictionLaws.hpp"
+
+namespace edge {
+  namespace elastic {
+    namespace bench {
+      class Kernels;
+    }
+  }
+}
+
+/**
+ * Times the kernels of the elastic solvers in isolation.
+ *
+ * Every kernel runs on synthetic batches of entities whose data fits into L1, L2, the last level cache or only into DRAM.
+ * The work per entity is taken from the analytic kernel model; the results are written as JSON.
+ **/
+class edge::elastic::bench::Kernels {
+  private:
+    //! number of size classes: L1, L2, LLC, DRAM
+    static unsigned short const N_SIZES = 4;
+
+    //! number of faces
+    static unsigned short const N_FAS = C_ENT[T_SDISC.ELEMENT].N_FACES;
+
+    //! number of vertices per face
+    static unsigned short const N_FA_VES = C_ENT[T_SDISC.ELEMENT].N_FACE_VERTICES;
+
+    //! number of slip-rate samples per kinematic point source
+    static unsigned short const N_SR_SAMPLES = 16;
+
+    //! model of the kernels' work
+    typedef monitor::KernelModel< T_SDISC.ELEMENT,
+                                  ORDER,
+                                  N_QUANTITIES,
+                                  N_CRUNS,
+                                  real_base > t_model;
+
+    //! kinematic source descriptions, one per concurrent run
+    typedef solvers::t_Kinematics< N_DIM,
+                                   N_ELEMENT_MODES,
+                                   1,
+                                   real_base,
+                                   int_el > t_kin;
+
+    //! linear slip weakening data of the faces and their single quadrature point
+    typedef solvers::t_LinSlipWeakGlobal< real_base, N_CRUNS > t_lswGl;
+    typedef solvers::t_LinSlipWeakFace< real_base > t_lswFa;
+    typedef solvers::t_LinSlipWeakFaceQuadPoint< real_base, N_DIM, N_CRUNS > t_lswQp;
+
+    //! data of a single kernel measurement
+    typedef struct {
+      //! name of the kernel
+      std::string name;
+      //! entity type the kernel works on
+      std::string entity;
+      //! id of the size class
+      unsigned short size;
+      //! number of entities in the batch
+      std::size_t nEns;
+      //! bytes of the batch
+      std::size_t bytes;
+      //! seconds per entity
+      double time;
+      //! last level cache misses per entity, negative if not available
+      double llcMisses;
+      //! work per entity, see the kernel model
+      double work[3];
+    } t_result;
+
+    //! names of the size classes
+    std::string m_sizeNames[N_SIZES] = { "L1", "L2", "LLC", "DRAM" };
+
+    //! targeted bytes of the batches in the size classes
+    std::size_t m_sizes[N_SIZES];
+
+    //! minimum duration of a measurement in seconds
+    double m_minTime;
+
+    //! random number generator for the synthetic data
+    std::mt19937 m_gen;
+
+    //! results of the measurements
+    std::vector< t_result > m_results;
+
+    //! last level cache misses per call of the last measurement, negative if not available
+    double m_llcMisses;
+
+    /**
+     * Fills the given values with uniform random numbers in [i_min, i_max].
+     *
+     * @param i_nVals number of values.
+     * @param i_min lower bound.
+     * @param i_max upper bound.
+     * @param o_vals will be set to random values.
+     **/
+    void random( std::size_t   i_nVals,
+                 real_base     i_min,
+                 real_base     i_max,
+                 real_base   * o_vals ) {
+      std::uniform_real_distribution< real_base > l_dist( i_min, i_max );
+      for( std::size_t l_va = 0; l_va < i_nVals; l_va++ ) o_vals[l_va] = l_dist( m_gen );
+    }
+
+    /**
+     * Sets up star matrices of synthetic elements, which have the sparsity pattern of a real mesh.
+     * The vertices of the reference element are scaled and, for simplices, perturbed at random;
+     * material parameters of order one keep repeated updates of the DOFs bounded.
+     *
+     * @param i_nEls number of elements.
+     * @param o_starM will be set to the star matrices.
+     **/
+    void starM( int_el            i_nEls,
+                t_matStar       (*o_starM)[N_DIM] ) {
+      unsigned short const l_nVes = C_ENT[T_SDISC.ELEMENT].N_VERTICES;
+      real_mesh const *l_refVes = C_REF_ELEMENT.VE.ENT[T_SDISC.ELEMENT];
+      bool l_simplex = T_SDISC.ELEMENT == TRIA3 || T_SDISC.ELEMENT == TET4;
+
+      std::vector< t_vertexChars > l_veChars( std::size_t(i_nEls) * l_nVes );
+      std::vector< int_el > l_elVe( std::size_t(i_nEls) * l_nVes );
+      std::vector< t_bgPars > l_bgPars( i_nEls );
+
+      std::uniform_real_distribution< real_mesh > l_distSc( 0.5, 2 );
+      std::uniform_real_distribution< real_mesh > l_distPe( -0.15, 0.15 );
+      std::uniform_real_distribution< real_base > l_distMat( 1, 2 );
+
+      for( int_el l_el = 0; l_el < i_nEls; l_el++ ) {
+        real_mesh l_scale[3] = { 1, 1, 1 };
+        for( unsigned short l_di = 0; l_di < N_DIM; l_di++ ) l_scale[l_di] = l_distSc( m_gen );
+
+        for( unsigned short l_ve = 0; l_ve < l_nVes; l_ve++ ) {
+          std::size_t l_id = std::size_t(l_el) * l_nVes + l_ve;
+          l_elVe[l_id] = l_id;
+
+          for( unsigned short l_di = 0; l_di < 3; l_di++ ) {
+            real_mesh l_co = (l_di < N_DIM) ? l_refVes[l_di*l_nVes + l_ve] : 0;
+            if( l_simplex && l_di < N_DIM ) l_co += l_distPe( m_gen );
+            l_veChars[l_id].coords[l_di] = l_co * l_scale[l_di];
+          }
+        }
+
+        l_bgPars[l_el].rho = l_distMat( m_gen );
+        l_bgPars[l_el].lam = l_distMat( m_gen );
+        l_bgPars[l_el].mu  = l_distMat( m_gen );
+      }
+
+      solvers::AderDg::setupStarM( i_nEls,
+                                   l_veChars.data(),
+                                   (int_el (*)[l_nVes]) l_elVe.data(),
+                                   (t_bgPars (*)[1]) l_bgPars.data(),
+                                   o_starM );
+    }
+
+    /**
+     * Times the given function. The function is called once for warm-up and repeated until the minimum duration is reached.
+     * The last level cache misses per call are stored in m_llcMisses.
+     *
+     * @param i_fun function which is timed.
+     * @return average seconds per call.
+     *
+     * @paramt TL_T_FUN type of the function.
+     **/
+    template< typename TL_T_FUN >
+    double measure( TL_T_FUN i_fun ) {
+      i_fun();
+
+      monitor::PerfCounters l_cnts;
+      bool l_cntsOn =    l_cnts.open( sizeof(real_base) == 4 )
+                      && l_cnts.available( monitor::PerfCounters::LLC_MISSES );
+      double l_cntsBe[monitor::PerfCounters::N_VALUES];
+      double l_cntsAf[monitor::PerfCounters::N_VALUES];
+      l_cnts.read( l_cntsBe );
+
+      std::size_t l_reps = 0;
+      double l_dur = 0;
+      std::chrono::steady_clock::time_point l_start = std::chrono::steady_clock::now();
+      while( l_dur < m_minTime || l_reps < 3 ) {
+        i_fun();
+        l_reps++;
+        l_dur = std::chrono::duration< double >( std::chrono::steady_clock::now() - l_start ).count();
+      }
+
+      l_cnts.read( l_cntsAf );
+      m_llcMisses = -1;
+      if( l_cntsOn ) m_llcMisses = ( l_cntsAf[monitor::PerfCounters::LLC_MISSES] - l_cntsBe[monitor::PerfCounters::LLC_MISSES] ) / l_reps;
+
+      return l_dur / l_reps;
+    }
+
+    /**
+     * Stores the result of a measurement.
+     *
+     * @param i_name name of the kernel.
+     * @param i_entity entity type the kernel works on.
+     * @param i_size id of the size class.
+     * @param i_nEns number of entities in the batch.
+     * @param i_bytes bytes of the batch.
+     * @param i_time seconds per call for the entire batch.
+     * @param i_work work per entity.
+     **/
+    void store( std::string const & i_name,
+                std::string const & i_entity,
+                unsigned short      i_size,
+                std::size_t         i_nEns,
+                std::size_t         i_bytes,
+                double              i_time,
+                double      const   i_work[3] ) {
+      t_result l_res;
+      l_res.name   = i_name;
+      l_res.entity = i_entity;
+      l_res.size   = i_size;
+      l_res.nEns   = i_nEns;
+      l_res.bytes  = i_bytes;
+      l_res.time   = i_time / i_nEns;
+      l_res.llcMisses = (m_llcMisses < 0) ? -1 : m_llcMisses / i_nEns;
+      for( unsigned short l_en = 0; l_en < 3; l_en++ ) l_res.work[l_en] = i_work[l_en];
+      m_results.push_back( l_res );
+
+      EDGE_LOG_INFO << "  " << i_name << " (" << m_sizeNames[i_size] << ", " << i_nEns << " " << i_entity << "s): "
+                    << l_res.time * 1E9 << " ns/" << i_entity << ", "
+                    << i_work[0] / l_res.time * 1E-9 << " GFLOP/s"
+                    << ( (l_res.llcMisses < 0) ? "" : ", LLC misses/" + i_entity + ": " + std::to_string( l_res.llcMisses ) );
+    }
+
+    /**
+     * Benchmarks the ADER-DG kernels on a batch of elements: time prediction, volume integration,
+     * local and neighboring surface integration.
+     * Face-neighbors are drawn at random from the batch.
+     *
+     * @param i_size id of the size class.
+     * @param i_dg constant DG data.
+     * @param i_mm matrix-matrix multiplication kernels.
+     *
+     * @paramt TL_T_MM type of the matrix-matrix multiplication kernels.
+     **/
+    template< typename TL_T_MM >
+    void aderDg( unsigned short   i_size,
+                 t_dg           & i_dg,
+                 TL_T_MM        & i_mm ) {
+      typedef real_base t_dofs[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS];
+
+      // bytes per element
+      std::size_t l_bytesEl =   2 * sizeof(t_dofs)
+                              + N_DIM * sizeof(t_matStar)
+                              + 2 * N_FAS * sizeof(t_fluxSolver)
+                              + N_FAS * ( sizeof(int_el) + 2 * sizeof(unsigned short) );
+      int_el l_nEls = std::max( m_sizes[i_size] / l_bytesEl, (std::size_t) 1 );
+
+      // allocate and init synthetic data
+      t_dofs *l_dofs = (t_dofs*) data::common::allocate( l_nEls * sizeof(t_dofs), ALIGNMENT.BASE.HEAP );
+      t_dofs *l_tInt = (t_dofs*) data::common::allocate( l_nEls * sizeof(t_dofs), ALIGNMENT.BASE.HEAP );
+      t_matStar (*l_starM)[N_DIM] = (t_matStar (*)[N_DIM]) data::common::allocate( l_nEls * N_DIM * sizeof(t_matStar),
+                                                                                    ALIGNMENT.BASE.HEAP );
+      t_fluxSolver (*l_fsL)[N_FAS] = (t_fluxSolver (*)[N_FAS]) data::common::allocate( l_nEls * N_FAS * sizeof(t_fluxSolver),
+                                                                                       ALIGNMENT.BASE.HEAP );
+      t_fluxSolver (*l_fsN)[N_FAS] = (t_fluxSolver (*)[N_FAS]) data::common::allocate( l_nEls * N_FAS * sizeof(t_fluxSolver),
+                                                                                       ALIGNMENT.BASE.HEAP );
+      std::vector< int_el > l_elFaEl( l_nEls * N_FAS );
+      std::vector< unsigned short > l_fIdElFaEl( l_nEls * N_FAS );
+      std::vector< unsigned short > l_vIdElFaEl( l_nEls * N_FAS );
+
+      random( l_nEls * sizeof(t_dofs) / sizeof(real_base),             0, 1, l_dofs[0][0][0] );
+      random( l_nEls * sizeof(t_dofs) / sizeof(real_base),             0, 1, l_tInt[0][0][0] );
+      starM( l_nEls, l_starM );
+      random( l_nEls * N_FAS * sizeof(t_fluxSolver) / sizeof(real_base), -1, 1, (real_base *) l_fsL );
+      random( l_nEls * N_FAS * sizeof(t_fluxSolver) / sizeof(real_base), -1, 1, (real_base *) l_fsN );
+
+      std::uniform_int_distribution< int_el > l_distEl( 0, l_nEls-1 );
+      std::uniform_int_distribution< unsigned short > l_distFa( 0, N_FAS-1 );
+      std::uniform_int_distribution< unsigned short > l_distVe( 0, N_FA_VES-1 );
+      for( std::size_t l_id = 0; l_id < l_elFaEl.size(); l_id++ ) {
+        l_elFaEl[l_id]    = l_distEl( m_gen );
+        l_fIdElFaEl[l_id] = l_distFa( m_gen );
+        l_vIdElFaEl[l_id] = l_distVe( m_gen );
+      }
+
+      // small time step keeps the repeated updates of the DOFs bounded
+      real_base l_dT = 1E-4;
+
+      // scratch memory
+      real_base (*l_tmpEl)[N_ELEMENT_MODES][N_CRUNS] = parallel::g_scratchMem->tRes;
+      real_base (*l_derBuffer)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS] = parallel::g_scratchMem->dBuf;
+      real_base (*l_tmpFa)[N_QUANTITIES][N_FACE_MODES][N_CRUNS] =
+        (real_base (*)[N_QUANTITIES][N_FACE_MODES][N_CRUNS]) parallel::g_scratchMem->dBuf;
+
+      double l_work[3];
+
+      // time prediction
+      double l_time = measure( [&]() {
+        for( int_el l_el = 0; l_el < l_nEls; l_el++ ) {
+          solvers::TimePred< T_SDISC.ELEMENT,
+                             N_QUANTITIES,
+                             ORDER,
+                             ORDER,
+                             N_CRUNS >::ck(  l_dT,
+                                             i_dg.mat.stiffT,
+                                           &(l_starM[l_el][0].mat),
+                                             l_dofs[l_el],
+                                             i_mm,
+                                             l_tmpEl,
+                                             l_derBuffer,
+                                             l_tInt[l_el] );
+        }
+      } );
+      t_model::timePred( N_MAT_STAR, l_work );
+      store( "TimePred::ck", "element", i_size, l_nEls, l_nEls * l_bytesEl, l_time, l_work );
+
+      // volume integration
+      l_time = measure( [&]() {
+        for( int_el l_el = 0; l_el < l_nEls; l_el++ ) {
+          solvers::VolInt< T_SDISC.ELEMENT,
+                           N_QUANTITIES,
+                           ORDER,
+                           N_CRUNS >::apply(  i_dg.mat.stiff,
+                                             &l_starM[l_el][0].mat,
+                                              l_tInt[l_el],
+                                              i_mm,
+                                              l_dofs[l_el],
+                                              l_tmpEl );
+        }
+      } );
+      t_model::volInt( N_MAT_STAR, l_work );
+      store( "VolInt::apply", "element", i_size, l_nEls, l_nEls * l_bytesEl, l_time, l_work );
+
+      // local surface integration
+      l_time = measure( [&]() {
+        for( int_el l_el = 0; l_el < l_nEls; l_el++ ) {
+          int_el l_pre = std::min( l_el+1, l_nEls-1 );
+
+          solvers::SurfInt< T_SDISC.ELEMENT,
+                            N_QUANTITIES,
+                            ORDER,
+                            ORDER,
+                            N_CRUNS >::local( i_dg.mat.fluxL,
+                                              i_dg.mat.fluxT,
+                                              ( real_base (*)[N_QUANTITIES][N_QUANTITIES] ) ( l_fsL[l_el][0].solver[0] ),
+                                              l_tInt[l_el],
+                                              i_mm,
+                                              l_dofs[l_el],
+                                              l_tmpFa,
+                                              l_dofs[l_pre],
+                                              l_tInt[l_pre] );
+        }
+      } );
+      t_model::surfLocal( l_work );
+      store( "SurfInt::local", "element", i_size, l_nEls, l_nEls * l_bytesEl, l_time, l_work );
+
+      // neighboring surface integration
+      l_time = measure( [&]() {
+        for( int_el l_el = 0; l_el < l_nEls; l_el++ ) {
+          for( unsigned short l_fa = 0; l_fa < N_FAS; l_fa++ ) {
+            std::size_t l_id = l_el * N_FAS + l_fa;
+            unsigned short l_fId = solvers::SurfInt< T_SDISC.ELEMENT,
+                                                     N_QUANTITIES,
+                                                     ORDER,
+                                                     ORDER,
+                                                     N_CRUNS >::fMatId( l_vIdElFaEl[l_id],
+                                                                        l_fIdElFaEl[l_id] );
+            int_el l_ne = l_elFaEl[l_id];
+            int_el l_neUp = (l_id+1 < l_elFaEl.size()) ? l_elFaEl[l_id+1] : l_ne;
+
+            solvers::SurfInt< T_SDISC.ELEMENT,
+                              N_QUANTITIES,
+                              ORDER,
+                              ORDER,
+                              N_CRUNS >::neigh( i_dg.mat.fluxN[l_fId],
+                                                i_dg.mat.fluxT[l_fa],
+                                                ( real_base (*)[N_QUANTITIES] ) ( l_fsN[l_el][l_fa].solver[0] ),
+                                                l_tInt[l_ne],
+                                                i_mm,
+                                                l_dofs[l_el],
+                                                l_tmpFa,
+                                                l_tInt[l_neUp],
+                                                l_fa,
+                                                l_fId + N_FAS );
+          }
+        }
+      } );
+      t_model::neigh( l_work );
+      store( "SurfInt::neigh", "element", i_size, l_nEls, l_nEls * l_bytesEl, l_time, l_work );
+
+      data::common::release( l_dofs );
+      data::common::release( l_tInt );
+      data::common::release( l_starM );
+      data::common::release( l_fsL );
+      data::common::release( l_fsN );
+    }
+
+    /**
+     * Benchmarks the local and neighboring updates of a batch of elements in two sweeps and fused in tiles.
+     * The face-neighbors are banded as in a reordered mesh: face pair i is adjacent to the elements at -s^i and +s^i
+     * (periodic), where s is chosen such that the largest distance is about half a tile.
+     * Elements which are not fused get their neighboring update in a second sweep, as in the solver.
+     *
+     * @param i_size id of the size class.
+     * @param i_dg constant DG data.
+     * @param i_mm matrix-matrix multiplication kernels.
+     *
+     * @paramt TL_T_MM type of the matrix-matrix multiplication kernels.
+     **/
+    template< typename TL_T_MM >
+    void fused( unsigned short   i_size,
+                t_dg           & i_dg,
+                TL_T_MM        & i_mm ) {
+      typedef real_base t_dofs[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS];
+
+      // bytes per element
+      std::size_t l_bytesEl =   2 * sizeof(t_dofs)
+                              + N_DIM * sizeof(t_matStar)
+                              + 2 * N_FAS * sizeof(t_fluxSolver)
+                              + N_FAS * ( sizeof(int_el) + 2 * sizeof(unsigned short) );
+      int_el l_nEls = std::max( m_sizes[i_size] / l_bytesEl, (std::size_t) 1 );
+
+      t_dofs *l_dofs = (t_dofs*) data::common::allocate( l_nEls * sizeof(t_dofs), ALIGNMENT.BASE.HEAP );
+      t_dofs *l_tInt = (t_dofs*) data::common::allocate( l_nEls * sizeof(t_dofs), ALIGNMENT.BASE.HEAP );
+      t_matStar (*l_starM)[N_DIM] = (t_matStar (*)[N_DIM]) data::common::allocate( l_nEls * N_DIM * sizeof(t_matStar),
+                                                                                    ALIGNMENT.BASE.HEAP );
+      t_fluxSolver (*l_fsL)[N_FAS] = (t_fluxSolver (*)[N_FAS]) data::common::allocate( l_nEls * N_FAS * sizeof(t_fluxSolver),
+                                                                                       ALIGNMENT.BASE.HEAP );
+      t_fluxSolver (*l_fsN)[N_FAS] = (t_fluxSolver (*)[N_FAS]) data::common::allocate( l_nEls * N_FAS * sizeof(t_fluxSolver),
+                                                                                       ALIGNMENT.BASE.HEAP );
+      std::vector< int_el > l_elFaEl( l_nEls * N_FAS );
+      std::vector< unsigned short > l_fIdElFaEl( l_nEls * N_FAS );
+      std::vector< unsigned short > l_vIdElFaEl( l_nEls * N_FAS );
+      std::vector< unsigned char > l_elFused( l_nEls, 0 );
+
+      random( l_nEls * sizeof(t_dofs) / sizeof(real_base),             0, 1, l_dofs[0][0][0] );
+      random( l_nEls * sizeof(t_dofs) / sizeof(real_base),             0, 1, l_tInt[0][0][0] );
+      starM( l_nEls, l_starM );
+      random( l_nEls * N_FAS * sizeof(t_fluxSolver) / sizeof(real_base), -1, 1, (real_base *) l_fsL );
+      random( l_nEls * N_FAS * sizeof(t_fluxSolver) / sizeof(real_base), -1, 1, (real_base *) l_fsN );
+
+      // stride of the bands
+      int_el l_stride = 2;
+      for( int_el l_st = 2; ; l_st++ ) {
+        int_el l_max = 1;
+        for( unsigned short l_pa = 0; l_pa < N_FAS/2; l_pa++ ) l_max *= l_st;
+        if( l_max > N_ELEMENTS_TILE_FUSED / 2 ) break;
+        l_stride = l_st;
+      }
+
+      std::uniform_int_distribution< unsigned short > l_distFa( 0, N_FAS-1 );
+      std::uniform_int_distribution< unsigned short > l_distVe( 0, N_FA_VES-1 );
+      for( int_el l_el = 0; l_el < l_nEls; l_el++ ) {
+        int_el l_dist = 1;
+        for( unsigned short l_fa = 0; l_fa < N_FAS; l_fa++ ) {
+          std::size_t l_id = l_el * N_FAS + l_fa;
+          int_el l_off = l_dist % l_nEls;
+          l_elFaEl[l_id]    = (l_fa % 2 == 0) ? (l_el + l_nEls - l_off) % l_nEls : (l_el + l_off) % l_nEls;
+          l_fIdElFaEl[l_id] = l_distFa( m_gen );
+          l_vIdElFaEl[l_id] = l_distVe( m_gen );
+          if( l_fa % 2 == 1 ) l_dist *= l_stride;
+        }
+      }
+      int_el const (*l_elFaElPtr)[N_FAS] = (int_el const (*)[N_FAS]) l_elFaEl.data();
+      unsigned short const (*l_fIdPtr)[N_FAS] = (unsigned short const (*)[N_FAS]) l_fIdElFaEl.data();
+      unsigned short const (*l_vIdPtr)[N_FAS] = (unsigned short const (*)[N_FAS]) l_vIdElFaEl.data();
+
+      real_base l_dT = 1E-4;
+      real_base (*l_tmpFa)[N_QUANTITIES][N_FACE_MODES][N_CRUNS] =
+        (real_base (*)[N_QUANTITIES][N_FACE_MODES][N_CRUNS]) parallel::g_scratchMem->dBuf;
+
+      double l_work[3];
+      t_model::localNeigh( N_MAT_STAR, l_work );
+
+      // two sweeps
+      double l_time = measure( [&]() {
+        solvers::AderDg::localEls( (int_el) 0, l_nEls, l_dT, i_dg, l_starM, l_fsL, l_dofs, l_tInt, i_mm );
+        for( int_el l_el = 0; l_el < l_nEls; l_el++ )
+          solvers::AderDg::neighEl< false >( l_el, l_nEls-1, i_dg, (t_faceChars *) nullptr, l_fsN,
+                                             l_elFaElPtr, l_elFaElPtr, l_fIdPtr, l_vIdPtr,
+                                             l_tInt, l_dofs, i_mm, l_tmpFa );
+      } );
+      store( "AderDg::local+neigh", "element", i_size, l_nEls, l_nEls * l_bytesEl, l_time, l_work );
+
+      // fused tiles and the remaining neighboring updates
+      int_el l_nFused = 0;
+      l_time = measure( [&]() {
+        solvers::FusedTiles< int_el,
+                             N_FAS,
+                             N_ELEMENTS_TILE_FUSED,
+                             N_ELEMENTS_PEND_FUSED >::run( 0, l_nEls, l_elFaElPtr, 0, (int_el const *) nullptr,
+          [&]( int_el i_firstTl, int_el i_nElsTl ) {
+            solvers::AderDg::localEls( i_firstTl, i_nElsTl, l_dT, i_dg, l_starM, l_fsL, l_dofs, l_tInt, i_mm );
+          },
+          [&]( int_el i_el, int_el i_last, bool ) {
+            solvers::AderDg::neighEl< false >( i_el, i_last, i_dg, (t_faceChars *) nullptr, l_fsN,
+                                               l_elFaElPtr, l_elFaElPtr, l_fIdPtr, l_vIdPtr,
+                                               l_tInt, l_dofs, i_mm, l_tmpFa );
+            l_elFused[i_el] = 1;
+          } );
+
+        l_nFused = 0;
+        for( int_el l_el = 0; l_el < l_nEls; l_el++ ) {
+          if( l_elFused[l_el] == 0 )
+            solvers::AderDg::neighEl< false >( l_el, l_nEls-1, i_dg, (t_faceChars *) nullptr, l_fsN,
+                                               l_elFaElPtr, l_elFaElPtr, l_fIdPtr, l_vIdPtr,
+                                               l_tInt, l_dofs, i_mm, l_tmpFa );
+          else l_nFused++;
+          l_elFused[l_el] = 0;
+        }
+      } );
+      store( "AderDg::localNeigh", "element", i_size, l_nEls, l_nEls * l_bytesEl, l_time, l_work );
+      EDGE_LOG_INFO << "    fused neighboring updates: " << l_nFused << " / " << l_nEls << " elements";
+
+      data::common::release( l_dofs );
+      data::common::release( l_tInt );
+      data::common::release( l_starM );
+      data::common::release( l_fsL );
+      data::common::release( l_fsN );
+    }
+
+    /**
+     * Benchmarks the kinematic sources on a batch of source-elements.
+     * Every element holds one point source per concurrent run, all slip directions are active.
+     *
+     * @param i_size id of the size class.
+     **/
+    void kinematics( unsigned short i_size ) {
+      typedef real_base t_dofs[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS];
+      unsigned short const l_nStress = (N_DIM == 2) ? 3 : 6;
+
+      // bytes per element
+      std::size_t l_bytesEl =   sizeof(t_dofs)
+                              + N_CRUNS * (   sizeof(int_el) * (2 + N_DIM)
+                                            + sizeof(real_base) * (   2 + N_ELEMENT_MODES
+                                                                    + N_DIM * ( l_nStress + N_SR_SAMPLES ) ) );
+      int_el l_nEls = std::max( m_sizes[i_size] / l_bytesEl, (std::size_t) 1 );
+
+      t_dofs *l_dofs = (t_dofs*) data::common::allocate( l_nEls * sizeof(t_dofs), ALIGNMENT.BASE.HEAP );
+      random( l_nEls * sizeof(t_dofs) / sizeof(real_base), 0, 1, l_dofs[0][0][0] );
+
+      // every element holds a source of every run
+      std::vector< int_el > l_elSpSo( (l_nEls+1) * N_CRUNS );
+      for( int_el l_el = 0; l_el < l_nEls+1; l_el++ )
+        for( unsigned short l_ru = 0; l_ru < N_CRUNS; l_ru++ ) l_elSpSo[l_el * N_CRUNS + l_ru] = l_el;
+
+      // set up the source descriptions
+      std::vector< int_el > l_soElDe( l_nEls );
+      std::vector< int_el > l_first( N_CRUNS * N_DIM * (l_nEls+1) );
+      std::vector< real_base > l_onSet( N_CRUNS * l_nEls, 0 );
+      std::vector< real_base > l_dt( N_CRUNS * l_nEls, (real_base) 0.01 );
+      std::vector< real_base > l_bEval( N_CRUNS * l_nEls * N_ELEMENT_MODES );
+      std::vector< real_base > l_sSca( N_CRUNS * N_DIM * l_nEls * l_nStress );
+      std::vector< real_base > l_sr( N_CRUNS * N_DIM * l_nEls * N_SR_SAMPLES );
+      random( l_bEval.size(), -1, 1, l_bEval.data() );
+      random( l_sSca.size(),  -1, 1, l_sSca.data()  );
+      random( l_sr.size(),     0, 1, l_sr.data()    );
+
+      for( int_el l_so = 0; l_so < l_nEls; l_so++ ) l_soElDe[l_so] = l_so;
+
+      t_kin l_kin[N_CRUNS];
+      for( unsigned short l_ru = 0; l_ru < N_CRUNS; l_ru++ ) {
+        l_kin[l_ru].nSrcs  = l_nEls;
+        l_kin[l_ru].soElDe = l_soElDe.data();
+        l_kin[l_ru].onSet  = l_onSet.data() + l_ru * l_nEls;
+        l_kin[l_ru].dt     = l_dt.data() + l_ru * l_nEls;
+        l_kin[l_ru].bEval  = (real_base (*)[N_ELEMENT_MODES]) ( l_bEval.data() + l_ru * l_nEls * N_ELEMENT_MODES );
+
+        for( unsigned short l_di = 0; l_di < N_DIM; l_di++ ) {
+          std::size_t l_rd = l_ru * N_DIM + l_di;
+          l_kin[l_ru].aSlip[l_di] = true;
+          l_kin[l_ru].first[l_di] = l_first.data() + l_rd * (l_nEls+1);
+          for( int_el l_so = 0; l_so < l_nEls+1; l_so++ ) l_kin[l_ru].first[l_di][l_so] = l_so * N_SR_SAMPLES;
+          l_kin[l_ru].sSca[l_di] = (real_base (*)[t_kin::TL_N_STRESS][1]) ( l_sSca.data() + l_rd * l_nEls * l_nStress );
+          l_kin[l_ru].sr[l_di]   = (real_base (*)[1]) ( l_sr.data() + l_rd * l_nEls * N_SR_SAMPLES );
+        }
+      }
+
+      // integrate over the center of the slip-rate samples
+      real_base l_t1 = (real_base) 0.01 * (N_SR_SAMPLES / 2);
+      real_base l_t2 = l_t1 + (real_base) 0.01;
+
+      double l_time = measure( [&]() {
+        solvers::Kinematics< T_SDISC.ELEMENT,
+                             N_QUANTITIES,
+                             ORDER,
+                             N_CRUNS,
+                             1 >::applyDirac(                            (int_el) 0,
+                                                                          l_nEls,
+                                                                          l_t1,
+                                                                          l_t2,
+                                              (int_el const (*)[N_CRUNS]) l_elSpSo.data(),
+                                                                          l_kin,
+                                                                          l_dofs );
+      } );
+      double l_work[3];
+      t_model::source( l_work );
+      store( "Kinematics::applyDirac", "element", i_size, l_nEls, l_nEls * l_bytesEl, l_time, l_work );
+
+      data::common::release( l_dofs );
+    }
+
+    /**
+     * Benchmarks linear slip weakening on batches of faces with a single quadrature point each.
+     *
+     * @param i_size id of the size class.
+     **/
+    void friction( unsigned short i_size ) {
+      typedef real_base t_ms[3][N_QUANTITIES][N_CRUNS][N_FACES_FRICTION_BATCH];
+
+      // bytes per face
+      std::size_t l_bytesFa = sizeof(t_ms) / N_FACES_FRICTION_BATCH + sizeof(t_lswFa) + sizeof(t_lswQp);
+      int_el l_nBas = std::max( m_sizes[i_size] / (l_bytesFa * N_FACES_FRICTION_BATCH), (std::size_t) 1 );
+      int_el l_nFas = l_nBas * N_FACES_FRICTION_BATCH;
+
+      t_lswGl l_gl;
+      std::vector< t_lswFa > l_lswFa( l_nFas );
+      std::vector< t_lswQp > l_lswQp( l_nFas );
+      t_ms *l_ms = (t_ms*) data::common::allocate( l_nBas * sizeof(t_ms), ALIGNMENT.BASE.HEAP );
+
+      for( unsigned short l_ru = 0; l_ru < N_CRUNS; l_ru++ ) {
+        l_gl.mus[l_ru]   = 0.677;
+        l_gl.mud[l_ru]   = 0.525;
+        l_gl.dcInv[l_ru] = 1 / 0.4;
+      }
+
+      std::uniform_real_distribution< real_base > l_dist( 0, 1 );
+      for( int_el l_fa = 0; l_fa < l_nFas; l_fa++ ) {
+        l_lswFa[l_fa].lEqM   = l_dist( m_gen ) < 0.5;
+        l_lswFa[l_fa].csDmuM = l_dist( m_gen );
+        l_lswFa[l_fa].csDmuP = l_dist( m_gen );
+      }
+      random( l_nFas * sizeof(t_lswQp) / sizeof(real_base), 0, 1, (real_base *) l_lswQp.data() );
+      for( int_el l_fa = 0; l_fa < l_nFas; l_fa++ ) {
+        for( unsigned short l_ru = 0; l_ru < N_CRUNS; l_ru++ ) {
+          // compressive normal stress and friction coefficient in between dynamic and static friction
+          l_lswQp[l_fa].sn0[l_ru] = -l_lswQp[l_fa].sn0[l_ru];
+          l_lswQp[l_fa].muf[l_ru] = l_gl.mud[l_ru] + l_lswQp[l_fa].muf[l_ru] * ( l_gl.mus[l_ru] - l_gl.mud[l_ru] );
+        }
+      }
+      random( l_nBas * sizeof(t_ms) / sizeof(real_base), -1, 1, l_ms[0][0][0][0] );
+
+      struct {
+        t_lswGl  *gl;
+        t_lswFa  *fa;
+        t_lswQp (*qp)[1];
+      } l_faData;
+      l_faData.gl = &l_gl;
+
+      double l_time = measure( [&]() {
+        for( int_el l_ba = 0; l_ba < l_nBas; l_ba++ ) {
+          l_faData.fa = l_lswFa.data() + l_ba * N_FACES_FRICTION_BATCH;
+          l_faData.qp = (t_lswQp (*)[1]) ( l_lswQp.data() + l_ba * N_FACES_FRICTION_BATCH );
+
+          solvers::FrictionLaws< N_DIM, N_CRUNS >::template perturbBatch<
+            real_base,
+            N_FACES_FRICTION_BATCH
+          >(  N_FACES_FRICTION_BATCH,
+              (real_base) 1E-4,
+              l_ms[l_ba][0],
+             &l_faData,
+              l_ms[l_ba][1],
+              l_ms[l_ba][2] );
+        }
+      } );
+      double l_work[3];
+      t_model::friction( l_work );
+      store( "FrictionLaws::linSlipWeak", "face", i_size, l_nFas, l_nFas * l_bytesFa, l_time, l_work );
+
+      data::common::release( l_ms );
+    }
+
+  public:
+    /**
+     * Constructor, which derives the sizes of the batches from the caches.
+     * Batches of the cache levels target half the capacity, DRAM-batches exceed the last level cache by a factor of four.
+     *
+     * @param i_minTime minimum duration of a single measurement in seconds.
+     **/
+    Kernels( double i_minTime = 0.1 ): m_minTime( i_minTime ), m_gen( 17 ), m_llcMisses( -1 ) {
+      long l_caches[3] = { 32 * 1024, 1024 * 1024, 32 * 1024 * 1024 };
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+      long l_sys[3] = { sysconf( _SC_LEVEL1_DCACHE_SIZE ),
+                        sysconf( _SC_LEVEL2_CACHE_SIZE ),
+                        sysconf( _SC_LEVEL3_CACHE_SIZE ) };
+      for( unsigned short l_ca = 0; l_ca < 3; l_ca++ )
+        if( l_sys[l_ca] > 0 ) l_caches[l_ca] = l_sys[l_ca];
+#endif
+      // fall back to L2 as last level cache
+      if( l_caches[2] < l_caches[1] ) l_caches[2] = l_caches[1];
+
+      for( unsigned short l_ca = 0; l_ca < 3; l_ca++ ) m_sizes[l_ca] = l_caches[l_ca] / 2;
+      m_sizes[3] = (std::size_t) l_caches[2] * 4;
+    }
+
+    /**
+     * Runs all benchmarks.
+     *
+     * @param i_dg constant DG data.
+     * @param i_mm matrix-matrix multiplication kernels.
+     *
+     * @paramt TL_T_MM type of the matrix-matrix multiplication kernels.
+     **/
+    template< typename TL_T_MM >
+    void run( t_dg    & i_dg,
+              TL_T_MM & i_mm ) {
+      for( unsigned short l_si = 0; l_si < N_SIZES; l_si++ ) {
+        EDGE_LOG_INFO << "benchmarking " << m_sizeNames[l_si] << "-sized batches (" << m_sizes[l_si] << " bytes)";
+        aderDg( l_si, i_dg, i_mm );
+        fused( l_si, i_dg, i_mm );
+        kinematics( l_si );
+        friction( l_si );
+      }
+    }
+
+    /**
+     * Writes the results as JSON.
+     *
+     * @param i_path path of the output file.
+     **/
+    void write( std::string const & i_path ) const {
+      std::string l_elType;
+      if(      T_SDISC.ELEMENT == TRIA3 ) l_elType = "tria3";
+      else if( T_SDISC.ELEMENT == QUAD4R ) l_elType = "quad4r";
+      else if( T_SDISC.ELEMENT == TET4  ) l_elType = "tet4";
+      else if( T_SDISC.ELEMENT == HEX8R ) l_elType = "hex8r";
+      else                                l_elType = "unknown";
+
+#if defined PP_T_KERNELS_XSMM
+      std::string l_kernels = "xsmm";
+#elif defined PP_T_KERNELS_XSMM_DENSE_SINGLE
+      std::string l_kernels = "xsmm-dense-single";
+#else
+      std::string l_kernels = "vanilla";
+#endif
+
+      std::ofstream l_file( i_path );
+      EDGE_CHECK( l_file.is_open() ) << "could not open " << i_path;
+
+      l_file << "{\n";
+      l_file << "  \"config\": { \"equations\": \"elastic\", \"element_type\": \"" << l_elType << "\", \"order\": " << ORDER
+             << ", \"precision\": " << PP_PRECISION << ", \"cfr\": " << N_CRUNS << ", \"kernels\": \"" << l_kernels << "\" },\n";
+      l_file << "  \"sizes\": {";
+      for( unsigned short l_si = 0; l_si < N_SIZES; l_si++ )
+        l_file << ( (l_si > 0) ? ", " : " " ) << "\"" << m_sizeNames[l_si] << "\": " << m_sizes[l_si];
+      l_file << " },\n";
+      l_file << "  \"results\": [\n";
+      for( std::size_t l_re = 0; l_re < m_results.size(); l_re++ ) {
+        t_result const & l_res = m_results[l_re];
+        l_file << "    { \"kernel\": \"" << l_res.name << "\", \"size\": \"" << m_sizeNames[l_res.size]
+               << "\", \"entity\": \"" << l_res.entity << "\", \"n_entities\": " << l_res.nEns
+               << ", \"bytes\": " << l_res.bytes
+               << ", \"ns_per_entity\": " << l_res.time * 1E9
+               << ", \"gflops\": " << l_res.work[0] / l_res.time * 1E-9
+               << ", \"gflops_sparse\": " << l_res.work[1] / l_res.time * 1E-9
+               << ", \"gbytes_per_s\": " << l_res.work[2] / l_res.time * 1E-9
+               << ", \"llc_misses_per_entity\": " << l_res.llcMisses << " }"
+               << ( (l_re+1 < m_results.size()) ? "," : "" ) << "\n";
+      }
+      l_file << "  ]\n}\n";
+    }
+};
+
+#endif
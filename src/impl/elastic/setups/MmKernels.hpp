@@ -173,11 +173,13 @@ class edge::elastic::setups::MmKernels {
 
       // (O-1)*2 kernels for time integration
       // (multiplication with transposed stiffness matrix and star matrix)
+      // the kernels shrink with the derivatives: derivative l_de-1 (input) has
+      // CE_N_ELEMENT_MODES_CK( l_de-1 ) and derivative l_de (output) CE_N_ELEMENT_MODES_CK( l_de ) non-zero modes
       for( unsigned int l_de = 1; l_de < i_order; l_de++ ) {
         // multiplication with transpose stiffness matrix
         io_mm.add( i_nQts,                                           // m
-                   CE_N_ELEMENT_MODES_CK( i_tEl, i_order, l_de-1 ),  // n
-                   CE_N_ELEMENT_MODES_CK( i_tEl, i_order, l_de ),    // k
+                   CE_N_ELEMENT_MODES_CK( i_tEl, i_order, l_de ),    // n
+                   CE_N_ELEMENT_MODES_CK( i_tEl, i_order, l_de-1 ),  // k
                    l_nMdsEl,                                         // ldA
                    l_nMdsEl,                                         // ldB
                    l_nMdsEl,                                         // ldC
@@ -26,6 +26,8 @@
 #define ADER_DG_HPP
 
 #include <limits>
+#include <algorithm>
+#include <vector>
 #include <cassert>
 #include "constants.hpp"
 #include "mesh/common.hpp"
@@ -36,6 +38,7 @@
 #include "io/Receivers.h"
 #include "InternalBoundary.hpp"
 #include "FrictionLaws.hpp"
+#include "FusedTiles.hpp"
 #include "crop.hpp"
 #if defined(PP_T_KERNELS_XSMM) || defined(PP_T_KERNELS_XSMM_DENSE_SINGLE)
 #include <libxsmm.h>
@@ -431,10 +434,12 @@ class edge::elastic::solvers::AderDg {
      * @param i_time time of the initial DOFs.
      * @param i_dT time step.
      * @param i_firstSpRp first sparse rupture-element.
+     * @param i_nSpRp number of sparse rupture-elements in the range of elements.
+     * @param i_spRpDe dense ids of the sparse rupture-elements.
      * @param i_firstSpRe first sparse receiver entity.
+     * @param i_nSpRe number of sparse receiver entities in the range of elements.
      * @param i_elFa faces adjacent to the elements.
      * @param i_faChars face characteristics.
-     * @param i_elChars element characteristics.
      * @param i_dg const DG data.
      * @param i_starM star matrices.
      * @param i_fluxSolvers flux solvers for the local element's contribution.
@@ -456,10 +461,12 @@ class edge::elastic::solvers::AderDg {
                        double                           i_time,
                        double                           i_dT,
                        TL_T_INT_LID                     i_firstSpRp,
+                       TL_T_INT_LID                     i_nSpRp,
+                       TL_T_INT_LID             const * i_spRpDe,
                        TL_T_INT_LID                     i_firstSpRe,
+                       TL_T_INT_LID                     i_nSpRe,
                        TL_T_INT_LID            (* i_elFa)[ C_ENT[T_SDISC.ELEMENT].N_FACES ],
                        t_faceChars               * i_faChars,
-                       t_elementChars            * i_elChars,
                        t_dg                      & i_dg,
                        t_matStar                (* i_starM)[N_DIM],
                        t_fluxSolver             (* i_fluxSolvers)[ C_ENT[T_SDISC.ELEMENT].N_FACES ],
@@ -474,32 +481,158 @@ class edge::elastic::solvers::AderDg {
       (void) __builtin_assume_aligned(o_tInt,  ALIGNMENT.ELEMENT_MODES.PRIVATE);
 #endif
 
-      // counter of elements with faces having rupture physics
-      TL_T_INT_LID l_elRp = i_firstSpRp;
+      // special physics
+      localPre( i_time, i_dT,
+                i_firstSpRp, i_nSpRp, i_spRpDe,
+                i_firstSpRe, i_nSpRe,
+                i_dg, i_starM,
+                io_dofs, o_tInt, o_tRup,
+                io_recvs, i_mm );
 
-      // counter for receivers
-      unsigned int l_enRe = i_firstSpRe;
+      // all elements
+      localEls( i_first, i_nElements,
+                i_dT,
+                i_dg, i_starM, i_fluxSolvers,
+                io_dofs, o_tInt, i_mm );
+    }
 
+    /**
+     * Handles the elements with special physics in the local step through compact lists of sparse entities.
+     * This keeps the loop over all elements free of sparse type checks.
+     *
+     * @param i_time time of the initial DOFs.
+     * @param i_dT time step.
+     * @param i_firstSpRp first sparse rupture-element.
+     * @param i_nSpRp number of sparse rupture-elements.
+     * @param i_spRpDe dense ids of the sparse rupture-elements.
+     * @param i_firstSpRe first sparse receiver entity.
+     * @param i_nSpRe number of sparse receiver entities.
+     * @param i_dg const DG data.
+     * @param i_starM star matrices.
+     * @param io_dofs DOFs.
+     * @param o_tInt scratch for the time integrated DOFs of receiver elements.
+     * @param o_tRup will be set to DOFs for rupture elements.
+     * @param io_recvs will be updated with receiver info.
+     * @param i_mm matrix-matrix multiplication kernels.
+     *
+     * @paramt TL_T_INT_LID integer type of local entity ids.
+     * @paramt TL_T_REAL floating point type.
+     * @paramt TL_T_MM matrix-matrix multiplication kernels.
+     **/
+    template < typename TL_T_INT_LID,
+               typename TL_T_REAL,
+               typename TL_T_MM >
+    static void localPre( double                           i_time,
+                          double                           i_dT,
+                          TL_T_INT_LID                     i_firstSpRp,
+                          TL_T_INT_LID                     i_nSpRp,
+                          TL_T_INT_LID             const * i_spRpDe,
+                          TL_T_INT_LID                     i_firstSpRe,
+                          TL_T_INT_LID                     i_nSpRe,
+                          t_dg                           & i_dg,
+                          t_matStar                     (* i_starM)[N_DIM],
+                          TL_T_REAL                     (* io_dofs)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS],
+                          TL_T_REAL                     (* o_tInt)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS],
+                          TL_T_REAL                     (* o_tRup)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS],
+                          edge::io::Receivers            & io_recvs,
+                          TL_T_MM                        & i_mm ) {
       // temporary data structurre for product for two-way mult and receivers
       TL_T_REAL (*l_tmpEl)[N_ELEMENT_MODES][N_CRUNS] = parallel::g_scratchMem->tRes;
 
       // buffer for derivatives
       TL_T_REAL (*l_derBuffer)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS] = parallel::g_scratchMem->dBuf;
 
-      // iterate over all elements
-      for( TL_T_INT_LID l_el = i_first; l_el < i_first+i_nElements; l_el++ ) {
-        if( (i_elChars[l_el].spType & RUPTURE) != RUPTURE ) {}
-        else {
-          // save DOFs of the rupture element
-          for( unsigned short l_qt = 0; l_qt < N_QUANTITIES; l_qt++ )
-            for( unsigned short l_md = 0; l_md < N_ELEMENT_MODES; l_md++ )
-              for( unsigned short l_ru = 0; l_ru < N_CRUNS; l_ru++ )
-                o_tRup[l_elRp][l_qt][l_md][l_ru] = io_dofs[l_el][l_qt][l_md][l_ru];
-
-          // increase rupture element counter
-          l_elRp++;
+      // save DOFs of the rupture elements
+      for( TL_T_INT_LID l_elRp = i_firstSpRp; l_elRp < i_firstSpRp+i_nSpRp; l_elRp++ ) {
+        TL_T_INT_LID l_el = i_spRpDe[l_elRp];
+
+        for( unsigned short l_qt = 0; l_qt < N_QUANTITIES; l_qt++ )
+          for( unsigned short l_md = 0; l_md < N_ELEMENT_MODES; l_md++ )
+            for( unsigned short l_ru = 0; l_ru < N_CRUNS; l_ru++ )
+              o_tRup[l_elRp][l_qt][l_md][l_ru] = io_dofs[l_el][l_qt][l_md][l_ru];
+      }
+
+      // write receivers (if required)
+      for( TL_T_INT_LID l_enRe = i_firstSpRe; l_enRe < i_firstSpRe+i_nSpRe; l_enRe++ ) {
+        // skip receivers without output in this time step
+        if( !(io_recvs.getRecvTimeRel( l_enRe, i_time, i_dT ) >= 0) ) continue;
+
+        TL_T_INT_LID l_el = io_recvs.getEnDe( l_enRe );
+
+        // derive the time derivatives; the time integrated DOFs are overwritten by the element loop
+        TimePred< T_SDISC.ELEMENT,
+                  N_QUANTITIES,
+                  ORDER,
+                  ORDER,
+                  N_CRUNS >::ck( (TL_T_REAL)  i_dT,
+                                              i_dg.mat.stiffT,
+                                            &(i_starM[l_el][0].mat), // TODO: fix struct
+                                              io_dofs[l_el],
+                                              i_mm,
+                                              l_tmpEl,
+                                              l_derBuffer,
+                                              o_tInt[l_el] );
+
+        while( true ) { // iterate of possible multiple receiver-ouput per time step
+          double l_rePt = io_recvs.getRecvTimeRel( l_enRe, i_time, i_dT );
+          if( !(l_rePt >= 0) ) break;
+          else {
+            TL_T_REAL l_rePts = l_rePt;
+            // eval time prediction at the given point
+            TimePred< T_SDISC.ELEMENT,
+                      N_QUANTITIES,
+                      ORDER,
+                      ORDER,
+                      N_CRUNS >::evalTimePrediction(  1,
+                                                     &l_rePts,
+                                                      l_derBuffer,
+                        (TL_T_REAL (*)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS])l_tmpEl );
+
+            // write this time prediction
+            io_recvs.writeRecvAll( l_enRe, l_tmpEl );
+          }
         }
+      }
+
+    }
+
+    /**
+     * Performs the local step for a range of elements without special physics.
+     *
+     * @param i_first first element considered.
+     * @param i_nElements number of elements.
+     * @param i_dT time step.
+     * @param i_dg const DG data.
+     * @param i_starM star matrices.
+     * @param i_fluxSolvers flux solvers for the local element's contribution.
+     * @param io_dofs DOFs.
+     * @param o_tInt will be set to time integrated DOFs.
+     * @param i_mm matrix-matrix multiplication kernels.
+     *
+     * @paramt TL_T_INT_LID integer type of local entity ids.
+     * @paramt TL_T_REAL floating point type.
+     * @paramt TL_T_MM matrix-matrix multiplication kernels.
+     **/
+    template < typename TL_T_INT_LID,
+               typename TL_T_REAL,
+               typename TL_T_MM >
+    static void localEls( TL_T_INT_LID                     i_first,
+                          TL_T_INT_LID                     i_nElements,
+                          double                           i_dT,
+                          t_dg                           & i_dg,
+                          t_matStar                     (* i_starM)[N_DIM],
+                          t_fluxSolver                  (* i_fluxSolvers)[ C_ENT[T_SDISC.ELEMENT].N_FACES ],
+                          TL_T_REAL                     (* io_dofs)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS],
+                          TL_T_REAL                     (* o_tInt)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS],
+                          TL_T_MM                        & i_mm ) {
+      // temporary data structurre for product for two-way mult
+      TL_T_REAL (*l_tmpEl)[N_ELEMENT_MODES][N_CRUNS] = parallel::g_scratchMem->tRes;
 
+      // buffer for derivatives
+      TL_T_REAL (*l_derBuffer)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS] = parallel::g_scratchMem->dBuf;
+
+      // iterate over all elements
+      for( TL_T_INT_LID l_el = i_first; l_el < i_first+i_nElements; l_el++ ) {
         /*
          * compute ader time integration
          */
@@ -516,33 +649,6 @@ class edge::elastic::solvers::AderDg {
                                               l_derBuffer,
                                               o_tInt[l_el] );
 
-        /*
-         * Write receivers (if required)
-         */
-        if( !( (i_elChars[l_el].spType & RECEIVER) == RECEIVER) ) {} // no receivers in the current element
-        else { // we have receivers in the current element
-          while( true ) { // iterate of possible multiple receiver-ouput per time step
-            double l_rePt = io_recvs.getRecvTimeRel( l_enRe, i_time, i_dT );
-            if( !(l_rePt >= 0) ) break;
-            else {
-              TL_T_REAL l_rePts = l_rePt;
-              // eval time prediction at the given point
-              TimePred< T_SDISC.ELEMENT,
-                        N_QUANTITIES,
-                        ORDER,
-                        ORDER,
-                        N_CRUNS >::evalTimePrediction(  1,
-                                                       &l_rePts,
-                                                        l_derBuffer,
-                          (TL_T_REAL (*)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS])l_tmpEl );
-
-              // write this time prediction
-              io_recvs.writeRecvAll( l_enRe, l_tmpEl );
-            }
-          }
-          l_enRe++;
-        }
-
         /*
          * compute volume contribution
          */
@@ -658,11 +764,119 @@ class edge::elastic::solvers::AderDg {
       EDGE_LOG_FATAL << "removed quadrature-based rupture physics";
     }
 
+    /**
+     * Performs the neighboring update of a single element.
+     *
+     * @param i_el element.
+     * @param i_last last element of the considered range (used for prefetching).
+     * @param i_dg constant DG data.
+     * @param i_faChars face characteristics.
+     * @param i_fluxSolvers flux solvers for the neighboring elements' contribution.
+     * @param i_elFa elements' adjacent faces.
+     * @param i_elFaEl face-neighboring elements.
+     * @param i_fIdElFaEl local face ids of face-neighboring elememts.
+     * @param i_vIdElFaEl local vertex ids w.r.t. the shared face from the neighboring elements' perspsective.
+     * @param i_tInt time integrated degrees of freedom.
+     * @param io_dofs DOFs which will be updated with neighboring elements' contribution.
+     * @param i_mm matrix-matrix multiplication kernels.
+     * @param o_tmpFa temporary face data.
+     *
+     * @paramt TL_BND true if the element has faces with boundary conditions (outflow or free surface), false otherwise.
+     * @paramt TL_T_INT_LID integer type of local entity ids.
+     * @paramt TL_T_REAL type used for floating point arithmetic.
+     * @paramt TL_T_MM type of the matrix-matrix multiplication kernels.
+     **/
+    template< bool     TL_BND,
+              typename TL_T_INT_LID,
+              typename TL_T_REAL,
+              typename TL_T_MM >
+    static void neighEl( TL_T_INT_LID            i_el,
+                         TL_T_INT_LID            i_last,
+                         t_dg             & i_dg,
+                         t_faceChars      * i_faChars,
+                         t_fluxSolver    (* i_fluxSolvers)[ C_ENT[T_SDISC.ELEMENT].N_FACES ],
+                         TL_T_INT_LID   const (* i_elFa)[C_ENT[T_SDISC.ELEMENT].N_FACES],
+                         TL_T_INT_LID   const (* i_elFaEl)[C_ENT[T_SDISC.ELEMENT].N_FACES],
+                         unsigned short const (* i_fIdElFaEl)[C_ENT[T_SDISC.ELEMENT].N_FACES],
+                         unsigned short const (* i_vIdElFaEl)[C_ENT[T_SDISC.ELEMENT].N_FACES],
+                         TL_T_REAL       (* i_tInt)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS],
+                         TL_T_REAL            (* io_dofs)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS],
+                         TL_T_MM          & i_mm,
+                         TL_T_REAL            (* o_tmpFa)[N_QUANTITIES][N_FACE_MODES][N_CRUNS] ) {
+      // add neighboring contribution
+      for( TL_T_INT_LID l_fa = 0; l_fa < C_ENT[T_SDISC.ELEMENT].N_FACES; l_fa++ ) {
+        // boundary conditions of the face
+        bool l_outflow = false;
+        bool l_freeSurface = false;
+
+        if( TL_BND ) {
+          TL_T_INT_LID l_faId = i_elFa[i_el][l_fa];
+          l_outflow     = (i_faChars[l_faId].spType & OUTFLOW)      == OUTFLOW;
+          l_freeSurface = (i_faChars[l_faId].spType & FREE_SURFACE) == FREE_SURFACE;
+        }
+
+        if( !l_outflow ) {
+          // determine flux matrix id
+          unsigned short l_fId = SurfInt< T_SDISC.ELEMENT,
+                                          N_QUANTITIES,
+                                          ORDER,
+                                          ORDER,
+                                          N_CRUNS >::fMatId( i_vIdElFaEl[i_el][l_fa],
+                                                             i_fIdElFaEl[i_el][l_fa] );
+
+          // derive neighbor
+          TL_T_INT_LID l_ne = ( !l_freeSurface ) ? i_elFaEl[i_el][l_fa] : i_el;
+
+          /*
+           * prefetches
+           */
+          const TL_T_REAL (* l_pre)[N_ELEMENT_MODES][N_CRUNS] = nullptr;
+          TL_T_INT_LID l_neUp = std::numeric_limits<TL_T_INT_LID>::max();
+          // prefetch for the upcoming surface integration of this element
+          if( l_fa < C_ENT[T_SDISC.ELEMENT].N_FACES-1 ) l_neUp = i_elFaEl[i_el][l_fa+1];
+          // first surface integration of the next element
+          else if( i_el < i_last ) l_neUp = i_elFaEl[i_el+1][0];
+
+          // only proceed with adjacent data if the element exists
+          if( l_neUp != std::numeric_limits<TL_T_INT_LID>::max() ) l_pre = i_tInt[l_neUp];
+          // next element data in case of boundary conditions
+          else if( i_el < i_last )                                  l_pre = io_dofs[i_el+1];
+          // default to element data to avoid performance penality
+          else                                                      l_pre = io_dofs[i_el];
+
+          /*
+           * solve
+           */
+          SurfInt< T_SDISC.ELEMENT,
+                   N_QUANTITIES,
+                   ORDER,
+                   ORDER,
+                   N_CRUNS >::neigh( ( !l_freeSurface ) ? i_dg.mat.fluxN[l_fId] :
+                                                          i_dg.mat.fluxL[l_fa],
+                                     i_dg.mat.fluxT[l_fa],
+                                     ( TL_T_REAL (*)[N_QUANTITIES] )  ( i_fluxSolvers[i_el][l_fa].solver[0] ), // TODO: fix struct
+                                     i_tInt[l_ne],
+                                     i_mm,
+                                     io_dofs[i_el],
+                                     o_tmpFa,
+                                     l_pre,
+                                     l_fa,
+                                     ( !l_freeSurface ) ? l_fId + C_ENT[T_SDISC.ELEMENT].N_FACES: l_fa );
+        }
+      }
+    }
+
     /**
      * Performs the neighboring updates of the ADER-DG scheme.
      *
+     * Elements with outflow or free surface boundary conditions are given as a compact list of dense ids.
+     * Ranges of elements in between run through a path without checks of the boundary conditions.
+     *
      * @param i_first first element considered.
      * @param i_nElements number of elements.
+     * @param i_nElBnd number of elements with outflow or free surface boundary conditions.
+     * @param i_elBnd ascending dense ids of the elements with outflow or free surface boundary conditions.
+     * @param io_elFused flags of elements whose neighboring update was fused with the local step, nullptr if not used. Flagged elements are skipped and reset.
      * @param i_dg constant DG data.
      * @param i_faChars face characteristics.
      * @param i_fluxSolvers flux solvers for the neighboring elements' contribution.
@@ -687,6 +901,9 @@ class edge::elastic::solvers::AderDg {
     static void neigh( TL_T_INT_LID            i_first,
                        TL_T_INT_LID            i_nElements,
                        TL_T_INT_LID            i_firstSpRp,
+                       TL_T_INT_LID            i_nElBnd,
+                       TL_T_INT_LID     const * i_elBnd,
+                       unsigned char          * io_elFused,
                        t_dg             & i_dg,
                        t_faceChars      * i_faChars,
                        t_fluxSolver    (* i_fluxSolvers)[ C_ENT[T_SDISC.ELEMENT].N_FACES ],
@@ -710,68 +927,154 @@ class edge::elastic::solvers::AderDg {
         TL_T_REAL (*l_tmpFa)[N_QUANTITIES][N_FACE_MODES][N_CRUNS] =
           (TL_T_REAL (*)[N_QUANTITIES][N_FACE_MODES][N_CRUNS]) parallel::g_scratchMem->dBuf;
 
+      // end of the elements and last element
+      TL_T_INT_LID l_end  = i_first+i_nElements;
+      TL_T_INT_LID l_last = l_end-1;
+
+      // first element with boundary conditions in the range
+      TL_T_INT_LID const * l_elBnd    = std::lower_bound( i_elBnd, i_elBnd+i_nElBnd, i_first );
+      TL_T_INT_LID const * l_elBndEnd = i_elBnd+i_nElBnd;
+
       // iterate over elements
-      for( TL_T_INT_LID l_el = i_first; l_el < i_first+i_nElements; l_el++ ) {
+      TL_T_INT_LID l_el = i_first;
+      while( l_el < l_end ) {
+        // interior elements up to the next element with boundary conditions
+        TL_T_INT_LID l_endIn = ( l_elBnd != l_elBndEnd ) ? std::min( *l_elBnd, l_end ) : l_end;
 
-        // add neighboring contribution
-        for( TL_T_INT_LID l_fa = 0; l_fa < C_ENT[T_SDISC.ELEMENT].N_FACES; l_fa++ ) {
-          TL_T_INT_LID l_faId = i_elFa[l_el][l_fa];
-          TL_T_INT_LID l_ne;
+        for( ; l_el < l_endIn; l_el++ ) {
+          if( io_elFused != nullptr && io_elFused[l_el] != 0 ) { io_elFused[l_el] = 0; continue; }
 
-          // determine flux matrix id
-          unsigned short l_fId = SurfInt< T_SDISC.ELEMENT,
-                                          N_QUANTITIES,
-                                          ORDER,
-                                          ORDER,
-                                          N_CRUNS >::fMatId( i_vIdElFaEl[l_el][l_fa],
-                                                             i_fIdElFaEl[l_el][l_fa] );
-
-          if( (i_faChars[l_faId].spType & OUTFLOW) != OUTFLOW ) {
-            // derive neighbor
-            if( (i_faChars[l_faId].spType & FREE_SURFACE) != FREE_SURFACE )
-              l_ne = i_elFaEl[l_el][l_fa];
-            else
-              l_ne = l_el;
-
-            /*
-             * prefetches
-             */
-            const TL_T_REAL (* l_pre)[N_ELEMENT_MODES][N_CRUNS] = nullptr;
-            TL_T_INT_LID l_neUp = std::numeric_limits<TL_T_INT_LID>::max();
-            // prefetch for the upcoming surface integration of this element
-            if( l_fa < C_ENT[T_SDISC.ELEMENT].N_FACES-1 ) l_neUp = i_elFaEl[l_el][l_fa+1];
-            // first surface integration of the next element
-            else if( l_el < i_first+i_nElements-1 ) l_neUp = i_elFaEl[l_el+1][0];
-
-            // only proceed with adjacent data if the element exists
-            if( l_neUp != std::numeric_limits<TL_T_INT_LID>::max() ) l_pre = i_tInt[l_neUp];
-            // next element data in case of boundary conditions
-            else if( l_el < i_first+i_nElements-1 )              l_pre = io_dofs[l_el+1];
-            // default to element data to avoid performance penality
-            else                                                 l_pre = io_dofs[l_el];
-
-            /*
-             * solve
-             */
-            SurfInt< T_SDISC.ELEMENT,
-                     N_QUANTITIES,
-                     ORDER,
-                     ORDER,
-                     N_CRUNS >::neigh( ((i_faChars[l_faId].spType & FREE_SURFACE) != FREE_SURFACE ) ? i_dg.mat.fluxN[l_fId] :
-                                                                                                      i_dg.mat.fluxL[l_fa],
-                                       i_dg.mat.fluxT[l_fa],
-                                       ( TL_T_REAL (*)[N_QUANTITIES] )  ( i_fluxSolvers[l_el][l_fa].solver[0] ), // TODO: fix struct
-                                       i_tInt[l_ne],
-                                       i_mm,
-                                       io_dofs[l_el],
-                                       l_tmpFa,
-                                       l_pre,
-                                       l_fa,
-                                       ((i_faChars[l_faId].spType & FREE_SURFACE) != FREE_SURFACE ) ? l_fId + C_ENT[T_SDISC.ELEMENT].N_FACES: l_fa );
+          neighEl< false >( l_el, l_last,
+                            i_dg, i_faChars, i_fluxSolvers,
+                            i_elFa, i_elFaEl, i_fIdElFaEl, i_vIdElFaEl,
+                            i_tInt, io_dofs, i_mm, l_tmpFa );
+        }
+
+        // element with boundary conditions
+        if( l_el < l_end ) {
+          if( io_elFused != nullptr && io_elFused[l_el] != 0 ) io_elFused[l_el] = 0;
+          else neighEl< true >( l_el, l_last,
+                                i_dg, i_faChars, i_fluxSolvers,
+                                i_elFa, i_elFaEl, i_fIdElFaEl, i_vIdElFaEl,
+                                i_tInt, io_dofs, i_mm, l_tmpFa );
+          l_el++;
+          l_elBnd++;
         }
       }
     }
-  }
+
+    /**
+     * Fused local and neighboring updates for a range of elements with temporal blocking.
+     *
+     * The range is processed in cache-sized tiles of consecutive elements.
+     * After the local step of a tile, the neighboring updates of all elements whose face-neighbors finished the local step are performed
+     * while the data is still in cache.
+     * Elements with face-neighbors outside of the range are left to the regular neighboring step; all others are flagged.
+     *
+     * @param i_first first element considered.
+     * @param i_nElements number of elements.
+     * @param i_time time of the initial DOFs.
+     * @param i_dT time step.
+     * @param i_firstSpRp first sparse rupture-element.
+     * @param i_nSpRp number of sparse rupture-elements in the range of elements.
+     * @param i_spRpDe dense ids of the sparse rupture-elements.
+     * @param i_firstSpRe first sparse receiver entity.
+     * @param i_nSpRe number of sparse receiver entities in the range of elements.
+     * @param i_nElBnd number of elements with outflow or free surface boundary conditions.
+     * @param i_elBnd ascending dense ids of the elements with outflow or free surface boundary conditions.
+     * @param i_faChars face characteristics.
+     * @param i_dg const DG data.
+     * @param i_starM star matrices.
+     * @param i_fluxSolversL flux solvers for the local element's contribution.
+     * @param i_fluxSolversN flux solvers for the neighboring elements' contribution.
+     * @param i_elFa elements' adjacent faces.
+     * @param i_elFaEl face-neighboring elements.
+     * @param i_fIdElFaEl local face ids of face-neighboring elememts.
+     * @param i_vIdElFaEl local vertex ids w.r.t. the shared face from the neighboring elements' perspsective.
+     * @param io_dofs DOFs.
+     * @param o_tInt will be set to time integrated DOFs.
+     * @param o_tRup will be set to DOFs for rupture elements.
+     * @param io_recvs will be updated with receiver info.
+     * @param i_mm matrix-matrix multiplication kernels.
+     * @param o_elFused will be set to 1 for elements whose neighboring update was performed.
+     *
+     * @paramt TL_T_INT_LID integer type of local entity ids.
+     * @paramt TL_T_REAL floating point type.
+     * @paramt TL_T_MM matrix-matrix multiplication kernels.
+     **/
+    template < typename TL_T_INT_LID,
+               typename TL_T_REAL,
+               typename TL_T_MM >
+    static void localNeigh( TL_T_INT_LID                     i_first,
+                            TL_T_INT_LID                     i_nElements,
+                            double                           i_time,
+                            double                           i_dT,
+                            TL_T_INT_LID                     i_firstSpRp,
+                            TL_T_INT_LID                     i_nSpRp,
+                            TL_T_INT_LID             const * i_spRpDe,
+                            TL_T_INT_LID                     i_firstSpRe,
+                            TL_T_INT_LID                     i_nSpRe,
+                            TL_T_INT_LID                     i_nElBnd,
+                            TL_T_INT_LID             const * i_elBnd,
+                            t_faceChars                    * i_faChars,
+                            t_dg                           & i_dg,
+                            t_matStar                     (* i_starM)[N_DIM],
+                            t_fluxSolver                  (* i_fluxSolversL)[ C_ENT[T_SDISC.ELEMENT].N_FACES ],
+                            t_fluxSolver                  (* i_fluxSolversN)[ C_ENT[T_SDISC.ELEMENT].N_FACES ],
+                            TL_T_INT_LID           const  (* i_elFa)[C_ENT[T_SDISC.ELEMENT].N_FACES],
+                            TL_T_INT_LID           const  (* i_elFaEl)[C_ENT[T_SDISC.ELEMENT].N_FACES],
+                            unsigned short         const  (* i_fIdElFaEl)[C_ENT[T_SDISC.ELEMENT].N_FACES],
+                            unsigned short         const  (* i_vIdElFaEl)[C_ENT[T_SDISC.ELEMENT].N_FACES],
+                            TL_T_REAL                     (* io_dofs)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS],
+                            TL_T_REAL                     (* o_tInt)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS],
+                            TL_T_REAL                     (* o_tRup)[N_QUANTITIES][N_ELEMENT_MODES][N_CRUNS],
+                            edge::io::Receivers            & io_recvs,
+                            TL_T_MM                        & i_mm,
+                            unsigned char                  * o_elFused ) {
+#if __has_builtin(__builtin_assume_aligned)
+      // share alignment with compiler
+      (void) __builtin_assume_aligned(io_dofs, ALIGNMENT.ELEMENT_MODES.PRIVATE);
+      (void) __builtin_assume_aligned(o_tInt,  ALIGNMENT.ELEMENT_MODES.PRIVATE);
+#endif
+
+      // special physics, has to be called for the entire range before touching the DOFs
+      localPre( i_time, i_dT,
+                i_firstSpRp, i_nSpRp, i_spRpDe,
+                i_firstSpRe, i_nSpRe,
+                i_dg, i_starM,
+                io_dofs, o_tInt, o_tRup,
+                io_recvs, i_mm );
+
+      // temporary face data of the neighboring updates
+      TL_T_REAL (*l_tmpFa)[N_QUANTITIES][N_FACE_MODES][N_CRUNS] =
+        (TL_T_REAL (*)[N_QUANTITIES][N_FACE_MODES][N_CRUNS]) parallel::g_scratchMem->dBuf;
+
+      FusedTiles< TL_T_INT_LID,
+                  C_ENT[T_SDISC.ELEMENT].N_FACES,
+                  N_ELEMENTS_TILE_FUSED,
+                  N_ELEMENTS_PEND_FUSED >::run( i_first,
+                                                i_nElements,
+                                                i_elFaEl,
+                                                i_nElBnd,
+                                                i_elBnd,
+                                                [&]( TL_T_INT_LID i_firstTl, TL_T_INT_LID i_nElsTl ) {
+                                                  localEls( i_firstTl, i_nElsTl,
+                                                            i_dT,
+                                                            i_dg, i_starM, i_fluxSolversL,
+                                                            io_dofs, o_tInt, i_mm );
+                                                },
+                                                [&]( TL_T_INT_LID i_el, TL_T_INT_LID i_last, bool i_bnd ) {
+                                                  if( i_bnd )
+                                                    neighEl< true  >( i_el, i_last, i_dg, i_faChars, i_fluxSolversN,
+                                                                      i_elFa, i_elFaEl, i_fIdElFaEl, i_vIdElFaEl,
+                                                                      o_tInt, io_dofs, i_mm, l_tmpFa );
+                                                  else
+                                                    neighEl< false >( i_el, i_last, i_dg, i_faChars, i_fluxSolversN,
+                                                                      i_elFa, i_elFaEl, i_fIdElFaEl, i_vIdElFaEl,
+                                                                      o_tInt, io_dofs, i_mm, l_tmpFa );
+                                                  o_elFused[i_el] = 1;
+                                                } );
+    }
 };
 
 #endif
\ No newline at end of file
@@ -23,6 +23,7 @@
 #ifndef FINITE_VOLUME_HPP
 #define FINITE_VOLUME_HPP
 
+#include <algorithm>
 #include "constants.hpp"
 #include "io/Receivers.h"
 #include "InternalBoundary.hpp"
@@ -202,8 +203,6 @@ class edge::elastic::solvers::FiniteVolume {
 
       // set up "dummy" values for high-order discretization
       TL_T_REAL l_massI[1]            = {1 / *C_REF_ELEMENT.VOL.ENT[T_SDISC.ELEMENT] };
-      TL_T_REAL l_ptsLine[1]          = {0.5};
-      TL_T_REAL l_weightsLine[1]      = {1};
       TL_T_REAL l_weightsFaces[1]     = {1};
       unsigned short const l_quadOpts =   (CE_N_FACE_VERTEX_OPTS(T_SDISC.ELEMENT)+1)
                                         *  C_ENT[T_SDISC.ELEMENT].N_FACES;
@@ -212,9 +211,6 @@ class edge::elastic::solvers::FiniteVolume {
         l_basisFaces[l_fa][0][0] = 1;
       }
 
-      // scratch memory
-      TL_T_REAL l_scratch[4][N_QUANTITIES][1][N_CRUNS];
-
       // struct for the pertubation of the middle states
       struct {
         TL_T_FRI_GL  *gl;
@@ -222,69 +218,115 @@ class edge::elastic::solvers::FiniteVolume {
         TL_T_FRI_QP (*qp)[1];
       } l_faData;
       l_faData.gl = &i_frictionGlobal;
-      l_faData.fa =  i_frictionFace+i_first;
-      l_faData.qp =  i_frictionQuadPoint+i_first;
-
-      // iterate over the rupture faces
-      for( TL_T_INT_LID l_fa = i_first; l_fa < i_first+i_nFaces; l_fa++ ) {
-        // get sparse rupture elements at the left and right side of the face
-        TL_T_INT_LID l_spL = i_faElSpRp[l_fa][0];
-        TL_T_INT_LID l_spR = i_faElSpRp[l_fa][1];
-
-        // call internal boundary solver
-        InternalBoundary<
-          T_SDISC.ELEMENT,
-          N_QUANTITIES,
-          1,
-          N_CRUNS >::template evalSpaceTime<
-            TL_T_REAL,
-            FrictionLaws< N_DIM, N_CRUNS >
-          >(  0, 0, 0, // irrelevant for FV
-              l_massI,
-              i_dT,
-              l_ptsLine,
-              l_weightsLine,
-              l_weightsFaces,
-              l_basisFaces,
-              i_solvers[l_fa][0],
-              i_solvers[l_fa][1],
-              i_solvers[l_fa][2],
-              i_solvers[l_fa][3],
-              i_tDofs+l_spL, // derivative (simply the DOF) "computation"
-              i_tDofs+l_spR, // derivative (simply the DOF) "computation"
-              l_scratch,
-              o_updates[l_fa][0],
-              o_updates[l_fa][1],
-             &l_faData );
-
-        // check if this face requires receiver output
-        if( (i_iBnd[l_fa].spType & RECEIVER) != RECEIVER ){}
-        else {
-          // check if the receiver requires output
-          if( io_recvsQuad.getRecvTimeRel( l_faRe, i_time, i_dT ) >= -TOL.TIME ) {
-            // gather receiver data, TODO: outsource
-            TL_T_REAL l_buff[ (N_DIM-1)*3 ][N_FACE_QUAD_POINTS][N_CRUNS];
-
-            for( unsigned short l_qp = 0; l_qp < N_FACE_QUAD_POINTS; l_qp++ ) {
-              for( unsigned short l_di = 0; l_di < N_DIM-1; l_di++ ) {
-                for( unsigned short l_ru = 0; l_ru < N_CRUNS; l_ru++ ) {
-                  l_buff[          0+l_di][l_qp][l_ru] = i_frictionQuadPoint[l_fa][l_qp].tr[l_di][l_ru];
-                  l_buff[  (N_DIM-1)+l_di][l_qp][l_ru] = i_frictionQuadPoint[l_fa][l_qp].sr[l_di][l_ru];
-                  l_buff[2*(N_DIM-1)+l_di][l_qp][l_ru] = i_frictionQuadPoint[l_fa][l_qp].dd[l_di][l_ru];
+
+      // iterate over batches of rupture faces
+      for( TL_T_INT_LID l_fb = i_first; l_fb < i_first+i_nFaces; l_fb += N_FACES_FRICTION_BATCH ) {
+        unsigned short l_nFa = std::min( (TL_T_INT_LID) N_FACES_FRICTION_BATCH, i_first+i_nFaces-l_fb );
+
+        // middle states of the batch: [0]: unperturbed, [1]: left side, [2]: right side
+        // remark: the single quad point of every face is the face's point in the batch
+        TL_T_REAL l_ms[3][N_QUANTITIES][N_CRUNS][N_FACES_FRICTION_BATCH];
+
+        // zero padding of the unused points
+        for( unsigned short l_qt = 0; l_qt < N_QUANTITIES; l_qt++ )
+          for( unsigned short l_ru = 0; l_ru < N_CRUNS; l_ru++ )
+            for( unsigned short l_ba = l_nFa; l_ba < N_FACES_FRICTION_BATCH; l_ba++ )
+              l_ms[0][l_qt][l_ru][l_ba] = 0;
+
+        // gather middle states
+        for( unsigned short l_ba = 0; l_ba < l_nFa; l_ba++ ) {
+          TL_T_INT_LID l_fa = l_fb + l_ba;
+
+          // get sparse rupture elements at the left and right side of the face
+          TL_T_INT_LID l_spL = i_faElSpRp[l_fa][0];
+          TL_T_INT_LID l_spR = i_faElSpRp[l_fa][1];
+
+          // remark: the time prediction of the FV-scheme is simply the DOFs
+          InternalBoundary<
+            T_SDISC.ELEMENT,
+            N_QUANTITIES,
+            1,
+            N_CRUNS >::template evalMsSpace<
+              TL_T_REAL,
+              N_FACES_FRICTION_BATCH
+            >(  0, 0, 0, // irrelevant for FV
+                l_ba,
+                l_basisFaces,
+                i_solvers[l_fa][0],
+                i_solvers[l_fa][1],
+                i_tDofs[l_spL],
+                i_tDofs[l_spR],
+                l_ms[0] );
+        }
+
+        // apply the friction law to the entire batch
+        l_faData.fa = i_frictionFace+l_fb;
+        l_faData.qp = i_frictionQuadPoint+l_fb;
+
+        FrictionLaws< N_DIM, N_CRUNS >::template perturbBatch<
+          TL_T_REAL,
+          N_FACES_FRICTION_BATCH
+        >( l_nFa,
+           i_dT,
+           l_ms[0],
+          &l_faData,
+           l_ms[1],
+           l_ms[2] );
+
+        for( unsigned short l_ba = 0; l_ba < l_nFa; l_ba++ ) {
+          TL_T_INT_LID l_fa = l_fb + l_ba;
+
+          // compute the updates from the perturbed middle states
+          InternalBoundary<
+            T_SDISC.ELEMENT,
+            N_QUANTITIES,
+            1,
+            N_CRUNS >::template intMsSpace<
+              TL_T_REAL,
+              N_FACES_FRICTION_BATCH
+            >(  0, 0, 0, // irrelevant for FV
+                l_ba,
+                l_massI,
+                l_weightsFaces,
+                l_basisFaces,
+                i_solvers[l_fa][2],
+                i_solvers[l_fa][3],
+                l_ms[1],
+                l_ms[2],
+                o_updates[l_fa][0],
+                o_updates[l_fa][1] );
+
+          // scale with the time step
+          for( unsigned short l_sd = 0; l_sd < 2; l_sd++ )
+            for( unsigned short l_qt = 0; l_qt < N_QUANTITIES; l_qt++ )
+              for( unsigned short l_ru = 0; l_ru < N_CRUNS; l_ru++ )
+                o_updates[l_fa][l_sd][l_qt][0][l_ru] *= i_dT;
+
+          // check if this face requires receiver output
+          if( (i_iBnd[l_fa].spType & RECEIVER) != RECEIVER ){}
+          else {
+            // check if the receiver requires output
+            if( io_recvsQuad.getRecvTimeRel( l_faRe, i_time, i_dT ) >= -TOL.TIME ) {
+              // gather receiver data, TODO: outsource
+              TL_T_REAL l_buff[ (N_DIM-1)*3 ][N_FACE_QUAD_POINTS][N_CRUNS];
+
+              for( unsigned short l_qp = 0; l_qp < N_FACE_QUAD_POINTS; l_qp++ ) {
+                for( unsigned short l_di = 0; l_di < N_DIM-1; l_di++ ) {
+                  for( unsigned short l_ru = 0; l_ru < N_CRUNS; l_ru++ ) {
+                    l_buff[          0+l_di][l_qp][l_ru] = i_frictionQuadPoint[l_fa][l_qp].tr[l_di][l_ru];
+                    l_buff[  (N_DIM-1)+l_di][l_qp][l_ru] = i_frictionQuadPoint[l_fa][l_qp].sr[l_di][l_ru];
+                    l_buff[2*(N_DIM-1)+l_di][l_qp][l_ru] = i_frictionQuadPoint[l_fa][l_qp].dd[l_di][l_ru];
+                  }
                 }
               }
+
+              // write the receiver info (potentially multiple time if time step is larger than receiver frequency)
+              io_recvsQuad.writeRecvAll( i_time, i_dT, l_faRe, l_buff );
             }
 
-            // write the receiver info (potentially multiple time if time step is larger than receiver frequency)
-            io_recvsQuad.writeRecvAll( i_time, i_dT, l_faRe, l_buff );
+            l_faRe++;
           }
-
-          l_faRe++;
         }
-
-        // update pointers
-        l_faData.fa++;
-        l_faData.qp++;
       }
     }
 
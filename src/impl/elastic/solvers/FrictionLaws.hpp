@@ -25,11 +25,15 @@
 #define FRICTION_LAWS_HPP
 
 #include "FrictionLaws.type"
+#include "io/logging.h"
 #include <cmath>
 
 namespace edge {
   namespace elastic {
     namespace solvers {
+      template< unsigned short TL_N_DIM, unsigned short TL_N_CRUNS >
+      class LinSlipWeakBatch;
+
       template< unsigned short TL_N_DIM, unsigned short TL_N_CRUNS >
       class FrictionLaws;
 
@@ -42,6 +46,136 @@ namespace edge {
   }
 }
 
+/**
+ * Transposition of linear slip weakening data from and to the batched structure of arrays layout.
+ *
+ * The points of a batch are ordered face-by-face, quad point by quad point:
+ *   point = face * #quad_points + quad_point.
+ * Unused points at the end of the batch are padded with the data of the last valid point.
+ * This keeps the batched kernels free of any remainder handling.
+ *
+ * @paramt TL_N_DIM number of dimensions.
+ * @paramt TL_N_CRUNS number of fused simulations.
+ **/
+template< unsigned short TL_N_DIM, unsigned short TL_N_CRUNS >
+class edge::elastic::solvers::LinSlipWeakBatch {
+  public:
+    /**
+     * Gathers the friction data of consecutive faces in the batch.
+     *
+     * @param i_nFa number of faces.
+     * @param i_lswFace per-face parameters, starting at the first face of the batch.
+     * @param i_lswQp per-quad point data, starting at the first face of the batch.
+     * @param o_ba will be set to the batched data.
+     *
+     * @paramt TL_T_REAL precision in all computations.
+     * @paramt TL_N_QPS number of quadrature points per face.
+     * @paramt TL_N_PTS number of points in the batch.
+     **/
+    template< typename       TL_T_REAL,
+              unsigned short TL_N_QPS,
+              unsigned short TL_N_PTS >
+    static void gather( unsigned short                                              i_nFa,
+                        t_LinSlipWeakFace< TL_T_REAL >                      const * i_lswFace,
+                        t_LinSlipWeakFaceQuadPoint< TL_T_REAL,
+                                                    TL_N_DIM,
+                                                    TL_N_CRUNS >            const (*i_lswQp)[TL_N_QPS],
+                        t_LinSlipWeakBatch< TL_T_REAL,
+                                            TL_N_DIM,
+                                            TL_N_CRUNS,
+                                            TL_N_PTS >                            & o_ba ) {
+      unsigned short l_nPts = i_nFa * TL_N_QPS;
+      EDGE_CHECK( l_nPts > 0 && l_nPts <= TL_N_PTS );
+
+      for( unsigned short l_pt = 0; l_pt < TL_N_PTS; l_pt++ ) {
+        // pad with last valid point
+        unsigned short l_src = (l_pt < l_nPts) ? l_pt : l_nPts-1;
+        unsigned short l_fa  = l_src / TL_N_QPS;
+        unsigned short l_qp  = l_src % TL_N_QPS;
+
+        o_ba.lEqM[l_pt]   = i_lswFace[l_fa].lEqM;
+        o_ba.csDmuM[l_pt] = i_lswFace[l_fa].csDmuM;
+        o_ba.csDmuP[l_pt] = i_lswFace[l_fa].csDmuP;
+
+        for( unsigned short l_ru = 0; l_ru < TL_N_CRUNS; l_ru++ ) {
+          o_ba.sn0[l_ru][l_pt] = i_lswQp[l_fa][l_qp].sn0[l_ru];
+          o_ba.muf[l_ru][l_pt] = i_lswQp[l_fa][l_qp].muf[l_ru];
+
+          for( unsigned short l_di = 0; l_di < TL_N_DIM-1; l_di++ ) {
+            o_ba.ss0[l_di][l_ru][l_pt] = i_lswQp[l_fa][l_qp].ss0[l_di][l_ru];
+            o_ba.dd[l_di][l_ru][l_pt]  = i_lswQp[l_fa][l_qp].dd[l_di][l_ru];
+          }
+        }
+      }
+    }
+
+    /**
+     * Scatters the updated friction data of the batch back to the faces' quad points.
+     *
+     * @param i_nFa number of faces.
+     * @param i_ba batched data.
+     * @param io_lswQp per-quad point data, starting at the first face of the batch, will be updated.
+     *
+     * @paramt TL_T_REAL precision in all computations.
+     * @paramt TL_N_QPS number of quadrature points per face.
+     * @paramt TL_N_PTS number of points in the batch.
+     **/
+    template< typename       TL_T_REAL,
+              unsigned short TL_N_QPS,
+              unsigned short TL_N_PTS >
+    static void scatter( unsigned short                                              i_nFa,
+                         t_LinSlipWeakBatch< TL_T_REAL,
+                                             TL_N_DIM,
+                                             TL_N_CRUNS,
+                                             TL_N_PTS >                      const & i_ba,
+                         t_LinSlipWeakFaceQuadPoint< TL_T_REAL,
+                                                     TL_N_DIM,
+                                                     TL_N_CRUNS >                 (*io_lswQp)[TL_N_QPS] ) {
+      for( unsigned short l_pt = 0; l_pt < i_nFa * TL_N_QPS; l_pt++ ) {
+        unsigned short l_fa  = l_pt / TL_N_QPS;
+        unsigned short l_qp  = l_pt % TL_N_QPS;
+
+        for( unsigned short l_ru = 0; l_ru < TL_N_CRUNS; l_ru++ ) {
+          io_lswQp[l_fa][l_qp].muf[l_ru] = i_ba.muf[l_ru][l_pt];
+
+          for( unsigned short l_di = 0; l_di < TL_N_DIM-1; l_di++ ) {
+            io_lswQp[l_fa][l_qp].tr[l_di][l_ru] = i_ba.tr[l_di][l_ru][l_pt];
+            io_lswQp[l_fa][l_qp].sr[l_di][l_ru] = i_ba.sr[l_di][l_ru][l_pt];
+            io_lswQp[l_fa][l_qp].dd[l_di][l_ru] = i_ba.dd[l_di][l_ru][l_pt];
+          }
+        }
+      }
+    }
+
+    /**
+     * Initializes the left and right side middle states with the unperturbed middle states.
+     *
+     * @param i_ms middle states.
+     * @param o_msL will be set to left side middle states.
+     * @param o_msR will be set to right side middle states.
+     *
+     * @paramt TL_T_REAL precision in all computations.
+     * @paramt TL_N_QU number of quantities.
+     * @paramt TL_N_PTS number of points in the batch.
+     **/
+    template< typename       TL_T_REAL,
+              unsigned short TL_N_QU,
+              unsigned short TL_N_PTS >
+    static void inline initMs( TL_T_REAL const i_ms[TL_N_QU][TL_N_CRUNS][TL_N_PTS],
+                               TL_T_REAL       o_msL[TL_N_QU][TL_N_CRUNS][TL_N_PTS],
+                               TL_T_REAL       o_msR[TL_N_QU][TL_N_CRUNS][TL_N_PTS] ) {
+      for( unsigned short l_qt = 0; l_qt < TL_N_QU; l_qt++ ) {
+        for( unsigned short l_ru = 0; l_ru < TL_N_CRUNS; l_ru++ ) {
+#pragma omp simd
+          for( unsigned short l_pt = 0; l_pt < TL_N_PTS; l_pt++ ) {
+            o_msL[l_qt][l_ru][l_pt] = i_ms[l_qt][l_ru][l_pt];
+            o_msR[l_qt][l_ru][l_pt] = i_ms[l_qt][l_ru][l_pt];
+          }
+        }
+      }
+    }
+};
+
 /**
  * Support for 2D friction laws.
  **/
@@ -183,6 +317,84 @@ class edge::elastic::solvers::FrictionLaws< 2, TL_N_CRUNS > {
       }
     }
 
+    /**
+     * Applies the linear slip weakening friction law in two dimensions to a batch of points.
+     *
+     * The implementation matches linSlipWeak, but is free of branches and operates on the
+     * structure of arrays layout, which allows for vectorization over the points.
+     *
+     * @param i_dt distance between this quad point and the previous one (or wave prop time step).
+     * @param i_lswGlobal per-simulation global parameters of linear slip weakening.
+     * @param io_ba batched data of the points, will be updated with slip, friction coefficient, slip rate and traction.
+     * @param i_ms middle states.
+     * @param o_msL will be set to perturbed left side middle states.
+     * @param o_msR will be set to perturbed right side middle states.
+     *
+     * @paramt TL_T_REAL precision in all computations.
+     * @paramt TL_N_PTS number of points in the batch.
+     **/
+    template< typename       TL_T_REAL,
+              unsigned short TL_N_PTS >
+    static void linSlipWeakBatch( TL_T_REAL                                            i_dt,
+                                  t_LinSlipWeakGlobal< TL_T_REAL, TL_N_CRUNS > const & i_lswGlobal,
+                                  t_LinSlipWeakBatch< TL_T_REAL,
+                                                      2,
+                                                      TL_N_CRUNS,
+                                                      TL_N_PTS >                     & io_ba,
+                                  TL_T_REAL                                    const   i_ms[5][TL_N_CRUNS][TL_N_PTS],
+                                  TL_T_REAL                                            o_msL[5][TL_N_CRUNS][TL_N_PTS],
+                                  TL_T_REAL                                            o_msR[5][TL_N_CRUNS][TL_N_PTS] ) {
+      // init left and right "perturbed" middle states
+      LinSlipWeakBatch< 2, TL_N_CRUNS >::template initMs< TL_T_REAL, 5, TL_N_PTS >( i_ms, o_msL, o_msR );
+
+      for( unsigned short l_ru = 0; l_ru < TL_N_CRUNS; l_ru++ ) {
+        TL_T_REAL l_mus =  i_lswGlobal.mus[l_ru];
+        TL_T_REAL l_wk  = -(i_lswGlobal.mus[l_ru] - i_lswGlobal.mud[l_ru]) * i_lswGlobal.dcInv[l_ru];
+        TL_T_REAL l_mud =  i_lswGlobal.mud[l_ru];
+
+#pragma omp simd
+        for( unsigned short l_pt = 0; l_pt < TL_N_PTS; l_pt++ ) {
+          TL_T_REAL l_ss0 = io_ba.ss0[0][l_ru][l_pt];
+          TL_T_REAL l_ms2 = i_ms[2][l_ru][l_pt];
+
+          // fault strength, only relevant for negative normal stress (compression) + switch sign
+          TL_T_REAL l_strength = io_ba.muf[l_ru][l_pt] * ( io_ba.sn0[l_ru][l_pt] + i_ms[0][l_ru][l_pt] );
+          l_strength = (l_strength < 0) ? -l_strength : 0;
+
+          // eval failure criterion
+          bool l_fail = std::abs( l_ss0 + l_ms2 ) > l_strength;
+
+          // traction, falls back to the middle state if the fault is locked
+          TL_T_REAL l_tr = l_strength - std::abs( l_ss0 );
+          l_tr = (l_ss0 > 0) ? l_tr : -l_tr;
+          l_tr = l_fail ? l_tr : l_ms2;
+
+          // perturb fault-tangent particle velocities
+          TL_T_REAL l_diff = l_tr - l_ms2;
+          TL_T_REAL l_vM = i_ms[4][l_ru][l_pt] - io_ba.csDmuM[l_pt] * l_diff;
+          TL_T_REAL l_vP = i_ms[4][l_ru][l_pt] + io_ba.csDmuP[l_pt] * l_diff;
+
+          // slip rate and resulting slip
+          TL_T_REAL l_sr = l_vP - l_vM;
+          io_ba.sr[0][l_ru][l_pt]  = l_sr;
+          io_ba.dd[0][l_ru][l_pt] += std::abs( l_sr ) * i_dt;
+
+          // update friction coefficient
+          TL_T_REAL l_arg = l_wk * io_ba.dd[0][l_ru][l_pt] + l_mus;
+          io_ba.muf[l_ru][l_pt] = (l_arg > l_mud) ? l_arg : l_mud;
+
+          // add background shear stress to traction for output
+          io_ba.tr[0][l_ru][l_pt] = l_tr + l_ss0;
+
+          // assign minus and plus side to left and right
+          o_msL[2][l_ru][l_pt] = l_tr;
+          o_msR[2][l_ru][l_pt] = l_tr;
+          o_msL[4][l_ru][l_pt] = io_ba.lEqM[l_pt] ? l_vM : l_vP;
+          o_msR[4][l_ru][l_pt] = io_ba.lEqM[l_pt] ? l_vP : l_vM;
+        }
+      }
+    }
+
   public:
     /**
      * Applies the linear slip weakening friction law in two dimensions.
@@ -253,6 +465,55 @@ class edge::elastic::solvers::FrictionLaws< 2, TL_N_CRUNS > {
                o_msL,
                o_msR );
     }
+
+    /**
+     * Applies the given friction law (derived from face data type) to all quadrature points of consecutive faces.
+     *
+     * The batch interface is shared among all friction laws:
+     *   The quad points of the faces are gathered in a structure of arrays layout, the law is applied to the entire batch
+     *   and the updated data is scattered back to the faces.
+     *
+     * @param i_nFa number of faces.
+     * @param i_dt "time step" of this pertubation. used for slip computation, not to be confused of the time step of seismic wave propagation.
+     * @param i_ms middle states for all fused simulations and points of the batch.
+     * @param io_faData data of the friction law, pointing to the first face of the batch.
+     * @param o_msL will be set to middle states at the left-side for all fused simulations and points of the batch.
+     * @param o_msR will be set to middle states at the right-side for all fused simulations and points of the batch.
+     *
+     * @paramt TL_T_REAL real type used for arithmetic oprations.
+     * @paramt TL_N_PTS number of points in the batch; unused points at the end hold padding.
+     * @paramt TL_T_FA_DATA face data of the friction law.
+     **/
+    template< typename       TL_T_REAL,
+              unsigned short TL_N_PTS,
+              typename       TL_T_FA_DATA >
+    static void perturbBatch( unsigned short         i_nFa,
+                              TL_T_REAL              i_dt,
+                              TL_T_REAL      const   i_ms[5][TL_N_CRUNS][TL_N_PTS],
+                              TL_T_FA_DATA         * io_faData,
+                              TL_T_REAL              o_msL[5][TL_N_CRUNS][TL_N_PTS],
+                              TL_T_REAL              o_msR[5][TL_N_CRUNS][TL_N_PTS] ) {
+      // number of quad points per face
+      static unsigned short const l_nQps = sizeof( *(io_faData->qp) ) / sizeof( (*(io_faData->qp))[0] );
+
+      t_LinSlipWeakBatch< TL_T_REAL, 2, TL_N_CRUNS, TL_N_PTS > l_ba;
+
+      LinSlipWeakBatch< 2, TL_N_CRUNS >::template gather< TL_T_REAL, l_nQps, TL_N_PTS >( i_nFa,
+                                                                                           io_faData->fa,
+                                                                                           io_faData->qp,
+                                                                                           l_ba );
+
+      linSlipWeakBatch< TL_T_REAL, TL_N_PTS >( i_dt,
+                                               *(io_faData->gl),
+                                               l_ba,
+                                               i_ms,
+                                               o_msL,
+                                               o_msR );
+
+      LinSlipWeakBatch< 2, TL_N_CRUNS >::template scatter< TL_T_REAL, l_nQps, TL_N_PTS >( i_nFa,
+                                                                                            l_ba,
+                                                                                            io_faData->qp );
+    }
 };
 
 /**
@@ -418,6 +679,108 @@ class edge::elastic::solvers::FrictionLaws< 3, TL_N_CRUNS > {
       }
     }
 
+    /**
+     * Applies the linear slip weakening friction law in three dimensions to a batch of points.
+     *
+     * The implementation matches linSlipWeak, but is free of branches and operates on the
+     * structure of arrays layout, which allows for vectorization over the points.
+     *
+     * @param i_dt distance between this quad point and the previous one (or wave prop time step).
+     * @param i_lswGlobal per-simulation global parameters of linear slip weakening.
+     * @param io_ba batched data of the points, will be updated with slip, friction coefficient, slip rate and traction.
+     * @param i_ms middle states.
+     * @param o_msL will be set to perturbed left side middle states.
+     * @param o_msR will be set to perturbed right side middle states.
+     *
+     * @paramt TL_T_REAL precision in all computations.
+     * @paramt TL_N_PTS number of points in the batch.
+     **/
+    template< typename       TL_T_REAL,
+              unsigned short TL_N_PTS >
+    static void linSlipWeakBatch( TL_T_REAL                                            i_dt,
+                                  t_LinSlipWeakGlobal< TL_T_REAL, TL_N_CRUNS > const & i_lswGlobal,
+                                  t_LinSlipWeakBatch< TL_T_REAL,
+                                                      3,
+                                                      TL_N_CRUNS,
+                                                      TL_N_PTS >                     & io_ba,
+                                  TL_T_REAL                                    const   i_ms[9][TL_N_CRUNS][TL_N_PTS],
+                                  TL_T_REAL                                            o_msL[9][TL_N_CRUNS][TL_N_PTS],
+                                  TL_T_REAL                                            o_msR[9][TL_N_CRUNS][TL_N_PTS] ) {
+      // init left and right "perturbed" middle states
+      LinSlipWeakBatch< 3, TL_N_CRUNS >::template initMs< TL_T_REAL, 9, TL_N_PTS >( i_ms, o_msL, o_msR );
+
+      for( unsigned short l_ru = 0; l_ru < TL_N_CRUNS; l_ru++ ) {
+        TL_T_REAL l_mus =  i_lswGlobal.mus[l_ru];
+        TL_T_REAL l_wk  = -(i_lswGlobal.mus[l_ru] - i_lswGlobal.mud[l_ru]) * i_lswGlobal.dcInv[l_ru];
+        TL_T_REAL l_mud =  i_lswGlobal.mud[l_ru];
+
+#pragma omp simd
+        for( unsigned short l_pt = 0; l_pt < TL_N_PTS; l_pt++ ) {
+          TL_T_REAL l_ss01 = io_ba.ss0[0][l_ru][l_pt];
+          TL_T_REAL l_ss02 = io_ba.ss0[1][l_ru][l_pt];
+          TL_T_REAL l_ms3  = i_ms[3][l_ru][l_pt];
+          TL_T_REAL l_ms5  = i_ms[5][l_ru][l_pt];
+
+          // fault strength, only relevant for negative normal stress (compression) + switch sign
+          TL_T_REAL l_strength = io_ba.muf[l_ru][l_pt] * ( io_ba.sn0[l_ru][l_pt] + i_ms[0][l_ru][l_pt] );
+          l_strength = (l_strength < 0) ? -l_strength : 0;
+
+          // combined total shear stress
+          TL_T_REAL l_shear1 = l_ss01 + l_ms3;
+          TL_T_REAL l_shear2 = l_ss02 + l_ms5;
+          TL_T_REAL l_shear  = std::sqrt( l_shear1*l_shear1 + l_shear2*l_shear2 );
+
+          // eval failure criterion
+          bool l_fail = l_shear > l_strength;
+
+          // tractions, fall back to the middle state if the fault is locked
+          // remark: the scaling is only used for failing faults, for which l_shear > 0 holds
+          TL_T_REAL l_scale = l_strength / ( l_fail ? l_shear : TL_T_REAL(1) );
+          TL_T_REAL l_tr1 = l_fail ? l_shear1 * l_scale - l_ss01 : l_ms3;
+          TL_T_REAL l_tr2 = l_fail ? l_shear2 * l_scale - l_ss02 : l_ms5;
+
+          // perturb fault parallel velocities
+          TL_T_REAL l_diff1 = l_tr1 - l_ms3;
+          TL_T_REAL l_diff2 = l_tr2 - l_ms5;
+
+          TL_T_REAL l_vM1 = i_ms[7][l_ru][l_pt] - io_ba.csDmuM[l_pt] * l_diff1;
+          TL_T_REAL l_vM2 = i_ms[8][l_ru][l_pt] - io_ba.csDmuM[l_pt] * l_diff2;
+          TL_T_REAL l_vP1 = i_ms[7][l_ru][l_pt] + io_ba.csDmuP[l_pt] * l_diff1;
+          TL_T_REAL l_vP2 = i_ms[8][l_ru][l_pt] + io_ba.csDmuP[l_pt] * l_diff2;
+
+          // slip rates and resulting slip
+          TL_T_REAL l_sr1 = l_vP1 - l_vM1;
+          TL_T_REAL l_sr2 = l_vP2 - l_vM2;
+          io_ba.sr[0][l_ru][l_pt] = l_sr1;
+          io_ba.sr[1][l_ru][l_pt] = l_sr2;
+
+          TL_T_REAL l_dd1 = io_ba.dd[0][l_ru][l_pt] + std::abs( l_sr1 ) * i_dt;
+          TL_T_REAL l_dd2 = io_ba.dd[1][l_ru][l_pt] + std::abs( l_sr2 ) * i_dt;
+          io_ba.dd[0][l_ru][l_pt] = l_dd1;
+          io_ba.dd[1][l_ru][l_pt] = l_dd2;
+
+          // update friction coefficient
+          TL_T_REAL l_arg = l_wk * std::sqrt( l_dd1*l_dd1 + l_dd2*l_dd2 ) + l_mus;
+          io_ba.muf[l_ru][l_pt] = (l_arg > l_mud) ? l_arg : l_mud;
+
+          // add background shear stress to traction for output
+          io_ba.tr[0][l_ru][l_pt] = l_tr1 + l_ss01;
+          io_ba.tr[1][l_ru][l_pt] = l_tr2 + l_ss02;
+
+          // assign minus and plus side to left and right
+          o_msL[3][l_ru][l_pt] = l_tr1;
+          o_msL[5][l_ru][l_pt] = l_tr2;
+          o_msR[3][l_ru][l_pt] = l_tr1;
+          o_msR[5][l_ru][l_pt] = l_tr2;
+
+          o_msL[7][l_ru][l_pt] = io_ba.lEqM[l_pt] ? l_vM1 : l_vP1;
+          o_msL[8][l_ru][l_pt] = io_ba.lEqM[l_pt] ? l_vM2 : l_vP2;
+          o_msR[7][l_ru][l_pt] = io_ba.lEqM[l_pt] ? l_vP1 : l_vM1;
+          o_msR[8][l_ru][l_pt] = io_ba.lEqM[l_pt] ? l_vP2 : l_vM2;
+        }
+      }
+    }
+
   public:
     /**
      * Applies the linear slip weakening friction law in three dimensions.
@@ -489,6 +852,55 @@ class edge::elastic::solvers::FrictionLaws< 3, TL_N_CRUNS > {
                o_msL,
                o_msR );
     }
+
+    /**
+     * Applies the given friction law (derived from face data type) to all quadrature points of consecutive faces.
+     *
+     * The batch interface is shared among all friction laws:
+     *   The quad points of the faces are gathered in a structure of arrays layout, the law is applied to the entire batch
+     *   and the updated data is scattered back to the faces.
+     *
+     * @param i_nFa number of faces.
+     * @param i_dt "time step" of this pertubation. used for slip computation, not to be confused of the time step of seismic wave propagation.
+     * @param i_ms middle states for all fused simulations and points of the batch.
+     * @param io_faData data of the friction law, pointing to the first face of the batch.
+     * @param o_msL will be set to middle states at the left-side for all fused simulations and points of the batch.
+     * @param o_msR will be set to middle states at the right-side for all fused simulations and points of the batch.
+     *
+     * @paramt TL_T_REAL real type used for arithmetic oprations.
+     * @paramt TL_N_PTS number of points in the batch; unused points at the end hold padding.
+     * @paramt TL_T_FA_DATA face data of the friction law.
+     **/
+    template< typename       TL_T_REAL,
+              unsigned short TL_N_PTS,
+              typename       TL_T_FA_DATA >
+    static void perturbBatch( unsigned short         i_nFa,
+                              TL_T_REAL              i_dt,
+                              TL_T_REAL      const   i_ms[9][TL_N_CRUNS][TL_N_PTS],
+                              TL_T_FA_DATA         * io_faData,
+                              TL_T_REAL              o_msL[9][TL_N_CRUNS][TL_N_PTS],
+                              TL_T_REAL              o_msR[9][TL_N_CRUNS][TL_N_PTS] ) {
+      // number of quad points per face
+      static unsigned short const l_nQps = sizeof( *(io_faData->qp) ) / sizeof( (*(io_faData->qp))[0] );
+
+      t_LinSlipWeakBatch< TL_T_REAL, 3, TL_N_CRUNS, TL_N_PTS > l_ba;
+
+      LinSlipWeakBatch< 3, TL_N_CRUNS >::template gather< TL_T_REAL, l_nQps, TL_N_PTS >( i_nFa,
+                                                                                           io_faData->fa,
+                                                                                           io_faData->qp,
+                                                                                           l_ba );
+
+      linSlipWeakBatch< TL_T_REAL, TL_N_PTS >( i_dt,
+                                               *(io_faData->gl),
+                                               l_ba,
+                                               i_ms,
+                                               o_msL,
+                                               o_msR );
+
+      LinSlipWeakBatch< 3, TL_N_CRUNS >::template scatter< TL_T_REAL, l_nQps, TL_N_PTS >( i_nFa,
+                                                                                            l_ba,
+                                                                                            io_faData->qp );
+    }
 };
 
 #endif
@@ -277,3 +277,149 @@ TEST_CASE( "Perturbation of middle states through linear slip weaking in 3D.", "
   REQUIRE( l_sr[0][0] == Approx( l_srRef[0] ) );
   REQUIRE( l_sr[1][0] == Approx( l_srRef[1] ) );
 }
+
+TEST_CASE( "Batched linear slip weakening in 2D and 3D.", "[FrictionLaws][batchLSW]" ) {
+  // two faces with three quad points each, two fused runs, padded batch of eight points
+
+  edge::elastic::solvers::t_LinSlipWeakGlobal< double, 2 > l_gl;
+  l_gl.mus[0] = 0.677; l_gl.mus[1] = 0.6;
+  l_gl.mud[0] = 0.55;  l_gl.mud[1] = 0.5;
+  l_gl.dcInv[0] = 2.5; l_gl.dcInv[1] = 5.0;
+
+  edge::elastic::solvers::t_LinSlipWeakFace< double > l_fa[2];
+  l_fa[0].lEqM = true;  l_fa[0].csDmuM = 1.0E-7; l_fa[0].csDmuP = 2.0E-7;
+  l_fa[1].lEqM = false; l_fa[1].csDmuM = 3.0E-7; l_fa[1].csDmuP = 0.5E-7;
+
+  /*
+   * 2D
+   */
+  edge::elastic::solvers::t_LinSlipWeakFaceQuadPoint< double, 2, 2 > l_qp2[2][3];
+  edge::elastic::solvers::t_LinSlipWeakFaceQuadPoint< double, 2, 2 > l_qp2Ref[2][3];
+  double l_ms2[5][2][8] = {};
+  for( unsigned short l_pt = 0; l_pt < 6; l_pt++ ) {
+    for( unsigned short l_ru = 0; l_ru < 2; l_ru++ ) {
+      edge::elastic::solvers::t_LinSlipWeakFaceQuadPoint< double, 2, 2 > &l_qp = l_qp2[l_pt/3][l_pt%3];
+      l_qp.sn0[l_ru]    = -120E6 + l_pt * 1E6;
+      // alternate between locked and failing faults
+      l_qp.ss0[0][l_ru] = ( (l_pt+l_ru) % 2 == 0 ) ? 81.6E6 : -20E6;
+      l_qp.muf[l_ru]    = 0.59;
+      l_qp.dd[0][l_ru]  = 0.05 * l_pt;
+      for( unsigned short l_qt = 0; l_qt < 5; l_qt++ ) {
+        l_ms2[l_qt][l_ru][l_pt] = (l_qt < 3) ? -1E6 * (l_qt+1) + l_ru * 1E5 : 0.1 * (l_qt+l_pt) - l_ru;
+      }
+    }
+  }
+  for( unsigned short l_fa0 = 0; l_fa0 < 2; l_fa0++ )
+    for( unsigned short l_q = 0; l_q < 3; l_q++ ) l_qp2Ref[l_fa0][l_q] = l_qp2[l_fa0][l_q];
+
+  struct {
+    edge::elastic::solvers::t_LinSlipWeakGlobal< double, 2 > *gl;
+    edge::elastic::solvers::t_LinSlipWeakFace< double > *fa;
+    edge::elastic::solvers::t_LinSlipWeakFaceQuadPoint< double, 2, 2 > (*qp)[3];
+  } l_faData2;
+  l_faData2.gl = &l_gl;
+  l_faData2.fa = l_fa;
+  l_faData2.qp = l_qp2;
+
+  double l_msL2[5][2][8], l_msR2[5][2][8];
+  edge::elastic::solvers::FrictionLaws< 2, 2 >::perturbBatch< double, 8 >( 2,
+                                                                          0.004,
+                                                                          l_ms2,
+                                                                          &l_faData2,
+                                                                          l_msL2,
+                                                                          l_msR2 );
+
+  // compare to the scalar implementation
+  for( unsigned short l_pt = 0; l_pt < 6; l_pt++ ) {
+    double l_ms[5][2], l_msL[5][2], l_msR[5][2];
+    for( unsigned short l_qt = 0; l_qt < 5; l_qt++ )
+      for( unsigned short l_ru = 0; l_ru < 2; l_ru++ ) l_ms[l_qt][l_ru] = l_ms2[l_qt][l_ru][l_pt];
+
+    edge::elastic::solvers::FrictionLaws< 2, 2 >::perturb( 0.004,
+                                                           l_gl,
+                                                           l_fa[l_pt/3],
+                                                           l_ms,
+                                                           l_qp2Ref[l_pt/3][l_pt%3],
+                                                           l_msL,
+                                                           l_msR );
+
+    for( unsigned short l_ru = 0; l_ru < 2; l_ru++ ) {
+      for( unsigned short l_qt = 0; l_qt < 5; l_qt++ ) {
+        REQUIRE( l_msL2[l_qt][l_ru][l_pt] == Approx( l_msL[l_qt][l_ru] ) );
+        REQUIRE( l_msR2[l_qt][l_ru][l_pt] == Approx( l_msR[l_qt][l_ru] ) );
+      }
+      REQUIRE( l_qp2[l_pt/3][l_pt%3].muf[l_ru]   == Approx( l_qp2Ref[l_pt/3][l_pt%3].muf[l_ru]   ) );
+      REQUIRE( l_qp2[l_pt/3][l_pt%3].dd[0][l_ru] == Approx( l_qp2Ref[l_pt/3][l_pt%3].dd[0][l_ru] ) );
+      REQUIRE( l_qp2[l_pt/3][l_pt%3].sr[0][l_ru] == Approx( l_qp2Ref[l_pt/3][l_pt%3].sr[0][l_ru] ) );
+      REQUIRE( l_qp2[l_pt/3][l_pt%3].tr[0][l_ru] == Approx( l_qp2Ref[l_pt/3][l_pt%3].tr[0][l_ru] ) );
+    }
+  }
+
+  /*
+   * 3D
+   */
+  edge::elastic::solvers::t_LinSlipWeakFaceQuadPoint< double, 3, 2 > l_qp3[2][3];
+  edge::elastic::solvers::t_LinSlipWeakFaceQuadPoint< double, 3, 2 > l_qp3Ref[2][3];
+  double l_ms3[9][2][8] = {};
+  for( unsigned short l_pt = 0; l_pt < 6; l_pt++ ) {
+    for( unsigned short l_ru = 0; l_ru < 2; l_ru++ ) {
+      edge::elastic::solvers::t_LinSlipWeakFaceQuadPoint< double, 3, 2 > &l_qp = l_qp3[l_pt/3][l_pt%3];
+      l_qp.sn0[l_ru]    = -120E6 + l_pt * 1E6;
+      l_qp.ss0[0][l_ru] = ( (l_pt+l_ru) % 2 == 0 ) ? 40E6 : -5E6;
+      l_qp.ss0[1][l_ru] = ( (l_pt+l_ru) % 2 == 0 ) ? 71.2E6 : 2E6;
+      l_qp.ss0A[l_ru]   = std::sqrt( l_qp.ss0[0][l_ru] * l_qp.ss0[0][l_ru] + l_qp.ss0[1][l_ru] * l_qp.ss0[1][l_ru] );
+      l_qp.muf[l_ru]    = 0.59;
+      l_qp.dd[0][l_ru]  = 0.05 * l_pt;
+      l_qp.dd[1][l_ru]  = -0.02 * l_pt;
+      for( unsigned short l_qt = 0; l_qt < 9; l_qt++ ) {
+        l_ms3[l_qt][l_ru][l_pt] = (l_qt < 6) ? -1E6 * (l_qt+1) + l_ru * 1E5 : 0.1 * (l_qt+l_pt) - l_ru;
+      }
+    }
+  }
+  for( unsigned short l_fa0 = 0; l_fa0 < 2; l_fa0++ )
+    for( unsigned short l_q = 0; l_q < 3; l_q++ ) l_qp3Ref[l_fa0][l_q] = l_qp3[l_fa0][l_q];
+
+  struct {
+    edge::elastic::solvers::t_LinSlipWeakGlobal< double, 2 > *gl;
+    edge::elastic::solvers::t_LinSlipWeakFace< double > *fa;
+    edge::elastic::solvers::t_LinSlipWeakFaceQuadPoint< double, 3, 2 > (*qp)[3];
+  } l_faData3;
+  l_faData3.gl = &l_gl;
+  l_faData3.fa = l_fa;
+  l_faData3.qp = l_qp3;
+
+  double l_msL3[9][2][8], l_msR3[9][2][8];
+  edge::elastic::solvers::FrictionLaws< 3, 2 >::perturbBatch< double, 8 >( 2,
+                                                                          0.004,
+                                                                          l_ms3,
+                                                                          &l_faData3,
+                                                                          l_msL3,
+                                                                          l_msR3 );
+
+  for( unsigned short l_pt = 0; l_pt < 6; l_pt++ ) {
+    double l_ms[9][2], l_msL[9][2], l_msR[9][2];
+    for( unsigned short l_qt = 0; l_qt < 9; l_qt++ )
+      for( unsigned short l_ru = 0; l_ru < 2; l_ru++ ) l_ms[l_qt][l_ru] = l_ms3[l_qt][l_ru][l_pt];
+
+    edge::elastic::solvers::FrictionLaws< 3, 2 >::perturb( 0.004,
+                                                           l_gl,
+                                                           l_fa[l_pt/3],
+                                                           l_ms,
+                                                           l_qp3Ref[l_pt/3][l_pt%3],
+                                                           l_msL,
+                                                           l_msR );
+
+    for( unsigned short l_ru = 0; l_ru < 2; l_ru++ ) {
+      for( unsigned short l_qt = 0; l_qt < 9; l_qt++ ) {
+        REQUIRE( l_msL3[l_qt][l_ru][l_pt] == Approx( l_msL[l_qt][l_ru] ) );
+        REQUIRE( l_msR3[l_qt][l_ru][l_pt] == Approx( l_msR[l_qt][l_ru] ) );
+      }
+      REQUIRE( l_qp3[l_pt/3][l_pt%3].muf[l_ru] == Approx( l_qp3Ref[l_pt/3][l_pt%3].muf[l_ru] ) );
+      for( unsigned short l_di = 0; l_di < 2; l_di++ ) {
+        REQUIRE( l_qp3[l_pt/3][l_pt%3].dd[l_di][l_ru] == Approx( l_qp3Ref[l_pt/3][l_pt%3].dd[l_di][l_ru] ) );
+        REQUIRE( l_qp3[l_pt/3][l_pt%3].sr[l_di][l_ru] == Approx( l_qp3Ref[l_pt/3][l_pt%3].sr[l_di][l_ru] ) );
+        REQUIRE( l_qp3[l_pt/3][l_pt%3].tr[l_di][l_ru] == Approx( l_qp3Ref[l_pt/3][l_pt%3].tr[l_di][l_ru] ) );
+      }
+    }
+  }
+}
@@ -0,0 +1,140 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @section DESCRIPTION
+ * Schedule of the fused local and neighboring updates.
+ **/
+
+#ifndef EDGE_ELASTIC_SOLVERS_FUSED_TILES_HPP
+#define EDGE_ELASTIC_SOLVERS_FUSED_TILES_HPP
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace edge {
+  namespace elastic {
+    namespace solvers {
+      template< typename       TL_T_INT_LID,
+                unsigned short TL_N_FAS,
+                TL_T_INT_LID   TL_N_TILE,
+                TL_T_INT_LID   TL_N_PEND >
+      class FusedTiles;
+    }
+  }
+}
+
+/**
+ * Processes a range of elements in tiles of consecutive elements.
+ * After the local step of a tile, an element's neighboring update is issued as soon as all face-neighbors finished their
+ * local step. Elements whose neighbors fall into upcoming tiles wait in a fixed-size list of pending elements.
+ * Elements with neighbors outside of the range, or which do not fit into the pending list, are skipped and left to the
+ * regular neighboring step.
+ *
+ * @paramt TL_T_INT_LID integer type of local entity ids.
+ * @paramt TL_N_FAS number of faces per element.
+ * @paramt TL_N_TILE number of elements per tile.
+ * @paramt TL_N_PEND maximum number of pending elements.
+ **/
+template< typename       TL_T_INT_LID,
+          unsigned short TL_N_FAS,
+          TL_T_INT_LID   TL_N_TILE,
+          TL_T_INT_LID   TL_N_PEND >
+class edge::elastic::solvers::FusedTiles {
+  public:
+    /**
+     * Runs the schedule.
+     *
+     * @param i_first first element.
+     * @param i_nEls number of elements.
+     * @param i_elFaEl face-neighboring elements, std::numeric_limits< TL_T_INT_LID >::max() if not existing.
+     * @param i_nElBnd number of elements with boundary conditions.
+     * @param i_elBnd sorted elements with boundary conditions.
+     * @param i_local local step, called with the first element and the number of elements of a tile.
+     * @param i_neigh neighboring update, called with the element, the last element of the current tile (prefetching)
+     *                and true if the element has boundary conditions.
+     *
+     * @paramt TL_T_LOCAL type of the local step.
+     * @paramt TL_T_NEIGH type of the neighboring update.
+     **/
+    template< typename TL_T_LOCAL,
+              typename TL_T_NEIGH >
+    static void run( TL_T_INT_LID         i_first,
+                     TL_T_INT_LID         i_nEls,
+                     TL_T_INT_LID const (*i_elFaEl)[TL_N_FAS],
+                     TL_T_INT_LID         i_nElBnd,
+                     TL_T_INT_LID const  *i_elBnd,
+                     TL_T_LOCAL           i_local,
+                     TL_T_NEIGH           i_neigh ) {
+      TL_T_INT_LID l_end = i_first+i_nEls;
+
+      // elements waiting for face-neighbors in upcoming tiles: element and largest neighbor
+      std::pair< TL_T_INT_LID, TL_T_INT_LID > l_pend[TL_N_PEND];
+      TL_T_INT_LID l_nPend = 0;
+
+      for( TL_T_INT_LID l_tl = i_first; l_tl < l_end; l_tl += TL_N_TILE ) {
+        TL_T_INT_LID l_endTl = std::min( l_tl + TL_N_TILE, l_end );
+
+        // local step of the tile
+        i_local( l_tl, l_endTl-l_tl );
+
+        // pending elements of previous tiles, which are ready now
+        TL_T_INT_LID l_nPendNew = 0;
+        for( TL_T_INT_LID l_pe = 0; l_pe < l_nPend; l_pe++ ) {
+          if( l_pend[l_pe].second < l_endTl ) {
+            TL_T_INT_LID l_el = l_pend[l_pe].first;
+            i_neigh( l_el, l_el, std::binary_search( i_elBnd, i_elBnd+i_nElBnd, l_el ) );
+          }
+          else l_pend[l_nPendNew++] = l_pend[l_pe];
+        }
+        l_nPend = l_nPendNew;
+
+        // elements of the tile
+        TL_T_INT_LID const * l_elBnd = std::lower_bound( i_elBnd, i_elBnd+i_nElBnd, l_tl );
+
+        for( TL_T_INT_LID l_el = l_tl; l_el < l_endTl; l_el++ ) {
+          // derive range of the face-neighbors, non-existing neighbors are ignored
+          TL_T_INT_LID l_neMin = l_el;
+          TL_T_INT_LID l_neMax = l_el;
+          for( unsigned short l_fa = 0; l_fa < TL_N_FAS; l_fa++ ) {
+            TL_T_INT_LID l_ne = i_elFaEl[l_el][l_fa];
+            if( l_ne != std::numeric_limits< TL_T_INT_LID >::max() ) {
+              l_neMin = std::min( l_neMin, l_ne );
+              l_neMax = std::max( l_neMax, l_ne );
+            }
+          }
+
+          bool l_bnd = ( l_elBnd != i_elBnd+i_nElBnd && *l_elBnd == l_el );
+          if( l_bnd ) l_elBnd++;
+
+          // neighbors outside of the range are handled by the regular neighboring step
+          if( l_neMin < i_first || l_neMax >= l_end ) continue;
+          // wait for upcoming tiles, the regular neighboring step takes over if the list is full
+          else if( l_neMax >= l_endTl ) {
+            if( l_nPend < TL_N_PEND ) l_pend[l_nPend++] = std::make_pair( l_el, l_neMax );
+          }
+          // neighbors are ready
+          else i_neigh( l_el, l_endTl-1, l_bnd );
+        }
+      }
+    }
+};
+
+#endif
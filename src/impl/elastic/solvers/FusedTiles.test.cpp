@@ -0,0 +1,124 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @section DESCRIPTION
+ * Unit tests of the schedule of the fused local and neighboring updates.
+ **/
+
+#include <catch.hpp>
+#include "FusedTiles.hpp"
+#include <vector>
+
+namespace {
+  /**
+   * Runs the schedule and checks its dependencies.
+   *
+   * @param i_first first element of the range.
+   * @param i_nEls number of elements in the range.
+   * @param i_elFaEl face-neighboring elements of all elements.
+   * @param i_elBnd sorted elements with boundary conditions.
+   * @param o_fused will be set to the number of neighboring updates per element.
+   *
+   * @paramt TL_N_PEND maximum number of pending elements.
+   **/
+  template< int TL_N_PEND >
+  void check( int                        i_first,
+              int                        i_nEls,
+              std::vector< int > const & i_elFaEl,
+              std::vector< int > const & i_elBnd,
+              std::vector< int >       & o_fused ) {
+    std::size_t l_nElsAll = i_elFaEl.size() / 2;
+    std::vector< int > l_local( l_nElsAll, 0 );
+    o_fused.assign( l_nElsAll, 0 );
+
+    edge::elastic::solvers::FusedTiles< int, 2, 8, TL_N_PEND >::run(
+      i_first,
+      i_nEls,
+      (int const (*)[2]) i_elFaEl.data(),
+      (int) i_elBnd.size(),
+      i_elBnd.data(),
+      [&]( int i_firstTl, int i_nElsTl ) {
+        REQUIRE( i_nElsTl <= 8 );
+        for( int l_el = i_firstTl; l_el < i_firstTl+i_nElsTl; l_el++ ) l_local[l_el]++;
+      },
+      [&]( int i_el, int i_last, bool i_bnd ) {
+        // the element and its neighbors finished their local step
+        REQUIRE( l_local[i_el] == 1 );
+        for( unsigned short l_fa = 0; l_fa < 2; l_fa++ ) {
+          int l_ne = i_elFaEl[i_el*2 + l_fa];
+          if( l_ne != std::numeric_limits< int >::max() ) REQUIRE( l_local[l_ne] == 1 );
+        }
+        REQUIRE( i_last >= i_el );
+        REQUIRE( i_bnd == std::binary_search( i_elBnd.begin(), i_elBnd.end(), i_el ) );
+        o_fused[i_el]++;
+      } );
+
+    // every element of the range is updated locally once, the others never
+    for( std::size_t l_el = 0; l_el < l_nElsAll; l_el++ ) {
+      bool l_in = int(l_el) >= i_first && int(l_el) < i_first+i_nEls;
+      REQUIRE( l_local[l_el] == (l_in ? 1 : 0) );
+      REQUIRE( o_fused[l_el] <= (l_in ? 1 : 0) );
+    }
+  }
+}
+
+TEST_CASE( "FusedTiles: chain of line elements.", "[FusedTiles]" ) {
+  int l_x = std::numeric_limits< int >::max();
+
+  std::vector< int > l_elFaEl( 100*2 );
+  for( int l_el = 0; l_el < 100; l_el++ ) {
+    l_elFaEl[l_el*2 + 0] = (l_el > 0)  ? l_el-1 : l_x;
+    l_elFaEl[l_el*2 + 1] = (l_el < 99) ? l_el+1 : l_x;
+  }
+  std::vector< int > l_elBnd = { 20, 21, 50 };
+  std::vector< int > l_fused;
+
+  // all elements with neighbors in the range are fused, pending elements wait for a single element only
+  check< 1 >( 10, 80, l_elFaEl, l_elBnd, l_fused );
+  for( int l_el = 0; l_el < 100; l_el++ ) REQUIRE( l_fused[l_el] == ( (l_el > 10 && l_el < 89) ? 1 : 0 ) );
+
+  // full range with boundaries of the mesh
+  check< 1 >( 0, 100, l_elFaEl, l_elBnd, l_fused );
+  for( int l_el = 0; l_el < 100; l_el++ ) REQUIRE( l_fused[l_el] == 1 );
+}
+
+TEST_CASE( "FusedTiles: far neighbors and overflow of the pending elements.", "[FusedTiles]" ) {
+  // every element is adjacent to the element 20 ids ahead (and behind)
+  int l_x = std::numeric_limits< int >::max();
+  std::vector< int > l_elFaEl( 64*2 );
+  for( int l_el = 0; l_el < 64; l_el++ ) {
+    l_elFaEl[l_el*2 + 0] = (l_el >= 20) ? l_el-20 : l_x;
+    l_elFaEl[l_el*2 + 1] = (l_el <  44) ? l_el+20 : l_x;
+  }
+  std::vector< int > l_elBnd;
+  std::vector< int > l_fused;
+
+  // enough space: all elements are fused
+  check< 64 >( 0, 64, l_elFaEl, l_elBnd, l_fused );
+  for( int l_el = 0; l_el < 64; l_el++ ) REQUIRE( l_fused[l_el] == 1 );
+
+  // overflow: the first 4 waiting elements are fused, the others are left to the regular neighboring step
+  check< 4 >( 0, 64, l_elFaEl, l_elBnd, l_fused );
+  int l_nFused = 0;
+  for( int l_el = 0; l_el < 64; l_el++ ) l_nFused += l_fused[l_el];
+  REQUIRE( l_nFused < 64 );
+  for( int l_el = 0; l_el < 4; l_el++ ) REQUIRE( l_fused[l_el] == 1 );
+  for( int l_el = 44; l_el < 64; l_el++ ) REQUIRE( l_fused[l_el] == 1 );
+}
@@ -111,8 +111,206 @@ class edge::elastic::solvers::InternalBoundary {
             }
           }
         }
+
+        /**
+         * Dummy batched perturbations.
+         **/
+        template< typename TL_T_REAL, unsigned short TL_N_PTS, typename TL_T_FA_DATA >
+        static void inline perturbBatch( unsigned short,
+                                         TL_T_REAL,
+                                         TL_T_REAL    const   i_ms[TL_N_QU][TL_N_CRUNS][TL_N_PTS],
+                                         TL_T_FA_DATA const *,
+                                         TL_T_REAL            o_msL[TL_N_QU][TL_N_CRUNS][TL_N_PTS],
+                                         TL_T_REAL            o_msR[TL_N_QU][TL_N_CRUNS][TL_N_PTS] ) {
+          for( unsigned short l_qt = 0; l_qt < TL_N_QU; l_qt++ ) {
+            for( unsigned short l_ru = 0; l_ru < TL_N_CRUNS; l_ru++ ) {
+              for( unsigned short l_pt = 0; l_pt < TL_N_PTS; l_pt++ ) {
+                o_msL[l_qt][l_ru][l_pt] = i_ms[l_qt][l_ru][l_pt];
+                o_msR[l_qt][l_ru][l_pt] = i_ms[l_qt][l_ru][l_pt];
+              }
+            }
+          }
+        }
     };
 
+    /**
+     * Evaluates the middle states at the quadrature points of a face.
+     * The middle states are written to consecutive points of a batch in structure of arrays layout.
+     *
+     * @param i_faIdL local face id of the left element.
+     * @param i_faIdR local face id of the right element.
+     * @param i_vIdR local id of the right element's vertex lying on the left element's first face-vertex.
+     * @param i_pt first point of the face in the batch.
+     * @param i_basisFaces evaluated basis at the quad points.
+     * @param i_tm1 transformation matrix from physical coordinates for face-aligned coordinates.
+     * @param i_solMsJumpL solver for the single jump from the left element's quantities to the middle state.
+     * @param i_dofsL modal DOFs of the left element.
+     * @param i_dofsR modal DOFs of the right element.
+     * @param o_ms will be set to the middle states at the face's points in the batch.
+     *
+     * @paramt TL_T_REAL floating point type.
+     * @paramt TL_N_PTS number of points in the batch.
+     **/
+    template< typename       TL_T_REAL,
+              unsigned short TL_N_PTS >
+    static void evalMsSpace( unsigned short        i_faIdL,
+                             unsigned short        i_faIdR,
+                             unsigned short        i_vIdR,
+                             unsigned short        i_pt,
+                             TL_T_REAL      const  i_basisFaces[TL_N_FACE_QUAD_OPTS][TL_N_FACE_QUAD_POINTS][TL_N_ELEMENT_MODES],
+                             TL_T_REAL      const  i_tm1[TL_N_QU][TL_N_QU],
+                             TL_T_REAL      const  i_solMsJumpL[TL_N_QU][TL_N_QU],
+                             TL_T_REAL      const  i_dofsL[TL_N_QU][TL_N_ELEMENT_MODES][TL_N_CRUNS],
+                             TL_T_REAL      const  i_dofsR[TL_N_QU][TL_N_ELEMENT_MODES][TL_N_CRUNS],
+                             TL_T_REAL             o_ms[TL_N_QU][TL_N_CRUNS][TL_N_PTS] ) {
+      EDGE_CHECK( i_pt + TL_N_FACE_QUAD_POINTS <= TL_N_PTS );
+
+      // rotate the DOFs from physical coordinates to face-aligned coords
+      // remark: the back-rotation to physical coordinates is part of the the flux solver
+      TL_T_REAL l_dofs[2][TL_N_QU][TL_N_ELEMENT_MODES][TL_N_CRUNS];
+      linalg::Matrix::matMulB0FusedBC( TL_N_CRUNS,
+                                       TL_N_QU, TL_N_ELEMENT_MODES, TL_N_QU,
+                                       i_tm1[0], i_dofsL[0][0], l_dofs[0][0][0] );
+      linalg::Matrix::matMulB0FusedBC( TL_N_CRUNS,
+                                       TL_N_QU, TL_N_ELEMENT_MODES, TL_N_QU,
+                                       i_tm1[0], i_dofsR[0][0], l_dofs[1][0][0] );
+
+      // derive face quad pos of right element
+      unsigned short l_posR  = C_ENT[TL_T_EL].N_FACES;
+      l_posR                += i_faIdR * CE_N_FACE_VERTEX_OPTS(TL_T_EL);
+      l_posR                += i_vIdR;
+
+      // iterate over the quad points in space
+      for( int_md l_qp = 0; l_qp < TL_N_FACE_QUAD_POINTS; l_qp++ ) {
+        // temporary values at the quad points
+        TL_T_REAL l_qEv[2][TL_N_QU][TL_N_CRUNS];
+        // jump in quantities
+        TL_T_REAL l_qJump[TL_N_QU][TL_N_CRUNS];
+
+        // eval left and right elements' DOFs at quad points
+        for( int_qt l_qt = 0; l_qt < TL_N_QU; l_qt++ ) {
+          dg::QuadratureEval<TL_T_EL, TL_O_SP, TL_N_CRUNS>::evalBasis( i_basisFaces[i_faIdL][l_qp],
+                                                                       l_dofs[0][l_qt],
+                                                                       l_qEv[0][l_qt] );
+
+          dg::QuadratureEval<TL_T_EL, TL_O_SP, TL_N_CRUNS>::evalBasis( i_basisFaces[l_posR][l_qp],
+                                                                       l_dofs[1][l_qt],
+                                                                       l_qEv[1][l_qt] );
+
+          // compute the jump in quantities
+          for( int_cfr l_ru = 0; l_ru < TL_N_CRUNS; l_ru++ ) {
+            l_qJump[l_qt][l_ru] = l_qEv[1][l_qt][l_ru] - l_qEv[0][l_qt][l_ru];
+          }
+        }
+        // jump over waves with negative speeds from the left to get the left-side middle state
+        linalg::Matrix::matMulB1FusedBC( TL_N_CRUNS,
+                                         TL_N_QU, 1, TL_N_QU,
+                                         i_solMsJumpL[0],
+                                         l_qJump[0],
+                                         l_qEv[0][0] );
+
+        // store the middle state in the batch
+        for( int_qt l_qt = 0; l_qt < TL_N_QU; l_qt++ ) {
+          for( int_cfr l_ru = 0; l_ru < TL_N_CRUNS; l_ru++ ) {
+            o_ms[l_qt][l_ru][i_pt+l_qp] = l_qEv[0][l_qt][l_ru];
+          }
+        }
+      }
+    }
+
+    /**
+     * Integrates the (probably perturbed) middle states at the quadrature points of a face
+     * and applies the flux solvers.
+     *
+     * @param i_faIdL local face id of the left element.
+     * @param i_faIdR local face id of the right element.
+     * @param i_vIdR local id of the right element's vertex lying on the left element's first face-vertex.
+     * @param i_pt first point of the face in the batch.
+     * @param i_massI diagonal of the inverse mass matrix (orthogonal basis is assumed).
+     * @param i_weightsFaces weights of the face's quadrature point.
+     * @param i_basisFaces evaluated basis at the quad points.
+     * @param i_solMsFluxL flux solver using (probably perturbed) middle states for the left element.
+     * @param i_solMsFluxR flux solver using (probably perturbed) middle states for the right element.
+     * @param i_msL left-side middle states of the batch.
+     * @param i_msR right-side middle states of the batch.
+     * @param o_surfUpdateL will be set to left-going surface update of this part of the internal boundary.
+     * @param o_surfUpdateR will be set to right-going surface update of this part of the internal boundary.
+     *
+     * @paramt TL_T_REAL floating point type.
+     * @paramt TL_N_PTS number of points in the batch.
+     **/
+    template< typename       TL_T_REAL,
+              unsigned short TL_N_PTS >
+    static void intMsSpace( unsigned short        i_faIdL,
+                            unsigned short        i_faIdR,
+                            unsigned short        i_vIdR,
+                            unsigned short        i_pt,
+                            TL_T_REAL      const  i_massI[TL_N_ELEMENT_MODES],
+                            TL_T_REAL      const  i_weightsFaces[TL_N_FACE_QUAD_POINTS],
+                            TL_T_REAL      const  i_basisFaces[TL_N_FACE_QUAD_OPTS][TL_N_FACE_QUAD_POINTS][TL_N_ELEMENT_MODES],
+                            TL_T_REAL      const  i_solMsFluxL[TL_N_QU][TL_N_QU],
+                            TL_T_REAL      const  i_solMsFluxR[TL_N_QU][TL_N_QU],
+                            TL_T_REAL      const  i_msL[TL_N_QU][TL_N_CRUNS][TL_N_PTS],
+                            TL_T_REAL      const  i_msR[TL_N_QU][TL_N_CRUNS][TL_N_PTS],
+                            TL_T_REAL             o_surfUpdateL[TL_N_QU][TL_N_ELEMENT_MODES][TL_N_CRUNS],
+                            TL_T_REAL             o_surfUpdateR[TL_N_QU][TL_N_ELEMENT_MODES][TL_N_CRUNS] ) {
+      EDGE_CHECK( i_pt + TL_N_FACE_QUAD_POINTS <= TL_N_PTS );
+
+      // temporary storage for the integrated middle states
+      TL_T_REAL l_msTmp[2][TL_N_QU][TL_N_ELEMENT_MODES][TL_N_CRUNS];
+      for( int_qt l_qt = 0; l_qt < TL_N_QU; l_qt++ ) {
+        for( int_md l_md = 0; l_md < TL_N_ELEMENT_MODES; l_md++ ) {
+          for( int_cfr l_ru = 0; l_ru < TL_N_CRUNS; l_ru++ ) {
+            l_msTmp[0][l_qt][l_md][l_ru] = 0;
+            l_msTmp[1][l_qt][l_md][l_ru] = 0;
+          }
+        }
+      }
+
+      // derive face quad pos of right element
+      unsigned short l_posR  = C_ENT[TL_T_EL].N_FACES;
+      l_posR                += i_faIdR * CE_N_FACE_VERTEX_OPTS(TL_T_EL);
+      l_posR                += i_vIdR;
+
+      for( int_md l_qp = 0; l_qp < TL_N_FACE_QUAD_POINTS; l_qp++ ) {
+        // compute the contribution of this quad point
+        // remark: due to linear fluxes, the flux computation is applied at the very end.
+        for( int_qt l_qt = 0; l_qt < TL_N_QU; l_qt++ ) {
+          for( int_md l_md = 0; l_md < TL_N_ELEMENT_MODES; l_md++ ) {
+            // precompute weights
+            TL_T_REAL l_weightL = i_weightsFaces[l_qp] *              // weight of the face
+                                  i_basisFaces[i_faIdL][l_qp][l_md] * // test function
+                                  i_massI[l_md];                      // inverse mass matrix
+
+            TL_T_REAL l_weightR = i_weightsFaces[l_qp] *              // weight of the face
+                                  i_basisFaces[l_posR][l_qp][l_md] *  // test function
+                                  i_massI[l_md];                      // inverse mass matrix
+
+            // add contribution
+            for( int_cfr l_ru = 0; l_ru < TL_N_CRUNS; l_ru++ ) {
+              // left-going fluxes are subtracted
+              l_msTmp[0][l_qt][l_md][l_ru] -= l_weightL * i_msL[l_qt][l_ru][i_pt+l_qp];
+              // right-going fluxes are added
+              l_msTmp[1][l_qt][l_md][l_ru] += l_weightR * i_msR[l_qt][l_ru][i_pt+l_qp];
+            }
+          }
+        }
+      }
+
+      // compute fluxes and rotate DOFs back to physical coordinate system
+      linalg::Matrix::matMulB0FusedBC( TL_N_CRUNS,
+                                       TL_N_QU, TL_N_ELEMENT_MODES, TL_N_QU,
+                                       i_solMsFluxL[0],
+                                       l_msTmp[0][0][0],
+                                       o_surfUpdateL[0][0] );
+
+      linalg::Matrix::matMulB0FusedBC( TL_N_CRUNS,
+                                       TL_N_QU, TL_N_ELEMENT_MODES, TL_N_QU,
+                                       i_solMsFluxR[0],
+                                       l_msTmp[1][0][0],
+                                       o_surfUpdateR[0][0] );
+    }
+
     /**
      * Evaluates the internal boundary condition in space at a face of the given element type.
      *
@@ -183,7 +381,7 @@ class edge::elastic::solvers::InternalBoundary {
      * @param io_faData data used in the pertubation of the middle states.
      *
      * @paramt TL_T_REAL floating point type.
-     * @paramt TL_T_MS_SOLV middle state "solver", offers member function .perturb.
+     * @paramt TL_T_MS_SOLV middle state "solver", offers member function .perturbBatch.
      * @paramt TL_T_FA_DATA data passed to middle state solver.
      **/
     template< typename TL_T_REAL,
@@ -205,106 +403,34 @@ class edge::elastic::solvers::InternalBoundary {
                            TL_T_REAL             o_surfUpdateR[TL_N_QU][TL_N_ELEMENT_MODES][TL_N_CRUNS],
                            TL_T_REAL             i_dt = 0,
                            TL_T_FA_DATA         *io_faData = nullptr ) {
-      // temporary storage for the middle states
-      TL_T_REAL l_msTmp[2][TL_N_QU][TL_N_ELEMENT_MODES][TL_N_CRUNS];
-      for( int_qt l_qt = 0; l_qt < TL_N_QU; l_qt++ ) {
-        for( int_md l_md = 0; l_md < TL_N_ELEMENT_MODES; l_md++ ) {
-          for( int_cfr l_ru = 0; l_ru < TL_N_CRUNS; l_ru++ ) {
-            l_msTmp[0][l_qt][l_md][l_ru] = 0;
-            l_msTmp[1][l_qt][l_md][l_ru] = 0;
-          }
-        }
-      }
-
-      // rotate the DOFs from physical coordinates to face-aligned coords
-      // remark: the back-rotation to physical coordinates is part of the the flux solver
-      TL_T_REAL l_dofs[2][TL_N_QU][TL_N_ELEMENT_MODES][TL_N_CRUNS];
-      linalg::Matrix::matMulB0FusedBC( TL_N_CRUNS,
-                                       TL_N_QU, TL_N_ELEMENT_MODES, TL_N_QU,
-                                       i_tm1[0], i_dofsL[0][0], l_dofs[0][0][0] );
-      linalg::Matrix::matMulB0FusedBC( TL_N_CRUNS,
-                                       TL_N_QU, TL_N_ELEMENT_MODES, TL_N_QU,
-                                       i_tm1[0], i_dofsR[0][0], l_dofs[1][0][0] );
-
-      // derive face quad pos of right element
-      unsigned short l_posR  = C_ENT[TL_T_EL].N_FACES;
-      l_posR                += i_faIdR * CE_N_FACE_VERTEX_OPTS(TL_T_EL);
-      l_posR                += i_vIdR;
-
-      // iterate over the quad points in space
-      for( int_md l_qp = 0; l_qp < CE_N_FACE_QUAD_POINTS( TL_T_EL, TL_O_SP ); l_qp++ ) {
-        // temporary values at the quad points
-        TL_T_REAL l_qEv[2][TL_N_QU][TL_N_CRUNS];
-        // jump in quantities
-        TL_T_REAL l_qJump[TL_N_QU][TL_N_CRUNS];
-
-        // eval left and right elements' DOFs at quad points
-        for( int_qt l_qt = 0; l_qt < TL_N_QU; l_qt++ ) {
-          dg::QuadratureEval<TL_T_EL, TL_O_SP, TL_N_CRUNS>::evalBasis( i_basisFaces[i_faIdL][l_qp],
-                                                                       l_dofs[0][l_qt],
-                                                                       l_qEv[0][l_qt] );
-
-          dg::QuadratureEval<TL_T_EL, TL_O_SP, TL_N_CRUNS>::evalBasis( i_basisFaces[l_posR][l_qp],
-                                                                       l_dofs[1][l_qt],
-                                                                       l_qEv[1][l_qt] );
-
-          // compute the jump in quantities
-          for( int_cfr l_ru = 0; l_ru < TL_N_CRUNS; l_ru++ ) {
-            l_qJump[l_qt][l_ru] = l_qEv[1][l_qt][l_ru] - l_qEv[0][l_qt][l_ru];
-          }
-        }
-        // jump over waves with negative speeds from the left to get the left-side middle state
-        linalg::Matrix::matMulB1FusedBC( TL_N_CRUNS,
-                                         TL_N_QU, 1, TL_N_QU,
-                                         i_solMsJumpL[0],
-                                         l_qJump[0],
-                                         l_qEv[0][0] );
-
-         // perturb if necessary
-         TL_T_REAL l_ms[2][TL_N_QU][TL_N_CRUNS];
-         TL_T_MS_SOLV::perturb( l_qp,
-                                i_dt,
-                                l_qEv[0],
-                                io_faData,
-                                l_ms[0],
-                                l_ms[1] );
-
-         // compute the contribution of this quad point
-         // remark: due to linear fluxes, the flux computation is applied at the very end.
-         for( int_qt l_qt = 0; l_qt < TL_N_QU; l_qt++ ) {
-           for( int_md l_md = 0; l_md < TL_N_ELEMENT_MODES; l_md++ ) {
-             // precompute weights
-             TL_T_REAL l_weightL = i_weightsFaces[l_qp] *              // weight of the face
-                                   i_basisFaces[i_faIdL][l_qp][l_md] * // test function
-                                   i_massI[l_md];                      // inverse mass matrix
-
-             TL_T_REAL l_weightR = i_weightsFaces[l_qp] *              // weight of the face
-                                   i_basisFaces[l_posR][l_qp][l_md] *  // test function
-                                   i_massI[l_md];                      // inverse mass matrix
-
-             // add contribution
-             for( int_cfr l_ru = 0; l_ru < TL_N_CRUNS; l_ru++ ) {
-               // left-going fluxes are subtracted
-               l_msTmp[0][l_qt][l_md][l_ru] -= l_weightL * l_ms[0][l_qt][l_ru];
-               // right-going fluxes are added
-               l_msTmp[1][l_qt][l_md][l_ru] += l_weightR * l_ms[1][l_qt][l_ru];
-             }
-           }
-         }
-      }
-
-      // compute fluxes and rotate DOFs back to physical coordinate system
-      linalg::Matrix::matMulB0FusedBC( TL_N_CRUNS,
-                                       TL_N_QU, TL_N_ELEMENT_MODES, TL_N_QU,
-                                       i_solMsFluxL[0],
-                                       l_msTmp[0][0][0],
-                                       o_surfUpdateL[0][0] );
-
-      linalg::Matrix::matMulB0FusedBC( TL_N_CRUNS,
-                                       TL_N_QU, TL_N_ELEMENT_MODES, TL_N_QU,
-                                       i_solMsFluxR[0],
-                                       l_msTmp[1][0][0],
-                                       o_surfUpdateR[0][0] );
+      // middle states at the quad points: [0]: unperturbed, [1]: left side, [2]: right side
+      TL_T_REAL l_ms[3][TL_N_QU][TL_N_CRUNS][TL_N_FACE_QUAD_POINTS];
+
+      evalMsSpace< TL_T_REAL,
+                   TL_N_FACE_QUAD_POINTS >( i_faIdL, i_faIdR, i_vIdR,
+                                            0,
+                                            i_basisFaces,
+                                            i_tm1,
+                                            i_solMsJumpL,
+                                            i_dofsL, i_dofsR,
+                                            l_ms[0] );
+
+      // perturb all quad points of the face at once if necessary
+      TL_T_MS_SOLV::template perturbBatch< TL_T_REAL,
+                                           TL_N_FACE_QUAD_POINTS >( 1,
+                                                                    i_dt,
+                                                                    l_ms[0],
+                                                                    io_faData,
+                                                                    l_ms[1],
+                                                                    l_ms[2] );
+
+      intMsSpace< TL_T_REAL,
+                  TL_N_FACE_QUAD_POINTS >( i_faIdL, i_faIdR, i_vIdR,
+                                           0,
+                                           i_massI, i_weightsFaces, i_basisFaces,
+                                           i_solMsFluxL, i_solMsFluxR,
+                                           l_ms[1], l_ms[2],
+                                           o_surfUpdateL, o_surfUpdateR );
     }
 
     /**
@@ -334,7 +460,7 @@ class edge::elastic::solvers::InternalBoundary {
      * @param o_surfUpdateR will be set to right-going surface update of this part of the internal boundary.
      *
      * @paramt TL_T_REAL floating point type.
-     * @paramt TL_T_MS_SOLV middle state "solver", offers member functions .perturb.
+     * @paramt TL_T_MS_SOLV middle state "solver", offers member function .perturbBatch.
      * @paramt TL_T_FA_DATA data passed to middle state solver.
      **/
     template< typename TL_T_REAL,
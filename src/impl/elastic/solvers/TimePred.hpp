@@ -104,7 +104,7 @@ class edge::elastic::solvers::TimePred {
      * @param i_dofs DOFs.
      * @param i_mm vanilla matrix-matrix multiplication kernels.
      * @param o_scratch will be used as scratch memory.
-     * @param o_der will be set to time derivatives.
+     * @param o_der will be set to time derivatives; only the non-zero modes CE_N_ELEMENT_MODES_CK of every derivative are written.
      * @param o_tInt will be set to time integrated DOFs.
      *
      * @paramt TL_T_REAL floating point type.
@@ -133,12 +133,12 @@ class edge::elastic::solvers::TimePred {
 
       // iterate over time derivatives
       for( unsigned int l_de = 1; l_de < TL_O_TI; l_de++ ) {
-        // reset this derivative
+        // reset the non-zero block of this derivative
         for( int_qt l_qt = 0; l_qt < TL_N_QTS; l_qt++ )
-          for( int_md l_md = 0; l_md < TL_N_MDS; l_md++ )
+          for( int_md l_md = 0; l_md < CE_N_ELEMENT_MODES_CK( TL_T_EL, TL_O_SP, l_de ); l_md++ )
             for( int_cfr l_cr = 0; l_cr < TL_N_CRS; l_cr++ ) o_der[l_de][l_qt][l_md][l_cr] = 0;
 
-        // compute the derivatives
+        // compute the derivatives, the kernels shrink with the non-zero modes of the derivatives
         for( unsigned short l_di = 0; l_di < TL_N_DIM; l_di++ ) {
           // multiply with transposed stiffness matrices and inverse mass matrix
           i_mm.m_kernels[(l_de-1)*2]( o_der[l_de-1][0][0],
@@ -0,0 +1,162 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *
+ * @section DESCRIPTION
+ * Tests the ADER time prediction of the elastic wave equations.
+ **/
+
+#include <catch.hpp>
+#include <random>
+#include <vector>
+#include "TimePred.hpp"
+#include "../setups/MmKernels.hpp"
+
+namespace edge {
+  namespace elastic {
+    namespace solvers {
+      namespace test {
+        /**
+         * Dense reference of the Cauchy–Kowalevski procedure, which uses all modes of all derivatives.
+         *
+         * @param i_nDim number of dimensions.
+         * @param i_nQts number of quantities.
+         * @param i_nMds number of modes.
+         * @param i_nCrs number of fused runs.
+         * @param i_order order of the time prediction.
+         * @param i_dT time step.
+         * @param i_stiffT transposed stiffness matrices.
+         * @param i_star star matrices.
+         * @param i_dofs DOFs.
+         * @param o_tInt will be set to the time integrated DOFs.
+         **/
+        static void ckDense( unsigned short         i_nDim,
+                             unsigned short         i_nQts,
+                             unsigned short         i_nMds,
+                             unsigned short         i_nCrs,
+                             unsigned short         i_order,
+                             real_base              i_dT,
+                             real_base      const * i_stiffT,
+                             real_base      const * i_star,
+                             real_base      const * i_dofs,
+                             real_base            * o_tInt ) {
+          unsigned int l_size = i_nQts * i_nMds * i_nCrs;
+          std::vector< real_base > l_der( i_dofs, i_dofs + l_size );
+          std::vector< real_base > l_derNew( l_size );
+          real_base l_scalar = i_dT;
+
+          for( unsigned int l_en = 0; l_en < l_size; l_en++ ) o_tInt[l_en] = l_scalar * i_dofs[l_en];
+
+          for( unsigned short l_de = 1; l_de < i_order; l_de++ ) {
+            for( unsigned int l_en = 0; l_en < l_size; l_en++ ) l_derNew[l_en] = 0;
+
+            // derivative: sum over the dimensions of star * derivative * transposed stiffness
+            for( unsigned short l_di = 0; l_di < i_nDim; l_di++ )
+              for( unsigned short l_q1 = 0; l_q1 < i_nQts; l_q1++ )
+                for( unsigned short l_q2 = 0; l_q2 < i_nQts; l_q2++ )
+                  for( unsigned short l_k = 0; l_k < i_nMds; l_k++ )
+                    for( unsigned short l_n = 0; l_n < i_nMds; l_n++ )
+                      for( unsigned short l_cr = 0; l_cr < i_nCrs; l_cr++ )
+                        l_derNew[ (l_q1*i_nMds + l_n)*i_nCrs + l_cr ] +=   i_star[ (l_di*i_nQts + l_q1)*i_nQts + l_q2 ]
+                                                                         * l_der[ (l_q2*i_nMds + l_k)*i_nCrs + l_cr ]
+                                                                         * i_stiffT[ (l_di*i_nMds + l_k)*i_nMds + l_n ];
+            l_der = l_derNew;
+
+            l_scalar *= -i_dT / (l_de+1);
+            for( unsigned int l_en = 0; l_en < l_size; l_en++ ) o_tInt[l_en] += l_scalar * l_der[l_en];
+          }
+        }
+
+        /**
+         * Runs the vanilla time prediction with the kernels of the setup and the dense reference on random data.
+         * The stiffness matrices have the sparsity pattern of a hierarchical basis, the star matrices are dense.
+         *
+         * @paramt TL_T_EL element type.
+         * @paramt TL_O order.
+         * @paramt TL_N_CRS number of fused runs.
+         **/
+        template< t_entityType   TL_T_EL,
+                  unsigned short TL_O,
+                  unsigned short TL_N_CRS >
+        static void run() {
+          unsigned short const l_nDim = C_ENT[TL_T_EL].N_DIM;
+          unsigned short const l_nQts = (l_nDim == 2) ? 5 : 9;
+          unsigned short const l_nMds = CE_N_ELEMENT_MODES( TL_T_EL, TL_O );
+          unsigned int   const l_size = l_nQts * l_nMds * TL_N_CRS;
+
+          std::mt19937 l_gen( TL_O );
+          std::uniform_real_distribution< real_base > l_dist( -1.0, 1.0 );
+
+          std::vector< real_base > l_stiffT( l_nDim * l_nMds * l_nMds );
+          std::vector< real_base > l_star( l_nDim * l_nQts * l_nQts );
+          std::vector< real_base > l_dofs( l_size );
+          // the derivative of a mode only has contributions in modes of lower order (hierarchical bases)
+          for( unsigned short l_di = 0; l_di < l_nDim; l_di++ ) {
+            for( unsigned short l_k = 0; l_k < l_nMds; l_k++ ) {
+              unsigned short l_oK = 1;
+              while( CE_N_ELEMENT_MODES( TL_T_EL, l_oK ) <= l_k ) l_oK++;
+
+              for( unsigned short l_n = 0; l_n < l_nMds; l_n++ ) {
+                bool l_nz = l_n < CE_N_ELEMENT_MODES_CK( TL_T_EL, l_oK, 1 );
+                l_stiffT[ (l_di*l_nMds + l_k)*l_nMds + l_n ] = l_nz ? l_dist( l_gen ) : 0;
+              }
+            }
+          }
+          for( std::size_t l_en = 0; l_en < l_star.size(); l_en++ ) l_star[l_en] = l_dist( l_gen );
+          for( std::size_t l_en = 0; l_en < l_dofs.size(); l_en++ ) l_dofs[l_en] = l_dist( l_gen );
+
+          data::MmVanilla< real_base > l_mm;
+          setups::MmKernels::add( TL_T_EL, TL_O, l_nQts, TL_N_CRS, l_mm );
+
+          std::vector< real_base > l_scratch( l_size ), l_der( TL_O * l_size );
+          std::vector< real_base > l_tInt( l_size ), l_tIntRef( l_size );
+
+          real_base l_dT = 0.1;
+          TimePred< TL_T_EL, l_nQts, TL_O, TL_O, TL_N_CRS >::ck( l_dT,
+                                                                 (real_base (*)[l_nMds][l_nMds]) l_stiffT.data(),
+                                                                 (real_base (*)[l_nQts][l_nQts]) l_star.data(),
+                                                                 (real_base (*)[l_nMds][TL_N_CRS]) l_dofs.data(),
+                                                                 l_mm,
+                                                                 (real_base (*)[l_nMds][TL_N_CRS]) l_scratch.data(),
+                                                                 (real_base (*)[l_nQts][l_nMds][TL_N_CRS]) l_der.data(),
+                                                                 (real_base (*)[l_nMds][TL_N_CRS]) l_tInt.data() );
+
+          ckDense( l_nDim, l_nQts, l_nMds, TL_N_CRS, TL_O, l_dT,
+                   l_stiffT.data(), l_star.data(), l_dofs.data(), l_tIntRef.data() );
+
+          for( unsigned int l_en = 0; l_en < l_size; l_en++ )
+            REQUIRE( l_tInt[l_en] == Approx( l_tIntRef[l_en] ).margin( 1E-10 ) );
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE( "TimePred: Vanilla Cauchy–Kowalevski procedure against a dense reference.", "[elastic][TimePred]" ) {
+  edge::elastic::solvers::test::run< TRIA3,  1, 1 >();
+  edge::elastic::solvers::test::run< TRIA3,  3, 1 >();
+  edge::elastic::solvers::test::run< TRIA3,  5, 1 >();
+  edge::elastic::solvers::test::run< QUAD4R, 4, 1 >();
+  edge::elastic::solvers::test::run< TET4,   2, 1 >();
+  edge::elastic::solvers::test::run< TET4,   4, 1 >();
+  edge::elastic::solvers::test::run< TET4,   5, 1 >();
+  edge::elastic::solvers::test::run< TET4,   3, 4 >();
+  edge::elastic::solvers::test::run< HEX8R,  3, 2 >();
+}
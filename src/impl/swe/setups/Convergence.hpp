@@ -95,6 +95,53 @@ class edge::swe::setups::Convergence {
         }
       }
     }
+#elif defined PP_T_ELEMENTS_TRIA3 || defined PP_T_ELEMENTS_QUAD4R
+    /**
+     * Sets a radial dam break problem.
+     * Elements with centroids inside the circle are initialized with the inner water height.
+     *
+     * @param i_cfr concurrent forward run.
+     * @param i_nElements number of elements.
+     * @param i_connElVe connectivity information from elements to vertices.
+     * @param i_vertexChars vertex characteristics.
+     * @param i_centerX x-coordinate of the circle's center.
+     * @param i_centerY y-coordinate of the circle's center.
+     * @param i_radius radius of the circle.
+     * @param i_hIn water height inside the circle.
+     * @param i_hOut water height outside the circle.
+     * @param o_b will be set to bathymetry.
+     * @param o_dofs will be set to dofs.
+     **/
+    static void setDamBreak2D(       int_cfr          i_cfr,
+                                     int_el           i_nElements,
+                               const int_el         (*i_connElVe)[C_ENT[T_SDISC.ELEMENT].N_VERTICES],
+                               const t_vertexChars   *i_vertexChars,
+                                     real_mesh        i_centerX,
+                                     real_mesh        i_centerY,
+                                     real_mesh        i_radius,
+                                     real_base        i_hIn,
+                                     real_base        i_hOut,
+                                     real_base      (*o_b)[1][1],
+                                     real_base      (*o_dofs)[N_QUANTITIES][1][N_CRUNS] ) {
+      for( int_el l_el = 0; l_el < i_nElements; l_el++ ) {
+        // derive the centroid
+        real_mesh l_cX = 0;
+        real_mesh l_cY = 0;
+        for( unsigned short l_ve = 0; l_ve < C_ENT[T_SDISC.ELEMENT].N_VERTICES; l_ve++ ) {
+          l_cX += i_vertexChars[ i_connElVe[l_el][l_ve] ].coords[0];
+          l_cY += i_vertexChars[ i_connElVe[l_el][l_ve] ].coords[1];
+        }
+        l_cX /= C_ENT[T_SDISC.ELEMENT].N_VERTICES;
+        l_cY /= C_ENT[T_SDISC.ELEMENT].N_VERTICES;
+
+        real_mesh l_dist2 = (l_cX-i_centerX)*(l_cX-i_centerX) + (l_cY-i_centerY)*(l_cY-i_centerY);
+
+        o_dofs[l_el][0][0][i_cfr] = ( l_dist2 < i_radius*i_radius ) ? i_hIn : i_hOut;
+        o_dofs[l_el][1][0][i_cfr] = 0;
+        o_dofs[l_el][2][0][i_cfr] = 0;
+        o_b[l_el][0][0] = 0;
+      }
+    }
 #else
 #error element type not supported.
 #endif
@@ -24,6 +24,8 @@
 #define FINITE_VOLUME_HPP
 
 #include <cmath>
+#include <limits>
+#include <algorithm>
 #include "constants.hpp"
 #include "Fwave.hpp"
 
@@ -40,26 +42,28 @@ class edge::swe::solvers::FiniteVolume {
     /**
      * Computes the CFL time step for the given element.
      * @param i_h water height.
-     * @param i_hu momentum.
-     * @param i_volume volume of the element.
-     * @param i_g gravity.
+     * @param i_hu momentum in x-direction.
+     * @param i_hv momentum in y-direction.
+     * @param i_length characteristic length of the element, see cflLength.
      * @param i_cfl cfl number.
+     * @param i_g gravity.
      **/
     static double computeCflTimeStep( double i_h,
                                       double i_hu,
-                                      double i_volume, 
-                                      double i_g = 9.81,
-                                      double i_cfl = 0.4 ) {
+                                      double i_hv,
+                                      double i_length,
+                                      double i_cfl,
+                                      double i_g = 9.81 ) {
       // only elements with water are updated
       if( i_h > 0 ) {
         // compute particle velocity
-        double l_u = i_hu / i_h;
+        double l_u = std::sqrt( i_hu*i_hu + i_hv*i_hv ) / i_h;
 
         // compute maximum, absolute wave speed
         double l_s = std::abs( l_u ) + std::sqrt( i_g * i_h );
 
         // compute time step
-        double l_dT  = ( i_volume / l_s );
+        double l_dT  = ( i_length / l_s );
                l_dT *= i_cfl;
 
         return l_dT;
@@ -69,6 +73,20 @@ class edge::swe::solvers::FiniteVolume {
       }
     }
 
+    /**
+     * Gets the characteristic length of an element in the CFL condition.
+     * This is the volume in 1D and a quarter of the insphere diameter in 2D, which is a lower bound of the ratio of the
+     * volume and the sum of the face areas: for triangles the insphere diameter is exactly 4*volume/perimeter,
+     * for rectangles it is the shorter edge.
+     *
+     * @param i_elChars characteristics of the element.
+     * @return characteristic length.
+     **/
+    static double cflLength( t_elementChars const & i_elChars ) {
+      if( N_DIM == 1 ) return i_elChars.volume;
+      else             return i_elChars.inDia * 0.25;
+    }
+
   public:
     /**
      * Gets the time step statistics according to the CFL-criterion for the entire mesh across all concurrent runs.
@@ -98,7 +116,9 @@ class edge::swe::solvers::FiniteVolume {
         for( int_cfr l_run = 0; l_run < N_CRUNS; l_run++ ) {
           l_cDt = std::min( l_cDt, computeCflTimeStep( i_elementModePrivate[l_element][0][0][l_run],
                                                        i_elementModePrivate[l_element][1][0][l_run],
-                                                       i_elementChars[l_element].volume )               );
+                                                       (N_QUANTITIES > 2) ? i_elementModePrivate[l_element][N_QUANTITIES-1][0][l_run] : 0,
+                                                       cflLength( i_elementChars[l_element] ),
+                                                       SCALE_CFL )                                        );
         }
 
         // add element to stats
@@ -112,27 +132,35 @@ class edge::swe::solvers::FiniteVolume {
     }
 
    /**
-    * Computes the net-updates for the given faces using the f-wave solver.
+    * Computes the net-updates for the given faces using the f-wave solver, face by face.
+    * This is the default in 1D and the reference of netUpdates, which is used if built with fwave_batch.
     *
     * @param i_first first face.
     * @param i_size number of faces after first.
     * @param i_faEl faces adjacent to elements.
+    * @param i_elChars element characteristics.
     * @param i_dofs degrees of freedom (height, momentum).
     * @param i_bath bathymetry for the elements.
     * @param o_netUpdate will be set to the net-updates for the faces' adjacent elements.
-    *
+    * @param i_cfl cfl number.
+    * @return minimum CFL time step of the faces' adjacent elements, based on the wave speeds of the f-wave solver.
     **/
-   static void netUpdates(       int_el      i_first,
-                                 int_el      i_size,
-                           const int_el    (*i_faEl)[2],
-                           const real_base (*i_dofs)[N_QUANTITIES][1][N_CRUNS],
-                           const real_base (*i_bath)[1][1],
-                                 real_base (*o_netUpdates)[4][1][N_CRUNS] ) {
+   static double netUpdatesScalar(       int_el           i_first,
+                                         int_el           i_size,
+                                   const int_el         (*i_faEl)[2],
+                                   const t_elementChars  *i_elChars,
+                                   const real_base      (*i_dofs)[N_QUANTITIES][1][N_CRUNS],
+                                   const real_base      (*i_bath)[1][1],
+                                         real_base      (*o_netUpdates)[4][1][N_CRUNS],
+                                         double           i_cfl ) {
 #if __has_builtin(__builtin_assume_aligned)
       // share alignment with compiler
       (void) __builtin_assume_aligned(i_dofs, ALIGNMENT.ELEMENT_MODES.PRIVATE);
       (void) __builtin_assume_aligned(o_netUpdates, ALIGNMENT.CRUNS);
 #endif
+      // maximum ratio of wave speed and element volume
+      double l_maxRatio = 0;
+
       // compute net-updates
       for( int_el l_fa = i_first; l_fa < i_first+i_size; l_fa++ ) {
         // determine neighbors
@@ -140,30 +168,246 @@ class edge::swe::solvers::FiniteVolume {
         int_el l_ri = i_faEl[l_fa][1];
 
         // compute net-updates
-        solvers::Fwave::computeNetUpdates( i_dofs[l_le][0],    i_dofs[l_ri][0],
-                                           i_dofs[l_le][1],    i_dofs[l_ri][1],
-                                           i_bath[l_le][0][0], i_bath[l_ri][0][0],
-                                           o_netUpdates[ l_fa] );
+        double l_speed = solvers::Fwave::computeNetUpdates( i_dofs[l_le][0],    i_dofs[l_ri][0],
+                                                            i_dofs[l_le][1],    i_dofs[l_ri][1],
+                                                            i_bath[l_le][0][0], i_bath[l_ri][0][0],
+                                                            o_netUpdates[ l_fa] );
+
+        double l_length = std::min( cflLength( i_elChars[l_le] ), cflLength( i_elChars[l_ri] ) );
+        l_maxRatio = std::max( l_maxRatio, l_speed / l_length );
+      }
+
+      if( l_maxRatio > 0 ) return i_cfl / l_maxRatio;
+      else                 return std::numeric_limits< double >::max();
+   }
+
+   /**
+    * Computes the net-updates for the given faces using the f-wave solver.
+    * The states of N_FACES_BATCH faces are gathered to structure of arrays and solved by the vectorized, batched kernel.
+    *
+    * @param i_first first face.
+    * @param i_size number of faces after first.
+    * @param i_faEl faces adjacent to elements.
+    * @param i_elChars element characteristics.
+    * @param i_dofs degrees of freedom (height, momentum).
+    * @param i_bath bathymetry for the elements.
+    * @param o_netUpdate will be set to the net-updates for the faces' adjacent elements.
+    * @param i_cfl cfl number.
+    * @return minimum CFL time step of the faces' adjacent elements, based on the wave speeds of the f-wave solver.
+    **/
+   static double netUpdates(       int_el           i_first,
+                                   int_el           i_size,
+                             const int_el         (*i_faEl)[2],
+                             const t_elementChars  *i_elChars,
+                             const real_base      (*i_dofs)[N_QUANTITIES][1][N_CRUNS],
+                             const real_base      (*i_bath)[1][1],
+                                   real_base      (*o_netUpdates)[4][1][N_CRUNS],
+                                   double           i_cfl ) {
+#if __has_builtin(__builtin_assume_aligned)
+      // share alignment with compiler
+      (void) __builtin_assume_aligned(i_dofs, ALIGNMENT.ELEMENT_MODES.PRIVATE);
+      (void) __builtin_assume_aligned(o_netUpdates, ALIGNMENT.CRUNS);
+#endif
+      // gathered states of the batch, [face][crun]
+      real_base l_hL[ N_FACES_BATCH*N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
+      real_base l_hR[ N_FACES_BATCH*N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
+      real_base l_huL[N_FACES_BATCH*N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
+      real_base l_huR[N_FACES_BATCH*N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
+      real_base l_bL[ N_FACES_BATCH*N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
+      real_base l_bR[ N_FACES_BATCH*N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
+
+      // net-updates and wave speeds of the batch
+      real_base l_nu[4][N_FACES_BATCH*N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
+      real_base l_speeds[N_FACES_BATCH*N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
+
+      // maximum ratio of wave speed and element volume
+      double l_maxRatio = 0;
+
+      for( int_el l_f0 = i_first; l_f0 < i_first+i_size; l_f0 += N_FACES_BATCH ) {
+        unsigned int l_nFa = std::min( int_el(N_FACES_BATCH), i_first+i_size-l_f0 );
+
+        // gather the states
+        for( unsigned int l_fb = 0; l_fb < l_nFa; l_fb++ ) {
+          int_el l_le = i_faEl[l_f0+l_fb][0];
+          int_el l_ri = i_faEl[l_f0+l_fb][1];
+
+          for( int_cfr l_ru = 0; l_ru < N_CRUNS; l_ru++ ) {
+            unsigned int l_en = l_fb*N_CRUNS + l_ru;
+            l_hL[l_en]  = i_dofs[l_le][0][0][l_ru];
+            l_hR[l_en]  = i_dofs[l_ri][0][0][l_ru];
+            l_huL[l_en] = i_dofs[l_le][1][0][l_ru];
+            l_huR[l_en] = i_dofs[l_ri][1][0][l_ru];
+            l_bL[l_en]  = i_bath[l_le][0][0];
+            l_bR[l_en]  = i_bath[l_ri][0][0];
+          }
+        }
+
+        // solve the batch
+        solvers::Fwave::computeNetUpdatesBatch( l_nFa*N_CRUNS,
+                                                l_hL,  l_hR,
+                                                l_huL, l_huR,
+                                                l_bL,  l_bR,
+                                                l_nu,
+                                                l_speeds );
+
+        // scatter the net-updates
+        for( unsigned int l_fb = 0; l_fb < l_nFa; l_fb++ ) {
+          int_el l_fa = l_f0+l_fb;
+          double l_length = std::min( cflLength( i_elChars[ i_faEl[l_fa][0] ] ),
+                                      cflLength( i_elChars[ i_faEl[l_fa][1] ] ) );
+
+          for( int_cfr l_ru = 0; l_ru < N_CRUNS; l_ru++ ) {
+            unsigned int l_en = l_fb*N_CRUNS + l_ru;
+            for( unsigned short l_nu4 = 0; l_nu4 < 4; l_nu4++ )
+              o_netUpdates[l_fa][l_nu4][0][l_ru] = l_nu[l_nu4][l_en];
+
+            l_maxRatio = std::max( l_maxRatio, l_speeds[l_en] / l_length );
+          }
+        }
       }
+
+      if( l_maxRatio > 0 ) return i_cfl / l_maxRatio;
+      else                 return std::numeric_limits< double >::max();
    }
 
+#if PP_N_DIM == 2
+   /**
+    * Computes the net-updates for the given faces of a two-dimensional mesh using the rotated f-wave solver.
+    * The momenta of N_FACES_BATCH faces are rotated to the faces' normal and tangential directions,
+    * solved by the vectorized, batched kernel and rotated back.
+    * Boundary faces use a ghost state: reflected normal momentum for walls, a copy of the state otherwise (outflow).
+    *
+    * @param i_first first face.
+    * @param i_size number of faces after first.
+    * @param i_faEl elements adjacent to the faces.
+    * @param i_faChars face characteristics.
+    * @param i_elChars element characteristics.
+    * @param i_dofs degrees of freedom (height, momenta).
+    * @param i_bath bathymetry for the elements.
+    * @param o_netUpdate will be set to the net-updates for the faces' adjacent elements.
+    * @param i_cfl cfl number.
+    * @return minimum CFL time step of the faces' adjacent elements, based on the wave speeds of the f-wave solver.
+    **/
+   static double netUpdatesRot(       int_el           i_first,
+                                      int_el           i_size,
+                                const int_el         (*i_faEl)[2],
+                                const t_faceChars     *i_faChars,
+                                const t_elementChars  *i_elChars,
+                                const real_base      (*i_dofs)[N_QUANTITIES][1][N_CRUNS],
+                                const real_base      (*i_bath)[1][1],
+                                      real_base      (*o_netUpdates)[2*N_QUANTITIES][1][N_CRUNS],
+                                      double           i_cfl ) {
+#if __has_builtin(__builtin_assume_aligned)
+      // share alignment with compiler
+      (void) __builtin_assume_aligned(i_dofs, ALIGNMENT.ELEMENT_MODES.PRIVATE);
+      (void) __builtin_assume_aligned(o_netUpdates, ALIGNMENT.CRUNS);
+#endif
+      // gathered states of the batch in the faces' coordinate systems, [face][crun]
+      real_base l_h[2][  N_FACES_BATCH*N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
+      real_base l_huN[2][N_FACES_BATCH*N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
+      real_base l_huT[2][N_FACES_BATCH*N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
+      real_base l_b[2][  N_FACES_BATCH*N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
+
+      // net-updates and wave speeds of the batch
+      real_base l_nu[6][N_FACES_BATCH*N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
+      real_base l_speeds[N_FACES_BATCH*N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
+
+      // maximum ratio of wave speed and characteristic length
+      double l_maxRatio = 0;
+
+      for( int_el l_f0 = i_first; l_f0 < i_first+i_size; l_f0 += N_FACES_BATCH ) {
+        unsigned int l_nFa = std::min( int_el(N_FACES_BATCH), i_first+i_size-l_f0 );
+
+        // gather and rotate the states
+        for( unsigned int l_fb = 0; l_fb < l_nFa; l_fb++ ) {
+          int_el l_fa = l_f0+l_fb;
+          real_base l_nX = i_faChars[l_fa].outNormal[0];
+          real_base l_nY = i_faChars[l_fa].outNormal[1];
+
+          bool l_bnd  = i_faEl[l_fa][1] == std::numeric_limits< int_el >::max();
+          bool l_wall = l_bnd && ( (i_faChars[l_fa].spType & WALL) == WALL );
+
+          for( unsigned short l_sd = 0; l_sd < 2; l_sd++ ) {
+            // boundary faces use the left element for the ghost state
+            int_el l_el = ( l_sd == 1 && l_bnd ) ? i_faEl[l_fa][0] : i_faEl[l_fa][l_sd];
+            real_base l_sign = ( l_sd == 1 && l_wall ) ? -1 : 1;
+
+            for( int_cfr l_ru = 0; l_ru < N_CRUNS; l_ru++ ) {
+              unsigned int l_en = l_fb*N_CRUNS + l_ru;
+              real_base l_hu = i_dofs[l_el][1][0][l_ru];
+              real_base l_hv = i_dofs[l_el][2][0][l_ru];
+
+              l_h[l_sd][l_en]   = i_dofs[l_el][0][0][l_ru];
+              l_huN[l_sd][l_en] = l_sign * (  l_hu * l_nX + l_hv * l_nY );
+              l_huT[l_sd][l_en] =            -l_hu * l_nY + l_hv * l_nX;
+              l_b[l_sd][l_en]   = i_bath[l_el][0][0];
+            }
+          }
+        }
+
+        // solve the batch
+        solvers::Fwave::computeNetUpdatesBatchRot( l_nFa*N_CRUNS,
+                                                   l_h[0],   l_h[1],
+                                                   l_huN[0], l_huN[1],
+                                                   l_huT[0], l_huT[1],
+                                                   l_b[0],   l_b[1],
+                                                   l_nu,
+                                                   l_speeds );
+
+        // rotate back and scatter the net-updates
+        for( unsigned int l_fb = 0; l_fb < l_nFa; l_fb++ ) {
+          int_el l_fa = l_f0+l_fb;
+          real_base l_nX = i_faChars[l_fa].outNormal[0];
+          real_base l_nY = i_faChars[l_fa].outNormal[1];
+
+          int_el l_ri = i_faEl[l_fa][1];
+          if( l_ri == std::numeric_limits< int_el >::max() ) l_ri = i_faEl[l_fa][0];
+          double l_length = std::min( cflLength( i_elChars[ i_faEl[l_fa][0] ] ),
+                                      cflLength( i_elChars[ l_ri ] ) );
+
+          for( int_cfr l_ru = 0; l_ru < N_CRUNS; l_ru++ ) {
+            unsigned int l_en = l_fb*N_CRUNS + l_ru;
+
+            for( unsigned short l_sd = 0; l_sd < 2; l_sd++ ) {
+              o_netUpdates[l_fa][l_sd*3+0][0][l_ru] =  l_nu[l_sd*3+0][l_en];
+              o_netUpdates[l_fa][l_sd*3+1][0][l_ru] =  l_nu[l_sd*3+1][l_en] * l_nX
+                                                     - l_nu[l_sd*3+2][l_en] * l_nY;
+              o_netUpdates[l_fa][l_sd*3+2][0][l_ru] =  l_nu[l_sd*3+1][l_en] * l_nY
+                                                     + l_nu[l_sd*3+2][l_en] * l_nX;
+            }
+
+            l_maxRatio = std::max( l_maxRatio, l_speeds[l_en] / l_length );
+          }
+        }
+      }
+
+      if( l_maxRatio > 0 ) return i_cfl / l_maxRatio;
+      else                 return std::numeric_limits< double >::max();
+   }
+#endif
+
     /**
      * Updates the elements with net-update contribution within a time step.
+     * Elements left of a face (w.r.t. the face's normal) receive the left-going, elements right of a face the right-going net-updates.
      *
-     * @param i_first first face.
-     * @param i_size number of faces after first.
+     * @param i_first first element.
+     * @param i_size number of elements after first.
      * @param i_dT time step.
      * @param i_elFa ids of faces adjacent to the elements.
+     * @param i_faEl ids of elements adjacent to the faces.
+     * @param i_faChars face characteristics.
      * @param i_elChars element characteristics.
-     * @param i_netUpdates of face-local net-updates, private for conurrent runs.
+     * @param i_netUpdates of face-local net-updates, [*][]: left-going quantities, right-going quantities, private for conurrent runs.
      * @param io_dofs DOFs: shallow water quantities in the elements, private for concurrent runs.
      **/
     static void update(       int_el                   i_first,
                               int_el                   i_size,
                               double                   i_dT,
                         const int_el                 (*i_elFa)[C_ENT[T_SDISC.ELEMENT].N_FACES],
+                        const int_el                 (*i_faEl)[2],
+                        const t_faceChars             *i_faChars,
                         const t_elementChars          *i_elChars,
-                        const real_base              (*i_netUpdates)[4][1][N_CRUNS],
+                        const real_base              (*i_netUpdates)[2*N_QUANTITIES][1][N_CRUNS],
                               real_base              (*io_dofs)[N_QUANTITIES][1][N_CRUNS] ) {
 #if __has_builtin(__builtin_assume_aligned)
       // share alignment with compiler
@@ -171,26 +415,23 @@ class edge::swe::solvers::FiniteVolume {
       (void) __builtin_assume_aligned(io_dofs, ALIGNMENT.ELEMENT_MODES.PRIVATE);
 #endif
 
-
-
       // update the elements
       for( int_el l_el = i_first; l_el < i_first+i_size; l_el++ ) {
-        // determine adjacent faces
-        int_el l_left  = i_elFa[l_el][0];
-        int_el l_right = i_elFa[l_el][1];
+        for( unsigned short l_fa = 0; l_fa < C_ENT[T_SDISC.ELEMENT].N_FACES; l_fa++ ) {
+          int_el l_faId = i_elFa[l_el][l_fa];
+
+          // right-going net-updates if the element is right of the face
+          unsigned short l_off = ( i_faEl[l_faId][0] == l_el ) ? 0 : N_QUANTITIES;
 
-        // scale update (dt / dx)
-        real_base l_scalar = i_dT * (1/i_elChars[l_el].volume);
+          // scale update (dt * area / volume)
+          real_base l_scalar = i_dT * i_faChars[l_faId].area / i_elChars[l_el].volume;
 
+          for( unsigned short l_qt = 0; l_qt < N_QUANTITIES; l_qt++ ) {
 #pragma omp simd
-        for( int_cfr l_ru = 0; l_ru < N_CRUNS; l_ru++ ) {
-          // right-going from the left
-          io_dofs[l_el][0][0][l_ru] -= l_scalar * i_netUpdates[l_left][2][0][l_ru];
-          io_dofs[l_el][1][0][l_ru] -= l_scalar * i_netUpdates[l_left][3][0][l_ru];
-
-          // left-going from the right
-          io_dofs[l_el][0][0][l_ru] -= l_scalar * i_netUpdates[l_right][0][0][l_ru];
-          io_dofs[l_el][1][0][l_ru] -= l_scalar * i_netUpdates[l_right][1][0][l_ru];
+            for( int_cfr l_ru = 0; l_ru < N_CRUNS; l_ru++ ) {
+              io_dofs[l_el][l_qt][0][l_ru] -= l_scalar * i_netUpdates[l_faId][l_off+l_qt][0][l_ru];
+            }
+          }
         }
       }
     }
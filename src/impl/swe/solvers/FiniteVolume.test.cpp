@@ -0,0 +1,326 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Tests the finite volume solver for the shallow water equations.
+ **/
+
+#include <catch.hpp>
+#include <random>
+#include <iostream>
+#include "FiniteVolume.hpp"
+#include "monitor/Timer.hpp"
+
+namespace edge {
+  namespace swe {
+    namespace solvers {
+      namespace test {
+        /**
+         * Initializes a random, wet line of elements with periodically connected faces.
+         *
+         * @param i_nEls number of elements (and faces).
+         * @param o_faEl will be set to the elements adjacent to the faces.
+         * @param o_elChars will be set to the element characteristics.
+         * @param o_dofs will be set to the DOFs.
+         * @param o_bath will be set to the bathymetry.
+         **/
+        static void initLine( int_el                          i_nEls,
+                              std::vector< int_el >         & o_faEl,
+                              std::vector< t_elementChars > & o_elChars,
+                              std::vector< real_base >      & o_dofs,
+                              std::vector< real_base >      & o_bath ) {
+          std::mt19937 l_gen( 42 );
+          std::uniform_real_distribution< double > l_h(  1.0, 10.0 );
+          std::uniform_real_distribution< double > l_hu( -5.0,  5.0 );
+          std::uniform_real_distribution< double > l_b(  -1.0,  1.0 );
+          std::uniform_real_distribution< double > l_vol( 0.5,  2.0 );
+
+          o_faEl.resize( 2*i_nEls );
+          o_elChars.resize( i_nEls );
+          o_dofs.resize( i_nEls*N_QUANTITIES*N_CRUNS );
+          o_bath.resize( i_nEls );
+
+          for( int_el l_el = 0; l_el < i_nEls; l_el++ ) {
+            o_faEl[l_el*2+0] = l_el;
+            o_faEl[l_el*2+1] = (l_el+1) % i_nEls;
+
+            o_elChars[l_el].volume = l_vol( l_gen );
+            o_elChars[l_el].inDia  = o_elChars[l_el].volume;
+            o_bath[l_el] = l_b( l_gen );
+
+            for( int_cfr l_ru = 0; l_ru < N_CRUNS; l_ru++ ) {
+              o_dofs[(l_el*N_QUANTITIES+0)*N_CRUNS + l_ru] = l_h(  l_gen );
+              o_dofs[(l_el*N_QUANTITIES+1)*N_CRUNS + l_ru] = l_hu( l_gen );
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE( "FiniteVolume: Batched and scalar net-updates.", "[FiniteVolume][netUpdates]" ) {
+  // number of elements, not a multiple of the batch size
+  int_el l_nEls = 10*N_FACES_BATCH+3;
+
+  std::vector< int_el > l_faEl;
+  std::vector< t_elementChars > l_elChars;
+  std::vector< real_base > l_dofs, l_bath;
+  edge::swe::solvers::test::initLine( l_nEls, l_faEl, l_elChars, l_dofs, l_bath );
+
+  std::vector< real_base > l_nuSc( l_nEls*4*N_CRUNS, 0 );
+  std::vector< real_base > l_nuBa( l_nEls*4*N_CRUNS, 0 );
+
+  // use an offset to cover a partial first batch
+  for( int_el l_first = 0; l_first < 2; l_first++ ) {
+    double l_dTsc = edge::swe::solvers::FiniteVolume::netUpdatesScalar( l_first,
+                                                                        l_nEls-l_first,
+                                                                        (int_el (*)[2]) l_faEl.data(),
+                                                                        l_elChars.data(),
+                                                                        (real_base (*)[N_QUANTITIES][1][N_CRUNS]) l_dofs.data(),
+                                                                        (real_base (*)[1][1]) l_bath.data(),
+                                                                        (real_base (*)[4][1][N_CRUNS]) l_nuSc.data(),
+                                                                        SCALE_CFL );
+
+    double l_dTba = edge::swe::solvers::FiniteVolume::netUpdates( l_first,
+                                                                  l_nEls-l_first,
+                                                                  (int_el (*)[2]) l_faEl.data(),
+                                                                  l_elChars.data(),
+                                                                  (real_base (*)[N_QUANTITIES][1][N_CRUNS]) l_dofs.data(),
+                                                                  (real_base (*)[1][1]) l_bath.data(),
+                                                                  (real_base (*)[4][1][N_CRUNS]) l_nuBa.data(),
+                                                                  SCALE_CFL );
+
+    REQUIRE( l_dTba == Approx( l_dTsc ) );
+    REQUIRE( l_dTba > 0 );
+
+    for( std::size_t l_en = 0; l_en < l_nuSc.size(); l_en++ ) {
+      REQUIRE( l_nuBa[l_en] == Approx( l_nuSc[l_en] ) );
+    }
+  }
+}
+
+TEST_CASE( "FiniteVolume: Lake at rest with varying bathymetry.", "[FiniteVolume][wellBalanced]" ) {
+  int_el l_nEls = 4*N_FACES_BATCH+1;
+
+  std::vector< int_el > l_faEl;
+  std::vector< t_elementChars > l_elChars;
+  std::vector< real_base > l_dofs, l_bath;
+  edge::swe::solvers::test::initLine( l_nEls, l_faEl, l_elChars, l_dofs, l_bath );
+
+  // constant surface elevation, fluid at rest
+  for( int_el l_el = 0; l_el < l_nEls; l_el++ ) {
+    for( int_cfr l_ru = 0; l_ru < N_CRUNS; l_ru++ ) {
+      l_dofs[(l_el*N_QUANTITIES+0)*N_CRUNS + l_ru] = 2 - l_bath[l_el];
+      l_dofs[(l_el*N_QUANTITIES+1)*N_CRUNS + l_ru] = 0;
+    }
+  }
+
+  std::vector< real_base > l_nuSc( l_nEls*4*N_CRUNS, 1 );
+  std::vector< real_base > l_nuBa( l_nEls*4*N_CRUNS, 1 );
+
+  edge::swe::solvers::FiniteVolume::netUpdatesScalar( 0,
+                                                      l_nEls,
+                                                      (int_el (*)[2]) l_faEl.data(),
+                                                      l_elChars.data(),
+                                                      (real_base (*)[N_QUANTITIES][1][N_CRUNS]) l_dofs.data(),
+                                                      (real_base (*)[1][1]) l_bath.data(),
+                                                      (real_base (*)[4][1][N_CRUNS]) l_nuSc.data(),
+                                                      SCALE_CFL );
+
+  edge::swe::solvers::FiniteVolume::netUpdates( 0,
+                                                l_nEls,
+                                                (int_el (*)[2]) l_faEl.data(),
+                                                l_elChars.data(),
+                                                (real_base (*)[N_QUANTITIES][1][N_CRUNS]) l_dofs.data(),
+                                                (real_base (*)[1][1]) l_bath.data(),
+                                                (real_base (*)[4][1][N_CRUNS]) l_nuBa.data(),
+                                                SCALE_CFL );
+
+  for( std::size_t l_en = 0; l_en < l_nuSc.size(); l_en++ ) {
+    REQUIRE( l_nuSc[l_en] == Approx(0).margin(1E-10) );
+    REQUIRE( l_nuBa[l_en] == Approx(0).margin(1E-10) );
+  }
+}
+
+TEST_CASE( "FiniteVolume: Dry states in the batched f-wave solver.", "[FiniteVolume][dry]" ) {
+  real_base l_h[2]  = { 0, 0 };
+  real_base l_hu[2] = { 0, 0 };
+  real_base l_b[2]  = { 0, 0 };
+  real_base l_nu[4][N_FACES_BATCH*N_CRUNS];
+  real_base l_speeds[N_FACES_BATCH*N_CRUNS];
+
+  // two dry elements
+  edge::swe::solvers::Fwave::computeNetUpdatesBatch( 1, l_h, l_h+1, l_hu, l_hu+1, l_b, l_b+1, l_nu, l_speeds );
+  for( unsigned short l_nu4 = 0; l_nu4 < 4; l_nu4++ ) REQUIRE( l_nu[l_nu4][0] == 0 );
+  REQUIRE( l_speeds[0] == 0 );
+
+  // dry-wet: finite updates
+  l_h[1] = 2;
+  edge::swe::solvers::Fwave::computeNetUpdatesBatch( 1, l_h, l_h+1, l_hu, l_hu+1, l_b, l_b+1, l_nu, l_speeds );
+  for( unsigned short l_nu4 = 0; l_nu4 < 4; l_nu4++ ) REQUIRE( std::isfinite( l_nu[l_nu4][0] ) );
+  REQUIRE( l_speeds[0] == Approx( std::sqrt( 9.81*2 ) ) );
+}
+
+TEST_CASE( "FiniteVolume: Throughput of the batched and scalar net-updates.", "[.][FiniteVolume][bench]" ) {
+  int_el l_nEls = 1024*1024;
+  unsigned int l_nReps = 20;
+
+  std::vector< int_el > l_faEl;
+  std::vector< t_elementChars > l_elChars;
+  std::vector< real_base > l_dofs, l_bath;
+  edge::swe::solvers::test::initLine( l_nEls, l_faEl, l_elChars, l_dofs, l_bath );
+  std::vector< real_base > l_nu( l_nEls*4*N_CRUNS, 0 );
+
+  edge::monitor::Timer l_timer;
+  double l_dT = 0;
+
+  for( unsigned short l_ba = 0; l_ba < 2; l_ba++ ) {
+    l_timer.start();
+    for( unsigned int l_re = 0; l_re < l_nReps; l_re++ ) {
+      if( l_ba == 0 ) l_dT += edge::swe::solvers::FiniteVolume::netUpdatesScalar( 0, l_nEls,
+                                                                                (int_el (*)[2]) l_faEl.data(),
+                                                                                l_elChars.data(),
+                                                                                (real_base (*)[N_QUANTITIES][1][N_CRUNS]) l_dofs.data(),
+                                                                                (real_base (*)[1][1]) l_bath.data(),
+                                                                                (real_base (*)[4][1][N_CRUNS]) l_nu.data(),
+                                                                                SCALE_CFL );
+      else            l_dT += edge::swe::solvers::FiniteVolume::netUpdates( 0, l_nEls,
+                                                                          (int_el (*)[2]) l_faEl.data(),
+                                                                          l_elChars.data(),
+                                                                          (real_base (*)[N_QUANTITIES][1][N_CRUNS]) l_dofs.data(),
+                                                                          (real_base (*)[1][1]) l_bath.data(),
+                                                                          (real_base (*)[4][1][N_CRUNS]) l_nu.data(),
+                                                                          SCALE_CFL );
+    }
+    l_timer.end();
+
+    std::cout << ( (l_ba == 0) ? "scalar" : "batched" ) << " f-wave: "
+              << double(l_nEls) * l_nReps * N_CRUNS / l_timer.elapsed() << " face-runs/s" << std::endl;
+  }
+
+  REQUIRE( l_dT > 0 );
+}
+
+TEST_CASE( "FiniteVolume: Rotated f-wave solver.", "[FiniteVolume][rot]" ) {
+  real_base l_h[2]    = { 3, 3 };
+  real_base l_huN[2]  = { 0, 0 };
+  real_base l_huT[2]  = { 0, 0 };
+  real_base l_b[2]    = { 0, 0 };
+  real_base l_nu[6][N_FACES_BATCH*N_CRUNS];
+  real_base l_speeds[N_FACES_BATCH*N_CRUNS];
+
+  // lake at rest
+  edge::swe::solvers::Fwave::computeNetUpdatesBatchRot( 1,
+                                                        l_h,   l_h+1,
+                                                        l_huN, l_huN+1,
+                                                        l_huT, l_huT+1,
+                                                        l_b,   l_b+1,
+                                                        l_nu,
+                                                        l_speeds );
+  for( unsigned short l_nu6 = 0; l_nu6 < 6; l_nu6++ ) REQUIRE( l_nu[l_nu6][0] == Approx(0).margin(1E-12) );
+  REQUIRE( l_speeds[0] == Approx( std::sqrt( 9.81*3 ) ) );
+
+  // lake at rest with a step in the bathymetry
+  l_h[0] = 4; l_b[0] = -1;
+  edge::swe::solvers::Fwave::computeNetUpdatesBatchRot( 1,
+                                                        l_h,   l_h+1,
+                                                        l_huN, l_huN+1,
+                                                        l_huT, l_huT+1,
+                                                        l_b,   l_b+1,
+                                                        l_nu,
+                                                        l_speeds );
+  for( unsigned short l_nu6 = 0; l_nu6 < 6; l_nu6++ ) REQUIRE( l_nu[l_nu6][0] == Approx(0).margin(1E-12) );
+
+  // the net-updates sum up to the jump in fluxes
+  l_h[0] = 2;     l_h[1] = 1.5;
+  l_huN[0] = 0.5; l_huN[1] = -0.2;
+  l_huT[0] = 0.3; l_huT[1] = 0.7;
+  l_b[0] = 0;     l_b[1] = 0;
+  edge::swe::solvers::Fwave::computeNetUpdatesBatchRot( 1,
+                                                        l_h,   l_h+1,
+                                                        l_huN, l_huN+1,
+                                                        l_huT, l_huT+1,
+                                                        l_b,   l_b+1,
+                                                        l_nu,
+                                                        l_speeds );
+
+  double l_fJump[3];
+  l_fJump[0] = l_huN[1] - l_huN[0];
+  l_fJump[1] =   l_huN[1]*l_huN[1]/l_h[1] + 0.5*9.81*l_h[1]*l_h[1]
+               - l_huN[0]*l_huN[0]/l_h[0] - 0.5*9.81*l_h[0]*l_h[0];
+  l_fJump[2] = l_huN[1]*l_huT[1]/l_h[1] - l_huN[0]*l_huT[0]/l_h[0];
+
+  for( unsigned short l_qt = 0; l_qt < 3; l_qt++ ) {
+    REQUIRE( l_nu[l_qt][0] + l_nu[3+l_qt][0] == Approx( l_fJump[l_qt] ) );
+  }
+}
+
+#if PP_N_DIM == 2
+TEST_CASE( "FiniteVolume: Throughput of the one- and two-dimensional net-updates per DOF.", "[.][FiniteVolume][bench]" ) {
+  int_el l_nEls = 1024*1024;
+  unsigned int l_nReps = 20;
+
+  std::vector< int_el > l_faEl;
+  std::vector< t_elementChars > l_elChars;
+  std::vector< real_base > l_dofs, l_bath;
+  edge::swe::solvers::test::initLine( l_nEls, l_faEl, l_elChars, l_dofs, l_bath );
+  std::vector< real_base > l_nu( l_nEls*2*N_QUANTITIES*N_CRUNS, 0 );
+
+  // faces with rotated normals
+  std::vector< t_faceChars > l_faChars( l_nEls );
+  for( int_el l_fa = 0; l_fa < l_nEls; l_fa++ ) {
+    double l_phi = l_fa * 0.01;
+    l_faChars[l_fa].outNormal[0] = std::cos( l_phi );
+    l_faChars[l_fa].outNormal[1] = std::sin( l_phi );
+    l_faChars[l_fa].spType = 0;
+  }
+
+  edge::monitor::Timer l_timer;
+  double l_dT = 0;
+
+  for( unsigned short l_di = 1; l_di < 3; l_di++ ) {
+    l_timer.start();
+    for( unsigned int l_re = 0; l_re < l_nReps; l_re++ ) {
+      if( l_di == 1 ) l_dT += edge::swe::solvers::FiniteVolume::netUpdates( 0, l_nEls,
+                                                                          (int_el (*)[2]) l_faEl.data(),
+                                                                          l_elChars.data(),
+                                                                          (real_base (*)[N_QUANTITIES][1][N_CRUNS]) l_dofs.data(),
+                                                                          (real_base (*)[1][1]) l_bath.data(),
+                                                                          (real_base (*)[4][1][N_CRUNS]) l_nu.data(),
+                                                                          SCALE_CFL );
+      else            l_dT += edge::swe::solvers::FiniteVolume::netUpdatesRot( 0, l_nEls,
+                                                                             (int_el (*)[2]) l_faEl.data(),
+                                                                             l_faChars.data(),
+                                                                             l_elChars.data(),
+                                                                             (real_base (*)[N_QUANTITIES][1][N_CRUNS]) l_dofs.data(),
+                                                                             (real_base (*)[1][1]) l_bath.data(),
+                                                                             (real_base (*)[2*N_QUANTITIES][1][N_CRUNS]) l_nu.data(),
+                                                                             SCALE_CFL );
+    }
+    l_timer.end();
+
+    // 1D solves for two, 2D for three quantities
+    std::cout << l_di << "D f-wave: "
+              << double(l_nEls) * l_nReps * N_CRUNS * (l_di+1) / l_timer.elapsed() << " DOF-face-updates/s" << std::endl;
+  }
+
+  REQUIRE( l_dT > 0 );
+}
+#endif
@@ -18,13 +18,14 @@
  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
  * @section DESCRIPTION
- * F-Wave solver for the one dimensional shallow water equations.
+ * F-Wave solver for the one and two dimensional shallow water equations.
  **/
 
 #ifndef FWAVE_HPP
 #define FWAVE_HPP
 
 #include <algorithm>
+#include <cmath>
 #include "constants.hpp"
 
 namespace edge {
@@ -47,14 +48,15 @@ class edge::swe::solvers::Fwave {
      * @param i_bL b for the left/minus side element.
      * @param i_bR b for the right/plus side element.
      * @param o_netUpdates set to the net-update of the face.
+     * @return maximum absolute wave speed of all concurrent runs.
      **/
-    static void computeNetUpdates( const t_elementModePrivate1   i_hL[ N_ELEMENT_MODES][N_CRUNS],
-                                   const t_elementModePrivate1   i_hR[ N_ELEMENT_MODES][N_CRUNS],
-                                   const t_elementModePrivate1   i_huL[N_ELEMENT_MODES][N_CRUNS],
-                                   const t_elementModePrivate1   i_huR[N_ELEMENT_MODES][N_CRUNS],
-                                   const t_elementModeShared1    i_bL,
-                                   const t_elementModeShared1    i_bR,
-                                         t_elementModePrivate1   o_netUpdates[4][N_FACE_MODES][N_CRUNS] ) {
+    static t_elementModePrivate1 computeNetUpdates( const t_elementModePrivate1   i_hL[ N_ELEMENT_MODES][N_CRUNS],
+                                                    const t_elementModePrivate1   i_hR[ N_ELEMENT_MODES][N_CRUNS],
+                                                    const t_elementModePrivate1   i_huL[N_ELEMENT_MODES][N_CRUNS],
+                                                    const t_elementModePrivate1   i_huR[N_ELEMENT_MODES][N_CRUNS],
+                                                    const t_elementModeShared1    i_bL,
+                                                    const t_elementModeShared1    i_bR,
+                                                          t_elementModePrivate1   o_netUpdates[4][N_FACE_MODES][N_CRUNS] ) {
 #if __has_builtin(__builtin_assume_aligned)
       (void) __builtin_assume_aligned(i_hL, ALIGNMENT.CRUNS);  (void) __builtin_assume_aligned(i_hR, ALIGNMENT.CRUNS);
       (void) __builtin_assume_aligned(i_huL, ALIGNMENT.CRUNS); (void) __builtin_assume_aligned(i_huR, ALIGNMENT.CRUNS);
@@ -81,8 +83,11 @@ class edge::swe::solvers::Fwave {
       // eigencoefficients
       t_elementModePrivate1 l_beta[2][N_CRUNS] __attribute__((aligned(ALIGNMENT.BASE.STACK)));
 
+      // maximum absolute wave speed
+      t_elementModePrivate1 l_maxSpeed = 0;
+
       // iterate over concurrent forward runs
-#pragma omp simd
+#pragma omp simd reduction(max:l_maxSpeed)
       for( int_cfr l_run = 0; l_run < N_CRUNS; l_run++ ) {
         // particle velocity
         l_uL[l_run] = i_huL[0][l_run] / i_hL[0][l_run];
@@ -96,7 +101,7 @@ class edge::swe::solvers::Fwave {
         l_fJump[0][l_run]  = i_huR[0][l_run] - i_huL[0][l_run];
         l_fJump[1][l_run]  = i_huR[0][l_run] * l_uR[l_run]  + (t_elementModePrivate1) 0.5  * (t_elementModePrivate1) 9.81 * i_hR[0][l_run] * i_hR[0][l_run];
         l_fJump[1][l_run] -= i_huL[0][l_run] * l_uL[l_run]  + (t_elementModePrivate1) 0.5  * (t_elementModePrivate1) 9.81 * i_hL[0][l_run] * i_hL[0][l_run];
-        l_fJump[1][l_run] += (t_elementModePrivate1) 0.5    * (t_elementModePrivate1) 9.81 * ( i_hR[0][l_run] + i_hL[0][l_run] * ( i_bR - i_bL ) );
+        l_fJump[1][l_run] += (t_elementModePrivate1) 0.5    * (t_elementModePrivate1) 9.81 * ( i_hR[0][l_run] + i_hL[0][l_run] ) * ( i_bR - i_bL );
 
         // compute scalar for 2x2 matrix inverse
         l_adMbc[l_run] = (t_elementModePrivate1) 1.0 / ( l_lambdaR[l_run] - l_lambdaL[l_run] );
@@ -120,6 +125,167 @@ class edge::swe::solvers::Fwave {
 
         o_netUpdates[2][0][l_run] = l_beta[1][l_run];
         o_netUpdates[3][0][l_run] = l_beta[1][l_run] * l_lambdaR[l_run];
+
+        l_maxSpeed = std::max( l_maxSpeed, std::max( std::abs( l_lambdaL[l_run] ),
+                                                     std::abs( l_lambdaR[l_run] ) ) );
+      }
+
+      return l_maxSpeed;
+    }
+
+    /**
+     * Computes the net-updates for a batch of faces, given as structure of arrays.
+     * The states of the faces are gathered by the caller, for example as [face][crun] for concurrent runs.
+     * In contrast to computeNetUpdates, the solver is branch-free: dry states are masked and have a zero particle velocity.
+     *
+     * @param i_n number of entries in the batch.
+     * @param i_hL water heights of the left/minus side elements.
+     * @param i_hR water heights of the right/plus side elements.
+     * @param i_huL momenta of the left/minus side elements.
+     * @param i_huR momenta of the right/plus side elements.
+     * @param i_bL bathymetry of the left/minus side elements.
+     * @param i_bR bathymetry of the right/plus side elements.
+     * @param o_netUpdates will be set to the net-updates, [*][]: left-going h, hu, right-going h, hu, [][*]: entry.
+     * @param o_speeds will be set to the maximum absolute wave speeds of the entries.
+     *
+     * @paramt TL_T_REAL floating point type.
+     **/
+    template< typename TL_T_REAL >
+    static void computeNetUpdatesBatch(       unsigned int   i_n,
+                                        const TL_T_REAL    * i_hL,
+                                        const TL_T_REAL    * i_hR,
+                                        const TL_T_REAL    * i_huL,
+                                        const TL_T_REAL    * i_huR,
+                                        const TL_T_REAL    * i_bL,
+                                        const TL_T_REAL    * i_bR,
+                                              TL_T_REAL   (* o_netUpdates)[N_FACES_BATCH*N_CRUNS],
+                                              TL_T_REAL    * o_speeds ) {
+      TL_T_REAL l_g = 9.81;
+
+#pragma omp simd
+      for( unsigned int l_en = 0; l_en < i_n; l_en++ ) {
+        // masks of wet states
+        bool l_wetL = i_hL[l_en] > 0;
+        bool l_wetR = i_hR[l_en] > 0;
+
+        // masked water heights and particle velocities, zero for dry states
+        TL_T_REAL l_hL = l_wetL ? i_hL[l_en] : 0;
+        TL_T_REAL l_hR = l_wetR ? i_hR[l_en] : 0;
+        TL_T_REAL l_uL = l_wetL ? i_huL[l_en] / i_hL[l_en] : 0;
+        TL_T_REAL l_uR = l_wetR ? i_huR[l_en] / i_hR[l_en] : 0;
+
+        // u -/+ sqrt(g*h)
+        TL_T_REAL l_lambdaL = l_uL - std::sqrt( l_g * l_hL );
+        TL_T_REAL l_lambdaR = l_uR + std::sqrt( l_g * l_hR );
+
+        // jump in fluxes
+        TL_T_REAL l_fJump0  = i_huR[l_en] - i_huL[l_en];
+        TL_T_REAL l_fJump1  = i_huR[l_en] * l_uR + TL_T_REAL(0.5) * l_g * l_hR * l_hR;
+                  l_fJump1 -= i_huL[l_en] * l_uL + TL_T_REAL(0.5) * l_g * l_hL * l_hL;
+                  l_fJump1 += TL_T_REAL(0.5) * l_g * ( l_hR + l_hL ) * ( i_bR[l_en] - i_bL[l_en] );
+
+        // scalar of the 2x2 matrix inverse, masked for coinciding eigenvalues
+        TL_T_REAL l_diff  = l_lambdaR - l_lambdaL;
+        TL_T_REAL l_adMbc = ( l_diff != 0 ) ? TL_T_REAL(1) / l_diff : 0;
+
+        // eigencoefficients
+        TL_T_REAL l_beta0 = l_adMbc * ( l_lambdaR * l_fJump0 - l_fJump1 );
+        TL_T_REAL l_beta1 = l_adMbc * ( l_fJump1 - l_lambdaL * l_fJump0 );
+
+        o_netUpdates[0][l_en] = l_beta0;
+        o_netUpdates[1][l_en] = l_beta0 * l_lambdaL;
+        o_netUpdates[2][l_en] = l_beta1;
+        o_netUpdates[3][l_en] = l_beta1 * l_lambdaR;
+
+        TL_T_REAL l_sL = std::abs( l_lambdaL );
+        TL_T_REAL l_sR = std::abs( l_lambdaR );
+        o_speeds[l_en] = ( l_sL > l_sR ) ? l_sL : l_sR;
+      }
+    }
+
+    /**
+     * Computes the net-updates for a batch of faces in two dimensions, given as structure of arrays.
+     * The momenta are given in the faces' coordinate systems (normal and tangential direction).
+     * The f-wave decomposition uses the two gravity waves and a shear wave, which carries the jump in the tangential momentum flux.
+     * As in computeNetUpdatesBatch, dry states are masked.
+     *
+     * @param i_n number of entries in the batch.
+     * @param i_hL water heights of the left/minus side elements.
+     * @param i_hR water heights of the right/plus side elements.
+     * @param i_huNL normal momenta of the left/minus side elements.
+     * @param i_huNR normal momenta of the right/plus side elements.
+     * @param i_huTL tangential momenta of the left/minus side elements.
+     * @param i_huTR tangential momenta of the right/plus side elements.
+     * @param i_bL bathymetry of the left/minus side elements.
+     * @param i_bR bathymetry of the right/plus side elements.
+     * @param o_netUpdates will be set to the net-updates, [*][]: left-going h, hu_n, hu_t, right-going h, hu_n, hu_t, [][*]: entry.
+     * @param o_speeds will be set to the maximum absolute wave speeds of the entries.
+     *
+     * @paramt TL_T_REAL floating point type.
+     **/
+    template< typename TL_T_REAL >
+    static void computeNetUpdatesBatchRot(       unsigned int   i_n,
+                                           const TL_T_REAL    * i_hL,
+                                           const TL_T_REAL    * i_hR,
+                                           const TL_T_REAL    * i_huNL,
+                                           const TL_T_REAL    * i_huNR,
+                                           const TL_T_REAL    * i_huTL,
+                                           const TL_T_REAL    * i_huTR,
+                                           const TL_T_REAL    * i_bL,
+                                           const TL_T_REAL    * i_bR,
+                                                 TL_T_REAL   (* o_netUpdates)[N_FACES_BATCH*N_CRUNS],
+                                                 TL_T_REAL    * o_speeds ) {
+      TL_T_REAL l_g = 9.81;
+
+#pragma omp simd
+      for( unsigned int l_en = 0; l_en < i_n; l_en++ ) {
+        // masks of wet states
+        bool l_wetL = i_hL[l_en] > 0;
+        bool l_wetR = i_hR[l_en] > 0;
+
+        // masked water heights and particle velocities, zero for dry states
+        TL_T_REAL l_hL  = l_wetL ? i_hL[l_en] : 0;
+        TL_T_REAL l_hR  = l_wetR ? i_hR[l_en] : 0;
+        TL_T_REAL l_uNL = l_wetL ? i_huNL[l_en] / i_hL[l_en] : 0;
+        TL_T_REAL l_uNR = l_wetR ? i_huNR[l_en] / i_hR[l_en] : 0;
+        TL_T_REAL l_uTL = l_wetL ? i_huTL[l_en] / i_hL[l_en] : 0;
+        TL_T_REAL l_uTR = l_wetR ? i_huTR[l_en] / i_hR[l_en] : 0;
+
+        // speeds of the gravity waves (u_n -/+ sqrt(g*h)) and the shear wave
+        TL_T_REAL l_lambdaL = l_uNL - std::sqrt( l_g * l_hL );
+        TL_T_REAL l_lambdaR = l_uNR + std::sqrt( l_g * l_hR );
+        TL_T_REAL l_lambdaS = TL_T_REAL(0.5) * ( l_uNL + l_uNR );
+
+        // jump in fluxes, including the bathymetry source term
+        TL_T_REAL l_fJump0  = i_huNR[l_en] - i_huNL[l_en];
+        TL_T_REAL l_fJump1  = i_huNR[l_en] * l_uNR + TL_T_REAL(0.5) * l_g * l_hR * l_hR;
+                  l_fJump1 -= i_huNL[l_en] * l_uNL + TL_T_REAL(0.5) * l_g * l_hL * l_hL;
+                  l_fJump1 += TL_T_REAL(0.5) * l_g * ( l_hR + l_hL ) * ( i_bR[l_en] - i_bL[l_en] );
+        TL_T_REAL l_fJump2  = i_huNR[l_en] * l_uTR - i_huNL[l_en] * l_uTL;
+
+        // scalar of the 2x2 matrix inverse, masked for coinciding eigenvalues
+        TL_T_REAL l_diff  = l_lambdaR - l_lambdaL;
+        TL_T_REAL l_adMbc = ( l_diff != 0 ) ? TL_T_REAL(1) / l_diff : 0;
+
+        // eigencoefficients, eigenvectors are (1, lambda_l, u_t,l), (0, 0, 1), (1, lambda_r, u_t,r)
+        TL_T_REAL l_betaL = l_adMbc * ( l_lambdaR * l_fJump0 - l_fJump1 );
+        TL_T_REAL l_betaR = l_adMbc * ( l_fJump1 - l_lambdaL * l_fJump0 );
+        TL_T_REAL l_betaS = l_fJump2 - l_betaL * l_uTL - l_betaR * l_uTR;
+
+        // assign the shear wave by the sign of its speed
+        TL_T_REAL l_shearL = ( l_lambdaS < 0 ) ? l_betaS : 0;
+        TL_T_REAL l_shearR = l_betaS - l_shearL;
+
+        o_netUpdates[0][l_en] = l_betaL;
+        o_netUpdates[1][l_en] = l_betaL * l_lambdaL;
+        o_netUpdates[2][l_en] = l_betaL * l_uTL + l_shearL;
+        o_netUpdates[3][l_en] = l_betaR;
+        o_netUpdates[4][l_en] = l_betaR * l_lambdaR;
+        o_netUpdates[5][l_en] = l_betaR * l_uTR + l_shearR;
+
+        TL_T_REAL l_sL = std::abs( l_lambdaL );
+        TL_T_REAL l_sR = std::abs( l_lambdaR );
+        o_speeds[l_en] = ( l_sL > l_sR ) ? l_sL : l_sR;
       }
     }
 };
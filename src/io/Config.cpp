@@ -135,6 +135,7 @@ void edge::io::Config::printConfig() {
   EDGE_LOG_INFO << "    files:";
   EDGE_LOG_INFO << "      in: " << m_meshFileIn;
   EDGE_LOG_INFO << "      out: " << m_meshFileOut;
+  if( m_meshFileOutNative != "" ) EDGE_LOG_INFO << "      out_native: " << m_meshFileOutNative;
   EDGE_LOG_INFO << "    boundary:";
   if( m_periodic != std::numeric_limits<int>::max() ) {
     EDGE_LOG_INFO << "      periodic: " << m_periodic;
@@ -143,6 +144,12 @@ void edge::io::Config::printConfig() {
     EDGE_LOG_INFO << "      " << m_bndConName[l_bn] << ": " << m_bndConId[l_bn];
   }
 #endif
+  EDGE_LOG_INFO << "    reorder: " << m_meshReorder;
+  if( m_meshReorderMisses ) EDGE_LOG_INFO << "    reorder misses: " << m_meshReorderMisses;
+#ifdef PP_T_MESH_REGULAR
+  EDGE_LOG_INFO << "    implicit: " << m_meshImplicit;
+#endif
+  if( m_meshCache != "" ) EDGE_LOG_INFO << "    cache: " << m_meshCache;
 
   // print info about sparse type domains
   for( unsigned short l_et = 0; l_et < 3; l_et++ ) {
@@ -166,6 +173,8 @@ void edge::io::Config::printConfig() {
   }
   EDGE_LOG_INFO << "  alright, we are sharing parameters again:";
   EDGE_LOG_INFO << "    end_time: " << m_endTime;
+  EDGE_LOG_INFO << "    fused_local_neigh: " << m_fusedLocalNeigh;
+  EDGE_LOG_INFO << "    dynamic_time_step: " << m_dynTimeStep;
 
   if( m_waveFieldType != "" ) {
     EDGE_LOG_INFO << "  wave_field:";
@@ -206,6 +215,13 @@ void edge::io::Config::printConfig() {
     EDGE_LOG_INFO << "    type: " << m_errorNormsType;
     EDGE_LOG_INFO << "    file: " << m_errorNormsFile;
   }
+
+  if( m_traceFile != "" ) {
+    EDGE_LOG_INFO << "  trace:";
+    EDGE_LOG_INFO << "    file: " << m_traceFile;
+  }
+
+  EDGE_LOG_INFO << "  bandwidth: " << m_bandwidth;
 }
 
 edge::io::Config::Config( std::string i_xmlPath ):
@@ -255,6 +271,28 @@ edge::io::Config::Config( std::string i_xmlPath ):
 
   m_meshFileIn = l_mesh.child("files").child("in").text().as_string();
   m_meshFileOut = l_mesh.child("files").child("out").text().as_string();
+  m_meshFileOutNative = l_mesh.child("files").child("out_native").text().as_string();
+
+  m_meshInNative =    m_meshFileIn.size() > 4
+                   && m_meshFileIn.compare( m_meshFileIn.size()-4, 4, ".edm" ) == 0;
+  EDGE_CHECK( !m_meshInNative || m_meshFileOutNative == "" )
+    << "conversion of native meshes is not supported";
+
+  m_meshReorder = l_mesh.child("reorder").text().as_string();
+  if( m_meshReorder == "" ) m_meshReorder = "none";
+  EDGE_CHECK( m_meshReorder == "none" || m_meshReorder == "morton" || m_meshReorder == "rcm" )
+    << "unknown element reordering: " << m_meshReorder;
+
+  m_meshReorderMisses = l_mesh.child("reorder_misses").text().as_bool();
+
+  m_meshCache = l_mesh.child("cache").text().as_string();
+
+  m_meshImplicit = l_mesh.child("implicit").text().as_bool();
+#if !defined PP_T_MESH_REGULAR || !defined PP_T_EQUATIONS_ADVECTION || defined PP_T_ELEMENTS_TET4
+  EDGE_CHECK( !m_meshImplicit ) << "implicit connectivity requires regular line, quad4r or hex8r meshes and advection";
+#endif
+  EDGE_CHECK( !m_meshImplicit || m_meshReorder == "none" )
+    << "implicit connectivity does not support reordered elements";
 
   // set periodic boundary value if present
   if( l_mesh.child("boundary").find_child(
@@ -317,6 +355,11 @@ edge::io::Config::Config( std::string i_xmlPath ):
 
   // read parameters shared among setups
   m_endTime = l_setups.child("end_time").text().as_double();
+  m_fusedLocalNeigh = l_setups.child("fused_local_neigh").text().as_bool();
+  m_dynTimeStep = l_setups.child("dynamic_time_step").text().as_bool();
+#ifndef PP_T_EQUATIONS_SWE
+  EDGE_CHECK( !m_dynTimeStep ) << "dynamic time steps are only supported for the shallow water equations";
+#endif
 
   // read output
   pugi::xml_node l_output = m_doc.child("edge").child("cfr").child("output");
@@ -363,6 +406,10 @@ edge::io::Config::Config( std::string i_xmlPath ):
   m_errorNormsType = l_output.child("error_norms").child("type").text().as_string();
   m_errorNormsFile = l_output.child("error_norms").child("file").text().as_string();
 
+  m_traceFile = l_output.child("trace").child("file").text().as_string();
+
+  m_bandwidth = l_output.child("bandwidth").text().as_bool();
+
   // print config
   printConfig();
 }
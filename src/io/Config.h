@@ -201,6 +201,24 @@ class edge::io::Config {
     //! mesh output file
     std::string m_meshFileOut;
 
+    //! true if the mesh input file is a native mesh (extension .edm)
+    bool m_meshInNative;
+
+    //! output file of the native mesh, empty if no conversion is done
+    std::string m_meshFileOutNative;
+
+    //! reordering of the elements for cache locality: none, morton or rcm
+    std::string m_meshReorder;
+
+    //! true if the cache misses of a neighbor gather are measured before and after the reordering
+    bool m_meshReorderMisses;
+
+    //! true if the connectivity of regular meshes is derived on the fly in the time stepping (the setup remains explicit)
+    bool m_meshImplicit;
+
+    //! path to the cache of derived mesh data, empty if disabled
+    std::string m_meshCache;
+
     /*
      * Simulation parameters
      */
@@ -210,6 +228,12 @@ class edge::io::Config {
     //! end time of the simulations
     double m_endTime;
 
+    //! true if the local and neighboring updates of the inner elements are fused
+    bool m_fusedLocalNeigh;
+
+    //! true if the time step is data-dependent and derived after every step (shallow water only)
+    bool m_dynTimeStep;
+
     //! type of the wave field output
     std::string m_waveFieldType;
 
@@ -225,6 +249,12 @@ class edge::io::Config {
     //! file for xml output of the norms
     std::string m_errorNormsFile;
 
+    //! prefix of the trace files (built-in tracing only)
+    std::string m_traceFile;
+
+    //! true if the sustained memory bandwidth is measured after the initialization (roofline of the statistics)
+    bool m_bandwidth;
+
     //! receiver coordinates
     std::vector< std::array< real_mesh, 3 > > m_recvCrds[2];
 
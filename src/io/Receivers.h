@@ -135,6 +135,16 @@ class edge::io::Receivers {
      **/
     void getEnRecv( std::vector< int_el > & o_en );
 
+    /**
+     * Gets the dense-entity of the given sparse entity.
+     *
+     * @param i_spEn sparse-entity.
+     * @return dense-entity.
+     **/
+    int_el getEnDe( int_el i_spEn ) const {
+      return m_recvs[ m_spEnToRecv[i_spEn] ].en;
+    }
+
     /**
      * Gets the relative time (w.r.t. i_time) at which the receiver(s) of the given sparse entity expects the next output.
      *
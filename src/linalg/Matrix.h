@@ -501,6 +501,111 @@ class edge::linalg::Matrix {
       }
     }
 
+    /**
+     * Fixed-size version of matMulFusedAC: C[r] * beta += A[r].B, for all 0 =< r =< #matrices.
+     * All sizes are compile-time constants, which allows the compiler to fully unroll the small loops
+     * and vectorize over the fused runs. A, B and C must not overlap.
+     *
+     * @param i_a matrix A.
+     * @param i_b matrix B.
+     * @param io_c matrix C.
+     *
+     * @paramt TL_T_REAL floating point precision.
+     * @paramt TL_N_CRS number of A and C matrices (fused runs).
+     * @paramt TL_M blas identifier M.
+     * @paramt TL_N blas identifier N.
+     * @paramt TL_K blas identifier K.
+     * @paramt TL_LD_A leading dimension of matrix A.
+     * @paramt TL_LD_B leading dimension of matrix B.
+     * @paramt TL_LD_C leading dimension of matrix C.
+     * @paramt TL_BETA_ONE true if beta is 1, false if beta is 0.
+     **/
+    template< typename       TL_T_REAL,
+              unsigned short TL_N_CRS,
+              unsigned int   TL_M,
+              unsigned int   TL_N,
+              unsigned int   TL_K,
+              unsigned int   TL_LD_A,
+              unsigned int   TL_LD_B,
+              unsigned int   TL_LD_C,
+              bool           TL_BETA_ONE >
+    static inline void matMulFusedAC( TL_T_REAL const * __restrict i_a,
+                                      TL_T_REAL const * __restrict i_b,
+                                      TL_T_REAL       * __restrict io_c ) {
+      for( unsigned int l_m = 0; l_m < TL_M; l_m++ ) {
+        if( !TL_BETA_ONE ) {
+          for( unsigned int l_n = 0; l_n < TL_N; l_n++ ) {
+#pragma omp simd
+            for( unsigned short l_r = 0; l_r < TL_N_CRS; l_r++ ) {
+              io_c[l_m*TL_LD_C*TL_N_CRS + l_n*TL_N_CRS + l_r] = 0;
+            }
+          }
+        }
+
+        for( unsigned int l_k = 0; l_k < TL_K; l_k++ ) {
+          for( unsigned int l_n = 0; l_n < TL_N; l_n++ ) {
+#pragma omp simd
+            for( unsigned short l_r = 0; l_r < TL_N_CRS; l_r++ ) {
+              io_c[l_m*TL_LD_C*TL_N_CRS + l_n*TL_N_CRS + l_r] += i_a[l_m*TL_LD_A*TL_N_CRS + l_k*TL_N_CRS + l_r] * i_b[l_k*TL_LD_B + l_n];
+            }
+          }
+        }
+      }
+    }
+
+    /**
+     * Fixed-size version of matMulFusedBC: C[r] * beta += A.B[r], for all 0 =< r =< #matrices.
+     * All sizes are compile-time constants, which allows the compiler to fully unroll the small loops
+     * and vectorize over the fused runs. A, B and C must not overlap.
+     *
+     * @param i_a matrix A.
+     * @param i_b matrix B.
+     * @param io_c matrix C.
+     *
+     * @paramt TL_T_REAL floating point precision.
+     * @paramt TL_N_CRS number of B and C matrices (fused runs).
+     * @paramt TL_M blas identifier M.
+     * @paramt TL_N blas identifier N.
+     * @paramt TL_K blas identifier K.
+     * @paramt TL_LD_A leading dimension of matrix A.
+     * @paramt TL_LD_B leading dimension of matrix B.
+     * @paramt TL_LD_C leading dimension of matrix C.
+     * @paramt TL_BETA_ONE true if beta is 1, false if beta is 0.
+     **/
+    template< typename       TL_T_REAL,
+              unsigned short TL_N_CRS,
+              unsigned int   TL_M,
+              unsigned int   TL_N,
+              unsigned int   TL_K,
+              unsigned int   TL_LD_A,
+              unsigned int   TL_LD_B,
+              unsigned int   TL_LD_C,
+              bool           TL_BETA_ONE >
+    static inline void matMulFusedBC( TL_T_REAL const * __restrict i_a,
+                                      TL_T_REAL const * __restrict i_b,
+                                      TL_T_REAL       * __restrict io_c ) {
+      for( unsigned int l_m = 0; l_m < TL_M; l_m++ ) {
+        if( !TL_BETA_ONE ) {
+          for( unsigned int l_n = 0; l_n < TL_N; l_n++ ) {
+#pragma omp simd
+            for( unsigned short l_r = 0; l_r < TL_N_CRS; l_r++ ) {
+              io_c[l_m*TL_LD_C*TL_N_CRS + l_n*TL_N_CRS + l_r] = 0;
+            }
+          }
+        }
+
+        for( unsigned int l_k = 0; l_k < TL_K; l_k++ ) {
+          TL_T_REAL l_a = i_a[l_m*TL_LD_A + l_k];
+          for( unsigned int l_n = 0; l_n < TL_N; l_n++ ) {
+#pragma omp simd
+            for( unsigned short l_r = 0; l_r < TL_N_CRS; l_r++ ) {
+              io_c[l_m*TL_LD_C*TL_N_CRS + l_n*TL_N_CRS + l_r] += l_a * i_b[l_k*TL_LD_B*TL_N_CRS + l_n*TL_N_CRS + l_r];
+            }
+          }
+        }
+      }
+    }
+
     /**
      * Transposes the given dense matrix.
      *
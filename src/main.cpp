@@ -41,8 +41,10 @@ INITIALIZE_EASYLOGGINGPP
 #include "data/Internal.hpp"
 #include "time/Manager.h"
 #include "mesh/SparseTypes.hpp"
+#include "mesh/Reorder.hpp"
 #include "mesh/setup_dep.inc"
 #include "monitor/Timer.hpp"
+#include "monitor/Phases.h"
 #include "monitor/instrument.hpp"
 
 // include dependencies of the setups
@@ -70,6 +72,10 @@ int main( int i_argc, char *i_argv[] ) {
   PP_INSTR_REG_DEF(init)
   PP_INSTR_REG_BEG(init,"init")
 
+  // phases of the initialization
+  edge::monitor::Phases l_phases;
+  l_phases.start( "parallel" );
+
   // start shared memory parallelization
   edge::parallel::Shared l_shared;
   l_shared.init();
@@ -80,6 +86,7 @@ int main( int i_argc, char *i_argv[] ) {
 
   // reconfigure the logging interface with rank and thread id
   edge::io::logging::config();
+  l_phases.end();
 
   EDGE_LOG_INFO << "##########################################################################";
   EDGE_LOG_INFO << "##############   ##############            ###############  ##############";
@@ -113,44 +120,128 @@ int main( int i_argc, char *i_argv[] ) {
   edge::data::common::printMemStats();
 
   // parse command line options
+  l_phases.start( "config" );
   EDGE_LOG_INFO << "parsing command line options";
   edge::io::OptionParser l_options( i_argc, i_argv );
 
   EDGE_LOG_INFO << "parsing xml config";
   edge::io::Config l_config( l_options.getXmlPath() );
 
+#ifdef PP_USE_INSTR_TRACE
+  // the trace's path is part of the config: the init region is opened again once the trace is on
+  edge::monitor::Trace::init( l_config.m_traceFile );
+  edge::monitor::Trace::begin( init_instrId );
+#endif
+  l_phases.end();
+
   // parse mesh
   EDGE_LOG_INFO << "parsing mesh";
+  l_phases.start( "mesh" );
 #include "mesh/setup.inc"
+  l_phases.end();
 
   // get the data layout
   EDGE_LOG_INFO << "taking care of data layout now";
+  l_phases.start( "layout" );
 #include "data/setup.inc"
+  l_phases.end();
 
   // initialize all elements/faces
+  l_phases.start( "alloc" );
   edge::data::Internal l_internal;
   l_internal.initScratch();
   l_internal.initDense(  l_enLayouts[0].nEnts,
                          l_enLayouts[1].nEnts,
                          l_enLayouts[2].nEnts );
+  l_phases.end();
 
   // setup constant data structures for DG
   EDGE_LOG_INFO << "setting up basis and DG-structure";
+  l_phases.start( "dg" );
   edge::dg::Basis l_basis( T_SDISC.ELEMENT, ORDER );
   l_basis.print();
 
 #include "dg/setup_ader.inc"
+  l_phases.end();
 
   // initialize internal chars and connectivity information
   EDGE_LOG_INFO << "initializing internal chars and connectivity info";
-  l_mesh.getVeChars( l_internal.m_vertexChars  );
-  l_mesh.getElChars( l_internal.m_elementChars );
-  l_mesh.getFaChars( l_internal.m_faceChars    );
-  l_mesh.getConnect( l_internal.m_vertexChars,
-                     l_internal.m_faceChars,
-                     l_internal.m_connect      );
-
-  // enhance entity chars if set in the config
+  l_phases.start( "connect" );
+  std::vector< int_gid > l_gIdsEl;
+  t_inMap l_inMap;
+
+  if( !l_meshCached ) {
+    l_mesh.getVeChars( l_internal.m_vertexChars  );
+    l_mesh.getElChars( l_internal.m_elementChars );
+    l_mesh.getFaChars( l_internal.m_faceChars    );
+    l_mesh.getConnect( l_internal.m_vertexChars,
+                       l_internal.m_faceChars,
+                       l_internal.m_connect      );
+
+    l_mesh.getGIdsEl( l_gIdsEl );
+    l_inMap = *l_mesh.getInMap();
+  }
+
+  // sizes of the cached chars and connectivity
+  std::size_t l_nVe = l_enLayouts[0].nEnts;
+  std::size_t l_nFa = l_enLayouts[1].nEnts;
+  std::size_t l_nEl = l_enLayouts[2].nEnts;
+  std::size_t l_sizesCache[10] = { l_nVe * sizeof(t_vertexChars),
+                                   l_nFa * sizeof(t_faceChars),
+                                   l_nEl * sizeof(t_elementChars),
+                                   l_nFa * sizeof(*l_internal.m_connect.faVe),
+                                   l_nEl * sizeof(*l_internal.m_connect.elVe),
+                                   l_nFa * sizeof(*l_internal.m_connect.faEl),
+                                   l_nEl * sizeof(*l_internal.m_connect.elFa),
+                                   l_nEl * sizeof(*l_internal.m_connect.elFaEl),
+                                   l_nEl * sizeof(*l_internal.m_connect.fIdElFaEl),
+                                   l_nEl * sizeof(*l_internal.m_connect.vIdElFaEl) };
+  void * l_dataCache[10] = { l_internal.m_vertexChars,
+                             l_internal.m_faceChars,
+                             l_internal.m_elementChars,
+                             l_internal.m_connect.faVe,
+                             l_internal.m_connect.elVe,
+                             l_internal.m_connect.faEl,
+                             l_internal.m_connect.elFa,
+                             l_internal.m_connect.elFaEl,
+                             l_internal.m_connect.fIdElFaEl,
+                             l_internal.m_connect.vIdElFaEl };
+  std::string l_namesCache[10] = { "ve_chars", "fa_chars", "el_chars",
+                                   "fa_ve", "el_ve", "fa_el", "el_fa", "el_fa_el", "f_id_el_fa_el", "v_id_el_fa_el" };
+
+  if( l_meshCached ) {
+    // copy the memory-mapped data to the (NUMA-aware) internal data structures
+    for( unsigned short l_da = 0; l_da < 10; l_da++ )
+      l_meshCache.get( l_namesCache[l_da], l_sizesCache[l_da], l_dataCache[l_da] );
+
+    l_meshCache.get( "g_ids_el", l_gIdsEl      );
+    l_meshCache.get( "ve_me_da", l_inMap.veMeDa );
+    l_meshCache.get( "ve_da_me", l_inMap.veDaMe );
+    l_meshCache.get( "fa_me_da", l_inMap.faMeDa );
+    l_meshCache.get( "fa_da_me", l_inMap.faDaMe );
+    l_meshCache.get( "el_me_da", l_inMap.elMeDa );
+    l_meshCache.get( "el_da_me", l_inMap.elDaMe );
+  }
+  else if( l_meshCache.enabled() ) {
+    // write the derived data, equation-specific sections might follow; the cache is finished after the setup
+    l_meshCache.begin( l_meshKey );
+    l_meshCache.add( "layout_ve", l_enLayouts[0] );
+    l_meshCache.add( "layout_fa", l_enLayouts[1] );
+    l_meshCache.add( "layout_el", l_enLayouts[2] );
+
+    for( unsigned short l_da = 0; l_da < 10; l_da++ )
+      l_meshCache.add( l_namesCache[l_da], l_dataCache[l_da], l_sizesCache[l_da] );
+
+    l_meshCache.add( "g_ids_el", l_gIdsEl      );
+    l_meshCache.add( "ve_me_da", l_inMap.veMeDa );
+    l_meshCache.add( "ve_da_me", l_inMap.veDaMe );
+    l_meshCache.add( "fa_me_da", l_inMap.faMeDa );
+    l_meshCache.add( "fa_da_me", l_inMap.faDaMe );
+    l_meshCache.add( "el_me_da", l_inMap.elMeDa );
+    l_meshCache.add( "el_da_me", l_inMap.elDaMe );
+  }
+
+  // enhance entity chars if set in the config, native meshes and the cache hold the chars of the mesh only
   if( l_config.m_spTypesDoms[0].size() > 0 ) EDGE_LOG_FATAL << "not implemented";
   if( l_config.m_spTypesDoms[1].size() > 0 ) edge::mesh::SparseTypes<
                                                T_SDISC.FACE
@@ -161,6 +252,7 @@ int main( int i_argc, char *i_argv[] ) {
                                                       l_internal.m_vertexChars,
                                                       l_internal.m_faceChars );
   if( l_config.m_spTypesDoms[2].size() > 0 ) EDGE_LOG_FATAL << "not implemented";
+  l_phases.end();
 
   EDGE_VLOG(2) << "  printing neigh relations (loc_fa-nei_fa-nei_ve):";
   if (EDGE_VLOG_IS_ON(2)) {
@@ -169,12 +261,64 @@ int main( int i_argc, char *i_argv[] ) {
                                                           l_internal.m_connect.vIdElFaEl[0] );
   }
 
-//TODO: add to internal
-std::vector< int_gid > l_gIdsEl;
-l_mesh.getGIdsEl( l_gIdsEl );
+  // reorder the inner elements of the time groups for cache locality
+  l_phases.start( "reorder" );
+  std::vector< int_el > l_elNewOld( l_enLayouts[2].nEnts );
+  for( int_el l_el = 0; l_el < l_enLayouts[2].nEnts; l_el++ ) l_elNewOld[l_el] = l_el;
+
+  if( l_config.m_meshReorder != "none" ) {
+    EDGE_LOG_INFO << "reordering inner elements: " << l_config.m_meshReorder;
+    // size of the elements' DOFs, used by the cache miss measurements
+    std::size_t l_elDofsSize = std::size_t(N_QUANTITIES) * N_ELEMENT_MODES * N_CRUNS * sizeof(real_base);
+    EDGE_LOG_INFO << "  average neighbor distance before: "
+                  << edge::mesh::Reorder< T_SDISC.ELEMENT >::neighDist( l_enLayouts[2].nEnts,
+                                                                        l_internal.m_connect.elFaEl );
+    // the measurement touches the DOFs of all elements, which is expensive for large meshes
+    double l_llcMisses = -1;
+    if( l_config.m_meshReorderMisses )
+      l_llcMisses = edge::mesh::Reorder< T_SDISC.ELEMENT >::neighMisses( l_enLayouts[2].nEnts,
+                                                                        l_internal.m_connect.elFaEl,
+                                                                        l_elDofsSize );
+    if( l_llcMisses >= 0 ) EDGE_LOG_INFO << "  last level cache misses per element of a neighbor gather before: " << l_llcMisses;
+
+    for( std::size_t l_tg = 0; l_tg < l_enLayouts[2].timeGroups.size(); l_tg++ ) {
+      // send and receive elements keep their order, which is matched across ranks
+      if( l_config.m_meshReorder == "morton" )
+        edge::mesh::Reorder< T_SDISC.ELEMENT >::morton( l_enLayouts[2].timeGroups[l_tg].inner.first,
+                                                        l_enLayouts[2].timeGroups[l_tg].inner.size,
+                                                        l_internal.m_connect.elVe,
+                                                        l_internal.m_vertexChars,
+                                                        l_elNewOld.data() );
+      else
+        edge::mesh::Reorder< T_SDISC.ELEMENT >::rcm( l_enLayouts[2].timeGroups[l_tg].inner.first,
+                                                     l_enLayouts[2].timeGroups[l_tg].inner.size,
+                                                     l_internal.m_connect.elFaEl,
+                                                     l_elNewOld.data() );
+    }
+
+    edge::mesh::Reorder< T_SDISC.ELEMENT >::apply( l_enLayouts[2].nEnts,
+                                                   l_enLayouts[1].nEnts,
+                                                   l_elNewOld,
+                                                   l_internal.m_elementChars,
+                                                   l_internal.m_connect,
+                                                   l_gIdsEl,
+                                                   l_inMap );
+
+    EDGE_LOG_INFO << "  average neighbor distance after: "
+                  << edge::mesh::Reorder< T_SDISC.ELEMENT >::neighDist( l_enLayouts[2].nEnts,
+                                                                        l_internal.m_connect.elFaEl );
+    if( l_config.m_meshReorderMisses )
+      l_llcMisses = edge::mesh::Reorder< T_SDISC.ELEMENT >::neighMisses( l_enLayouts[2].nEnts,
+                                                                        l_internal.m_connect.elFaEl,
+                                                                        l_elDofsSize );
+    if( l_llcMisses >= 0 ) EDGE_LOG_INFO << "  last level cache misses per element of a neighbor gather after: " << l_llcMisses;
+  }
+  l_phases.end();
 
   // setup receivers
+  l_phases.start( "receivers" );
 #include "io/inc/setup_recv.inc"
+  l_phases.end();
 
   // time step statistics
   double l_dT[3];
@@ -182,6 +326,7 @@ l_mesh.getGIdsEl( l_gIdsEl );
   EDGE_LOG_INFO << "performing equation-specific setup";
   PP_INSTR_REG_DEF(equSpe)
   PP_INSTR_REG_BEG(equSpe,"eq_spec_setup")
+  l_phases.start( "equations" );
 #if defined PP_T_EQUATIONS_ADVECTION
 #include "impl/advection/setup.inc"
 #elif defined PP_T_EQUATIONS_ELASTIC
@@ -189,8 +334,31 @@ l_mesh.getGIdsEl( l_gIdsEl );
 #elif defined PP_T_EQUATIONS_SWE
 #include "impl/swe/setup.inc"
 #endif
+  l_phases.end();
   PP_INSTR_REG_END(equSpe)
 
+  // complete the cache of derived mesh data or the native mesh
+  l_phases.start( "mesh_finish" );
+  if( l_meshCache.writing() ) {
+    l_meshCache.finish();
+    if( l_config.m_meshFileOutNative != "" )
+      EDGE_LOG_INFO << "wrote the native mesh, use " << l_config.m_meshFileOutNative << " as input of subsequent runs";
+  }
+
+#if defined PP_T_MESH_REGULAR
+  // derive the connectivity of the time stepping on the fly, which saves the connectivity's memory traffic in the
+  // neighboring updates; the setup still builds the explicit connectivity, thus the peak memory is unchanged
+  if( l_config.m_meshImplicit ) {
+    EDGE_LOG_INFO << "switching to the implicit connectivity of the regular mesh";
+    l_internal.m_implicit.init( l_config.m_nElementsX,
+                                l_config.m_nElementsY,
+                                l_config.m_nElementsZ );
+    EDGE_CHECK_EQ( l_internal.m_implicit.getNEl(), l_enLayouts[2].nEnts );
+    l_internal.releaseImplicit();
+  }
+#endif
+  l_phases.end();
+
 #ifdef PP_USE_MPI
   double l_dTgts;
   MPI_Allreduce( l_dT, &l_dTgts, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD );
@@ -199,9 +367,11 @@ l_mesh.getGIdsEl( l_gIdsEl );
 #endif
 
   // construct single GTS cluster
+  l_phases.start( "time" );
   edge::time::TimeGroupStatic l_cluster( std::numeric_limits< int_ts >::max(),
                                          1,
-                                         l_internal );
+                                         l_internal,
+                                         l_config.m_dynTimeStep );
 
   EDGE_LOG_INFO << "time step stats coming thru (min_mpi,min,ave,max): "
                 << l_dTgts << ", " << l_dT[0] << ", " << l_dT[1] << ", " << l_dT[2];
@@ -216,12 +386,14 @@ l_mesh.getGIdsEl( l_gIdsEl );
   double l_syncInt = l_config.m_waveFieldInt;
 
   if( std::abs(l_syncInt) < TOL.TIME ) l_syncInt = l_endTime;
+  l_phases.end();
 
   // create a wave field writer
+  l_phases.start( "output" );
   edge::io::WaveField l_writer( l_config.m_waveFieldType,
                                 l_config.m_waveFieldFile,
                                 l_enLayouts[2],
-                                l_mesh.getInMap(),
+                               &l_inMap,
                                 l_internal.m_vertexChars,
                                 l_internal.m_connect.elVe,
                                 l_internal.m_elementModePrivate1 );
@@ -229,14 +401,18 @@ l_mesh.getGIdsEl( l_gIdsEl );
   // write setup
   EDGE_LOG_INFO << "reached synchronization point #0: " << l_simTime;
   l_writer.write( 0 );
+  l_phases.end();
 
-  // print mem stats
-  edge::data::common::printMemStats();
+  // print mem stats and measure the bandwidth for the roofline, if requested
+  l_phases.start( "bandwidth" );
+  double l_bwMem = edge::data::common::printMemStats( l_config.m_bandwidth );
+  l_phases.end();
 
   // print timing info for init
   l_timer.end();
   PP_INSTR_REG_END(init)
   EDGE_LOG_INFO << "initialization phase took us " << l_timer.elapsed() << " seconds";
+  l_phases.print( "initialization phases" );
 
   PP_INSTR_REG_DEF(comp)
 #ifdef PP_USE_MPI
@@ -253,11 +429,15 @@ l_mesh.getGIdsEl( l_gIdsEl );
            l_stepTime = std::min( l_stepTime, l_syncInt );
 
     l_time.simulate( l_stepTime );
+#ifdef PP_USE_INSTR_TRACE
+    edge::monitor::Trace::dump();
+#endif
 
     // update simulation time
     l_simTime += l_stepTime;
 
     EDGE_LOG_INFO << "reached synchronization point #" << l_step << ": " << l_simTime;
+    l_time.logStats( l_bwMem );
 
     // write this sync step
     l_writer.write( l_stepTime );
@@ -269,6 +449,25 @@ l_mesh.getGIdsEl( l_gIdsEl );
   EDGE_LOG_INFO << "that's the duration of the computations ("
                 << l_cluster.getUpdatesPer() << " time steps): "
                 << l_timer.elapsed() << " seconds";
+
+  // throughput of the owned elements
+  {
+    double l_nEls = 0;
+    for( std::size_t l_tg = 0; l_tg < l_enLayouts[2].timeGroups.size(); l_tg++ )
+      l_nEls += l_enLayouts[2].timeGroups[l_tg].nEntsOwn;
+#ifdef PP_USE_MPI
+    double l_nElsLoc = l_nEls;
+    l_err = MPI_Allreduce( &l_nElsLoc, &l_nEls, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+    EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+#endif
+    double l_elUps = l_nEls * l_cluster.getUpdatesPer() / l_timer.elapsed();
+    EDGE_LOG_INFO << "throughput (#elements, element updates/s, DOF updates/s): "
+                  << l_nEls << ", " << l_elUps << ", " << l_elUps * N_QUANTITIES * N_ELEMENT_MODES * N_CRUNS;
+  }
+  edge::data::common::printMemHwm();
+#ifdef PP_USE_PERF
+  l_time.logCounters();
+#endif
   PP_INSTR_REG_DEF(fin)
   PP_INSTR_REG_BEG(fin,"fin")
   l_timer.start();
@@ -291,4 +490,8 @@ l_mesh.getGIdsEl( l_gIdsEl );
   l_timer.end();
   PP_INSTR_REG_END(fin)
   EDGE_LOG_INFO << "finalizing time: " << l_timer.elapsed();
+
+#ifdef PP_USE_INSTR_TRACE
+  edge::monitor::Trace::fin();
+#endif
 }
@@ -0,0 +1,313 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Binary cache of derived mesh data.
+ **/
+
+#include "Cache.h"
+#include "parallel/global.h"
+#include <cstring>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef PP_USE_MPI
+#include "parallel/mpi_wrapper.inc"
+#endif
+
+uint64_t edge::mesh::Cache::hash( void        const * i_data,
+                                  std::size_t         i_size,
+                                  uint64_t            i_hash ) {
+  unsigned char const * l_data = (unsigned char const *) i_data;
+
+  for( std::size_t l_by = 0; l_by < i_size; l_by++ ) {
+    i_hash ^= l_data[l_by];
+    i_hash *= 0x100000001b3ull;
+  }
+
+  return i_hash;
+}
+
+uint64_t edge::mesh::Cache::hashFileLocal( std::string const & i_path,
+                                           uint64_t            i_hash ) {
+  int l_fd = open( i_path.c_str(), O_RDONLY );
+  if( l_fd < 0 ) return i_hash;
+
+  struct stat l_stat;
+  if( fstat( l_fd, &l_stat ) != 0 || l_stat.st_size == 0 ) {
+    close( l_fd );
+    return i_hash;
+  }
+
+  void * l_map = mmap( nullptr, l_stat.st_size, PROT_READ, MAP_PRIVATE, l_fd, 0 );
+  close( l_fd );
+  if( l_map == MAP_FAILED ) return i_hash;
+
+  madvise( l_map, l_stat.st_size, MADV_SEQUENTIAL );
+  i_hash = hash( l_map, l_stat.st_size, i_hash );
+  munmap( l_map, l_stat.st_size );
+
+  return i_hash;
+}
+
+uint64_t edge::mesh::Cache::hashFile( std::string const & i_path,
+                                      uint64_t            i_hash ) {
+  // only rank 0 reads the file, the other ranks receive the hash
+  if( parallel::g_rank == 0 ) i_hash = hashFileLocal( i_path, i_hash );
+
+#ifdef PP_USE_MPI
+  int l_err = MPI_Bcast( &i_hash, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD );
+  EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+#endif
+
+  return i_hash;
+}
+
+edge::mesh::Cache::~Cache() {
+  unmap();
+
+  // discard incomplete files
+  if( m_out != nullptr ) {
+    fclose( m_out );
+    std::remove( (m_path + ".tmp").c_str() );
+  }
+}
+
+void edge::mesh::Cache::unmap() {
+  if( m_map != nullptr ) munmap( m_map, m_mapSize );
+  m_map = nullptr;
+  m_mapSize = 0;
+  m_sections.clear();
+}
+
+bool edge::mesh::Cache::loadLocal( uint64_t i_key ) {
+  unmap();
+  if( !enabled() ) return false;
+
+  int l_fd = open( m_path.c_str(), O_RDONLY );
+  if( l_fd < 0 ) return false;
+
+  struct stat l_stat;
+  if( fstat( l_fd, &l_stat ) != 0 || (std::size_t) l_stat.st_size < sizeof(Header) ) {
+    close( l_fd );
+    return false;
+  }
+
+  void * l_map = mmap( nullptr, l_stat.st_size, PROT_READ, MAP_PRIVATE, l_fd, 0 );
+  close( l_fd );
+  if( l_map == MAP_FAILED ) return false;
+
+  m_map = (char *) l_map;
+  m_mapSize = l_stat.st_size;
+
+  // check the header
+  Header const * l_header = (Header const *) m_map;
+  if(    l_header->magic   != MAGIC
+      || l_header->version != VERSION
+      || l_header->key     != i_key
+      || l_header->offsetToc + l_header->nSections * sizeof(Entry) > m_mapSize ) {
+    unmap();
+    return false;
+  }
+
+  // parse the table of contents
+  Entry const * l_toc = (Entry const *) (m_map + l_header->offsetToc);
+  for( uint64_t l_se = 0; l_se < l_header->nSections; l_se++ ) {
+    if( l_toc[l_se].offset + l_toc[l_se].size > m_mapSize ) {
+      unmap();
+      return false;
+    }
+
+    std::string l_name( l_toc[l_se].name, strnlen( l_toc[l_se].name, N_CHARS_NAME ) );
+    m_sections[l_name] = std::make_pair( m_map + l_toc[l_se].offset, l_toc[l_se].size );
+  }
+
+  return true;
+}
+
+bool edge::mesh::Cache::load( uint64_t i_key ) {
+  int l_loaded = loadLocal( i_key ) ? 1 : 0;
+
+#ifdef PP_USE_MPI
+  // a partial hit is a miss on all ranks, since the ranks which missed read the mesh collectively
+  int l_err = MPI_Allreduce( MPI_IN_PLACE, &l_loaded, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD );
+  EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+#endif
+
+  if( l_loaded == 0 ) unmap();
+  return l_loaded != 0;
+}
+
+void const * edge::mesh::Cache::get( std::string const & i_name,
+                                     std::size_t         i_size ) const {
+  EDGE_CHECK( has( i_name ) ) << "section missing in mesh cache: " << i_name;
+  EDGE_CHECK_EQ( m_sections.at( i_name ).second, i_size ) << i_name;
+
+  return m_sections.at( i_name ).first;
+}
+
+void edge::mesh::Cache::get( std::string const & i_name,
+                             std::size_t         i_size,
+                             void              * o_data ) const {
+  std::memcpy( o_data, get( i_name, i_size ), i_size );
+}
+
+void edge::mesh::Cache::get( std::string const & i_name,
+                             t_enLayout        & o_layout ) const {
+  std::vector< int64_t > l_buf;
+  get( i_name, l_buf );
+
+  std::size_t l_pos = 0;
+  auto l_next = [&]() -> int64_t { EDGE_CHECK_LT( l_pos, l_buf.size() ); return l_buf[l_pos++]; };
+
+  o_layout.nEnts = l_next();
+  o_layout.timeGroups.resize( l_next() );
+
+  for( std::size_t l_tg = 0; l_tg < o_layout.timeGroups.size(); l_tg++ ) {
+    t_timeGroup &l_tgr = o_layout.timeGroups[l_tg];
+    l_tgr.nEntsOwn    = l_next();
+    l_tgr.nEntsNotOwn = l_next();
+    l_tgr.inner.first = l_next();
+    l_tgr.inner.size  = l_next();
+
+    l_tgr.send.resize( l_next() );
+    for( std::size_t l_rg = 0; l_rg < l_tgr.send.size(); l_rg++ ) {
+      l_tgr.send[l_rg].first = l_next();
+      l_tgr.send[l_rg].size  = l_next();
+    }
+
+    l_tgr.receive.resize( l_next() );
+    for( std::size_t l_rg = 0; l_rg < l_tgr.receive.size(); l_rg++ ) {
+      l_tgr.receive[l_rg].first = l_next();
+      l_tgr.receive[l_rg].size  = l_next();
+    }
+
+    l_tgr.neRanks.resize( l_next() );
+    for( std::size_t l_ne = 0; l_ne < l_tgr.neRanks.size(); l_ne++ ) l_tgr.neRanks[l_ne] = l_next();
+
+    l_tgr.neTgs.resize( l_next() );
+    for( std::size_t l_ne = 0; l_ne < l_tgr.neTgs.size(); l_ne++ ) l_tgr.neTgs[l_ne] = l_next();
+  }
+
+  EDGE_CHECK_EQ( l_pos, l_buf.size() );
+}
+
+void edge::mesh::Cache::begin( uint64_t i_key ) {
+  EDGE_CHECK( enabled() );
+  EDGE_CHECK( m_out == nullptr );
+
+  m_out = fopen( (m_path + ".tmp").c_str(), "wb" );
+  EDGE_CHECK( m_out != nullptr ) << "could not open mesh cache for writing: " << m_path;
+
+  m_outKey = i_key;
+  m_outToc.clear();
+
+  // reserve space for the header, which is written in finish()
+  Header l_header = {};
+  EDGE_CHECK_EQ( fwrite( &l_header, sizeof(Header), 1, m_out ), 1 );
+}
+
+void edge::mesh::Cache::add( std::string const & i_name,
+                             void        const * i_data,
+                             std::size_t         i_size ) {
+  EDGE_CHECK( m_out != nullptr );
+  EDGE_CHECK_LT( i_name.size(), N_CHARS_NAME ) << i_name;
+
+  // align the section
+  long l_pos = ftell( m_out );
+  char l_pad[ALIGNMENT_SECTION] = {};
+  std::size_t l_nPad = (ALIGNMENT_SECTION - (l_pos % ALIGNMENT_SECTION)) % ALIGNMENT_SECTION;
+  if( l_nPad > 0 ) EDGE_CHECK_EQ( fwrite( l_pad, 1, l_nPad, m_out ), l_nPad );
+
+  Entry l_entry = {};
+  std::strncpy( l_entry.name, i_name.c_str(), N_CHARS_NAME-1 );
+  l_entry.offset = l_pos + l_nPad;
+  l_entry.size   = i_size;
+  m_outToc.push_back( l_entry );
+
+  if( i_size > 0 ) EDGE_CHECK_EQ( fwrite( i_data, 1, i_size, m_out ), i_size ) << i_name;
+}
+
+void edge::mesh::Cache::add( std::string const & i_name,
+                             t_enLayout  const & i_layout ) {
+  std::vector< int64_t > l_buf;
+
+  l_buf.push_back( i_layout.nEnts );
+  l_buf.push_back( i_layout.timeGroups.size() );
+
+  for( std::size_t l_tg = 0; l_tg < i_layout.timeGroups.size(); l_tg++ ) {
+    t_timeGroup const &l_tgr = i_layout.timeGroups[l_tg];
+    l_buf.push_back( l_tgr.nEntsOwn );
+    l_buf.push_back( l_tgr.nEntsNotOwn );
+    l_buf.push_back( l_tgr.inner.first );
+    l_buf.push_back( l_tgr.inner.size );
+
+    l_buf.push_back( l_tgr.send.size() );
+    for( std::size_t l_rg = 0; l_rg < l_tgr.send.size(); l_rg++ ) {
+      l_buf.push_back( l_tgr.send[l_rg].first );
+      l_buf.push_back( l_tgr.send[l_rg].size );
+    }
+
+    l_buf.push_back( l_tgr.receive.size() );
+    for( std::size_t l_rg = 0; l_rg < l_tgr.receive.size(); l_rg++ ) {
+      l_buf.push_back( l_tgr.receive[l_rg].first );
+      l_buf.push_back( l_tgr.receive[l_rg].size );
+    }
+
+    l_buf.push_back( l_tgr.neRanks.size() );
+    for( std::size_t l_ne = 0; l_ne < l_tgr.neRanks.size(); l_ne++ ) l_buf.push_back( l_tgr.neRanks[l_ne] );
+
+    l_buf.push_back( l_tgr.neTgs.size() );
+    for( std::size_t l_ne = 0; l_ne < l_tgr.neTgs.size(); l_ne++ ) l_buf.push_back( l_tgr.neTgs[l_ne] );
+  }
+
+  add( i_name, l_buf );
+}
+
+void edge::mesh::Cache::finish() {
+  EDGE_CHECK( m_out != nullptr );
+
+  // write the aligned table of contents
+  long l_pos = ftell( m_out );
+  char l_pad[ALIGNMENT_SECTION] = {};
+  std::size_t l_nPad = (ALIGNMENT_SECTION - (l_pos % ALIGNMENT_SECTION)) % ALIGNMENT_SECTION;
+  if( l_nPad > 0 ) EDGE_CHECK_EQ( fwrite( l_pad, 1, l_nPad, m_out ), l_nPad );
+  l_pos += l_nPad;
+
+  if( m_outToc.size() > 0 )
+    EDGE_CHECK_EQ( fwrite( m_outToc.data(), sizeof(Entry), m_outToc.size(), m_out ), m_outToc.size() );
+
+  // write the header
+  Header l_header;
+  l_header.magic     = MAGIC;
+  l_header.version   = VERSION;
+  l_header.key       = m_outKey;
+  l_header.nSections = m_outToc.size();
+  l_header.offsetToc = l_pos;
+
+  EDGE_CHECK_EQ( fseek( m_out, 0, SEEK_SET ), 0 );
+  EDGE_CHECK_EQ( fwrite( &l_header, sizeof(Header), 1, m_out ), 1 );
+  EDGE_CHECK_EQ( fclose( m_out ), 0 );
+  m_out = nullptr;
+
+  // move the complete file to its final location
+  EDGE_CHECK_EQ( std::rename( (m_path + ".tmp").c_str(), m_path.c_str() ), 0 );
+}
@@ -0,0 +1,298 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Binary cache of derived mesh data.
+ **/
+
+#ifndef EDGE_MESH_CACHE_H
+#define EDGE_MESH_CACHE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+#include "data/layout.hpp"
+#include "io/logging.h"
+
+namespace edge {
+  namespace mesh {
+    class Cache;
+  }
+}
+
+/**
+ * Binary cache of derived mesh data (connectivity, entity characteristics, layouts).
+ *
+ * The cache is a single file per rank, holding named sections which are aligned to ALIGNMENT_SECTION bytes.
+ * Cached files are mapped to memory and only accepted if the key, derived from the mesh and the configuration, matches.
+ * The same format is used for native, pre-partitioned meshes, which are keyed by the build and the partition only.
+ *
+ * Layout of the file:
+ *   header (magic, version, key, number of sections, offset of the table of contents),
+ *   data of the sections,
+ *   table of contents (name, offset and size of every section).
+ **/
+class edge::mesh::Cache {
+  private:
+    //! magic number of cache files
+    static uint64_t const MAGIC = 0x48434143454744ull; // EDGCACH
+
+    //! version of the file format
+    static uint64_t const VERSION = 1;
+
+    //! alignment of the sections in bytes
+    static uint64_t const ALIGNMENT_SECTION = 64;
+
+    //! maximum length of section names (including the terminating null character)
+    static std::size_t const N_CHARS_NAME = 48;
+
+    //! header of cache files
+    struct Header {
+      uint64_t magic;
+      uint64_t version;
+      uint64_t key;
+      uint64_t nSections;
+      uint64_t offsetToc;
+    };
+
+    //! entry in the table of contents
+    struct Entry {
+      char     name[N_CHARS_NAME];
+      uint64_t offset;
+      uint64_t size;
+    };
+
+    //! path to the cache file
+    std::string m_path;
+
+    //! memory mapped file, nullptr if not loaded
+    char * m_map = nullptr;
+
+    //! size of the memory mapped file
+    std::size_t m_mapSize = 0;
+
+    //! sections of a loaded file
+    std::map< std::string, std::pair< char const *, uint64_t > > m_sections;
+
+    //! file which is written, nullptr if not writing
+    FILE * m_out = nullptr;
+
+    //! key of the written file
+    uint64_t m_outKey = 0;
+
+    //! table of contents of the written file
+    std::vector< Entry > m_outToc;
+
+    /**
+     * Unmaps a loaded file.
+     **/
+    void unmap();
+
+    /**
+     * Maps the cache file to memory, if it exists and matches the given key, local to the calling rank.
+     *
+     * @param i_key key which the cache file has to match.
+     * @return true if the cache file was loaded, false otherwise.
+     **/
+    bool loadLocal( uint64_t i_key );
+
+    /**
+     * Hashes the contents of the given file, local to the calling rank.
+     *
+     * @param i_path path to the file.
+     * @param i_hash initial hash value.
+     * @return hash, i_hash if the file could not be read.
+     **/
+    static uint64_t hashFileLocal( std::string const & i_path,
+                                   uint64_t            i_hash );
+
+  public:
+    /**
+     * Hashes the given bytes using 64-bit FNV-1a.
+     *
+     * @param i_data data which is hashed.
+     * @param i_size size of the data in bytes.
+     * @param i_hash initial hash value, used to combine multiple hashes.
+     * @return hash.
+     **/
+    static uint64_t hash( void        const * i_data,
+                          std::size_t         i_size,
+                          uint64_t            i_hash = 0xcbf29ce484222325ull );
+
+    /**
+     * Hashes the contents of the given file.
+     * Only rank 0 reads the file and broadcasts the hash; collective operation if MPI is used.
+     *
+     * @param i_path path to the file.
+     * @param i_hash initial hash value, used to combine multiple hashes; has to match on all ranks.
+     * @return hash, i_hash if the file could not be read by rank 0.
+     **/
+    static uint64_t hashFile( std::string const & i_path,
+                              uint64_t            i_hash = 0xcbf29ce484222325ull );
+
+    /**
+     * Constructor.
+     *
+     * @param i_path path to the cache file, an empty path disables the cache.
+     **/
+    Cache( std::string const & i_path ): m_path( i_path ) {};
+
+    /**
+     * Destructor, unmaps loaded files and discards incomplete writes.
+     **/
+    ~Cache();
+
+    /**
+     * Checks if the cache is enabled.
+     *
+     * @return true if enabled, false otherwise.
+     **/
+    bool enabled() const { return m_path != ""; }
+
+    /**
+     * Checks if a matching cache file is loaded.
+     *
+     * @return true if loaded, false otherwise.
+     **/
+    bool loaded() const { return m_map != nullptr; }
+
+    /**
+     * Maps the cache file to memory, if it exists and matches the given key.
+     * The file is only accepted if it matches on all ranks, otherwise no rank keeps its file; collective operation if MPI is used.
+     *
+     * @param i_key key which the cache file has to match.
+     * @return true if the cache files were loaded by all ranks, false otherwise.
+     **/
+    bool load( uint64_t i_key );
+
+    /**
+     * Checks if the loaded cache has the given section.
+     *
+     * @param i_name name of the section.
+     * @return true if the section exists, false otherwise.
+     **/
+    bool has( std::string const & i_name ) const { return m_sections.count( i_name ) > 0; }
+
+    /**
+     * Gets the data of a section of the loaded cache.
+     *
+     * @param i_name name of the section.
+     * @param i_size expected size of the section in bytes.
+     * @return pointer to the memory mapped data of the section.
+     **/
+    void const * get( std::string const & i_name,
+                      std::size_t         i_size ) const;
+
+    /**
+     * Copies the data of a section of the loaded cache.
+     *
+     * @param i_name name of the section.
+     * @param i_size expected size of the section in bytes.
+     * @param o_data will be set to the data of the section.
+     **/
+    void get( std::string const & i_name,
+              std::size_t         i_size,
+              void              * o_data ) const;
+
+    /**
+     * Gets a vector from the loaded cache.
+     *
+     * @param i_name name of the section.
+     * @param o_vec will be set to the vector.
+     *
+     * @paramt TL_T_VAL type of the vector's values.
+     **/
+    template< typename TL_T_VAL >
+    void get( std::string const     & i_name,
+              std::vector< TL_T_VAL > & o_vec ) const {
+      EDGE_CHECK( has( i_name ) ) << i_name;
+      std::size_t l_size = m_sections.at( i_name ).second;
+      EDGE_CHECK_EQ( l_size % sizeof(TL_T_VAL), 0 );
+
+      o_vec.resize( l_size / sizeof(TL_T_VAL) );
+      if( l_size > 0 ) get( i_name, l_size, o_vec.data() );
+    }
+
+    /**
+     * Gets an entity layout from the loaded cache.
+     *
+     * @param i_name name of the section.
+     * @param o_layout will be set to the entity layout.
+     **/
+    void get( std::string const & i_name,
+              t_enLayout        & o_layout ) const;
+
+    /**
+     * Starts writing a new cache file.
+     * The file is written to a temporary location and moved to the cache path in finish().
+     *
+     * @param i_key key of the cache file.
+     **/
+    void begin( uint64_t i_key );
+
+    /**
+     * Writes a section to the cache file.
+     *
+     * @param i_name name of the section.
+     * @param i_data data of the section.
+     * @param i_size size of the data in bytes.
+     **/
+    void add( std::string const & i_name,
+              void        const * i_data,
+              std::size_t         i_size );
+
+    /**
+     * Writes a vector as section to the cache file.
+     *
+     * @param i_name name of the section.
+     * @param i_vec vector which is written.
+     *
+     * @paramt TL_T_VAL type of the vector's values.
+     **/
+    template< typename TL_T_VAL >
+    void add( std::string             const & i_name,
+              std::vector< TL_T_VAL > const & i_vec ) {
+      add( i_name, i_vec.data(), i_vec.size() * sizeof(TL_T_VAL) );
+    }
+
+    /**
+     * Writes an entity layout as section to the cache file.
+     *
+     * @param i_name name of the section.
+     * @param i_layout entity layout.
+     **/
+    void add( std::string const & i_name,
+              t_enLayout  const & i_layout );
+
+    /**
+     * Finishes writing of the cache file.
+     **/
+    void finish();
+
+    /**
+     * Checks if a cache file is being written.
+     *
+     * @return true if writing, false otherwise.
+     **/
+    bool writing() const { return m_out != nullptr; }
+};
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Unit tests of the binary mesh cache.
+ **/
+
+#include <catch.hpp>
+#include "Cache.h"
+#include <cstdio>
+
+TEST_CASE( "Mesh cache: hashes.", "[Cache][hash]" ) {
+  char l_data[3] = { 'a', 'b', 'c' };
+
+  // reference values of 64-bit FNV-1a
+  REQUIRE( edge::mesh::Cache::hash( l_data, 0 ) == 0xcbf29ce484222325ull );
+  REQUIRE( edge::mesh::Cache::hash( l_data, 1 ) == 0xaf63dc4c8601ec8cull );
+  REQUIRE( edge::mesh::Cache::hash( l_data, 3 ) == 0xe71fa2190541574bull );
+
+  // combined hashes
+  REQUIRE( edge::mesh::Cache::hash( l_data+1, 2, edge::mesh::Cache::hash( l_data, 1 ) ) == 0xe71fa2190541574bull );
+
+  // missing files don't change the hash
+  REQUIRE( edge::mesh::Cache::hashFile( "/this/file/does/not/exist", 5 ) == 5 );
+}
+
+TEST_CASE( "Mesh cache: writing and loading.", "[Cache][io]" ) {
+  std::string l_path = "mesh_cache.test.edc";
+  std::remove( l_path.c_str() );
+
+  // layout with a single time group
+  t_enLayout l_layout;
+  l_layout.nEnts = 20;
+  l_layout.timeGroups.resize( 1 );
+  l_layout.timeGroups[0].nEntsOwn    = 15;
+  l_layout.timeGroups[0].nEntsNotOwn = 5;
+  l_layout.timeGroups[0].inner.first = 0;
+  l_layout.timeGroups[0].inner.size  = 10;
+  l_layout.timeGroups[0].send.resize( 2 );
+  l_layout.timeGroups[0].send[0].first = 10; l_layout.timeGroups[0].send[0].size = 3;
+  l_layout.timeGroups[0].send[1].first = 13; l_layout.timeGroups[0].send[1].size = 2;
+  l_layout.timeGroups[0].receive.resize( 1 );
+  l_layout.timeGroups[0].receive[0].first = 15; l_layout.timeGroups[0].receive[0].size = 5;
+  l_layout.timeGroups[0].neRanks.push_back( 3 );
+  l_layout.timeGroups[0].neRanks.push_back( 7 );
+  l_layout.timeGroups[0].neTgs.push_back( 0 );
+
+  int_el l_conn[5][3];
+  for( int_el l_en = 0; l_en < 5; l_en++ )
+    for( unsigned short l_co = 0; l_co < 3; l_co++ ) l_conn[l_en][l_co] = l_en * 3 + l_co;
+
+  std::vector< double > l_vec = { 1.5, -2.5, 3.25 };
+
+  {
+    edge::mesh::Cache l_cache( l_path );
+    REQUIRE( l_cache.enabled() );
+    REQUIRE( !l_cache.load( 17 ) );
+
+    l_cache.begin( 17 );
+    l_cache.add( "layout", l_layout );
+    l_cache.add( "conn", l_conn, sizeof(l_conn) );
+    l_cache.add( "vec", l_vec );
+    l_cache.add( "empty", nullptr, 0 );
+    l_cache.finish();
+  }
+
+  // wrong key
+  edge::mesh::Cache l_cache( l_path );
+  REQUIRE( !l_cache.load( 18 ) );
+  REQUIRE( !l_cache.loaded() );
+
+  // matching key
+  REQUIRE( l_cache.load( 17 ) );
+  REQUIRE( l_cache.loaded() );
+  REQUIRE( l_cache.has( "conn" ) );
+  REQUIRE( l_cache.has( "empty" ) );
+  REQUIRE( !l_cache.has( "missing" ) );
+
+  // sections are aligned
+  REQUIRE( (uint64_t) l_cache.get( "conn", sizeof(l_conn) ) % 64 == 0 );
+
+  int_el l_conn2[5][3];
+  l_cache.get( "conn", sizeof(l_conn2), l_conn2 );
+  for( int_el l_en = 0; l_en < 5; l_en++ )
+    for( unsigned short l_co = 0; l_co < 3; l_co++ ) REQUIRE( l_conn2[l_en][l_co] == l_en * 3 + l_co );
+
+  std::vector< double > l_vec2;
+  l_cache.get( "vec", l_vec2 );
+  REQUIRE( l_vec2 == l_vec );
+
+  t_enLayout l_layout2;
+  l_cache.get( "layout", l_layout2 );
+  REQUIRE( l_layout2.nEnts == 20 );
+  REQUIRE( l_layout2.timeGroups.size() == 1 );
+  REQUIRE( l_layout2.timeGroups[0].nEntsOwn    == 15 );
+  REQUIRE( l_layout2.timeGroups[0].nEntsNotOwn == 5 );
+  REQUIRE( l_layout2.timeGroups[0].inner.size  == 10 );
+  REQUIRE( l_layout2.timeGroups[0].send.size() == 2 );
+  REQUIRE( l_layout2.timeGroups[0].send[1].first == 13 );
+  REQUIRE( l_layout2.timeGroups[0].send[1].size  == 2 );
+  REQUIRE( l_layout2.timeGroups[0].receive.size() == 1 );
+  REQUIRE( l_layout2.timeGroups[0].receive[0].size == 5 );
+  REQUIRE( l_layout2.timeGroups[0].neRanks.size() == 2 );
+  REQUIRE( l_layout2.timeGroups[0].neRanks[1] == 7 );
+  REQUIRE( l_layout2.timeGroups[0].neTgs.size() == 1 );
+
+  std::remove( l_path.c_str() );
+}
@@ -24,6 +24,7 @@
 #include "Moab.h"
 #include <cassert>
 #include <cmath>
+#include <algorithm>
 #ifdef PP_USE_MPI
 #include <MBParallelConventions.h>
 #endif
@@ -502,12 +503,35 @@ void edge::mesh::Moab::setupEnLayout( int_tg                             i_tg,
   // allocate total ent size with 5% overhead
   o_ents.reserve( i_ents.size() * 1.05 );
 
+  // first inner-entity of the time group
+  std::size_t l_firstIn = o_ents.size();
+
   // get inner-elements
   for( moab::Range::const_iterator l_en = i_ents.begin(); l_en != i_ents.end(); l_en++ ) {
     if( getEnMpiType(*l_en) == 0 ) o_ents.push_back( *l_en );
   }
   EDGE_CHECK_GT( o_ents.size(), 0 ); // make sure we have inner entities
 
+  /*
+   * Faces: move inner-faces adjacent to send-elements to the end of the inner-faces.
+   * Together with the send- and receive-faces, which directly follow, these form a contiguous range of
+   * faces whose face-local work is required by the neighboring updates of the send-elements.
+   */
+  if( m_core.dimension_from_handle( i_ents.front() ) == m_dim-1 ) {
+    std::stable_partition( o_ents.begin() + l_firstIn,
+                           o_ents.end(),
+                           [&]( moab::EntityHandle i_fa ) {
+                             std::vector< moab::EntityHandle > l_faEl;
+                             l_error = m_core.get_adjacencies( &i_fa, 1, m_dim, true, l_faEl );
+                             EDGE_CHECK_EQ( l_error, moab::MB_SUCCESS );
+
+                             for( std::size_t l_el = 0; l_el < l_faEl.size(); l_el++ ) {
+                               if( getEnMpiType( l_faEl[l_el] ) != 0 ) return false;
+                             }
+                             return true;
+                           } );
+  }
+
   // store the inner info
   o_enLayout.timeGroups[i_tg].inner.first = o_enLayout.nEnts;
   o_enLayout.timeGroups[i_tg].inner.size  = o_ents.size();
@@ -234,6 +234,7 @@ class edge::mesh::Moab {
      * with respect to a a single neighboring rank are sorted by the global ids of the entities. This is to ensure
      * a consistent ordering of the send-entities w.r.t. to the remote receive-ents and vice versa.
      * For vertices and faces, we consider only consider interface-data to be shared.
+     * Inner-faces adjacent to at least one send-element are located at the end of the inner-faces.
      **/
     void setupDataLayout();
 
@@ -0,0 +1,389 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Reordering of elements for cache locality.
+ **/
+#ifndef EDGE_MESH_REORDER_HPP
+#define EDGE_MESH_REORDER_HPP
+
+#include "constants.hpp"
+#include "data/layout.hpp"
+#include "io/logging.h"
+#include "monitor/PerfCounters.h"
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace edge {
+  namespace mesh {
+    template < t_entityType TL_T_EL >
+    class Reorder;
+  }
+}
+
+/**
+ * Reordering of elements for cache locality.
+ *
+ * All functions operate on permutations, given as new-to-old (newOld) or old-to-new (oldNew) mappings of dense ids.
+ * The permutations are local to the given ranges of elements, entries outside of the ranges are left untouched.
+ *
+ * @paramt TL_T_EL element type.
+ **/
+template < t_entityType TL_T_EL >
+class edge::mesh::Reorder {
+  private:
+    //! number of dimensions
+    static unsigned short const TL_N_DIS = C_ENT[TL_T_EL].N_DIM;
+
+    //! number of element vertices
+    static unsigned short const TL_N_EL_VES = C_ENT[TL_T_EL].N_VERTICES;
+
+    //! number of element faces
+    static unsigned short const TL_N_EL_FAS = C_ENT[TL_T_EL].N_FACES;
+
+    //! bits per dimension in the Morton keys
+    static unsigned short const TL_N_BITS = 63 / TL_N_DIS;
+
+  public:
+    /**
+     * Derives the Morton key of the given point.
+     *
+     * @param i_pt point, every coordinate is in [0, 2^(63/#dims) ).
+     * @return Morton key, the bits of the coordinates are interleaved.
+     **/
+    static uint64_t mortonKey( uint64_t const i_pt[TL_N_DIS] ) {
+      uint64_t l_key = 0;
+
+      for( unsigned short l_bi = 0; l_bi < TL_N_BITS; l_bi++ ) {
+        for( unsigned short l_di = 0; l_di < TL_N_DIS; l_di++ ) {
+          l_key |= ( (i_pt[l_di] >> l_bi) & 1 ) << (l_bi*TL_N_DIS + l_di);
+        }
+      }
+
+      return l_key;
+    }
+
+    /**
+     * Orders the elements in the given range along a Morton curve through their centroids.
+     *
+     * @param i_first first element in the range.
+     * @param i_size number of elements in the range.
+     * @param i_elVe vertices adjacent to the elements.
+     * @param i_veChars vertex characteristics.
+     * @param o_newOld will be set to the new-to-old mapping of the elements in the range.
+     **/
+    static void morton( int_el                 i_first,
+                        int_el                 i_size,
+                        int_el        const (* i_elVe)[TL_N_EL_VES],
+                        t_vertexChars const  * i_veChars,
+                        int_el               * o_newOld ) {
+      if( i_size == 0 ) return;
+
+      // derive centroids and bounding box
+      std::vector< double > l_cens( std::size_t(i_size) * TL_N_DIS );
+      double l_min[TL_N_DIS], l_max[TL_N_DIS];
+      for( unsigned short l_di = 0; l_di < TL_N_DIS; l_di++ ) {
+        l_min[l_di] =  std::numeric_limits< double >::max();
+        l_max[l_di] = -std::numeric_limits< double >::max();
+      }
+
+      for( int_el l_el = 0; l_el < i_size; l_el++ ) {
+        for( unsigned short l_di = 0; l_di < TL_N_DIS; l_di++ ) {
+          double l_cen = 0;
+          for( unsigned short l_ve = 0; l_ve < TL_N_EL_VES; l_ve++ )
+            l_cen += i_veChars[ i_elVe[i_first+l_el][l_ve] ].coords[l_di];
+          l_cen /= TL_N_EL_VES;
+
+          l_cens[l_el*TL_N_DIS + l_di] = l_cen;
+          l_min[l_di] = std::min( l_min[l_di], l_cen );
+          l_max[l_di] = std::max( l_max[l_di], l_cen );
+        }
+      }
+
+      // derive Morton keys
+      uint64_t l_maxCell = (uint64_t(1) << TL_N_BITS) - 1;
+      double l_nCells = double( l_maxCell );
+      std::vector< std::pair< uint64_t, int_el > > l_keys( i_size );
+
+      for( int_el l_el = 0; l_el < i_size; l_el++ ) {
+        uint64_t l_pt[TL_N_DIS];
+        for( unsigned short l_di = 0; l_di < TL_N_DIS; l_di++ ) {
+          double l_ext = l_max[l_di] - l_min[l_di];
+          double l_rel = (l_ext > 0) ? (l_cens[l_el*TL_N_DIS + l_di] - l_min[l_di]) / l_ext : 0;
+          // clamp, since the conversion to double might have rounded up
+          l_pt[l_di] = std::min( uint64_t( l_rel * l_nCells ), l_maxCell );
+        }
+
+        l_keys[l_el].first  = mortonKey( l_pt );
+        l_keys[l_el].second = i_first + l_el;
+      }
+
+      // sort by the keys, ties are resolved through the old ids
+      std::sort( l_keys.begin(), l_keys.end() );
+
+      for( int_el l_el = 0; l_el < i_size; l_el++ ) o_newOld[i_first+l_el] = l_keys[l_el].second;
+    }
+
+    /**
+     * Orders the elements in the given range through the reverse Cuthill-McKee algorithm on the face-adjacency graph.
+     * Neighbors outside of the range are ignored.
+     *
+     * @param i_first first element in the range.
+     * @param i_size number of elements in the range.
+     * @param i_elFaEl face-neighboring elements, std::numeric_limits< int_el >::max() if not existing.
+     * @param o_newOld will be set to the new-to-old mapping of the elements in the range.
+     **/
+    static void rcm( int_el          i_first,
+                     int_el          i_size,
+                     int_el const (* i_elFaEl)[TL_N_EL_FAS],
+                     int_el        * o_newOld ) {
+      // degree of the elements within the range
+      std::vector< unsigned short > l_deg( i_size, 0 );
+      for( int_el l_el = 0; l_el < i_size; l_el++ ) {
+        for( unsigned short l_fa = 0; l_fa < TL_N_EL_FAS; l_fa++ ) {
+          int_el l_ne = i_elFaEl[i_first+l_el][l_fa];
+          if( l_ne >= i_first && l_ne < i_first+i_size && l_ne != i_first+l_el ) l_deg[l_el]++;
+        }
+      }
+
+      std::vector< bool > l_visited( i_size, false );
+      std::vector< int_el > l_order;
+      l_order.reserve( i_size );
+
+      // start elements of the connected components, ascending degree
+      std::vector< int_el > l_starts( i_size );
+      for( int_el l_el = 0; l_el < i_size; l_el++ ) l_starts[l_el] = l_el;
+      std::stable_sort( l_starts.begin(), l_starts.end(),
+                        [&]( int_el i_a, int_el i_b ) { return l_deg[i_a] < l_deg[i_b]; } );
+
+      std::deque< int_el > l_queue;
+      for( int_el l_st = 0; l_st < i_size; l_st++ ) {
+        if( l_visited[ l_starts[l_st] ] ) continue;
+
+        // breadth-first search, neighbors are visited in order of ascending degree
+        l_queue.push_back( l_starts[l_st] );
+        l_visited[ l_starts[l_st] ] = true;
+
+        while( !l_queue.empty() ) {
+          int_el l_el = l_queue.front();
+          l_queue.pop_front();
+          l_order.push_back( l_el );
+
+          int_el l_nes[TL_N_EL_FAS];
+          unsigned short l_nNes = 0;
+          for( unsigned short l_fa = 0; l_fa < TL_N_EL_FAS; l_fa++ ) {
+            int_el l_ne = i_elFaEl[i_first+l_el][l_fa];
+            if( l_ne >= i_first && l_ne < i_first+i_size && !l_visited[l_ne-i_first] ) {
+              l_visited[l_ne-i_first] = true;
+              l_nes[l_nNes] = l_ne-i_first;
+              l_nNes++;
+            }
+          }
+          std::stable_sort( l_nes, l_nes+l_nNes,
+                            [&]( int_el i_a, int_el i_b ) { return l_deg[i_a] < l_deg[i_b]; } );
+
+          for( unsigned short l_ne = 0; l_ne < l_nNes; l_ne++ ) l_queue.push_back( l_nes[l_ne] );
+        }
+      }
+      EDGE_CHECK_EQ( l_order.size(), std::size_t(i_size) );
+
+      // reverse the order
+      for( int_el l_el = 0; l_el < i_size; l_el++ ) o_newOld[i_first+l_el] = i_first + l_order[i_size-1-l_el];
+    }
+
+    /**
+     * Inverts the given permutation.
+     *
+     * @param i_nEns number of entities.
+     * @param i_newOld new-to-old mapping.
+     * @param o_oldNew will be set to the old-to-new mapping.
+     **/
+    static void invert( int_el         i_nEns,
+                        int_el const * i_newOld,
+                        int_el       * o_oldNew ) {
+      for( int_el l_en = 0; l_en < i_nEns; l_en++ ) o_oldNew[ i_newOld[l_en] ] = l_en;
+    }
+
+    /**
+     * Permutes the rows of the given entity-indexed data.
+     *
+     * @param i_nEns number of entities.
+     * @param i_newOld new-to-old mapping.
+     * @param io_data data which gets permuted.
+     *
+     * @paramt TL_T_DATA type of the data of a single entity, has to be trivially copyable.
+     **/
+    template< typename TL_T_DATA >
+    static void permute( int_el            i_nEns,
+                         int_el    const * i_newOld,
+                         TL_T_DATA       * io_data ) {
+      std::vector< char > l_tmp( std::size_t(i_nEns) * sizeof(TL_T_DATA) );
+      std::memcpy( l_tmp.data(), io_data, l_tmp.size() );
+
+      for( int_el l_en = 0; l_en < i_nEns; l_en++ ) {
+        std::memcpy( io_data+l_en,
+                     l_tmp.data() + std::size_t( i_newOld[l_en] ) * sizeof(TL_T_DATA),
+                     sizeof(TL_T_DATA) );
+      }
+    }
+
+    /**
+     * Renumbers the given ids.
+     *
+     * @param i_nIds number of ids.
+     * @param i_oldNew old-to-new mapping.
+     * @param io_ids ids which get renumbered; std::numeric_limits< int_el >::max() is ignored.
+     **/
+    static void renumber( std::size_t          i_nIds,
+                          int_el       const * i_oldNew,
+                          int_el             * io_ids ) {
+      for( std::size_t l_id = 0; l_id < i_nIds; l_id++ ) {
+        if( io_ids[l_id] != std::numeric_limits< int_el >::max() ) io_ids[l_id] = i_oldNew[ io_ids[l_id] ];
+      }
+    }
+
+    /**
+     * Derives the average distance of the ids of face-neighboring elements.
+     * This is a proxy for the locality of the neighboring accesses.
+     *
+     * @param i_nEls number of elements.
+     * @param i_elFaEl face-neighboring elements, std::numeric_limits< int_el >::max() if not existing.
+     * @return average distance of the ids.
+     **/
+    static double neighDist( int_el          i_nEls,
+                             int_el const (* i_elFaEl)[TL_N_EL_FAS] ) {
+      double l_dist = 0;
+      std::size_t l_nNes = 0;
+
+      for( int_el l_el = 0; l_el < i_nEls; l_el++ ) {
+        for( unsigned short l_fa = 0; l_fa < TL_N_EL_FAS; l_fa++ ) {
+          int_el l_ne = i_elFaEl[l_el][l_fa];
+          if( l_ne == std::numeric_limits< int_el >::max() ) continue;
+
+          l_dist += std::abs( double(l_ne) - double(l_el) );
+          l_nNes++;
+        }
+      }
+
+      return (l_nNes > 0) ? l_dist / l_nNes : 0;
+    }
+
+    /**
+     * Measures the last level cache misses of a gather of the elements' and their face-neighbors' data.
+     * The gather touches one value per cache line and mimics the accesses of the local and neighboring updates.
+     * A temporary buffer with the given size per element is allocated.
+     *
+     * @param i_nEls number of elements.
+     * @param i_elFaEl face-neighboring elements, std::numeric_limits< int_el >::max() if not existing.
+     * @param i_nBytes bytes of data per element.
+     * @return last level cache misses per element, negative if the hardware counters are not available.
+     **/
+    static double neighMisses( int_el          i_nEls,
+                               int_el const (* i_elFaEl)[TL_N_EL_FAS],
+                               std::size_t     i_nBytes ) {
+      monitor::PerfCounters l_cnts;
+      if( !l_cnts.open( false ) || !l_cnts.available( monitor::PerfCounters::LLC_MISSES ) ) return -1;
+      if( i_nEls == 0 ) return 0;
+
+      // values per element and values per cache line
+      std::size_t l_nVals = std::max( i_nBytes / sizeof(double), std::size_t(1) );
+      std::size_t l_nValsCl = 64 / sizeof(double);
+      std::vector< double > l_data( std::size_t(i_nEls) * l_nVals, 1.0 );
+
+      double l_cntsBe[monitor::PerfCounters::N_VALUES];
+      double l_cntsAf[monitor::PerfCounters::N_VALUES];
+      double l_acc = 0;
+
+      l_cnts.read( l_cntsBe );
+      for( int_el l_el = 0; l_el < i_nEls; l_el++ ) {
+        for( std::size_t l_va = 0; l_va < l_nVals; l_va += l_nValsCl )
+          l_acc += l_data[ std::size_t(l_el) * l_nVals + l_va ];
+
+        for( unsigned short l_fa = 0; l_fa < TL_N_EL_FAS; l_fa++ ) {
+          int_el l_ne = i_elFaEl[l_el][l_fa];
+          if( l_ne == std::numeric_limits< int_el >::max() ) continue;
+
+          for( std::size_t l_va = 0; l_va < l_nVals; l_va += l_nValsCl )
+            l_acc += l_data[ std::size_t(l_ne) * l_nVals + l_va ];
+        }
+      }
+      l_cnts.read( l_cntsAf );
+
+      // keep the gather alive
+      volatile double l_sink = l_acc;
+      (void) l_sink;
+
+      return ( l_cntsAf[monitor::PerfCounters::LLC_MISSES] - l_cntsBe[monitor::PerfCounters::LLC_MISSES] ) / i_nEls;
+    }
+
+    /**
+     * Applies the given permutation of the elements to the element characteristics, connectivity info,
+     * global ids and the index mapping between the mesh and the data.
+     *
+     * @param i_nEls number of elements.
+     * @param i_nFas number of faces.
+     * @param i_newOld new-to-old mapping of the elements.
+     * @param io_elChars element characteristics.
+     * @param io_connect connectivity information.
+     * @param io_gIdsEl global ids of the elements.
+     * @param io_inMap index mapping between mesh and data.
+     **/
+    static void apply( int_el                         i_nEls,
+                       int_el                         i_nFas,
+                       std::vector< int_el >  const & i_newOld,
+                       t_elementChars               * io_elChars,
+                       t_connect                    & io_connect,
+                       std::vector< int_gid >       & io_gIdsEl,
+                       t_inMap                      & io_inMap ) {
+      EDGE_CHECK_EQ( i_newOld.size(), std::size_t(i_nEls) );
+
+      std::vector< int_el > l_oldNew( i_nEls );
+      invert( i_nEls, i_newOld.data(), l_oldNew.data() );
+
+      // element-indexed data
+      permute( i_nEls, i_newOld.data(), io_elChars );
+      permute( i_nEls, i_newOld.data(), io_connect.elVe );
+      permute( i_nEls, i_newOld.data(), io_connect.elFa );
+      permute( i_nEls, i_newOld.data(), io_connect.elFaEl );
+      permute( i_nEls, i_newOld.data(), io_connect.fIdElFaEl );
+      permute( i_nEls, i_newOld.data(), io_connect.vIdElFaEl );
+      if( io_gIdsEl.size() > 0 ) {
+        EDGE_CHECK_EQ( io_gIdsEl.size(), std::size_t(i_nEls) );
+        permute( i_nEls, i_newOld.data(), io_gIdsEl.data() );
+      }
+      if( io_inMap.elDaMe.size() > 0 ) {
+        EDGE_CHECK_EQ( io_inMap.elDaMe.size(), std::size_t(i_nEls) );
+        permute( i_nEls, i_newOld.data(), io_inMap.elDaMe.data() );
+      }
+
+      // element ids
+      renumber( std::size_t(i_nEls) * ( sizeof(*io_connect.elFaEl) / sizeof(int_el) ),
+                l_oldNew.data(),
+                io_connect.elFaEl[0] );
+      renumber( std::size_t(i_nFas) * 2,           l_oldNew.data(), io_connect.faEl[0]   );
+      renumber( io_inMap.elMeDa.size(),            l_oldNew.data(), io_inMap.elMeDa.data() );
+    }
+};
+
+#endif
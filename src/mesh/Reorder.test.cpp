@@ -0,0 +1,138 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Unit tests for the reordering of elements.
+ **/
+
+#include <catch.hpp>
+#include "Reorder.hpp"
+
+TEST_CASE( "Reorder: Morton keys.", "[Reorder][mortonKey]" ) {
+  uint64_t l_pt[2];
+
+  l_pt[0] = 0; l_pt[1] = 0;
+  REQUIRE( edge::mesh::Reorder< TRIA3 >::mortonKey( l_pt ) == 0 );
+
+  l_pt[0] = 1; l_pt[1] = 0;
+  REQUIRE( edge::mesh::Reorder< TRIA3 >::mortonKey( l_pt ) == 1 );
+
+  l_pt[0] = 0; l_pt[1] = 1;
+  REQUIRE( edge::mesh::Reorder< TRIA3 >::mortonKey( l_pt ) == 2 );
+
+  l_pt[0] = 1; l_pt[1] = 1;
+  REQUIRE( edge::mesh::Reorder< TRIA3 >::mortonKey( l_pt ) == 3 );
+
+  l_pt[0] = 2; l_pt[1] = 0;
+  REQUIRE( edge::mesh::Reorder< TRIA3 >::mortonKey( l_pt ) == 4 );
+
+  l_pt[0] = 3; l_pt[1] = 3;
+  REQUIRE( edge::mesh::Reorder< TRIA3 >::mortonKey( l_pt ) == 15 );
+
+  uint64_t l_pt3[3] = { 1, 1, 1 };
+  REQUIRE( edge::mesh::Reorder< TET4 >::mortonKey( l_pt3 ) == 7 );
+  l_pt3[2] = 2;
+  REQUIRE( edge::mesh::Reorder< TET4 >::mortonKey( l_pt3 ) == 35 );
+}
+
+TEST_CASE( "Reorder: Morton order of line elements.", "[Reorder][morton]" ) {
+  /*
+   * Vertices: 0: 0.0, 1: 1.0, 2: 2.0, 3: 3.0, 4: 4.0
+   * Elements (first element is kept):
+   *   0: 3-4, 1: 0-1, 2: 2-3, 3: 1-2
+   */
+  t_vertexChars l_veChars[5];
+  for( unsigned short l_ve = 0; l_ve < 5; l_ve++ ) {
+    l_veChars[l_ve].coords[0] = l_ve;
+    l_veChars[l_ve].coords[1] = 0;
+    l_veChars[l_ve].coords[2] = 0;
+  }
+
+  int_el l_elVe[4][2] = { {3,4}, {0,1}, {2,3}, {1,2} };
+  int_el l_newOld[4] = { 0, 1, 2, 3 };
+
+  edge::mesh::Reorder< LINE >::morton( 1, 3, l_elVe, l_veChars, l_newOld );
+
+  REQUIRE( l_newOld[0] == 0 );
+  REQUIRE( l_newOld[1] == 1 );
+  REQUIRE( l_newOld[2] == 3 );
+  REQUIRE( l_newOld[3] == 2 );
+}
+
+TEST_CASE( "Reorder: Reverse Cuthill-McKee order of line elements.", "[Reorder][rcm]" ) {
+  /*
+   * Chain of elements: 4 - 0 - 3 - 1 - 2
+   */
+  int_el l_x = std::numeric_limits< int_el >::max();
+  int_el l_elFaEl[5][2] = { {4,3}, {3,2}, {1,l_x}, {0,1}, {l_x,0} };
+  int_el l_newOld[5];
+
+  REQUIRE( edge::mesh::Reorder< LINE >::neighDist( 5, l_elFaEl ) == Approx( 2.5 ) );
+
+  edge::mesh::Reorder< LINE >::rcm( 0, 5, l_elFaEl, l_newOld );
+
+  // reverse BFS from the end of the chain with lowest id
+  REQUIRE( l_newOld[0] == 4 );
+  REQUIRE( l_newOld[1] == 0 );
+  REQUIRE( l_newOld[2] == 3 );
+  REQUIRE( l_newOld[3] == 1 );
+  REQUIRE( l_newOld[4] == 2 );
+
+  // renumber the neighbors
+  int_el l_oldNew[5];
+  edge::mesh::Reorder< LINE >::invert( 5, l_newOld, l_oldNew );
+  edge::mesh::Reorder< LINE >::permute( 5, l_newOld, l_elFaEl );
+  edge::mesh::Reorder< LINE >::renumber( 10, l_oldNew, l_elFaEl[0] );
+
+  REQUIRE( edge::mesh::Reorder< LINE >::neighDist( 5, l_elFaEl ) == Approx( 1.0 ) );
+  REQUIRE( l_elFaEl[0][0] == l_x );
+  REQUIRE( l_elFaEl[0][1] == 1 );
+  REQUIRE( l_elFaEl[2][0] == 1 );
+  REQUIRE( l_elFaEl[2][1] == 3 );
+  REQUIRE( l_elFaEl[4][1] == l_x );
+}
+
+TEST_CASE( "Reorder: Cache misses of a neighbor gather.", "[Reorder][neighMisses]" ) {
+  int_el l_x = std::numeric_limits< int_el >::max();
+
+  // chain of line elements, 128 MiB of data
+  int_el l_nEls = 1 << 21;
+  std::vector< int_el > l_elFaEl( std::size_t(l_nEls) * 2 );
+  for( int_el l_el = 0; l_el < l_nEls; l_el++ ) {
+    l_elFaEl[l_el*2 + 0] = (l_el > 0)        ? l_el-1 : l_x;
+    l_elFaEl[l_el*2 + 1] = (l_el < l_nEls-1) ? l_el+1 : l_x;
+  }
+
+  double l_missesChain = edge::mesh::Reorder< LINE >::neighMisses( l_nEls,
+                                                                   (int_el (*)[2]) l_elFaEl.data(),
+                                                                   64 );
+
+  // scatter the neighbors
+  for( int_el l_el = 0; l_el < l_nEls; l_el++ )
+    for( unsigned short l_fa = 0; l_fa < 2; l_fa++ )
+      if( l_elFaEl[l_el*2 + l_fa] != l_x ) l_elFaEl[l_el*2 + l_fa] = int_el( ( std::size_t(l_elFaEl[l_el*2 + l_fa]) * 7919 ) % l_nEls );
+
+  double l_missesScat = edge::mesh::Reorder< LINE >::neighMisses( l_nEls,
+                                                                  (int_el (*)[2]) l_elFaEl.data(),
+                                                                  64 );
+
+  // counters might be unavailable, e.g., in containers
+  REQUIRE( (l_missesChain < 0) == (l_missesScat < 0) );
+  if( l_missesChain >= 0 ) REQUIRE( l_missesScat > l_missesChain );
+}
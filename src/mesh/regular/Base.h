@@ -142,7 +142,7 @@ class edge::mesh::regular::Base {
 
       // find biggest (balanced) divisor
       unsigned int l_di = 1;
-      for(  int l_it = 1; l_it < i_nRanks; l_it++ ) {
+      for(  int l_it = 1; l_it*l_it*l_it <= i_nRanks; l_it++ ) {
         if( i_nRanks % (l_it*l_it) == 0 && l_it <= (i_nRanks / (l_it*l_it)) ) l_di = l_it;
       }
 
@@ -0,0 +1,199 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Implicit connectivity of regular meshes.
+ **/
+
+#ifndef EDGE_MESH_REGULAR_IMPLICIT_HPP
+#define EDGE_MESH_REGULAR_IMPLICIT_HPP
+
+#include "constants.hpp"
+#include "io/logging.h"
+
+namespace edge {
+  namespace mesh {
+    namespace regular {
+      template< t_entityType TL_T_EL >
+      class Implicit;
+    }
+  }
+}
+
+/**
+ * Implicit connectivity of the periodic, regular line, quad4r and hex8r meshes of mesh::Regular.
+ * The face-neighboring elements and the adjacent faces are derived on the fly from the elements' (i,j,k)-indices,
+ * which matches the explicit connectivity of mesh::Regular, as long as the elements are not reordered.
+ *
+ * Local faces (directions):
+ *   line:   0: -x, 1: +x
+ *   quad4r: 0: -y, 1: +x, 2: +y, 3: -x
+ *   hex8r:  0: -z, 1: -y, 2: +x, 3: +y, 4: -x, 5: +z
+ *
+ * @paramt TL_T_EL element type.
+ **/
+template< t_entityType TL_T_EL >
+class edge::mesh::regular::Implicit {
+  private:
+    //! number of faces per element
+    static unsigned short const TL_N_FAS = C_ENT[TL_T_EL].N_FACES;
+
+    //! number of faces owned by every element
+    static unsigned short const TL_N_FAS_OWN = C_ENT[TL_T_EL].N_DIM;
+
+    //! number of elements in x-, y- and z-direction, 0 in x-direction if disabled
+    int_el m_nX = 0, m_nY = 1, m_nZ = 1;
+
+    /**
+     * Gets the direction of a local face.
+     *
+     * @param i_fa local face.
+     * @param o_di will be set to the dimension (0: x, 1: y, 2: z).
+     * @param o_si will be set to the sign (-1 or +1).
+     **/
+    static void getDir( unsigned short  i_fa,
+                        unsigned short &o_di,
+                        int_el         &o_si ) {
+      if( TL_T_EL == LINE ) {
+        o_di = 0;
+        o_si = (i_fa == 0) ? -1 : 1;
+      }
+      else if( TL_T_EL == QUAD4R ) {
+        o_di = (i_fa % 2 == 0) ? 1 : 0;
+        o_si = (i_fa == 0 || i_fa == 3) ? -1 : 1;
+      }
+      else {
+        o_di = (i_fa == 0 || i_fa == 5) ? 2 : ( (i_fa == 1 || i_fa == 3) ? 1 : 0 );
+        o_si = (i_fa == 0 || i_fa == 1 || i_fa == 4) ? -1 : 1;
+      }
+    }
+
+    /**
+     * Gets the slot of an owned face, mesh::Regular stores TL_N_FAS_OWN faces per element.
+     *
+     * @param i_fa local face.
+     * @return slot of the face, TL_N_FAS_OWN if the face is owned by the neighbor.
+     **/
+    static unsigned short getSlot( unsigned short i_fa ) {
+      if( TL_T_EL == LINE )   return (i_fa == 0) ? 0 : TL_N_FAS_OWN;
+      if( TL_T_EL == QUAD4R ) return (i_fa == 3) ? 0 : ( (i_fa == 0) ? 1 : TL_N_FAS_OWN );
+      return (i_fa < 3) ? i_fa : TL_N_FAS_OWN;
+    }
+
+  public:
+    /**
+     * Initializes the implicit connectivity.
+     *
+     * @param i_nX number of elements in x-direction.
+     * @param i_nY number of elements in y-direction (ignored in 1D).
+     * @param i_nZ number of elements in z-direction (ignored in 1D and 2D).
+     **/
+    void init( int_el i_nX,
+               int_el i_nY = 1,
+               int_el i_nZ = 1 ) {
+      EDGE_CHECK( TL_T_EL == LINE || TL_T_EL == QUAD4R || TL_T_EL == HEX8R );
+      EDGE_CHECK_GT( i_nX, 0 );
+
+      m_nX = i_nX;
+      m_nY = (C_ENT[TL_T_EL].N_DIM > 1) ? i_nY : 1;
+      m_nZ = (C_ENT[TL_T_EL].N_DIM > 2) ? i_nZ : 1;
+      EDGE_CHECK( m_nY > 0 && m_nZ > 0 );
+    }
+
+    /**
+     * Checks if the implicit connectivity is enabled.
+     *
+     * @return true if enabled, false otherwise.
+     **/
+    bool enabled() const { return m_nX > 0; }
+
+    /**
+     * Gets the number of elements.
+     *
+     * @return number of elements.
+     **/
+    int_el getNEl() const { return m_nX * m_nY * m_nZ; }
+
+    /**
+     * Gets the local face id of a face w.r.t. the face-neighboring element.
+     *
+     * @param i_fa local face id w.r.t. the element.
+     * @return local face id w.r.t. the face-neighboring element.
+     **/
+    static unsigned short fIdElFaEl( unsigned short i_fa ) {
+      if( TL_T_EL == LINE )   return 1 - i_fa;
+      if( TL_T_EL == QUAD4R ) return (i_fa + 2) % 4;
+      return (i_fa == 0 || i_fa == 5) ? 5 - i_fa : ( (i_fa + 1) % 4 ) + 1;
+    }
+
+    /**
+     * Gets the local vertex id of the face-neighboring element, which matches the face's first vertex.
+     * Faces of regular meshes are never rotated.
+     *
+     * @return 0.
+     **/
+    static unsigned short vIdElFaEl( unsigned short ) { return 0; }
+
+    /**
+     * Gets the face-neighboring elements of an element.
+     * All boundaries are periodic.
+     *
+     * @param i_el element.
+     * @param o_elFaEl will be set to the face-neighboring elements.
+     **/
+    void elFaEl( int_el i_el,
+                 int_el o_elFaEl[TL_N_FAS] ) const {
+      int_el l_n[3]   = { m_nX, m_nY, m_nZ };
+      int_el l_pos[3] = { i_el % m_nX,
+                         (i_el / m_nX) % m_nY,
+                          i_el / (m_nX * m_nY) };
+
+      for( unsigned short l_fa = 0; l_fa < TL_N_FAS; l_fa++ ) {
+        unsigned short l_di;
+        int_el l_si;
+        getDir( l_fa, l_di, l_si );
+
+        int_el l_posNe[3] = { l_pos[0], l_pos[1], l_pos[2] };
+        l_posNe[l_di] = (l_pos[l_di] + l_n[l_di] + l_si) % l_n[l_di];
+
+        o_elFaEl[l_fa] = l_posNe[0] + m_nX * ( l_posNe[1] + m_nY * l_posNe[2] );
+      }
+    }
+
+    /**
+     * Gets the faces adjacent to an element.
+     *
+     * @param i_el element.
+     * @param o_elFa will be set to the adjacent faces.
+     **/
+    void elFa( int_el i_el,
+               int_el o_elFa[TL_N_FAS] ) const {
+      int_el l_elFaEl[TL_N_FAS];
+      elFaEl( i_el, l_elFaEl );
+
+      for( unsigned short l_fa = 0; l_fa < TL_N_FAS; l_fa++ ) {
+        unsigned short l_sl = getSlot( l_fa );
+
+        if( l_sl < TL_N_FAS_OWN ) o_elFa[l_fa] = i_el * TL_N_FAS_OWN + l_sl;
+        else                      o_elFa[l_fa] = l_elFaEl[l_fa] * TL_N_FAS_OWN + getSlot( fIdElFaEl(l_fa) );
+      }
+    }
+};
+
+#endif
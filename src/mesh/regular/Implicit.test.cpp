@@ -0,0 +1,100 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Tests the implicit connectivity of regular meshes.
+ **/
+
+#include <catch.hpp>
+#include <vector>
+#include "Implicit.hpp"
+#include "mesh/Regular.h"
+
+TEST_CASE( "Implicit: Local face ids of the face-neighboring elements.", "[implicit][fIdElFaEl]" ) {
+  REQUIRE( edge::mesh::regular::Implicit< LINE >::fIdElFaEl(0) == 1 );
+  REQUIRE( edge::mesh::regular::Implicit< LINE >::fIdElFaEl(1) == 0 );
+
+  unsigned short l_quad[4] = { 2, 3, 0, 1 };
+  for( unsigned short l_fa = 0; l_fa < 4; l_fa++ )
+    REQUIRE( edge::mesh::regular::Implicit< QUAD4R >::fIdElFaEl(l_fa) == l_quad[l_fa] );
+
+  unsigned short l_hex[6] = { 5, 3, 4, 1, 2, 0 };
+  for( unsigned short l_fa = 0; l_fa < 6; l_fa++ )
+    REQUIRE( edge::mesh::regular::Implicit< HEX8R >::fIdElFaEl(l_fa) == l_hex[l_fa] );
+}
+
+TEST_CASE( "Implicit: Implicit against explicit connectivity of regular meshes.", "[implicit][connect]" ) {
+  unsigned short const l_nFas = C_ENT[T_SDISC.ELEMENT].N_FACES;
+
+  int_el l_nX = 7, l_nY = 5, l_nZ = 4;
+#if defined PP_T_ELEMENTS_LINE
+  edge::mesh::Regular l_mesh( edge::mesh::Regular::Line, l_nX, 1.0 );
+#elif defined PP_T_ELEMENTS_QUAD4R
+  edge::mesh::Regular l_mesh( edge::mesh::Regular::Quadrilateral, l_nX, 1.0, l_nY, 2.0 );
+#else
+  edge::mesh::Regular l_mesh( edge::mesh::Regular::Hexahedral, l_nX, 1.0, l_nY, 2.0, l_nZ, 3.0 );
+#endif
+
+  int_el l_nEl = l_mesh.getNElements();
+  int_el l_nFa = l_mesh.getNFaces();
+  int_el l_nVe = l_mesh.getNVertices();
+
+  std::vector< t_vertexChars  > l_veChars( l_nVe );
+  std::vector< t_faceChars    > l_faChars( l_nFa );
+  l_mesh.getVeChars( l_veChars.data() );
+  l_mesh.getFaChars( l_faChars.data() );
+
+  std::vector< int_el > l_elVe( l_nEl * C_ENT[T_SDISC.ELEMENT].N_VERTICES );
+  std::vector< int_el > l_faVe( l_nFa * C_ENT[T_SDISC.FACE].N_VERTICES );
+  std::vector< int_el > l_faEl( l_nFa * 2 );
+  std::vector< int_el > l_elFa( l_nEl * l_nFas );
+  std::vector< int_el > l_elFaEl( l_nEl * l_nFas );
+  std::vector< unsigned short > l_fIdElFaEl( l_nEl * l_nFas );
+  std::vector< unsigned short > l_vIdElFaEl( l_nEl * l_nFas );
+
+  t_connect l_connect;
+  l_connect.elVe      = (int_el (*)[C_ENT[T_SDISC.ELEMENT].N_VERTICES]) l_elVe.data();
+  l_connect.faVe      = (int_el (*)[C_ENT[T_SDISC.FACE].N_VERTICES]) l_faVe.data();
+  l_connect.faEl      = (int_el (*)[2]) l_faEl.data();
+  l_connect.elFa      = (int_el (*)[l_nFas]) l_elFa.data();
+  l_connect.elFaEl    = (int_el (*)[l_nFas]) l_elFaEl.data();
+  l_connect.fIdElFaEl = (unsigned short (*)[l_nFas]) l_fIdElFaEl.data();
+  l_connect.vIdElFaEl = (unsigned short (*)[l_nFas]) l_vIdElFaEl.data();
+
+  l_mesh.getConnect( l_veChars.data(), l_faChars.data(), l_connect );
+
+  edge::mesh::regular::Implicit< T_SDISC.ELEMENT > l_implicit;
+  REQUIRE( !l_implicit.enabled() );
+  l_implicit.init( l_nX, l_nY, l_nZ );
+  REQUIRE( l_implicit.enabled() );
+  REQUIRE( l_implicit.getNEl() == l_nEl );
+
+  for( int_el l_el = 0; l_el < l_nEl; l_el++ ) {
+    int_el l_elFaElIm[l_nFas], l_elFaIm[l_nFas];
+    l_implicit.elFaEl( l_el, l_elFaElIm );
+    l_implicit.elFa(   l_el, l_elFaIm   );
+
+    for( unsigned short l_fa = 0; l_fa < l_nFas; l_fa++ ) {
+      REQUIRE( l_elFaElIm[l_fa] == l_connect.elFaEl[l_el][l_fa] );
+      REQUIRE( l_elFaIm[l_fa]   == l_connect.elFa[l_el][l_fa]   );
+      REQUIRE( l_implicit.fIdElFaEl( l_fa ) == l_connect.fIdElFaEl[l_el][l_fa] );
+      REQUIRE( l_implicit.vIdElFaEl( l_fa ) == l_connect.vIdElFaEl[l_el][l_fa] );
+    }
+  }
+}
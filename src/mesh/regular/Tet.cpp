@@ -265,10 +265,39 @@ bool edge::mesh::regular::Tet::isInnerEl(       unsigned short i_tet,
   return false;
 }
 
+bool edge::mesh::regular::Tet::isFaCreator(       unsigned short i_fa,
+                                            const int            i_hxPos[3] ) const {
+  // faces inside the hex are never shared
+  if( i_fa >= 12 ) return true;
+
+  unsigned short l_di = i_fa / 4;
+
+  // left, front and bottom faces: only non-MPI faces at the lower domain boundary are created
+  if( i_fa % 4 < 2 ) return i_hxPos[l_di] == 0 && !isMpiBnd(m_mpiNe[l_di][0]);
+  // right, back and top faces: created in the domain's interior and at non-periodic, non-MPI boundaries
+  else return    i_hxPos[l_di] <  (int) m_nHex[l_di]-1
+              || ( !isMpiBnd(m_mpiNe[l_di][1]) && !m_periodic );
+}
+
+bool edge::mesh::regular::Tet::isFaWriter(       unsigned short i_fa,
+                                           const int            i_hxPos[3] ) const {
+  if( i_fa >= 12 ) return true;
+
+  unsigned short l_di = i_fa / 4;
+
+  // periodic lower faces are shared with the last hex in the dimension
+  if( i_fa % 4 < 2 ) return !( i_hxPos[l_di] == 0 && m_periodic && !isMpiBnd(m_mpiNe[l_di][0]) );
+  // upper faces are shared with the next hex, if not at the domain boundary
+  else return i_hxPos[l_di] == (int) m_nHex[l_di]-1;
+}
+
 void edge::mesh::regular::Tet::deriveInMapVeAndFa() {
   m_inMap.veMeDa.resize( m_veLayout.nEnts );
   m_inMap.veDaMe.resize( m_veLayout.nEnts );
   // setup dummy info for vertices
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
   for( int_el l_ve = 0; l_ve < m_veLayout.nEnts; l_ve++ ) {
     m_inMap.veMeDa[l_ve] = m_inMap.veDaMe[l_ve] = l_ve;
   }
@@ -276,6 +305,9 @@ void edge::mesh::regular::Tet::deriveInMapVeAndFa() {
   // faces aren't duplicated at all
   m_inMap.faMeDa.resize( m_faLayout.nEnts );
   m_inMap.faDaMe.resize( m_faLayout.nEnts );
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
   for( int_el l_fa = 0; l_fa < m_faLayout.nEnts; l_fa++ ) {
     m_inMap.faMeDa[l_fa] = m_inMap.faDaMe[l_fa] = l_fa;
   }
@@ -546,25 +578,13 @@ void edge::mesh::regular::Tet::init(       bool         i_type,
   m_veLayout.timeGroups[0].nEntsOwn = getNVeOwned();
   // TODO: Add neighboring info if required.
 
-  // init hexes
+  // init hexes, their types and vertices
   m_hexes.clear();
   m_hexes.resize( (m_nHex[0]+2)*(m_nHex[1]+2)*(m_nHex[2]+2) );
-  for( std::size_t l_hx = 0; l_hx < m_hexes.size(); l_hx++ ) {
-    m_hexes[l_hx].type = false;
-    for( unsigned short l_ve = 0; l_ve <  8; l_ve++ ) m_hexes[l_hx].ve[l_ve] = std::numeric_limits<int_el>::max();
-    for( unsigned short l_fa = 0; l_fa < 16; l_fa++ ) m_hexes[l_hx].fa[l_fa] = std::numeric_limits<int_el>::max();
-  }
-
-  std::function< void( unsigned int, unsigned short )  > l_updateFaInfo = [&]( unsigned int   i_hx,
-                                                                               unsigned short i_fa ) {
-    m_hexes[i_hx].fa[i_fa] = m_faLayout.nEnts;
 
-    m_faLayout.nEnts++;
-    m_faLayout.timeGroups[0].inner.size++;
-    m_faLayout.timeGroups[0].nEntsOwn++;
-  };
-
-  // iterate over all hexes and set up type and inner ents, and vertices
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
   for( int l_zh = -1; l_zh < (int) m_nHex[2]+1; l_zh++ ) {
     for( int l_yh = -1; l_yh < (int) m_nHex[1]+1; l_yh++ ) {
       for( int l_xh = -1; l_xh < (int) m_nHex[0]+1; l_xh++ ) {
@@ -577,122 +597,143 @@ void edge::mesh::regular::Tet::init(       bool         i_type,
         if( std::abs(l_yh)%2 == 1 ) m_hexes[l_hx].type = !m_hexes[l_hx].type;
         if( std::abs(l_zh)%2 == 1 ) m_hexes[l_hx].type = !m_hexes[l_hx].type;
 
-        /*
-         * Face setup
-         */
-        // check if the hex is owned
-        bool l_xOwn = l_xh >= 0 && l_xh < (int) m_nHex[0];
-        bool l_yOwn = l_yh >= 0 && l_yh < (int) m_nHex[1];
-        bool l_zOwn = l_zh >= 0 && l_zh < (int) m_nHex[2];
-
-        // compute neighboring indices
-        unsigned int l_hxLe = getHxIdBnd( l_xh-1, l_yh,   l_zh,   m_nHex[0], m_nHex[1], m_nHex[2] );
-        unsigned int l_hxFr = getHxIdBnd( l_xh,   l_yh-1, l_zh,   m_nHex[0], m_nHex[1], m_nHex[2] );
-        unsigned int l_hxBo = getHxIdBnd( l_xh,   l_yh,   l_zh-1, m_nHex[0], m_nHex[1], m_nHex[2] );
-        unsigned int l_hxRi = getHxIdBnd( l_xh+1, l_yh,   l_zh,   m_nHex[0], m_nHex[1], m_nHex[2] );
-        unsigned int l_hxBa = getHxIdBnd( l_xh,   l_yh+1, l_zh,   m_nHex[0], m_nHex[1], m_nHex[2] );
-        unsigned int l_hxTo = getHxIdBnd( l_xh,   l_yh,   l_zh+1, m_nHex[0], m_nHex[1], m_nHex[2] );
-
-        // only consider owned hexes for faces
-        if( l_xOwn && l_yOwn && l_zOwn ) {
-          // iterate over left faces
-          for( unsigned short l_fa = 0; l_fa < 2; l_fa++ ) {
-            // left-bnd, non-mpi faces are inner faces and have to be created
-            if( l_xh == 0 && !isMpiBnd(m_mpiNe[0][0]) ) {
-              l_updateFaInfo( l_hx, l_fa );
-            }
-            // all other faces are part of the left-neighboring hex
-            else if( l_xh > 0 ) {
-              m_hexes[l_hx].fa[l_fa] = m_hexes[l_hxLe].fa[l_fa+2];
-            }
-          }
+        for( unsigned short l_fa = 0; l_fa < 16; l_fa++ ) m_hexes[l_hx].fa[l_fa] = std::numeric_limits<int_el>::max();
 
-          // iterate over right faces
-          for( unsigned short l_fa = 2; l_fa < 4; l_fa++ ) {
-            // create right-inner faces
-            if(    (l_xh == (int) m_nHex[0]-1 && !isMpiBnd(m_mpiNe[0][1]) && !m_periodic)
-                ||  l_xh <  (int) m_nHex[0]-1 ) l_updateFaInfo( l_hx, l_fa );
-            else if( m_periodic && !isMpiBnd(m_mpiNe[0][1]) ) m_hexes[l_hx].fa[l_fa] = m_hexes[l_hxRi].fa[l_fa-2];
-          }
+        Base::getVesHex( l_xh,
+                         l_yh,
+                         l_zh,
+                         m_nHex[0],
+                         m_nHex[1],
+                         m_nHex[2],
+                         m_hexes[l_hx].ve );
+      }
+    }
+  }
 
-          // iterate over front faces
-          for( unsigned short l_fa = 4; l_fa < 6; l_fa++ ) {
-            // front-bd, non-mpi faces are inner and have to be created
-            if( l_yh == 0 && !isMpiBnd(m_mpiNe[1][0]) ) l_updateFaInfo( l_hx, l_fa );
-            // all other faces are part of the front-neighbor
-            else if( l_yh > 0 ) {
-              m_hexes[l_hx].fa[l_fa] = m_hexes[l_hxFr].fa[l_fa+2];
-            }
-          }
+  /*
+   * Inner faces and inner elements are numbered in the order of the owned hexes.
+   * We count them per z-slab of hexes first, which allows every slab to derive its first ids
+   * through a prefix sum and set up its entities independently of the others.
+   */
+  std::vector< int_el > l_faFirst( m_nHex[2]+1, 0 );
+  std::vector< int_el > l_elFirst( m_nHex[2]+1, 0 );
 
-          // iterate over back faces
-          for( unsigned short l_fa = 6; l_fa < 8; l_fa++ ) {
-            // inner back-faces belong to this hex
-            if(    (l_yh == (int) m_nHex[1]-1 && !isMpiBnd(m_mpiNe[1][1]) && !m_periodic)
-                ||  l_yh <  (int) m_nHex[1]-1 ) l_updateFaInfo( l_hx, l_fa );
-            else if( m_periodic && !isMpiBnd(m_mpiNe[1][1]) ) m_hexes[l_hx].fa[l_fa] = m_hexes[l_hxBa].fa[l_fa-2];
-          }
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
+  for( int l_zh = 0; l_zh < (int) m_nHex[2]; l_zh++ ) {
+    int l_hxPos[3];
+    l_hxPos[2] = l_zh;
 
-          // iterate over bottom faces
-          for( unsigned short l_fa = 8; l_fa < 10; l_fa++ ) {
-            // bottom-bnd, non-mpi faces are inner and created
-            if( l_zh == 0 && !isMpiBnd(m_mpiNe[2][0]) ) l_updateFaInfo( l_hx, l_fa );
-            // all other faces are part of the neighboring hex
-            else if( l_zh > 0 ) {
-              m_hexes[l_hx].fa[l_fa] = m_hexes[l_hxBo].fa[l_fa+2];
-            }
-          }
+    for( l_hxPos[1] = 0; l_hxPos[1] < (int) m_nHex[1]; l_hxPos[1]++ ) {
+      for( l_hxPos[0] = 0; l_hxPos[0] < (int) m_nHex[0]; l_hxPos[0]++ ) {
+        for( unsigned short l_fa = 0; l_fa < 16; l_fa++ )
+          if( isFaCreator( l_fa, l_hxPos ) ) l_faFirst[l_zh+1]++;
 
-          // iterate over top faces
-          for( unsigned short l_fa = 10; l_fa < 12; l_fa++ ) {
-            // top inner-faces are always created
-            if(    (l_zh == (int) m_nHex[2]-1 && !isMpiBnd(m_mpiNe[2][1]) && !m_periodic)
-                ||  l_zh <  (int) m_nHex[2]-1 ) l_updateFaInfo( l_hx, l_fa );
-            else if( m_periodic && !isMpiBnd(m_mpiNe[2][1]) ) m_hexes[l_hx].fa[l_fa] = m_hexes[l_hxTo].fa[l_fa-2];
-          }
+        for( unsigned short l_te = 0; l_te < 5; l_te++ )
+          if( isInnerEl( l_te, l_hxPos ) ) l_elFirst[l_zh+1]++;
+      }
+    }
+  }
+
+  for( unsigned int l_zh = 0; l_zh < m_nHex[2]; l_zh++ ) {
+    l_faFirst[l_zh+1] += l_faFirst[l_zh];
+    l_elFirst[l_zh+1] += l_elFirst[l_zh];
+  }
+
+  // create the inner faces and elements
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
+  for( int l_zh = 0; l_zh < (int) m_nHex[2]; l_zh++ ) {
+    int_el l_faId = l_faFirst[l_zh];
+    int_el l_elId = l_elFirst[l_zh];
+
+    int l_hxPos[3];
+    l_hxPos[2] = l_zh;
 
-          // iterate over faces inside the hex and create them, at least no shares here..
-          for( unsigned int short l_fa = 12; l_fa < 16; l_fa++ ) l_updateFaInfo( l_hx, l_fa );
+    for( l_hxPos[1] = 0; l_hxPos[1] < (int) m_nHex[1]; l_hxPos[1]++ ) {
+      for( l_hxPos[0] = 0; l_hxPos[0] < (int) m_nHex[0]; l_hxPos[0]++ ) {
+        unsigned int l_hx = getHxId( l_hxPos[0], l_hxPos[1], l_hxPos[2], m_nHex[0], m_nHex[1], m_nHex[2] );
+
+        for( unsigned short l_fa = 0; l_fa < 16; l_fa++ ) {
+          if( isFaCreator( l_fa, l_hxPos ) ) {
+            m_hexes[l_hx].fa[l_fa] = l_faId;
+            l_faId++;
+          }
         }
 
-        /*
-         * Element setup
-         */
-        // iterate over tets
         for( unsigned short l_te = 0; l_te < 5; l_te++ ) {
-          int l_hxPos[3];
-          l_hxPos[0] = l_xh; l_hxPos[1] = l_yh; l_hxPos[2] = l_zh;
-          bool l_in = isInnerEl( l_te, l_hxPos );
-          if( l_in ) {
-            m_hexes[l_hx].el[l_te].push_back( m_elLayout.nEnts );
-
-            // inner elmements are unique
-            EDGE_CHECK( m_elLayout.nEnts == m_nMeshEl );
-
-            m_inMap.elMeDa.push_back( m_elLayout.nEnts );
-            m_inMap.elDaMe.push_back( m_nMeshEl        );
-            m_nMeshEl++;
-
-            m_elLayout.nEnts++;
-            m_elLayout.timeGroups[0].inner.size++;
-            m_elLayout.timeGroups[0].nEntsOwn++;
+          if( isInnerEl( l_te, l_hxPos ) ) {
+            m_hexes[l_hx].el[l_te].push_back( l_elId );
+            l_elId++;
           }
         }
+      }
+    }
+    EDGE_CHECK( l_faId == l_faFirst[l_zh+1] );
+    EDGE_CHECK( l_elId == l_elFirst[l_zh+1] );
+  }
 
-        /**
-         * Vertex setup
-         **/
-        Base::getVesHex( l_xh,
-                         l_yh,
-                         l_zh,
-                         m_nHex[0],
-                         m_nHex[1],
-                         m_nHex[2],
-                         m_hexes[l_hx].ve );
+  // assign the shared faces, which are owned by the left, front or bottom neighbor or are periodic
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
+  for( int l_zh = 0; l_zh < (int) m_nHex[2]; l_zh++ ) {
+    int l_hxPos[3];
+    l_hxPos[2] = l_zh;
+
+    for( l_hxPos[1] = 0; l_hxPos[1] < (int) m_nHex[1]; l_hxPos[1]++ ) {
+      for( l_hxPos[0] = 0; l_hxPos[0] < (int) m_nHex[0]; l_hxPos[0]++ ) {
+        unsigned int l_hx = getHxId( l_hxPos[0], l_hxPos[1], l_hxPos[2], m_nHex[0], m_nHex[1], m_nHex[2] );
+
+        for( unsigned short l_fa = 0; l_fa < 12; l_fa++ ) {
+          if( isFaCreator( l_fa, l_hxPos ) ) continue;
+
+          unsigned short l_di = l_fa / 4;
+          bool l_up = (l_fa % 4) > 1;
+
+          int l_hxPosNe[3];
+          l_hxPosNe[0] = l_hxPos[0]; l_hxPosNe[1] = l_hxPos[1]; l_hxPosNe[2] = l_hxPos[2];
+
+          // all other lower faces are part of the lower neighbor
+          if( !l_up && l_hxPos[l_di] > 0 ) {
+            l_hxPosNe[l_di]--;
+            unsigned int l_hxNe = getHxId( l_hxPosNe[0], l_hxPosNe[1], l_hxPosNe[2], m_nHex[0], m_nHex[1], m_nHex[2] );
+            m_hexes[l_hx].fa[l_fa] = m_hexes[l_hxNe].fa[l_fa+2];
+          }
+          // periodic upper faces are part of the first hex
+          else if( l_up && m_periodic && !isMpiBnd(m_mpiNe[l_di][1]) ) {
+            l_hxPosNe[l_di]++;
+            unsigned int l_hxNe = getHxIdBnd( l_hxPosNe[0], l_hxPosNe[1], l_hxPosNe[2], m_nHex[0], m_nHex[1], m_nHex[2] );
+            m_hexes[l_hx].fa[l_fa] = m_hexes[l_hxNe].fa[l_fa-2];
+          }
+        }
       }
     }
   }
 
+  // update the layouts and index mappings
+  m_faLayout.nEnts                      += l_faFirst[m_nHex[2]];
+  m_faLayout.timeGroups[0].inner.size   += l_faFirst[m_nHex[2]];
+  m_faLayout.timeGroups[0].nEntsOwn     += l_faFirst[m_nHex[2]];
+
+  // inner elmements are unique
+  EDGE_CHECK( m_elLayout.nEnts == m_nMeshEl );
+  m_elLayout.nEnts                      += l_elFirst[m_nHex[2]];
+  m_elLayout.timeGroups[0].inner.size   += l_elFirst[m_nHex[2]];
+  m_elLayout.timeGroups[0].nEntsOwn     += l_elFirst[m_nHex[2]];
+  m_nMeshEl                             += l_elFirst[m_nHex[2]];
+
+  m_inMap.elMeDa.clear(); m_inMap.elMeDa.resize( m_nMeshEl );
+  m_inMap.elDaMe.clear(); m_inMap.elDaMe.resize( m_nMeshEl );
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
+  for( int_el l_el = 0; l_el < m_nMeshEl; l_el++ ) {
+    m_inMap.elMeDa[l_el] = m_inMap.elDaMe[l_el] = l_el;
+  }
+
   // set up communication, layer by layer
   int l_ids[3];
 
@@ -951,27 +992,12 @@ void edge::mesh::regular::Tet::init( const unsigned int i_nHex[3],
   EDGE_LOG_INFO << "  our per-dimension mpi-setup (x,y,z): "
                 << l_nPart[0] << " " << l_nPart[1] << " " << l_nPart[2];
 
-  // iterate over previous ranks and compute the element offset
-  unsigned int l_offset[3] = {0,0,0};
+  // compute the element offset, previous partitions hold the same or one more hex per dimension
+  unsigned int l_offset[3];
 
   for( unsigned short l_di = 0; l_di < 3; l_di++ ) {
-    for( unsigned int l_pr = 0; l_pr < l_part[l_di]; l_pr++ ) {
-      unsigned int l_partPr[3];
-      l_partPr[0] = l_part[0]; l_partPr[1] = l_part[1]; l_partPr[2] = l_part[2];
-      l_partPr[l_di] = l_pr;
-
-      int l_prRank = Base::getRank( l_nPart, l_partPr );
-
-      unsigned int l_nHexPr[3], l_nPartPr[3];
-      Base::getSetup3d( i_nRanks,
-                        l_prRank,
-                        m_periodic, // TODO: fix periodic
-                        i_nHex,
-                        l_nHexPr,
-                        l_nPartPr,
-                        l_partPr );
-      l_offset[l_di] += l_nHexPr[l_di];
-    }
+    l_offset[l_di]  = l_part[l_di] * ( i_nHex[l_di] / l_nPart[l_di] );
+    l_offset[l_di] += std::min( l_part[l_di], i_nHex[l_di] % l_nPart[l_di] );
   }
 
   // derive local corner of the rank's domain
@@ -1034,6 +1060,9 @@ void edge::mesh::regular::Tet::init( const unsigned int i_nHex[3],
 
 void edge::mesh::regular::Tet::getElVe( int_el (*o_elVe)[4] ) {
   // iterate over hexes
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
   for( std::size_t l_hx = 0; l_hx < m_hexes.size(); l_hx++ ) {
     // iterate over tets
     for( unsigned short l_te = 0; l_te < 5; l_te++ ) {
@@ -1051,13 +1080,20 @@ void edge::mesh::regular::Tet::getElVe( int_el (*o_elVe)[4] ) {
 
 void edge::mesh::regular::Tet::getFaVe( int_el (*o_faVe)[3] ) {
   // iterate over owned hexes having faces
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
   for( int l_zh = 0; l_zh < (int) m_nHex[2]; l_zh++ ) {
     for( int l_yh = 0; l_yh < (int) m_nHex[1]; l_yh++ ) {
       for( int l_xh = 0; l_xh < (int) m_nHex[0]; l_xh++ ) {
+        int l_hxPos[3] = { l_xh, l_yh, l_zh };
         unsigned int l_hx = getHxId( l_xh, l_yh, l_zh, m_nHex[0], m_nHex[1], m_nHex[2] );
 
         // iterate over hex faces
         for( unsigned short l_fa = 0; l_fa < 16; l_fa++ ) {
+          // shared faces are written by a single hex only
+          if( !isFaWriter( l_fa, l_hxPos ) ) continue;
+
           // iterate over face vertices
           for( unsigned short l_ve = 0; l_ve < 3; l_ve++ ) {
             unsigned short l_veId = m_mapFaVe[m_hexes[l_hx].type][l_fa][l_ve];
@@ -1137,12 +1173,18 @@ void edge::mesh::regular::Tet::getFaEl( int_el (*o_faEl)[2] ) {
     };
 
   // iterate over owned hexes having faces
-  int l_hxPos[3] = {0,0,0};
-  for( l_hxPos[2] = 0; l_hxPos[2] < (int) m_nHex[2]; l_hxPos[2]++ ) {
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
+  for( int l_zh = 0; l_zh < (int) m_nHex[2]; l_zh++ ) {
+    int l_hxPos[3] = {0, 0, l_zh};
     for( l_hxPos[1] = 0; l_hxPos[1] < (int) m_nHex[1]; l_hxPos[1]++ ) {
       for( l_hxPos[0] = 0; l_hxPos[0] < (int) m_nHex[0]; l_hxPos[0]++ ) {
 
         for( unsigned short l_fa = 0; l_fa < 16; l_fa++ ) {
+          // shared faces are written by a single hex only
+          if( !isFaWriter( l_fa, l_hxPos ) ) continue;
+
           unsigned int l_hx = getHxId( l_hxPos[0], l_hxPos[1], l_hxPos[2], m_nHex[0], m_nHex[1], m_nHex[2] );
 
           l_map( l_fa,
@@ -1174,6 +1216,9 @@ void edge::mesh::regular::Tet::getElFa( int_el (*o_elFa)[4] ) {
     };
 
   // iterate over all hexes
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
   for( int l_zh = -1; l_zh < (int) m_nHex[2]+1; l_zh++ ) {
     for( int l_yh = -1; l_yh < (int) m_nHex[1]+1; l_yh++ ) {
       for( int l_xh = -1; l_xh < (int) m_nHex[0]+1; l_xh++ ) {
@@ -1239,6 +1284,9 @@ void edge::mesh::regular::Tet::getElFaEl( int_el (*o_elFaEl)[4] ) {
     };
 
   // iterate over all hexes
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
   for( int l_zh = -1; l_zh < (int) m_nHex[2]+1; l_zh++ ) {
     for( int l_yh = -1; l_yh < (int) m_nHex[1]+1; l_yh++ ) {
       for( int l_xh = -1; l_xh < (int) m_nHex[0]+1; l_xh++ ) {
@@ -1259,35 +1307,25 @@ void edge::mesh::regular::Tet::getElFaEl( int_el (*o_elFaEl)[4] ) {
 }
 
 void edge::mesh::regular::Tet::getVeChars( t_vertexChars *o_veChars ) {
-  // iterate over hexes
-  for( int l_zh = -1; l_zh < (int) m_nHex[2]+1; l_zh++ ) {
-    for( int l_yh = -1; l_yh < (int) m_nHex[1]+1; l_yh++ ) {
-      for( int l_xh = -1; l_xh < (int) m_nHex[0]+1; l_xh++ ) {
-        unsigned int l_hx = getHxId( l_xh, l_yh, l_zh, m_nHex[0], m_nHex[1], m_nHex[2] );
+  // the vertices form a structured grid, which starts at the lower-left-bottom ghost hex
+  int_el l_nVe[3];
+  for( unsigned short l_di = 0; l_di < 3; l_di++ ) l_nVe[l_di] = m_nHex[l_di]+3;
 
-        for( unsigned short l_ve = 0; l_ve < 8; l_ve++ ) {
-          double l_crds[3];
-          l_crds[0] = m_corner[0];
-          l_crds[1] = m_corner[1];
-          l_crds[2] = m_corner[2];
-
-          l_crds[0] += l_xh * m_dX[0];
-          l_crds[1] += l_yh * m_dX[1];
-          l_crds[2] += l_zh * m_dX[2];
-
-          if( l_ve == 1 || l_ve == 2 || l_ve == 5 || l_ve == 6 ) l_crds[0] += m_dX[0];
-          if( l_ve == 2 || l_ve == 3 || l_ve == 6 || l_ve == 7 ) l_crds[1] += m_dX[1];
-          if( l_ve == 4 || l_ve == 5 || l_ve == 6 || l_ve == 7 ) l_crds[2] += m_dX[2];
-
-          o_veChars[ m_hexes[l_hx].ve[l_ve] ].coords[0] = l_crds[0];
-          o_veChars[ m_hexes[l_hx].ve[l_ve] ].coords[1] = l_crds[1];
-          o_veChars[ m_hexes[l_hx].ve[l_ve] ].coords[2] = l_crds[2];
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
+  for( int_el l_ve = 0; l_ve < m_veLayout.nEnts; l_ve++ ) {
+    int_el l_pos[3];
+    l_pos[0] =  l_ve %  l_nVe[0];
+    l_pos[1] = (l_ve /  l_nVe[0]) % l_nVe[1];
+    l_pos[2] =  l_ve / (l_nVe[0]  * l_nVe[1]);
 
-          // set dummy vertex type
-          o_veChars[ m_hexes[l_hx].ve[l_ve] ].spType = MESH_TYPE_NONE;
-        }
-      }
+    for( unsigned short l_di = 0; l_di < 3; l_di++ ) {
+      o_veChars[l_ve].coords[l_di] = m_corner[l_di] + (l_pos[l_di]-1) * m_dX[l_di];
     }
+
+    // set dummy vertex type
+    o_veChars[l_ve].spType = MESH_TYPE_NONE;
   }
 }
 
@@ -1303,6 +1341,9 @@ void edge::mesh::regular::Tet::getFaChars( t_faceChars *o_faChars ) {
   getVeChars( l_veChars );
 
   // iterate over faces
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
   for( int_el l_fa = 0; l_fa < l_nFa; l_fa++ ) {
     // get the vertices
     real_mesh l_ves[3][3];
@@ -1336,14 +1377,26 @@ void edge::mesh::regular::Tet::getFaChars( t_faceChars *o_faChars ) {
   int_el (*l_elVe)[4] = ( int_el(*)[4] ) new int_el[4 * l_nEl];
   getElVe( l_elVe );
 
+  // derive the element writing the normal of each face (last adjacent element in the ordering)
+  int_el *l_faWr = new int_el[l_nFa];
+  for( int_el l_el = 0; l_el < l_nEl ; l_el++ ) {
+    for( unsigned short l_fa = 0; l_fa < 4; l_fa++ ) {
+      if( l_elFa[l_el][l_fa] != std::numeric_limits<int_el>::max() ) l_faWr[ l_elFa[l_el][l_fa] ] = l_el;
+    }
+  }
+
   // iterate over tets
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
   for( int_el l_el = 0; l_el < l_nEl ; l_el++ ) {
     // iterate over faces
     for( unsigned short l_fa = 0; l_fa < 4; l_fa++ ) {
       int_el l_faId = l_elFa[l_el][l_fa];
 
-      // ignore ghost faces
+      // ignore ghost faces and faces written by other elements
       if( l_faId == std::numeric_limits<int_el>::max() ) continue;
+      if( l_faWr[l_faId] != l_el ) continue;
 
       // get face coords
       real_mesh l_ves[3][3];
@@ -1375,6 +1428,7 @@ void edge::mesh::regular::Tet::getFaChars( t_faceChars *o_faChars ) {
   }
 
   delete[] l_faVe;
+  delete[] l_faWr;
   delete[] l_veChars;
   delete[] l_elFa;
   delete[] l_elVe;
@@ -1393,6 +1447,9 @@ void edge::mesh::regular::Tet::getElChars( t_elementChars *o_elChars ) {
   getElVe( l_elVe );
 
   // iterate over tets
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
   for( int_el l_el = 0; l_el < l_nEl ; l_el++ ) {
     // get vetex coords
     real_mesh l_ves[3][4];
@@ -1419,6 +1476,9 @@ void edge::mesh::regular::Tet::getElChars( t_elementChars *o_elChars ) {
 void edge::mesh::regular::Tet::getGIdsVe( std::vector< int_gid > &o_gIds ) {
   o_gIds.resize( m_veLayout.nEnts );
   // set info
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
   for( int_el l_gi = 0; l_gi < m_veLayout.nEnts; l_gi++ ) {
     o_gIds[l_gi] = l_gi;
   }
@@ -1427,6 +1487,9 @@ void edge::mesh::regular::Tet::getGIdsVe( std::vector< int_gid > &o_gIds ) {
 void edge::mesh::regular::Tet::getGIdsFa( std::vector< int_gid > &o_gIds ) {
   o_gIds.resize( m_faLayout.nEnts );
   // set info
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
   for( int_el l_gi = 0; l_gi < m_faLayout.nEnts; l_gi++ ) {
     o_gIds[l_gi] = l_gi;
   }
@@ -1436,23 +1499,16 @@ void edge::mesh::regular::Tet::getGIdsEl( std::vector< int_gid > &o_gIds ) {
   o_gIds.resize( m_elLayout.nEnts );
   for( std::size_t l_id = 0; l_id < o_gIds.size(); l_id++ ) o_gIds[l_id] = std::numeric_limits<int_gid>::max();
 
-  int_gid l_gTmp = 0;
-
-  // store global ids dimension wise
+  // store global ids dimension wise, every hex holds five potential tets
   // TODO: For a real global id, we would have to consider the offsets by the neighbors
-  for( int l_zh = -1; l_zh < (int) m_nHex[2]+1; l_zh++ ) {
-    for( int l_yh = -1; l_yh < (int) m_nHex[1]+1; l_yh++ ) {
-      for( int l_xh = -1; l_xh < (int) m_nHex[0]+1; l_xh++ ) {
-        unsigned int l_hx = getHxId( l_xh, l_yh, l_zh, m_nHex[0], m_nHex[1], m_nHex[2] );
-        EDGE_CHECK( l_hx < m_hexes.size() );
-
-        for( unsigned short l_te = 0; l_te < 5; l_te++ ) {
-          for( unsigned short l_el = 0; l_el < m_hexes[l_hx].el[l_te].size(); l_el++ ) {
-            int_el l_elId = m_hexes[l_hx].el[l_te][l_el];
-            o_gIds[l_elId] = l_gTmp;
-          }
-          l_gTmp++;
-        }
+#ifdef PP_USE_OMP
+#pragma omp parallel for
+#endif
+  for( std::size_t l_hx = 0; l_hx < m_hexes.size(); l_hx++ ) {
+    for( unsigned short l_te = 0; l_te < 5; l_te++ ) {
+      for( unsigned short l_el = 0; l_el < m_hexes[l_hx].el[l_te].size(); l_el++ ) {
+        int_el l_elId = m_hexes[l_hx].el[l_te][l_el];
+        o_gIds[l_elId] = (int_gid) l_hx * 5 + l_te;
       }
     }
   }
@@ -548,6 +548,28 @@ class edge::mesh::regular::Tet {
     bool isInnerEl(       unsigned short i_tet,
                     const int            i_hxPos[3] ) const;
 
+    /**
+     * Tests if the given owned hex creates the given tet-face, i.e., is the first hex in our numbering which uses the face.
+     * Remark: Receive faces at MPI-boundaries are not created by the hexes.
+     *
+     * @param i_fa tet-face within the hex.
+     * @param i_hxPos x-, y- and z-position of the owned hex.
+     * @return true if the face is created by the hex, false otherwise.
+     **/
+    bool isFaCreator(       unsigned short i_fa,
+                      const int            i_hxPos[3] ) const;
+
+    /**
+     * Tests if the given owned hex is the last hex in our numbering, which uses the given tet-face.
+     * This allows us to write face-info without races and still get the result of a serial iteration over the hexes.
+     *
+     * @param i_fa tet-face within the hex.
+     * @param i_hxPos x-, y- and z-position of the owned hex.
+     * @return true if the hex is the last one using the face, false otherwise.
+     **/
+    bool isFaWriter(       unsigned short i_fa,
+                     const int            i_hxPos[3] ) const;
+
     /**
      * Gets the index of an hex specified through x-, y-, z-position.
      *
@@ -0,0 +1,257 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @section DESCRIPTION
+ * Analytic model of the floating point operations and minimum memory traffic of the kernels.
+ **/
+
+#ifndef EDGE_MONITOR_KERNEL_MODEL_HPP
+#define EDGE_MONITOR_KERNEL_MODEL_HPP
+
+#include "constants.hpp"
+
+namespace edge {
+  namespace monitor {
+    template< t_entityType   TL_T_EL,
+              unsigned short TL_O_SP,
+              unsigned short TL_N_QTS,
+              unsigned short TL_N_CRUNS,
+              typename       TL_T_REAL >
+    class KernelModel;
+  }
+}
+
+/**
+ * Work of the kernels per processed entity, derived from the compile time shapes.
+ * The nominal FLOPs assume dense matrices; the sparse FLOPs use the non-zero blocks of the hierarchical bases in the
+ * Cauchy-Kowalevski procedure and volume integration (see CE_N_ELEMENT_MODES_CK) and the non-zeros of the star matrices.
+ * The minimum bytes count compulsory traffic of entity-local data only: global matrices are assumed to be cached and
+ * data of neighbors to be reused.
+ *
+ * Entries of the work: [0]: nominal FLOPs, [1]: sparse FLOPs, [2]: bytes.
+ *
+ * @paramt TL_T_EL element type.
+ * @paramt TL_O_SP order in space.
+ * @paramt TL_N_QTS number of quantities.
+ * @paramt TL_N_CRUNS number of concurrent forward runs (fused simulations).
+ * @paramt TL_T_REAL floating point type.
+ **/
+template< t_entityType   TL_T_EL,
+          unsigned short TL_O_SP,
+          unsigned short TL_N_QTS,
+          unsigned short TL_N_CRUNS,
+          typename       TL_T_REAL >
+class edge::monitor::KernelModel {
+  private:
+    // assemble derived template parameters
+    //! dimension of the element
+    static unsigned short const TL_N_DIM = C_ENT[TL_T_EL].N_DIM;
+    //! number of faces
+    static unsigned short const TL_N_FAS = C_ENT[TL_T_EL].N_FACES;
+    //! number of element modes
+    static unsigned short const TL_N_MDS = CE_N_ELEMENT_MODES( TL_T_EL, TL_O_SP );
+    //! number of face modes
+    static unsigned short const TL_N_FA_MDS = CE_N_ELEMENT_MODES( C_ENT[TL_T_EL].TYPE_FACES, TL_O_SP );
+    //! number of quadrature points per face
+    static unsigned short const TL_N_FA_QPS = CE_N_FACE_QUAD_POINTS( TL_T_EL, TL_O_SP );
+    //! number of entries of the DOFs
+    static unsigned int const TL_N_DOFS = TL_N_QTS * TL_N_MDS * TL_N_CRUNS;
+
+    /**
+     * Gets the FLOPs of a matrix-matrix multiplication, applied to all concurrent runs.
+     *
+     * @param i_m number of rows.
+     * @param i_n number of columns.
+     * @param i_k inner dimension.
+     * @return FLOPs.
+     **/
+    static double mm( double i_m,
+                      double i_n,
+                      double i_k ) {
+      return 2 * i_m * i_n * i_k * TL_N_CRUNS;
+    }
+
+    /**
+     * Gets the FLOPs of the surface contribution of a single face: projection to the face, flux solver, lifting.
+     *
+     * @return FLOPs.
+     **/
+    static double face() {
+      return mm( TL_N_QTS, TL_N_FA_MDS, TL_N_MDS ) + mm( TL_N_QTS, TL_N_FA_MDS, TL_N_QTS ) + mm( TL_N_QTS, TL_N_MDS, TL_N_FA_MDS );
+    }
+
+  public:
+    /**
+     * Work of the time prediction: Cauchy-Kowalevski procedure and scaled accumulation of the time integrated DOFs.
+     *
+     * @param i_nzStar number of non-zeros in each of the star matrices.
+     * @param o_work will be set to the work.
+     **/
+    static void timePred( unsigned short i_nzStar,
+                          double         o_work[3] ) {
+      o_work[0] = o_work[1] = TL_N_DOFS;
+
+      for( unsigned short l_de = 1; l_de < TL_O_SP; l_de++ ) {
+        double l_nDe[2] = { (double) CE_N_ELEMENT_MODES_CK( TL_T_EL, TL_O_SP, l_de-1 ),
+                            (double) CE_N_ELEMENT_MODES_CK( TL_T_EL, TL_O_SP, l_de   ) };
+
+        o_work[0] += TL_N_DIM * ( mm( TL_N_QTS, TL_N_MDS, TL_N_MDS ) + mm( TL_N_QTS, TL_N_MDS, TL_N_QTS ) );
+        o_work[1] += TL_N_DIM * ( mm( TL_N_QTS, l_nDe[1], l_nDe[0] ) + 2.0 * i_nzStar * l_nDe[1] * TL_N_CRUNS );
+
+        o_work[0] += 2.0 * TL_N_DOFS;
+        o_work[1] += 2.0 * TL_N_QTS * l_nDe[1] * TL_N_CRUNS;
+      }
+
+      // DOFs: read, time integrated DOFs: write, star matrices: read
+      o_work[2] = ( 2.0 * TL_N_DOFS + TL_N_DIM * i_nzStar ) * sizeof(TL_T_REAL);
+    }
+
+    /**
+     * Work of the volume integration.
+     *
+     * @param i_nzStar number of non-zeros in each of the star matrices.
+     * @param o_work will be set to the work.
+     **/
+    static void volInt( unsigned short i_nzStar,
+                        double         o_work[3] ) {
+      o_work[0] = o_work[1] = 0;
+
+      // derivatives of the basis span one degree less
+      if( TL_O_SP > 1 ) {
+        double l_nDe = CE_N_ELEMENT_MODES_CK( TL_T_EL, TL_O_SP, 1 );
+
+        o_work[0] += TL_N_DIM * ( mm( TL_N_QTS, TL_N_MDS, TL_N_MDS ) + mm( TL_N_QTS, TL_N_MDS, TL_N_QTS ) );
+        o_work[1] += TL_N_DIM * ( mm( TL_N_QTS, TL_N_MDS, l_nDe )    + 2.0 * i_nzStar * TL_N_MDS * TL_N_CRUNS );
+      }
+
+      // time integrated DOFs: read, DOFs: read and write, star matrices: read
+      o_work[2] = ( 3.0 * TL_N_DOFS + TL_N_DIM * i_nzStar ) * sizeof(TL_T_REAL);
+    }
+
+    /**
+     * Work of the local surface integration.
+     *
+     * @param o_work will be set to the work.
+     **/
+    static void surfLocal( double o_work[3] ) {
+      o_work[0] = o_work[1] = TL_N_FAS * face();
+
+      // time integrated DOFs: read, DOFs: read and write, local flux solvers: read
+      o_work[2] = ( 3.0 * TL_N_DOFS + TL_N_FAS * TL_N_QTS * TL_N_QTS ) * sizeof(TL_T_REAL);
+    }
+
+    /**
+     * Work of the local step: time prediction, volume and local surface contribution.
+     *
+     * @param i_nzStar number of non-zeros in each of the star matrices.
+     * @param o_work will be set to the work.
+     **/
+    static void local( unsigned short i_nzStar,
+                       double         o_work[3] ) {
+      double l_vol[3], l_surf[3];
+      timePred( i_nzStar, o_work );
+      volInt( i_nzStar, l_vol );
+      surfLocal( l_surf );
+
+      for( unsigned short l_en = 0; l_en < 2; l_en++ ) o_work[l_en] += l_vol[l_en] + l_surf[l_en];
+
+      // DOFs: read and write, time integrated DOFs: write, star matrices and local flux solvers: read
+      o_work[2] = ( 3.0 * TL_N_DOFS + TL_N_DIM * i_nzStar + TL_N_FAS * TL_N_QTS * TL_N_QTS ) * sizeof(TL_T_REAL);
+    }
+
+    /**
+     * Work of the neighboring step: surface contribution of the face-neighbors.
+     *
+     * @param o_work will be set to the work.
+     **/
+    static void neigh( double o_work[3] ) {
+      o_work[0] = o_work[1] = TL_N_FAS * face();
+
+      // time integrated DOFs: read, DOFs: read and write, neighboring flux solvers and connectivity: read
+      o_work[2]  = ( 3.0 * TL_N_DOFS + TL_N_FAS * TL_N_QTS * TL_N_QTS ) * sizeof(TL_T_REAL);
+      o_work[2] += TL_N_FAS * ( 2 * sizeof(int_el) + 2 * sizeof(unsigned short) );
+    }
+
+    /**
+     * Work of the fused local and neighboring step; the DOFs stay in cache between the two.
+     *
+     * @param i_nzStar number of non-zeros in each of the star matrices.
+     * @param o_work will be set to the work.
+     **/
+    static void localNeigh( unsigned short i_nzStar,
+                            double         o_work[3] ) {
+      double l_neigh[3];
+      local( i_nzStar, o_work );
+      neigh( l_neigh );
+
+      for( unsigned short l_en = 0; l_en < 3; l_en++ ) o_work[l_en] += l_neigh[l_en];
+      o_work[2] -= 2.0 * TL_N_DOFS * sizeof(TL_T_REAL);
+    }
+
+    /**
+     * Work of a rupture face: evaluation of both sides at the quadrature points, solvers at the points and lifting to both elements.
+     * The friction law is not accounted for.
+     *
+     * @param o_work will be set to the work.
+     **/
+    static void rupture( double o_work[3] ) {
+      o_work[0] = o_work[1] = 2 * (   mm( TL_N_QTS, TL_N_FA_QPS, TL_N_MDS )
+                                    + mm( TL_N_QTS, TL_N_FA_QPS, TL_N_QTS )
+                                    + mm( TL_N_QTS, TL_N_MDS,    TL_N_FA_QPS ) );
+
+      // time integrated DOFs: read, updates: write, solvers: read
+      o_work[2] = ( 4.0 * TL_N_DOFS + 4 * TL_N_QTS * TL_N_QTS ) * sizeof(TL_T_REAL);
+    }
+
+    /**
+     * Work of linear slip weakening at a single point of a fault, applied to all concurrent runs.
+     * Counts the operations of elastic::solvers::LinSlipWeak::linSlipWeakBatch, where additions, multiplications,
+     * divisions, absolute values and square roots are one FLOP each; comparisons, sign switches and selects are free.
+     *
+     * 2D: strength (2), failure (2), traction (2), velocity difference (1), perturbed velocities (4), slip rate (1),
+     *     slip (3), friction coefficient (2), output traction (1): 18.
+     * 3D: strength (2), total shear stresses (2), magnitude of the shear stress (4), scaling (1), tractions (4),
+     *     velocity differences (2), perturbed velocities (8), slip rates (2), slip (6), friction coefficient (6),
+     *     output tractions (2): 39.
+     *
+     * @param o_work will be set to the work.
+     **/
+    static void friction( double o_work[3] ) {
+      o_work[0] = o_work[1] = ( (TL_N_DIM == 2) ? 18 : 39 ) * TL_N_CRUNS;
+
+      // middle states: read, left and right perturbed states: write, point-data: read and write, face-data: read
+      o_work[2] = ( 3.0 * TL_N_QTS + 2.0 * ( 3 + 4 * (TL_N_DIM-1) ) ) * TL_N_CRUNS * sizeof(TL_T_REAL);
+      o_work[2] += 2 * sizeof(TL_T_REAL);
+    }
+
+    /**
+     * Work of a point source: time integrated contribution of all quantities to the modes of the element.
+     *
+     * @param o_work will be set to the work.
+     **/
+    static void source( double o_work[3] ) {
+      o_work[0] = o_work[1] = 2.0 * TL_N_DOFS;
+
+      // DOFs: read and write
+      o_work[2] = 2.0 * TL_N_DOFS * sizeof(TL_T_REAL);
+    }
+};
+
+#endif
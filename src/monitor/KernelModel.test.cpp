@@ -0,0 +1,100 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @section DESCRIPTION
+ * Unit tests of the analytic kernel model.
+ **/
+
+#include <catch.hpp>
+#include "KernelModel.hpp"
+
+TEST_CASE( "KernelModel: Elastic tetrahedrons, second order, double precision.", "[KernelModel]" ) {
+  // 4 modes, 9 quantities, 1 run: 36 DOFs; 3 face modes
+  typedef edge::monitor::KernelModel< TET4, 2, 9, 1, double > t_model;
+
+  double l_work[3];
+
+  // CK: DOFs copy (36), one derivative (dense: 3*(2*9*4*4 + 2*9*4*9) + 2*36, sparse: 3*(2*9*1*4 + 2*24*1) + 2*9)
+  t_model::timePred( 24, l_work );
+  REQUIRE( l_work[0] == Approx( 2916 ) );
+  REQUIRE( l_work[1] == Approx(  414 ) );
+  REQUIRE( l_work[2] == Approx( (2*36 + 3*24) * 8 ) );
+
+  // volume: dense 3*(2*9*4*4 + 2*9*4*9), sparse 3*(2*9*4*1 + 2*24*4)
+  t_model::volInt( 24, l_work );
+  REQUIRE( l_work[0] == Approx( 2808 ) );
+  REQUIRE( l_work[1] == Approx(  792 ) );
+  REQUIRE( l_work[2] == Approx( (3*36 + 3*24) * 8 ) );
+
+  // surface: 4 * (2*9*3*4 + 2*9*3*9 + 2*9*4*3)
+  t_model::surfLocal( l_work );
+  REQUIRE( l_work[0] == Approx( 3672 ) );
+  REQUIRE( l_work[1] == Approx( 3672 ) );
+  REQUIRE( l_work[2] == Approx( (3*36 + 4*81) * 8 ) );
+
+  t_model::local( 24, l_work );
+  REQUIRE( l_work[0] == Approx( 2916 + 2808 + 3672 ) );
+  REQUIRE( l_work[1] == Approx(  414 +  792 + 3672 ) );
+  REQUIRE( l_work[2] == Approx( (3*36 + 3*24 + 4*81) * 8 ) );
+
+  double l_neighBytes = (3*36 + 4*81) * 8 + 4 * ( 2*sizeof(int_el) + 2*sizeof(unsigned short) );
+  t_model::neigh( l_work );
+  REQUIRE( l_work[0] == Approx( 3672 ) );
+  REQUIRE( l_work[1] == Approx( 3672 ) );
+  REQUIRE( l_work[2] == Approx( l_neighBytes ) );
+
+  // DOFs are read and written once less than in two separate sweeps
+  t_model::localNeigh( 24, l_work );
+  REQUIRE( l_work[0] == Approx( 2916 + 2808 + 3672 + 3672 ) );
+  REQUIRE( l_work[1] == Approx(  414 +  792 + 3672 + 3672 ) );
+  REQUIRE( l_work[2] == Approx( (3*36 + 3*24 + 4*81) * 8 + l_neighBytes - 2*36*8 ) );
+
+  // middle states and perturbed states: 3*9, point data: 2*(3+4*2), face-data: 2
+  t_model::friction( l_work );
+  REQUIRE( l_work[0] == Approx( 39 ) );
+  REQUIRE( l_work[1] == Approx( 39 ) );
+  REQUIRE( l_work[2] == Approx( (27 + 22 + 2) * 8 ) );
+
+  // point source: scaled update of all DOFs
+  t_model::source( l_work );
+  REQUIRE( l_work[0] == Approx( 72 ) );
+  REQUIRE( l_work[1] == Approx( 72 ) );
+  REQUIRE( l_work[2] == Approx( 72*8 ) );
+}
+
+TEST_CASE( "KernelModel: Fused forward runs, single precision.", "[KernelModel]" ) {
+  typedef edge::monitor::KernelModel< TET4, 2, 9, 1,  float > t_single;
+  typedef edge::monitor::KernelModel< TET4, 2, 9, 8,  float > t_fused;
+
+  double l_single[3], l_fused[3];
+
+  // FLOPs and DOF-traffic scale with the number of runs, the star matrices are shared
+  t_single::local( 24, l_single );
+  t_fused::local(  24, l_fused  );
+  REQUIRE( l_fused[0] == Approx( 8 * l_single[0] ) );
+  REQUIRE( l_fused[1] == Approx( 8 * l_single[1] ) );
+  REQUIRE( l_single[2] == Approx(  (3*36 + 3*24 + 4*81) * 4 ) );
+  REQUIRE( l_fused[2]  == Approx(  (3*36*8 + 3*24 + 4*81) * 4 ) );
+
+  t_single::friction( l_single );
+  t_fused::friction(  l_fused  );
+  REQUIRE( l_fused[0] == Approx( 8 * 39 ) );
+  REQUIRE( l_fused[2] == Approx( (27 + 22) * 8 * 4 + 2 * 4 ) );
+}
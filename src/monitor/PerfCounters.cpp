@@ -0,0 +1,207 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @section DESCRIPTION
+ * Hardware performance counters of the calling thread through Linux' perf_event_open.
+ **/
+#include "PerfCounters.h"
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#ifdef __linux__
+namespace {
+  /**
+   * Checks if we are running on an Intel CPU.
+   *
+   * @return true if Intel, false otherwise.
+   **/
+  bool isIntel() {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int l_regs[4] = {0, 0, 0, 0};
+    if( __get_cpuid( 0, l_regs, l_regs+1, l_regs+2, l_regs+3 ) == 0 ) return false;
+
+    // vendor string is given in ebx, edx, ecx
+    char l_vendor[13];
+    std::memcpy( l_vendor,   l_regs+1, 4 );
+    std::memcpy( l_vendor+4, l_regs+3, 4 );
+    std::memcpy( l_vendor+8, l_regs+2, 4 );
+    l_vendor[12] = '\0';
+
+    return std::strcmp( l_vendor, "GenuineIntel" ) == 0;
+#else
+    return false;
+#endif
+  }
+}
+#endif
+
+edge::monitor::PerfCounters::PerfCounters(): m_open(false) {
+  for( unsigned short l_gr = 0; l_gr < N_GROUPS; l_gr++ ) {
+    m_nEvents[l_gr] = 0;
+    for( unsigned short l_ev = 0; l_ev < N_EVENTS_MAX; l_ev++ ) {
+      m_fds[l_gr][l_ev] = -1;
+      m_vals[l_gr][l_ev] = N_VALUES;
+      m_weights[l_gr][l_ev] = 0;
+    }
+  }
+}
+
+edge::monitor::PerfCounters::~PerfCounters() {
+  close();
+}
+
+int edge::monitor::PerfCounters::openEvent( uint32_t i_type,
+                                            uint64_t i_config,
+                                            int      i_leader ) {
+#ifdef __linux__
+  perf_event_attr l_attr;
+  std::memset( &l_attr, 0, sizeof(l_attr) );
+  l_attr.size = sizeof(l_attr);
+  l_attr.type = i_type;
+  l_attr.config = i_config;
+  l_attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // user space only, works with perf_event_paranoid <= 2
+  l_attr.exclude_kernel = 1;
+  l_attr.exclude_hv = 1;
+  // leaders start disabled and enable the entire group
+  l_attr.disabled = (i_leader == -1) ? 1 : 0;
+
+  // calling thread on any cpu
+  long l_fd = syscall( __NR_perf_event_open, &l_attr, 0, -1, i_leader, 0 );
+  return (l_fd < 0) ? -1 : (int) l_fd;
+#else
+  return -1;
+#endif
+}
+
+bool edge::monitor::PerfCounters::add( unsigned short i_gr,
+                                       uint32_t       i_type,
+                                       uint64_t       i_config,
+                                       Value          i_val,
+                                       double         i_weight ) {
+  unsigned short l_ev = m_nEvents[i_gr];
+  if( l_ev >= N_EVENTS_MAX ) return false;
+
+  int l_fd = openEvent( i_type, i_config, (l_ev == 0) ? -1 : m_fds[i_gr][0] );
+  if( l_fd == -1 ) return false;
+
+  m_fds[i_gr][l_ev] = l_fd;
+  m_vals[i_gr][l_ev] = i_val;
+  m_weights[i_gr][l_ev] = i_weight;
+  m_nEvents[i_gr]++;
+
+  return true;
+}
+
+bool edge::monitor::PerfCounters::open( bool i_fp32 ) {
+  close();
+
+#ifdef __linux__
+  // generic events, cycles lead the group
+  if( add( 0, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, CYCLES, 1 ) ) {
+    add( 0, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS,  INSTRUCTIONS, 1 );
+    add( 0, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES,  LLC_MISSES,   1 );
+  }
+  else return false;
+
+  // FP_ARITH_INST_RETIRED (event 0xC7): scalar, 128, 256 and 512 bit; FMAs count twice
+  if( isIntel() ) {
+    // umasks and weights: [0]: double precision, [1]: single precision
+    uint64_t const l_umasks[2][4]  = { { 0x01, 0x04, 0x10, 0x40 }, { 0x02, 0x08, 0x20, 0x80 } };
+    double   const l_weights[2][4] = { {    1,    2,    4,    8 }, {    1,    4,    8,   16 } };
+    unsigned short l_pr = (i_fp32) ? 1 : 0;
+
+    for( unsigned short l_ev = 0; l_ev < 4; l_ev++ ) {
+      add( 1, PERF_TYPE_RAW, (l_umasks[l_pr][l_ev] << 8) | 0xC7, FP_OPS, l_weights[l_pr][l_ev] );
+    }
+  }
+
+  for( unsigned short l_gr = 0; l_gr < N_GROUPS; l_gr++ ) {
+    if( m_nEvents[l_gr] > 0 ) {
+      ioctl( m_fds[l_gr][0], PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP );
+      ioctl( m_fds[l_gr][0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP );
+    }
+  }
+
+  m_open = true;
+#endif
+
+  return m_open;
+}
+
+void edge::monitor::PerfCounters::close() {
+  for( unsigned short l_gr = 0; l_gr < N_GROUPS; l_gr++ ) {
+    for( unsigned short l_ev = 0; l_ev < N_EVENTS_MAX; l_ev++ ) {
+#ifdef __linux__
+      if( m_fds[l_gr][l_ev] != -1 ) ::close( m_fds[l_gr][l_ev] );
+#endif
+      m_fds[l_gr][l_ev] = -1;
+      m_vals[l_gr][l_ev] = N_VALUES;
+    }
+    m_nEvents[l_gr] = 0;
+  }
+  m_open = false;
+}
+
+bool edge::monitor::PerfCounters::available( Value i_val ) const {
+  if( i_val == TIME ) return m_nEvents[0] > 0;
+
+  for( unsigned short l_gr = 0; l_gr < N_GROUPS; l_gr++ ) {
+    for( unsigned short l_ev = 0; l_ev < m_nEvents[l_gr]; l_ev++ ) {
+      if( m_vals[l_gr][l_ev] == i_val ) return true;
+    }
+  }
+
+  return false;
+}
+
+void edge::monitor::PerfCounters::read( double o_vals[N_VALUES] ) const {
+  for( unsigned short l_va = 0; l_va < N_VALUES; l_va++ ) o_vals[l_va] = 0;
+
+#ifdef __linux__
+  for( unsigned short l_gr = 0; l_gr < N_GROUPS; l_gr++ ) {
+    if( m_nEvents[l_gr] == 0 ) continue;
+
+    // layout of PERF_FORMAT_GROUP: #events, time enabled, time running, values
+    uint64_t l_buf[3+N_EVENTS_MAX];
+    ssize_t l_size = ::read( m_fds[l_gr][0], l_buf, sizeof(l_buf) );
+    if( l_size < (ssize_t) (3*sizeof(uint64_t)) || l_buf[0] != m_nEvents[l_gr] ) continue;
+
+    // scale multiplexed groups
+    double l_scale = (l_buf[2] > 0) ? double(l_buf[1]) / double(l_buf[2]) : 0;
+
+    for( unsigned short l_ev = 0; l_ev < m_nEvents[l_gr]; l_ev++ ) {
+      o_vals[ m_vals[l_gr][l_ev] ] += m_weights[l_gr][l_ev] * l_scale * l_buf[3+l_ev];
+    }
+
+    if( l_gr == 0 ) o_vals[TIME] = l_buf[1] * 1E-9;
+  }
+#endif
+}
@@ -0,0 +1,148 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @section DESCRIPTION
+ * Hardware performance counters of the calling thread through Linux' perf_event_open.
+ *
+ * Two counter groups are used:
+ *   0) cycles, instructions and last level cache misses (generic events),
+ *   1) retired floating point operations, available through raw events on Intel (FP_ARITH_INST_RETIRED).
+ * Unavailable counters (no Linux, restrictive perf_event_paranoid, containers, virtualized PMUs) are skipped
+ * and report zero; the counts of multiplexed groups are scaled by their running times.
+ **/
+
+#ifndef EDGE_MONITOR_PERF_COUNTERS_H_
+#define EDGE_MONITOR_PERF_COUNTERS_H_
+
+#include <cstdint>
+
+namespace edge {
+  namespace monitor {
+    class PerfCounters;
+  }
+}
+
+class edge::monitor::PerfCounters {
+  public:
+    //! values of the counters
+    enum Value {
+      CYCLES       = 0,
+      INSTRUCTIONS = 1,
+      LLC_MISSES   = 2,
+      FP_OPS       = 3,
+      TIME         = 4,
+      N_VALUES     = 5
+    };
+
+  private:
+    //! number of groups
+    static unsigned short const N_GROUPS = 2;
+
+    //! maximum number of events per group
+    static unsigned short const N_EVENTS_MAX = 4;
+
+    //! file descriptors of the events, -1 if not available
+    int m_fds[N_GROUPS][N_EVENTS_MAX];
+
+    //! value which is incremented by the events
+    unsigned short m_vals[N_GROUPS][N_EVENTS_MAX];
+
+    //! weights of the events
+    double m_weights[N_GROUPS][N_EVENTS_MAX];
+
+    //! number of opened events per group
+    unsigned short m_nEvents[N_GROUPS];
+
+    //! true if the counters were opened
+    bool m_open;
+
+    /**
+     * Opens an event.
+     *
+     * @param i_type type of the event.
+     * @param i_config config of the event.
+     * @param i_leader file descriptor of the group leader, -1 for a new group.
+     * @return file descriptor, -1 if the event is not available.
+     **/
+    static int openEvent( uint32_t i_type,
+                          uint64_t i_config,
+                          int      i_leader );
+
+    /**
+     * Adds an event to the given group, the first event of a group becomes the leader.
+     *
+     * @param i_gr group.
+     * @param i_type type of the event.
+     * @param i_config config of the event.
+     * @param i_val value which is incremented by the event.
+     * @param i_weight weight of the event.
+     * @return true if the event was added.
+     **/
+    bool add( unsigned short i_gr,
+              uint32_t       i_type,
+              uint64_t       i_config,
+              Value          i_val,
+              double         i_weight );
+
+  public:
+    /**
+     * Constructor, the counters are opened through open().
+     **/
+    PerfCounters();
+
+    /**
+     * Destructor, closes the counters.
+     **/
+    ~PerfCounters();
+
+    // counters are bound to their file descriptors
+    PerfCounters( PerfCounters const & ) = delete;
+    PerfCounters & operator=( PerfCounters const & ) = delete;
+
+    /**
+     * Opens and starts the counters for the calling thread.
+     *
+     * @param i_fp32 true if single precision floating point operations are counted, false for double precision.
+     * @return true if at least the cycles are available.
+     **/
+    bool open( bool i_fp32 );
+
+    /**
+     * Closes the counters.
+     **/
+    void close();
+
+    /**
+     * Checks if the given value is available.
+     *
+     * @param i_val value.
+     * @return true if available.
+     **/
+    bool available( Value i_val ) const;
+
+    /**
+     * Reads the current values (counts since opening, time in seconds).
+     *
+     * @param o_vals will be set to the values, zero if unavailable.
+     **/
+    void read( double o_vals[N_VALUES] ) const;
+};
+
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @section DESCRIPTION
+ * Unit tests of the hardware performance counters.
+ **/
+
+#include <catch.hpp>
+#include "PerfCounters.h"
+
+TEST_CASE( "Performance counters: open, read and close.", "[PerfCounters]" ) {
+  edge::monitor::PerfCounters l_cnts;
+  double l_vals[2][edge::monitor::PerfCounters::N_VALUES];
+
+  // closed counters read zero
+  l_cnts.read( l_vals[0] );
+  for( unsigned short l_va = 0; l_va < edge::monitor::PerfCounters::N_VALUES; l_va++ ) {
+    REQUIRE( l_vals[0][l_va] == 0 );
+    REQUIRE( !l_cnts.available( edge::monitor::PerfCounters::Value(l_va) ) );
+  }
+
+  // counters might be unavailable, e.g., in containers
+  bool l_open = l_cnts.open( false );
+  REQUIRE( l_open == l_cnts.available( edge::monitor::PerfCounters::CYCLES ) );
+  REQUIRE( l_open == l_cnts.available( edge::monitor::PerfCounters::TIME ) );
+
+  l_cnts.read( l_vals[0] );
+  volatile double l_sum = 0;
+  for( unsigned int l_it = 0; l_it < 100000; l_it++ ) l_sum += l_it * 0.5;
+  l_cnts.read( l_vals[1] );
+
+  for( unsigned short l_va = 0; l_va < edge::monitor::PerfCounters::N_VALUES; l_va++ ) {
+    REQUIRE( l_vals[1][l_va] >= l_vals[0][l_va] );
+  }
+  if( l_open ) REQUIRE( l_vals[1][edge::monitor::PerfCounters::CYCLES] > l_vals[0][edge::monitor::PerfCounters::CYCLES] );
+
+  l_cnts.close();
+  l_cnts.read( l_vals[0] );
+  REQUIRE( l_vals[0][edge::monitor::PerfCounters::CYCLES] == 0 );
+}
@@ -0,0 +1,158 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @section DESCRIPTION
+ * Hierarchical registry of (initialization) phases.
+ **/
+#include "Phases.h"
+#include "Timer.hpp"
+#include "parallel/global.h"
+#include "io/logging.h"
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#ifdef PP_USE_MPI
+#include "parallel/mpi_wrapper.inc"
+#endif
+
+void edge::monitor::Phases::getMem( double & o_rss,
+                                    double & o_hwm ) {
+  o_rss = 0;
+  o_hwm = 0;
+
+  // sizes are given in KiB
+  std::ifstream l_status("/proc/self/status");
+  std::string l_key;
+  while( l_status >> l_key ) {
+    if(      l_key == "VmRSS:" ) { l_status >> o_rss; o_rss *= 1024; }
+    else if( l_key == "VmHWM:" ) { l_status >> o_hwm; o_hwm *= 1024; }
+  }
+}
+
+void edge::monitor::Phases::start( std::string const & i_name ) {
+  std::size_t l_parent = m_active.size() > 0 ? m_active.back() : std::size_t(-1);
+
+  // find the phase among the children of the active phase
+  std::size_t l_id = 0;
+  for( ; l_id < m_phases.size(); l_id++ )
+    if( m_phases[l_id].parent == l_parent && m_phases[l_id].name == i_name ) break;
+
+  if( l_id == m_phases.size() ) {
+    Phase l_phase;
+    l_phase.name   = i_name;
+    l_phase.parent = l_parent;
+    l_phase.depth  = m_active.size();
+    l_phase.nCalls = 0;
+    l_phase.time   = 0;
+    l_phase.rss    = 0;
+    l_phase.hwm    = 0;
+
+    // insert after the last descendant of the parent to keep children next to their parents
+    std::size_t l_pos = m_phases.size();
+    if( l_parent != std::size_t(-1) ) {
+      l_pos = l_parent+1;
+      while( l_pos < m_phases.size() && m_phases[l_pos].depth > m_phases[l_parent].depth ) l_pos++;
+
+      // shift the ids of the parents behind the new phase
+      for( std::size_t l_ph = l_pos; l_ph < m_phases.size(); l_ph++ )
+        if( m_phases[l_ph].parent != std::size_t(-1) && m_phases[l_ph].parent >= l_pos ) m_phases[l_ph].parent++;
+      for( std::size_t l_ac = 0; l_ac < m_active.size(); l_ac++ )
+        if( m_active[l_ac] >= l_pos ) m_active[l_ac]++;
+    }
+
+    m_phases.insert( m_phases.begin()+l_pos, l_phase );
+    l_id = l_pos;
+  }
+
+  double l_rss, l_hwm;
+  getMem( l_rss, l_hwm );
+
+  m_active.push_back( l_id );
+  m_rss.push_back( l_rss );
+  m_hwm.push_back( l_hwm );
+  m_time.push_back( Timer::getWtime() );
+}
+
+void edge::monitor::Phases::end() {
+  EDGE_CHECK( !m_active.empty() ) << "no active phase";
+
+  double l_time = Timer::getWtime();
+  double l_rss, l_hwm;
+  getMem( l_rss, l_hwm );
+
+  Phase & l_phase = m_phases[ m_active.back() ];
+  l_phase.nCalls++;
+  l_phase.time += l_time - m_time.back();
+  l_phase.rss  += l_rss  - m_rss.back();
+  l_phase.hwm  += l_hwm  - m_hwm.back();
+
+  m_active.pop_back();
+  m_time.pop_back();
+  m_rss.pop_back();
+  m_hwm.pop_back();
+}
+
+void edge::monitor::Phases::print( std::string const & i_title ) const {
+  // local stats: time, rss, hwm
+  std::size_t l_nPhs = m_phases.size();
+  std::vector< double > l_loc( l_nPhs * 3 );
+  for( std::size_t l_ph = 0; l_ph < l_nPhs; l_ph++ ) {
+    l_loc[l_ph*3 + 0] = m_phases[l_ph].time;
+    l_loc[l_ph*3 + 1] = m_phases[l_ph].rss;
+    l_loc[l_ph*3 + 2] = m_phases[l_ph].hwm;
+  }
+
+  std::vector< double > l_max = l_loc;
+  std::vector< double > l_ave = l_loc;
+
+#ifdef PP_USE_MPI
+  // the reductions require matching phases on all ranks
+  unsigned long l_nPhsLoc = l_nPhs;
+  unsigned long l_nPhsMinMax[2];
+  int l_err = MPI_Allreduce( &l_nPhsLoc, l_nPhsMinMax+0, 1, MPI_UNSIGNED_LONG, MPI_MIN, MPI_COMM_WORLD );
+  EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+  l_err = MPI_Allreduce( &l_nPhsLoc, l_nPhsMinMax+1, 1, MPI_UNSIGNED_LONG, MPI_MAX, MPI_COMM_WORLD );
+  EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+
+  if( l_nPhsMinMax[0] == l_nPhsMinMax[1] ) {
+    l_err = MPI_Allreduce( l_loc.data(), l_max.data(), l_nPhs*3, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
+    EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+    l_err = MPI_Allreduce( l_loc.data(), l_ave.data(), l_nPhs*3, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+    EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+    for( std::size_t l_va = 0; l_va < l_ave.size(); l_va++ ) l_ave[l_va] /= parallel::g_nRanks;
+  }
+  else {
+    EDGE_LOG_WARNING << "phases differ across ranks, printing the local statistics only";
+  }
+#endif
+
+  double l_mib = 1024 * 1024;
+
+  EDGE_LOG_INFO << i_title << " (time max/ave [s], rss delta max/ave [MiB], peak rss delta max/ave [MiB]):";
+  for( std::size_t l_ph = 0; l_ph < l_nPhs; l_ph++ ) {
+    std::ostringstream l_line;
+    l_line << std::fixed << std::setprecision(3)
+           << std::string( 2 * (m_phases[l_ph].depth+1), ' ' ) << m_phases[l_ph].name << ": "
+           << l_max[l_ph*3 + 0]         << " / " << l_ave[l_ph*3 + 0]         << ", "
+           << l_max[l_ph*3 + 1] / l_mib << " / " << l_ave[l_ph*3 + 1] / l_mib << ", "
+           << l_max[l_ph*3 + 2] / l_mib << " / " << l_ave[l_ph*3 + 2] / l_mib;
+    EDGE_LOG_INFO << l_line.str();
+  }
+}
@@ -0,0 +1,123 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @section DESCRIPTION
+ * Hierarchical registry of (initialization) phases.
+ *
+ * Phases are started and ended in a nested fashion, the n-th start of a phase with the same name and parent
+ * accumulates into the same entry. Every phase records its wall-clock time, the change of the resident set size
+ * and the change of the peak resident set size (high-water mark) of the process.
+ * The report reduces the statistics over all ranks and requires that all ranks pass the same phases.
+ **/
+
+#ifndef EDGE_MONITOR_PHASES_H_
+#define EDGE_MONITOR_PHASES_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace edge {
+  namespace monitor {
+    class Phases;
+  }
+}
+
+class edge::monitor::Phases {
+  public:
+    //! statistics of a phase
+    struct Phase {
+      //! name of the phase
+      std::string name;
+
+      //! id of the parent phase, std::size_t(-1) for top-level phases
+      std::size_t parent;
+
+      //! nesting depth, 0 for top-level phases
+      unsigned short depth;
+
+      //! number of times the phase was ended
+      std::size_t nCalls;
+
+      //! accumulated wall-clock time in seconds
+      double time;
+
+      //! accumulated change of the resident set size in bytes
+      double rss;
+
+      //! accumulated change of the peak resident set size in bytes
+      double hwm;
+    };
+
+  private:
+    //! phases in order of their first start
+    std::vector< Phase > m_phases;
+
+    //! ids of the active phases, innermost last
+    std::vector< std::size_t > m_active;
+
+    //! start times of the active phases
+    std::vector< double > m_time;
+
+    //! resident set sizes at the starts of the active phases
+    std::vector< double > m_rss;
+
+    //! peak resident set sizes at the starts of the active phases
+    std::vector< double > m_hwm;
+
+  public:
+    /**
+     * Gets the resident set size and its peak from /proc/self/status.
+     *
+     * @param o_rss will be set to the resident set size in bytes, 0 if not available.
+     * @param o_hwm will be set to the peak resident set size in bytes, 0 if not available.
+     **/
+    static void getMem( double & o_rss,
+                        double & o_hwm );
+
+    /**
+     * Starts a phase, which is nested in the innermost active phase.
+     *
+     * @param i_name name of the phase.
+     **/
+    void start( std::string const & i_name );
+
+    /**
+     * Ends the innermost active phase.
+     **/
+    void end();
+
+    /**
+     * Gets the phases in order of their first start; children follow their parents.
+     *
+     * @return phases.
+     **/
+    std::vector< Phase > const & get() const { return m_phases; }
+
+    /**
+     * Prints the max and average of the phases' statistics over all ranks.
+     * Collective call if MPI is used.
+     *
+     * @param i_title title of the report.
+     **/
+    void print( std::string const & i_title ) const;
+};
+
+#endif
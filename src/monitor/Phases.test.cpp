@@ -0,0 +1,81 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @section DESCRIPTION
+ * Unit tests of the registry of phases.
+ **/
+
+#include <catch.hpp>
+#include "Phases.h"
+#include <vector>
+
+TEST_CASE( "Phases: nesting, accumulation and memory.", "[Phases]" ) {
+  edge::monitor::Phases l_phases;
+
+  l_phases.start( "a" );
+    l_phases.start( "b" );
+    l_phases.end();
+  l_phases.end();
+
+  l_phases.start( "c" );
+    // allocate and touch 64 MiB, which increases the peak resident set size
+    std::vector< char > l_data( 64 * 1024 * 1024, 1 );
+    l_phases.start( "b" );
+    l_phases.end();
+  l_phases.end();
+
+  // additional child of the first phase is placed next to its siblings
+  l_phases.start( "a" );
+    l_phases.start( "d" );
+      l_phases.start( "e" );
+      l_phases.end();
+    l_phases.end();
+    l_phases.start( "b" );
+    l_phases.end();
+  l_phases.end();
+
+  std::vector< edge::monitor::Phases::Phase > const & l_phs = l_phases.get();
+  REQUIRE( l_phs.size() == 6 );
+
+  std::string l_names[6] = { "a", "b", "d", "e", "c", "b" };
+  std::size_t l_parents[6] = { std::size_t(-1), 0, 0, 2, std::size_t(-1), 4 };
+  unsigned short l_depths[6] = { 0, 1, 1, 2, 0, 1 };
+  std::size_t l_nCalls[6] = { 2, 2, 1, 1, 1, 1 };
+
+  for( unsigned short l_ph = 0; l_ph < 6; l_ph++ ) {
+    REQUIRE( l_phs[l_ph].name   == l_names[l_ph]   );
+    REQUIRE( l_phs[l_ph].parent == l_parents[l_ph] );
+    REQUIRE( l_phs[l_ph].depth  == l_depths[l_ph]  );
+    REQUIRE( l_phs[l_ph].nCalls == l_nCalls[l_ph]  );
+    REQUIRE( l_phs[l_ph].time   >= 0 );
+    REQUIRE( l_phs[l_ph].hwm    >= 0 );
+  }
+
+  // parents include their children
+  REQUIRE( l_phs[0].time >= l_phs[1].time );
+  REQUIRE( l_phs[2].time >= l_phs[3].time );
+
+  // memory is only available on Linux
+  double l_rss, l_hwm;
+  edge::monitor::Phases::getMem( l_rss, l_hwm );
+  REQUIRE( l_hwm >= l_rss );
+  if( l_hwm > 0 ) REQUIRE( l_phs[4].rss >= 32 * 1024 * 1024 );
+  REQUIRE( l_data[0] == 1 );
+}
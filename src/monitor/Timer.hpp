@@ -23,7 +23,7 @@
 #ifndef TIMER_HPP
 #define TIMER_HPP
 
-#include <sys/time.h>
+#include <time.h>
 
 namespace edge {
   namespace monitor {
@@ -39,22 +39,22 @@ class edge::monitor::Timer {
     //! end time
     double l_end;
 
+  public:
     /**
-     * Gets the current wall clock time.
+     * Gets the current wall clock time of the monotonic clock.
      *
-     * @return wallclock time in seconds.
+     * @return wallclock time in seconds (arbitrary origin).
      **/
-    double getWtime() const {
-      struct timeval l_time;
+    static double getWtime() {
+      struct timespec l_time;
 
-      if( gettimeofday( &l_time, NULL ) ) {
+      if( clock_gettime( CLOCK_MONOTONIC, &l_time ) ) {
         return 0;
       }
 
-      return (double) l_time.tv_sec + (double) l_time.tv_usec * 0.000001;      
+      return (double) l_time.tv_sec + (double) l_time.tv_nsec * 1.0E-9;
     }
 
-  public:
     Timer(): l_start(0), l_end(0){}
 
     /**
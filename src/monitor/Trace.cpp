@@ -0,0 +1,253 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @section DESCRIPTION
+ * Lightweight, built-in tracing of instrumented regions.
+ **/
+#include "Trace.h"
+#include "parallel/global.h"
+#include "io/logging.h"
+#include <sstream>
+
+bool                                    edge::monitor::Trace::s_on = false;
+std::mutex                              edge::monitor::Trace::s_mutex;
+std::vector< std::string >              edge::monitor::Trace::s_names;
+std::vector< edge::monitor::Trace::Buffer* > edge::monitor::Trace::s_bufs;
+thread_local edge::monitor::Trace::Buffer   *edge::monitor::Trace::t_buf = nullptr;
+uint64_t                                edge::monitor::Trace::s_cap = 65536;
+uint64_t                                edge::monitor::Trace::s_tsc0 = 0;
+std::chrono::steady_clock::time_point   edge::monitor::Trace::s_t0;
+std::ofstream                           edge::monitor::Trace::s_json;
+std::ofstream                           edge::monitor::Trace::s_bin;
+uint64_t                                edge::monitor::Trace::s_nWritten = 0;
+uint64_t                                edge::monitor::Trace::s_nLost = 0;
+
+namespace {
+  /**
+   * Escapes the given string for JSON-output.
+   *
+   * @param i_str string.
+   * @return escaped string.
+   **/
+  std::string jsonEscape( std::string const & i_str ) {
+    std::string l_out;
+    for( std::size_t l_ch = 0; l_ch < i_str.size(); l_ch++ ) {
+      if( i_str[l_ch] == '"' || i_str[l_ch] == '\\' ) l_out += '\\';
+      l_out += i_str[l_ch];
+    }
+    return l_out;
+  }
+
+  /**
+   * Writes the raw bytes of the given value to the stream.
+   *
+   * @param io_os output stream.
+   * @param i_val value.
+   * @paramt TL_T_VAL type of the value.
+   **/
+  template< typename TL_T_VAL >
+  void writeRaw( std::ofstream  & io_os,
+                 TL_T_VAL const & i_val ) {
+    io_os.write( reinterpret_cast< char const * >( &i_val ), sizeof(TL_T_VAL) );
+  }
+}
+
+edge::monitor::Trace::Buffer * edge::monitor::Trace::addBuffer() {
+  Buffer *l_buf = new Buffer;
+  l_buf->tid = parallel::g_thread;
+  l_buf->cap = s_cap;
+  l_buf->ring.resize( s_cap );
+  l_buf->nRec.store( 0 );
+  l_buf->nDone = 0;
+  l_buf->depth = 0;
+
+  std::lock_guard< std::mutex > l_lock( s_mutex );
+  s_bufs.push_back( l_buf );
+  t_buf = l_buf;
+
+  return l_buf;
+}
+
+double edge::monitor::Trace::tscFreq() {
+#if defined(__x86_64__) || defined(__i386__)
+  uint64_t l_tsc = tsc();
+  double l_dur = std::chrono::duration< double >( std::chrono::steady_clock::now() - s_t0 ).count();
+  if( l_dur <= 0 || l_tsc <= s_tsc0 ) return 1E9;
+  return (l_tsc - s_tsc0) / l_dur;
+#else
+  return 1E9;
+#endif
+}
+
+void edge::monitor::Trace::init( std::string const & i_path,
+                                 uint64_t            i_cap ) {
+  EDGE_CHECK( !s_on );
+  if( i_path == "" ) return;
+
+  // round capacity to the next power of two
+  s_cap = 1;
+  while( s_cap < i_cap ) s_cap *= 2;
+
+  // reset buffers of previous traces
+  for( std::size_t l_bu = 0; l_bu < s_bufs.size(); l_bu++ ) {
+    s_bufs[l_bu]->cap = s_cap;
+    s_bufs[l_bu]->ring.resize( s_cap );
+    s_bufs[l_bu]->nRec.store( 0 );
+    s_bufs[l_bu]->nDone = 0;
+    s_bufs[l_bu]->depth = 0;
+  }
+  s_nWritten = 0;
+  s_nLost = 0;
+
+  std::string l_path = i_path + "_" + parallel::g_rankStr;
+  s_json.open( l_path + ".json" );
+  s_bin.open( l_path + ".bin", std::ios::binary );
+  EDGE_CHECK( s_json.good() ) << "could not open " << l_path << ".json";
+  EDGE_CHECK( s_bin.good() ) << "could not open " << l_path << ".bin";
+
+  s_json << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  s_json << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << parallel::g_rank
+         << ",\"args\":{\"name\":\"rank " << parallel::g_rank << "\"}}";
+
+  s_bin.write( "EDGETRC1", 8 );
+  writeRaw( s_bin, (int32_t) parallel::g_rank );
+  writeRaw( s_bin, (uint32_t) sizeof(Event) );
+
+  s_t0 = std::chrono::steady_clock::now();
+  s_tsc0 = tsc();
+  s_on = true;
+}
+
+uint32_t edge::monitor::Trace::regId( char const * i_name ) {
+  std::lock_guard< std::mutex > l_lock( s_mutex );
+
+  for( std::size_t l_na = 0; l_na < s_names.size(); l_na++ ) {
+    if( s_names[l_na] == i_name ) return l_na;
+  }
+  s_names.push_back( i_name );
+
+  return s_names.size()-1;
+}
+
+std::string edge::monitor::Trace::name( uint32_t i_id ) {
+  std::lock_guard< std::mutex > l_lock( s_mutex );
+  EDGE_CHECK_LT( i_id, s_names.size() );
+
+  return s_names[i_id];
+}
+
+void edge::monitor::Trace::dump() {
+  if( !s_on ) return;
+
+  double l_usPerTsc = 1E6 / tscFreq();
+
+  // names are registered in the beginning, copy them once per dump
+  std::vector< std::string > l_names;
+  std::vector< Buffer* > l_bufs;
+  {
+    std::lock_guard< std::mutex > l_lock( s_mutex );
+    for( std::size_t l_na = 0; l_na < s_names.size(); l_na++ )
+      l_names.push_back( jsonEscape( s_names[l_na] ) );
+    l_bufs = s_bufs;
+  }
+
+  for( std::size_t l_bu = 0; l_bu < l_bufs.size(); l_bu++ ) {
+    Buffer &l_buf = *l_bufs[l_bu];
+    uint64_t l_last = l_buf.nRec.load( std::memory_order_acquire );
+    uint64_t l_first = l_buf.nDone;
+
+    // events overwritten since the last dump
+    uint64_t l_lost = 0;
+    if( l_last - l_first > l_buf.cap ) {
+      l_lost = l_last - l_first - l_buf.cap;
+      l_first = l_last - l_buf.cap;
+    }
+    if( l_last == l_first && l_lost == 0 ) continue;
+
+    // binary block
+    writeRaw( s_bin, (uint8_t) 1 );
+    writeRaw( s_bin, (int32_t) l_buf.tid );
+    writeRaw( s_bin, (uint64_t) (l_last - l_first) );
+    writeRaw( s_bin, l_lost );
+
+    for( uint64_t l_ev = l_first; l_ev < l_last; l_ev++ ) {
+      Event const &l_event = l_buf.ring[ l_ev & (l_buf.cap-1) ];
+      writeRaw( s_bin, l_event );
+
+      // chrome trace, complete event
+      double l_ts  = (l_event.tsc[0] - s_tsc0) * l_usPerTsc;
+      double l_dur = (l_event.tsc[1] - l_event.tsc[0]) * l_usPerTsc;
+      s_json << ",\n{\"name\":\"" << l_names[l_event.reg]
+             << "\",\"ph\":\"X\",\"pid\":" << parallel::g_rank
+             << ",\"tid\":" << l_buf.tid
+             << ",\"ts\":" << std::fixed << l_ts
+             << ",\"dur\":" << l_dur << std::defaultfloat;
+      if( l_event.nPars > 0 ) {
+        s_json << ",\"args\":{";
+        for( uint32_t l_pa = 0; l_pa < l_event.nPars; l_pa++ ) {
+          if( l_pa > 0 ) s_json << ",";
+          s_json << "\"" << l_names[l_event.parIds[l_pa]] << "\":" << l_event.parVals[l_pa];
+        }
+        s_json << "}";
+      }
+      s_json << "}";
+    }
+
+    l_buf.nDone = l_last;
+    s_nWritten += l_last - l_first;
+    s_nLost += l_lost;
+  }
+
+  s_json.flush();
+  s_bin.flush();
+}
+
+void edge::monitor::Trace::fin() {
+  if( !s_on ) return;
+
+  // close open regions of the calling thread
+  while( t_buf != nullptr && t_buf->depth > 0 ) end();
+
+  dump();
+
+  // name table
+  std::lock_guard< std::mutex > l_lock( s_mutex );
+  writeRaw( s_bin, (uint8_t) 2 );
+  writeRaw( s_bin, (uint32_t) s_names.size() );
+  for( std::size_t l_na = 0; l_na < s_names.size(); l_na++ ) {
+    writeRaw( s_bin, (uint32_t) s_names[l_na].size() );
+    s_bin.write( s_names[l_na].data(), s_names[l_na].size() );
+  }
+
+  // clock
+  writeRaw( s_bin, (uint8_t) 3 );
+  writeRaw( s_bin, s_tsc0 );
+  writeRaw( s_bin, tscFreq() );
+
+  s_json << "\n]}\n";
+  s_json.close();
+  s_bin.close();
+
+  s_on = false;
+
+  if( s_nLost > 0 ) {
+    EDGE_LOG_WARNING << "trace lost " << s_nLost << " events, consider more frequent synchronization points";
+  }
+}
@@ -0,0 +1,295 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Lightweight, built-in tracing of instrumented regions.
+ *
+ * Every thread records its completed regions in a private ring buffer, no locks are taken on the hot path.
+ * The buffers are drained at synchronization points (all threads are outside of the parallel region)
+ * to a Chrome-trace JSON-file (chrome://tracing, Perfetto) and a compact binary file.
+ *
+ * Layout of the binary file (native byte order):
+ *   header:      char[8] "EDGETRC1", int32 rank, uint32 size of an event (bytes).
+ *   event block: uint8 1, int32 thread, uint64 #events, uint64 #lost events, #events x Event.
+ *   name table:  uint8 2, uint32 #names, #names x (uint32 length, chars).
+ *   clock:       uint8 3, uint64 reference time stamp, double time stamps per second.
+ **/
+
+#ifndef EDGE_MONITOR_TRACE_H_
+#define EDGE_MONITOR_TRACE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <fstream>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace edge {
+  namespace monitor {
+    class Trace;
+  }
+}
+
+class edge::monitor::Trace {
+  public:
+    //! record of a completed region
+    struct Event {
+      //! id of the region
+      uint32_t reg;
+
+      //! number of attached parameters
+      uint32_t nPars;
+
+      //! time stamps at begin and end of the region
+      uint64_t tsc[2];
+
+      //! ids of the parameters' names
+      uint32_t parIds[2];
+
+      //! values of the parameters
+      uint64_t parVals[2];
+    };
+
+    /**
+     * RAII-wrapper for regions spanning a scope.
+     **/
+    class Scope {
+      public:
+        /**
+         * Begins the region.
+         *
+         * @param i_reg id of the region.
+         **/
+        explicit Scope( uint32_t i_reg ) { begin( i_reg ); }
+
+        /**
+         * Ends the region.
+         **/
+        ~Scope() { end(); }
+    };
+
+  private:
+    //! maximum nesting depth of regions, deeper regions are skipped
+    static unsigned short const MAX_DEPTH = 32;
+
+    //! per-thread buffer
+    struct Buffer {
+      //! id of the owning thread
+      int tid;
+
+      //! capacity of the ring (power of two)
+      uint64_t cap;
+
+      //! ring of completed events
+      std::vector< Event > ring;
+
+      //! number of events recorded by the owner (monotonic)
+      std::atomic< uint64_t > nRec;
+
+      //! number of events handled by previous dumps
+      uint64_t nDone;
+
+      //! number of currently open regions
+      unsigned short depth;
+
+      //! open regions
+      Event open[MAX_DEPTH];
+    };
+
+    //! true if tracing is active
+    static bool s_on;
+
+    //! guards the registration of names and buffers
+    static std::mutex s_mutex;
+
+    //! names of regions and parameters, id is the position
+    static std::vector< std::string > s_names;
+
+    //! buffers of all threads
+    static std::vector< Buffer* > s_bufs;
+
+    //! buffer of the calling thread
+    static thread_local Buffer *t_buf;
+
+    //! capacity of new buffers
+    static uint64_t s_cap;
+
+    //! reference time stamp and wall clock time of the initialization
+    static uint64_t s_tsc0;
+    static std::chrono::steady_clock::time_point s_t0;
+
+    //! output streams
+    static std::ofstream s_json;
+    static std::ofstream s_bin;
+
+    //! number of written and lost events
+    static uint64_t s_nWritten;
+    static uint64_t s_nLost;
+
+    /**
+     * Allocates and registers the buffer of the calling thread.
+     *
+     * @return buffer.
+     **/
+    static Buffer * addBuffer();
+
+    /**
+     * Estimates the number of time stamps per second.
+     *
+     * @return time stamps per second.
+     **/
+    static double tscFreq();
+
+  public:
+    /**
+     * Reads the time stamp counter.
+     * The TSC is used on x86 (assumes an invariant TSC), a monotonic clock in ns otherwise.
+     *
+     * @return current time stamp.
+     **/
+    static uint64_t tsc() {
+#if defined(__x86_64__) || defined(__i386__)
+      return __rdtsc();
+#else
+      return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+#endif
+    }
+
+    /**
+     * Initializes the tracing.
+     * Has to be called outside of parallel regions; a finalized trace might be initialized again.
+     *
+     * @param i_path path of the output files, _<rank>.json and _<rank>.bin are appended. An empty path disables the tracing.
+     * @param i_cap capacity of the per-thread ring buffers (#events), rounded up to the next power of two.
+     **/
+    static void init( std::string const & i_path,
+                      uint64_t            i_cap = 65536 );
+
+    /**
+     * Gets the id of the given region or parameter name, registers it if required.
+     *
+     * @param i_name name.
+     * @return id.
+     **/
+    static uint32_t regId( char const * i_name );
+
+    /**
+     * Gets the name of the given id.
+     *
+     * @param i_id id.
+     * @return name.
+     **/
+    static std::string name( uint32_t i_id );
+
+    /**
+     * Begins a region on the calling thread.
+     *
+     * @param i_reg id of the region.
+     **/
+    static void begin( uint32_t i_reg ) {
+      if( !s_on ) return;
+      Buffer *l_buf = t_buf;
+      if( l_buf == nullptr ) l_buf = addBuffer();
+
+      if( l_buf->depth < MAX_DEPTH ) {
+        Event &l_ev = l_buf->open[l_buf->depth];
+        l_ev.reg = i_reg;
+        l_ev.nPars = 0;
+        l_ev.tsc[0] = tsc();
+      }
+      l_buf->depth++;
+    }
+
+    /**
+     * Ends the innermost open region of the calling thread.
+     **/
+    static void end() {
+      if( !s_on ) return;
+      Buffer *l_buf = t_buf;
+      if( l_buf == nullptr || l_buf->depth == 0 ) return;
+
+      l_buf->depth--;
+      if( l_buf->depth < MAX_DEPTH ) {
+        Event &l_ev = l_buf->open[l_buf->depth];
+        l_ev.tsc[1] = tsc();
+
+        // single producer: publish the event after writing it
+        uint64_t l_n = l_buf->nRec.load( std::memory_order_relaxed );
+        l_buf->ring[ l_n & (l_buf->cap-1) ] = l_ev;
+        l_buf->nRec.store( l_n+1, std::memory_order_release );
+      }
+    }
+
+    /**
+     * Attaches a parameter to the innermost open region of the calling thread.
+     * At most two parameters are kept per region, setting a parameter twice overwrites the value.
+     *
+     * @param i_id id of the parameter's name.
+     * @param i_val value of the parameter.
+     **/
+    static void param( uint32_t i_id,
+                       uint64_t i_val ) {
+      if( !s_on ) return;
+      Buffer *l_buf = t_buf;
+      if( l_buf == nullptr || l_buf->depth == 0 || l_buf->depth > MAX_DEPTH ) return;
+
+      Event &l_ev = l_buf->open[l_buf->depth-1];
+      for( uint32_t l_pa = 0; l_pa < l_ev.nPars; l_pa++ ) {
+        if( l_ev.parIds[l_pa] == i_id ) {
+          l_ev.parVals[l_pa] = i_val;
+          return;
+        }
+      }
+      if( l_ev.nPars < 2 ) {
+        l_ev.parIds[l_ev.nPars] = i_id;
+        l_ev.parVals[l_ev.nPars] = i_val;
+        l_ev.nPars++;
+      }
+    }
+
+    /**
+     * Writes all events recorded since the last dump.
+     * Has to be called outside of parallel regions, e.g., at synchronization points.
+     **/
+    static void dump();
+
+    /**
+     * Closes the open regions of the calling thread, writes the remaining events and finalizes the output.
+     **/
+    static void fin();
+
+    /**
+     * Gets the number of written and lost events.
+     *
+     * @param o_nWritten will be set to the number of events written.
+     * @param o_nLost will be set to the number of events overwritten in the ring buffers before a dump.
+     **/
+    static void stats( uint64_t &o_nWritten,
+                       uint64_t &o_nLost ) {
+      o_nWritten = s_nWritten;
+      o_nLost = s_nLost;
+    }
+};
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2018, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @section DESCRIPTION
+ * Unit tests of the built-in tracing.
+ **/
+
+#include <catch.hpp>
+#include "Trace.h"
+#include <cstdio>
+#include <sstream>
+
+namespace {
+  /**
+   * Reads the given file.
+   *
+   * @param i_path path of the file.
+   * @return content.
+   **/
+  std::string readFile( std::string const & i_path ) {
+    std::ifstream l_file( i_path, std::ios::binary );
+    std::stringstream l_ss;
+    l_ss << l_file.rdbuf();
+    return l_ss.str();
+  }
+
+  /**
+   * Counts the occurences of a pattern.
+   *
+   * @param i_str string which is searched.
+   * @param i_pat pattern.
+   * @return number of occurences.
+   **/
+  std::size_t count( std::string const & i_str,
+                     std::string const & i_pat ) {
+    std::size_t l_n = 0;
+    for( std::size_t l_pos = i_str.find( i_pat ); l_pos != std::string::npos; l_pos = i_str.find( i_pat, l_pos+1 ) ) l_n++;
+    return l_n;
+  }
+}
+
+TEST_CASE( "Trace: ids of names.", "[Trace][ids]" ) {
+  uint32_t l_id0 = edge::monitor::Trace::regId( "trace_test_a" );
+  uint32_t l_id1 = edge::monitor::Trace::regId( "trace_test_b" );
+
+  REQUIRE( l_id0 != l_id1 );
+  REQUIRE( edge::monitor::Trace::regId( "trace_test_a" ) == l_id0 );
+  REQUIRE( edge::monitor::Trace::name( l_id1 ) == "trace_test_b" );
+}
+
+TEST_CASE( "Trace: recording and dumping of regions.", "[Trace][dump]" ) {
+  std::string l_path = "trace.test";
+  std::string l_json = l_path + "_0.json";
+  std::string l_bin  = l_path + "_0.bin";
+
+  uint32_t l_outer = edge::monitor::Trace::regId( "outer" );
+  uint32_t l_inner = edge::monitor::Trace::regId( "inner" );
+  uint32_t l_step  = edge::monitor::Trace::regId( "step_id" );
+
+  // regions outside of an active trace are ignored
+  edge::monitor::Trace::begin( l_outer );
+  edge::monitor::Trace::end();
+
+  edge::monitor::Trace::init( l_path, 4 );
+
+  // nested regions, the inner one has a parameter
+  {
+    edge::monitor::Trace::Scope l_scope( l_outer );
+    for( uint64_t l_st = 0; l_st < 3; l_st++ ) {
+      edge::monitor::Trace::begin( l_inner );
+      edge::monitor::Trace::param( l_step, l_st );
+      edge::monitor::Trace::end();
+    }
+  }
+  edge::monitor::Trace::dump();
+
+  uint64_t l_nWritten, l_nLost;
+  edge::monitor::Trace::stats( l_nWritten, l_nLost );
+  REQUIRE( l_nWritten == 4 );
+  REQUIRE( l_nLost    == 0 );
+
+  // overflow of the ring buffer (capacity 4) between two dumps
+  for( unsigned short l_re = 0; l_re < 6; l_re++ ) {
+    edge::monitor::Trace::begin( l_inner );
+    edge::monitor::Trace::end();
+  }
+
+  // open region is closed by the finalization
+  edge::monitor::Trace::begin( l_outer );
+  edge::monitor::Trace::fin();
+
+  edge::monitor::Trace::stats( l_nWritten, l_nLost );
+  REQUIRE( l_nWritten == 8 );
+  REQUIRE( l_nLost    == 3 );
+
+  // chrome trace
+  std::string l_str = readFile( l_json );
+  REQUIRE( count( l_str, "\"ph\":\"X\"" ) == 8 );
+  REQUIRE( count( l_str, "\"name\":\"outer\"" ) == 2 );
+  REQUIRE( count( l_str, "\"name\":\"inner\"" ) == 6 );
+  REQUIRE( count( l_str, "\"step_id\":2" ) == 1 );
+  REQUIRE( l_str.substr( l_str.size()-3 ) == "]}\n" );
+
+  // binary trace
+  l_str = readFile( l_bin );
+  REQUIRE( l_str.substr( 0, 8 ) == "EDGETRC1" );
+  std::size_t l_size = 8 + 4 + 4;
+  l_size += 2 * ( 1 + 4 + 8 + 8 ) + 8 * sizeof(edge::monitor::Trace::Event);
+  REQUIRE( l_str.size() > l_size );
+  REQUIRE( l_str[l_size] == 2 );
+
+  std::remove( l_json.c_str() );
+  std::remove( l_bin.c_str() );
+}
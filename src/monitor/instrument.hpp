@@ -42,6 +42,20 @@ class gccDisableUnusedScoreP {
 #define PP_INSTR_PAR_UINT64(str1,str2) SCOREP_USER_PARAMETER_UINT64(str1,str2)
 #define PP_INSTR_REG_END(str)          SCOREP_USER_REGION_END(str)
 
+#elif defined PP_USE_INSTR_TRACE
+
+#include "monitor/Trace.h"
+
+// forward to the built-in tracing, ids are resolved once per call site
+#define PP_INSTR_FUN(str)              static uint32_t const l_instrFunId = edge::monitor::Trace::regId(str);\
+                                       edge::monitor::Trace::Scope l_instrFunScope( l_instrFunId );
+#define PP_INSTR_REG_DEF(str)
+#define PP_INSTR_REG_BEG(str1,str2)    static uint32_t const str1##_instrId = edge::monitor::Trace::regId(str2);\
+                                       edge::monitor::Trace::begin( str1##_instrId );
+#define PP_INSTR_PAR_UINT64(str1,str2) { static uint32_t const l_instrParId = edge::monitor::Trace::regId(str1);\
+                                         edge::monitor::Trace::param( l_instrParId, str2 ); }
+#define PP_INSTR_REG_END(str)          edge::monitor::Trace::end();
+
 #else
 
 // set empty macros in the case of disabled instrumentation
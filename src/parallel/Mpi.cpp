@@ -257,6 +257,36 @@ void edge::parallel::Mpi::beginRecvs( int_tg i_tg ) {
 #endif
 }
 
+void edge::parallel::Mpi::beginMin( double i_val ) {
+  m_minVal[0] = i_val;
+  m_minVal[1] = i_val;
+
+#ifdef PP_USE_MPI
+  EDGE_CHECK( m_minReq == MPI_REQUEST_NULL );
+
+#if MPI_VERSION >= 3
+  int l_error = MPI_Iallreduce( m_minVal, m_minVal+1, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD, &m_minReq );
+#else
+  // no non-blocking collectives available
+  int l_error = MPI_Allreduce(  m_minVal, m_minVal+1, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD );
+#endif
+  EDGE_CHECK( l_error == MPI_SUCCESS );
+#endif
+}
+
+bool edge::parallel::Mpi::finMin( double &o_val ) {
+#ifdef PP_USE_MPI
+  if( m_minReq != MPI_REQUEST_NULL ) {
+    int l_test;
+    MPI_Test( &m_minReq, &l_test, MPI_STATUS_IGNORE );
+    if( l_test == 0 ) return false;
+  }
+#endif
+
+  o_val = m_minVal[1];
+  return true;
+}
+
 bool edge::parallel::Mpi::finSends( int_tg i_tg ) {
 #ifdef PP_USE_MPI
   EDGE_CHECK( i_tg < m_send.size() );
@@ -75,8 +75,14 @@ class edge::parallel::Mpi {
 
   //! number of iterations over comm list until a check for new work is performed
   unsigned int m_nIterPerCheck;
+
+  //! request of the non-blocking minimum reduction
+  MPI_Request m_minReq = MPI_REQUEST_NULL;
 #endif
 
+  //! local value and result of the non-blocking minimum reduction
+  double m_minVal[2];
+
   public:
     //! max. version of the supported mpi-standard, 0: major, 1: minor
     static int m_verStd[2];
@@ -133,6 +139,22 @@ class edge::parallel::Mpi {
      **/
     void beginRecvs( int_tg i_tg );
 
+    /**
+     * Begins a non-blocking minimum reduction of the given value over all ranks.
+     * Only one reduction is allowed to be in flight.
+     *
+     * @param i_val local value.
+     **/
+    void beginMin( double i_val );
+
+    /**
+     * Tests for completion of the non-blocking minimum reduction.
+     *
+     * @param o_val will be set to the minimum over all ranks if finished.
+     * @return true if finished, false otherwise.
+     **/
+    bool finMin( double &o_val );
+
     /**
      * Checks if all sends for the specified time group are finished.
      *
@@ -22,7 +22,11 @@
  **/
 
 #include "Manager.h"
+#include "parallel/Mpi.h"
+#include "io/logging.h"
 #include "monitor/instrument.hpp"
+#include <algorithm>
+#include <sstream>
 
 void edge::time::Manager::schedule() {
 #if defined PP_T_EQUATIONS_ADVECTION
@@ -54,6 +58,10 @@ void edge::time::Manager::compute() {
   // scheduling and communicating workers have other duties, pure workers stay where they are
   bool l_schdCmm = m_shared.isSched() || m_shared.isComm();
 
+  // accounting of the calling thread
+  double *l_acc = &m_accTd[ std::size_t(parallel::g_thread) * N_PAD_ACC ];
+  double l_time = wtime();
+
   while( m_finished == false ) {
     bool l_wrk;
     int_tg          l_tg;
@@ -79,12 +87,35 @@ void edge::time::Manager::compute() {
       PP_INSTR_PAR_UINT64("cflow_id", (uint64_t) l_id )
 #pragma warning pop
 
+#ifdef PP_USE_PERF
+      double l_cnts[2][monitor::PerfCounters::N_VALUES];
+      m_cntsTd[parallel::g_thread].read( l_cnts[0] );
+#endif
+
       m_timeGroups[l_tg]->computeStep( l_st, l_first, l_size, l_enSp, m_recvs, m_recvsQuad );
 
+#ifdef PP_USE_PERF
+      m_cntsTd[parallel::g_thread].read( l_cnts[1] );
+      double *l_cntAcc = &m_cntAccTd[ std::size_t(parallel::g_thread) * N_PAD_CNT + l_st * monitor::PerfCounters::N_VALUES ];
+      for( unsigned short l_va = 0; l_va < monitor::PerfCounters::N_VALUES; l_va++ ) {
+        l_cntAcc[l_va] += l_cnts[1][l_va] - l_cnts[0][l_va];
+      }
+#endif
+
       PP_INSTR_REG_END(step)
 
       // set status to "finished"
       m_shared.setStatusTd( parallel::Shared::FIN, l_id );
+
+      double l_now = wtime();
+      l_acc[l_st] += l_now - l_time;
+      l_acc[N_STEP_TYPES+4+l_st] += l_size;
+      l_time = l_now;
+    }
+    else {
+      double l_now = wtime();
+      l_acc[N_STEP_TYPES] += l_now - l_time;
+      l_time = l_now;
     }
 
     // non-pure workers are allowed to exit
@@ -117,13 +148,223 @@ void edge::time::Manager::simulate( double i_time ) {
 #pragma omp parallel
 {
 #endif
+#ifdef PP_USE_PERF
+  // counters have to be opened by the counted threads
+  if( !m_cntsInit ) m_cntsTd[parallel::g_thread].open( PP_PRECISION == 32 );
+#endif
+
+  double *l_acc = &m_accTd[ std::size_t(parallel::g_thread) * N_PAD_ACC ];
+  double l_beg = wtime();
+
   while( m_finished == false ) {
-    if( m_shared.isSched() ) schedule();
-    if( m_shared.isComm()  ) communicate();
+    if( m_shared.isSched() ) {
+      double l_time = wtime();
+      schedule();
+      l_acc[N_STEP_TYPES+1] += wtime() - l_time;
+    }
+    if( m_shared.isComm()  ) {
+      double l_time = wtime();
+      communicate();
+      l_acc[N_STEP_TYPES+2] += wtime() - l_time;
+    }
     if( m_shared.isWrk()   ) compute();
   }
+
+  l_acc[N_STEP_TYPES+3] += wtime() - l_beg;
 #ifdef PP_USE_OMP
 }
 #endif
 
+#ifdef PP_USE_PERF
+  m_cntsInit = true;
+#endif
+
+}
+
+void edge::time::Manager::model() {
+#if defined PP_T_EQUATIONS_ADVECTION
+#include "src/impl/advection/inc/time/man_model.inc"
+#elif defined PP_T_EQUATIONS_ELASTIC
+#include "src/impl/elastic/inc/time/man_model.inc"
+#elif defined PP_T_EQUATIONS_SWE
+#include "src/impl/swe/inc/time/man_model.inc"
+#else
+#error "work model not defined"
+#endif
+
+  for( unsigned short l_st = 0; l_st < N_STEP_TYPES; l_st++ ) {
+    if( m_work[l_st][1] > 0 && m_work[l_st][2] > 0 ) {
+      EDGE_LOG_INFO << "  work model of step type " << STEP_NAMES[l_st] << " per entity (nominal / sparse FLOPs, bytes, sparse FLOPs/byte): "
+                    << m_work[l_st][0] << " / " << m_work[l_st][1] << ", " << m_work[l_st][2] << ", "
+                    << m_work[l_st][1] / m_work[l_st][2];
+    }
+  }
+}
+
+void edge::time::Manager::logStats( double i_bwMem ) {
+  /*
+   * derive the rank's metrics:
+   *   busy time per step type, idle fraction, imbalance, duty cycles of scheduling and communication,
+   *   followed by nominal GFLOP/s, sparse GFLOP/s, GB/s and fraction of the roofline per step type
+   */
+  unsigned short const l_nMetLb = N_STEP_TYPES + 4;
+  unsigned short const l_nMet = l_nMetLb + 4*N_STEP_TYPES;
+  double l_met[l_nMet];
+  for( unsigned short l_me = 0; l_me < l_nMet; l_me++ ) l_met[l_me] = 0;
+
+  double l_idle = 0;
+  double l_wall = 0;
+  double l_busyMax = 0;
+  double l_busySum = 0;
+  int    l_nWrks = 0;
+  double l_nEns[N_STEP_TYPES];
+  for( unsigned short l_st = 0; l_st < N_STEP_TYPES; l_st++ ) l_nEns[l_st] = 0;
+
+  for( int l_td = 0; l_td < parallel::g_nThreads; l_td++ ) {
+    double *l_acc = &m_accTd[ std::size_t(l_td) * N_PAD_ACC ];
+
+    double l_busy = 0;
+    for( unsigned short l_st = 0; l_st < N_STEP_TYPES; l_st++ ) {
+      l_met[l_st] += l_acc[l_st];
+      l_busy += l_acc[l_st];
+      l_nEns[l_st] += l_acc[N_STEP_TYPES+4+l_st];
+    }
+
+    // only workers account for busy or idle time
+    if( l_busy + l_acc[N_STEP_TYPES] > 0 ) {
+      l_busyMax = std::max( l_busyMax, l_busy );
+      l_busySum += l_busy;
+      l_nWrks++;
+    }
+
+    l_idle += l_acc[N_STEP_TYPES];
+    l_met[N_STEP_TYPES+2] += l_acc[N_STEP_TYPES+1];
+    l_met[N_STEP_TYPES+3] += l_acc[N_STEP_TYPES+2];
+    l_wall = std::max( l_wall, l_acc[N_STEP_TYPES+3] );
+
+    // reset for the next interval
+    for( unsigned short l_en = 0; l_en < N_ACC; l_en++ ) l_acc[l_en] = 0;
+  }
+
+  if( l_busySum + l_idle > 0 ) l_met[N_STEP_TYPES] = l_idle / ( l_busySum + l_idle );
+  l_met[N_STEP_TYPES+1] = (l_busySum > 0) ? l_busyMax / ( l_busySum / l_nWrks ) : 1;
+  if( l_wall > 0 ) {
+    l_met[N_STEP_TYPES+2] /= l_wall;
+    l_met[N_STEP_TYPES+3] /= l_wall;
+  }
+
+  // rates of the step types, the workers are assumed to process a step type concurrently
+  for( unsigned short l_st = 0; l_st < N_STEP_TYPES; l_st++ ) {
+    double l_time = (l_nWrks > 0) ? l_met[l_st] / l_nWrks : 0;
+    if( l_time <= 0 || m_work[l_st][2] <= 0 ) continue;
+
+    double *l_rates = l_met + l_nMetLb + 4*l_st;
+    l_rates[0] = l_nEns[l_st] * m_work[l_st][0] / l_time * 1E-9;
+    l_rates[1] = l_nEns[l_st] * m_work[l_st][1] / l_time * 1E-9;
+    l_rates[2] = l_nEns[l_st] * m_work[l_st][2] / l_time * 1E-9;
+
+    // memory roof of the roofline: arithmetic intensity times bandwidth
+    if( i_bwMem > 0 ) l_rates[3] = l_rates[1] / ( m_work[l_st][1] / m_work[l_st][2] * i_bwMem );
+  }
+
+  // aggregate over ranks
+  double l_min[l_nMet], l_avg[l_nMet], l_max[l_nMet];
+#ifdef PP_USE_MPI
+  int l_err = MPI_Allreduce( l_met, l_min, l_nMet, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD );
+  EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+  l_err = MPI_Allreduce( l_met, l_max, l_nMet, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
+  EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+  l_err = MPI_Allreduce( l_met, l_avg, l_nMet, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+  EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+#else
+  for( unsigned short l_me = 0; l_me < l_nMet; l_me++ ) l_min[l_me] = l_max[l_me] = l_avg[l_me] = l_met[l_me];
+#endif
+  for( unsigned short l_me = 0; l_me < l_nMet; l_me++ ) l_avg[l_me] /= parallel::g_nRanks;
+
+  EDGE_LOG_INFO << "  load balance (min / avg / max over ranks):";
+  for( unsigned short l_me = 0; l_me < l_nMet; l_me++ ) {
+    std::string l_name;
+    if(      l_me <  N_STEP_TYPES   ) l_name = std::string("busy time ") + STEP_NAMES[l_me] + " (s)";
+    else if( l_me == N_STEP_TYPES   ) l_name = "idle fraction of the workers";
+    else if( l_me == N_STEP_TYPES+1 ) l_name = "imbalance of the workers (max/avg busy time)";
+    else if( l_me == N_STEP_TYPES+2 ) l_name = "duty cycle of scheduling";
+    else if( l_me == N_STEP_TYPES+3 ) l_name = "duty cycle of communication";
+    else {
+      // skip step types without model or work
+      unsigned short l_st = (l_me - l_nMetLb) / 4;
+      unsigned short l_ra = (l_me - l_nMetLb) % 4;
+      if( l_max[l_nMetLb + 4*l_st + 2] <= 0 ) continue;
+      if( l_ra == 3 && i_bwMem <= 0 ) continue;
+
+      if( l_ra == 0 ) EDGE_LOG_INFO << "  performance of step type " << STEP_NAMES[l_st] << " per rank (min / avg / max over ranks):";
+
+      if(      l_ra == 0 ) l_name = "  GFLOP/s (nominal)";
+      else if( l_ra == 1 ) l_name = "  GFLOP/s (sparse)";
+      else if( l_ra == 2 ) l_name = "  GB/s";
+      else                 l_name = "  fraction of the roofline";
+    }
+
+    EDGE_LOG_INFO << "    " << l_name << ": "
+                  << l_min[l_me] << " / " << l_avg[l_me] << " / " << l_max[l_me];
+  }
+}
+
+#ifdef PP_USE_PERF
+void edge::time::Manager::logCounters() {
+  unsigned short const l_nVals = monitor::PerfCounters::N_VALUES;
+
+  // sum over threads: values per step type, followed by the number of threads providing the values
+  double l_cnts[N_STEP_TYPES*l_nVals + l_nVals];
+  for( unsigned short l_en = 0; l_en < N_STEP_TYPES*l_nVals + l_nVals; l_en++ ) l_cnts[l_en] = 0;
+
+  for( int l_td = 0; l_td < parallel::g_nThreads; l_td++ ) {
+    for( unsigned short l_en = 0; l_en < N_STEP_TYPES*l_nVals; l_en++ ) {
+      l_cnts[l_en] += m_cntAccTd[ std::size_t(l_td) * N_PAD_CNT + l_en ];
+    }
+    for( unsigned short l_va = 0; l_va < l_nVals; l_va++ ) {
+      if( m_cntsTd[l_td].available( monitor::PerfCounters::Value(l_va) ) ) l_cnts[N_STEP_TYPES*l_nVals + l_va] += 1;
+    }
+  }
+
+  // sum over ranks
+#ifdef PP_USE_MPI
+  int l_err = MPI_Allreduce( MPI_IN_PLACE, l_cnts, N_STEP_TYPES*l_nVals + l_nVals, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+  EDGE_CHECK_EQ( l_err, MPI_SUCCESS );
+#endif
+
+  double const *l_avail = l_cnts + N_STEP_TYPES*l_nVals;
+  double l_nTds = double(parallel::g_nThreads) * parallel::g_nRanks;
+
+  if( l_avail[monitor::PerfCounters::CYCLES] == 0 ) {
+    EDGE_LOG_WARNING << "hardware counters are not available (perf_event_open failed), check perf_event_paranoid or the container's seccomp profile";
+    return;
+  }
+
+  EDGE_LOG_INFO << "hardware counters of " << l_avail[monitor::PerfCounters::CYCLES] << " / " << l_nTds << " threads"
+                << ( l_avail[monitor::PerfCounters::FP_OPS] == 0 ? " (no flop counters)" : "" ) << ":";
+
+  for( unsigned short l_st = 0; l_st < N_STEP_TYPES; l_st++ ) {
+    double const *l_vals = l_cnts + l_st*l_nVals;
+    if( l_vals[monitor::PerfCounters::TIME] <= 0 ) continue;
+
+    std::ostringstream l_str;
+    l_str << "  " << STEP_NAMES[l_st] << ": "
+          << "time " << l_vals[monitor::PerfCounters::TIME] << " s";
+
+    if( l_vals[monitor::PerfCounters::CYCLES] > 0 ) {
+      l_str << ", IPC " << l_vals[monitor::PerfCounters::INSTRUCTIONS] / l_vals[monitor::PerfCounters::CYCLES];
+    }
+
+    if( l_vals[monitor::PerfCounters::FP_OPS] > 0 ) {
+      l_str << ", GFLOP/s per thread " << l_vals[monitor::PerfCounters::FP_OPS] / l_vals[monitor::PerfCounters::TIME] * 1E-9;
+
+      // every last level cache miss transfers one cache line of 64 bytes
+      if( l_avail[monitor::PerfCounters::LLC_MISSES] > 0 ) {
+        l_str << ", bytes/flop " << l_vals[monitor::PerfCounters::LLC_MISSES] * 64 / l_vals[monitor::PerfCounters::FP_OPS];
+      }
+    }
+
+    EDGE_LOG_INFO << l_str.str();
+  }
 }
+#endif
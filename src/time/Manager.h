@@ -29,7 +29,13 @@
 #include "io/Receivers.h"
 #include "io/ReceiversQuad.hpp"
 #include "TimeGroupStatic.h"
+#include "monitor/KernelModel.hpp"
+#include "data/common.hpp"
 #include <vector>
+#include <chrono>
+#ifdef PP_USE_PERF
+#include "monitor/PerfCounters.h"
+#endif
 
 namespace edge {
   namespace time {
@@ -63,6 +69,46 @@ class edge::time::Manager {
     //! true if the manager reached the desired synchronization point
     volatile bool m_finished;
 
+    //! entries of the per-thread accounting: busy time per step type, idle time, time in scheduling, time in communication, total time, processed entities per step type
+    static const unsigned short N_ACC = 2*N_STEP_TYPES + 4;
+
+    //! number of doubles between two threads' entries in m_accTd (multiple of a cache line)
+    static const unsigned short N_PAD_ACC = ((N_ACC+7)/8)*8;
+
+    //! per-thread accounting (seconds) since the last statistics, cache line aligned
+    double *m_accTd;
+
+    //! modeled work per entity of the step types: [0]: nominal FLOPs, [1]: sparse FLOPs, [2]: bytes
+    double m_work[N_STEP_TYPES][3];
+
+    /**
+     * Derives the work model of the step types.
+     **/
+    void model();
+
+#ifdef PP_USE_PERF
+    //! number of doubles between two threads' entries in m_cntAccTd (multiple of a cache line)
+    static const unsigned short N_PAD_CNT = ((N_STEP_TYPES*monitor::PerfCounters::N_VALUES+7)/8)*8;
+
+    //! hardware counters of the threads
+    std::vector< monitor::PerfCounters > m_cntsTd;
+
+    //! true if the threads opened their counters
+    bool m_cntsInit;
+
+    //! per-thread counter values, attributed to the step types, cache line aligned
+    double *m_cntAccTd;
+#endif
+
+    /**
+     * Gets the time of a monotonic wall clock.
+     *
+     * @return time in seconds.
+     **/
+    static double wtime() {
+      return std::chrono::duration< double >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+    }
+
     //! scheduling loop
     void schedule();
 
@@ -90,7 +136,33 @@ class edge::time::Manager {
                                       T_SDISC.ELEMENT,
                                       ORDER,
                                       N_CRUNS >        &i_recvsQuad ):
-     m_dTfun(i_dT), m_shared(i_shared), m_mpi(i_mpi), m_recvs(i_recvs), m_recvsQuad(i_recvsQuad){};
+     m_dTfun(i_dT), m_shared(i_shared), m_mpi(i_mpi), m_recvs(i_recvs), m_recvsQuad(i_recvsQuad),
+     m_accTd( (double*) data::common::allocate( std::size_t(parallel::g_nThreads) * N_PAD_ACC * sizeof(double), 64 ) )
+#ifdef PP_USE_PERF
+     , m_cntsTd( parallel::g_nThreads ), m_cntsInit( false ),
+     m_cntAccTd( (double*) data::common::allocate( std::size_t(parallel::g_nThreads) * N_PAD_CNT * sizeof(double), 64 ) )
+#endif
+     {
+       for( std::size_t l_en = 0; l_en < std::size_t(parallel::g_nThreads) * N_PAD_ACC; l_en++ ) m_accTd[l_en] = 0;
+#ifdef PP_USE_PERF
+       for( std::size_t l_en = 0; l_en < std::size_t(parallel::g_nThreads) * N_PAD_CNT; l_en++ ) m_cntAccTd[l_en] = 0;
+#endif
+       model();
+     };
+
+    /**
+     * Destructor, frees the accounting of the threads.
+     **/
+    ~Manager() {
+      data::common::release( m_accTd );
+#ifdef PP_USE_PERF
+      data::common::release( m_cntAccTd );
+#endif
+    };
+
+    // the manager owns the accounting buffers
+    Manager( Manager const & ) = delete;
+    Manager & operator=( Manager const & ) = delete;
 
     /**
      * Adds a time group to the time manager.
@@ -105,6 +177,27 @@ class edge::time::Manager {
      * @param i_time time to advance forward in time.
      **/
     void simulate( double i_time );
+
+    /**
+     * Logs the accounting of the threads since the last call and resets it.
+     * Reported are the busy times per step type, the idle fraction and imbalance of the workers,
+     * and the duty cycles of the scheduling and communicating threads; as min, avg and max over all ranks.
+     * The work model of the step types gives their GFLOP/s and GB/s; the fraction of the roofline
+     * is relative to the memory bound given by the bandwidth.
+     * Collective operation if MPI is used.
+     *
+     * @param i_bwMem sustained memory bandwidth of the rank in GB/s, 0 if unknown.
+     **/
+    void logStats( double i_bwMem = 0 );
+
+#ifdef PP_USE_PERF
+    /**
+     * Logs the hardware counters accumulated over all calls of simulate, aggregated over all threads and ranks.
+     * Reported are GFLOP/s per thread, instructions per cycle and bytes (last level cache misses) per flop of the step types.
+     * Collective operation if MPI is used.
+     **/
+    void logCounters();
+#endif
 };
 
 #endif
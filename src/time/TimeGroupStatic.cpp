@@ -23,6 +23,9 @@
 
 #include "TimeGroupStatic.h"
 #include "monitor/instrument.hpp"
+#include "parallel/global.h"
+#include <limits>
+#include <cmath>
 
 #if defined PP_T_EQUATIONS_ADVECTION
 #include "impl/advection/ts_dep.inc"
@@ -34,20 +37,29 @@
 
 edge::time::TimeGroupStatic::TimeGroupStatic(       int_ts          i_rate,
                                                     int_ts          i_funMult,
-                                              const data::Internal &i_internal ):
+                                              const data::Internal &i_internal,
+                                                    bool            i_dynamic ):
 // m_rate(     i_rate     ),
  m_funMult(  i_funMult  ),
+ m_dynamic(  i_dynamic  ),
  m_internal( i_internal )
 {
   m_covSimTime = 0;
   m_updatesPer = 0;
   m_updatesReq = 0;
+  m_timeRem    = 0;
+  m_dTdyn      = 0;
+
+  m_dTminTd.resize( std::size_t(parallel::g_nThreads) * N_PAD_TD,
+                    std::numeric_limits< double >::max() );
 }
 
 void edge::time::TimeGroupStatic::setUp( double i_dTfun,
                                          double i_time ) {
-  // set general time step
-  m_dTgen = i_dTfun * m_funMult;
+  // set general time step, dynamic time stepping continues with the last data-dependent time step
+  if( m_dynamic && m_dTdyn > 0 ) m_dTgen = m_dTdyn * m_funMult;
+  else                           m_dTgen = i_dTfun * m_funMult;
+  m_timeRem = i_time;
 
   // derive number of required updates
   m_updatesReq  = i_time / m_dTgen;
@@ -71,10 +83,49 @@ void edge::time::TimeGroupStatic::updateTsInfo() {
   m_updatesReq -= 1;
 
   m_covSimTime += m_dT;
+  m_timeRem    -= m_dT;
+
+  setDt();
+}
+
+void edge::time::TimeGroupStatic::updateTsInfo( double i_dTfun ) {
+  m_updatesPer += 1;
+  m_covSimTime += m_dT;
+  m_timeRem    -= m_dT;
+
+  // the last update hit the synchronization time exactly
+  if( m_updatesReq <= 1 ) {
+    m_updatesReq = 0;
+    m_dTdyn = i_dTfun;
+    return;
+  }
+
+  m_dTdyn = i_dTfun;
+  m_dTgen = i_dTfun * m_funMult;
+
+  // derive the remaining updates with the new time step
+  m_updatesReq = std::max( int_ts(1), int_ts( std::ceil( m_timeRem / m_dTgen ) ) );
+  m_dTfin = std::max( 0.0, m_timeRem - ( m_dTgen * (m_updatesReq-1) ) );
 
   setDt();
 }
 
+void edge::time::TimeGroupStatic::minDt( double i_dT ) {
+  double &l_dT = m_dTminTd[ std::size_t(parallel::g_thread) * N_PAD_TD ];
+  l_dT = std::min( l_dT, i_dT );
+}
+
+double edge::time::TimeGroupStatic::reduceDt() {
+  double l_dT = std::numeric_limits< double >::max();
+
+  for( int l_td = 0; l_td < parallel::g_nThreads; l_td++ ) {
+    l_dT = std::min( l_dT, m_dTminTd[ std::size_t(l_td) * N_PAD_TD ] );
+    m_dTminTd[ std::size_t(l_td) * N_PAD_TD ] = std::numeric_limits< double >::max();
+  }
+
+  return l_dT;
+}
+
 void edge::time::TimeGroupStatic::computeStep( unsigned short                              i_step,
                                                int_el                                      i_first,
                                                int_el                                      i_size,
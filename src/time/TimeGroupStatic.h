@@ -29,6 +29,7 @@
 #include "data/layout.hpp"
 #include "io/Receivers.h"
 #include "io/ReceiversQuad.hpp"
+#include <vector>
 
 namespace edge {
   namespace time {
@@ -62,6 +63,21 @@ class edge::time::TimeGroupStatic {
     //! covered simulation time
     double m_covSimTime;
 
+    //! true if the time step is data-dependent and set after every update
+    const bool m_dynamic;
+
+    //! remaining time until synchronization
+    double m_timeRem;
+
+    //! data-dependent time step of the upcoming updates, 0 if not set yet
+    double m_dTdyn;
+
+    //! number of doubles between two threads' entries in m_dTminTd (cache line)
+    static const unsigned short N_PAD_TD = 8;
+
+    //! thread-local minima of the data-dependent time steps, [*]: thread (padded)
+    std::vector< double > m_dTminTd;
+
     //! elements/faces under control of this cluster
     data::Internal m_internal;
 
@@ -77,10 +93,12 @@ class edge::time::TimeGroupStatic {
      * @param i_rate local rate of this cluster.
      * @param i_funMult global rate with respect to the fundamental time step.
      * @param i_internal data under control of this cluster.
+     * @param i_dynamic if true, the time step is data-dependent and set through updateTsInfo( double ).
      **/
     TimeGroupStatic(       int_ts          i_rate,
                            int_ts          i_funMult,
-                     const data::Internal &i_internal );
+                     const data::Internal &i_internal,
+                           bool            i_dynamic = false );
 
     /**
      * Sets up the cluster for iterations until the given synchronization point.
@@ -96,6 +114,36 @@ class edge::time::TimeGroupStatic {
      **/
     void updateTsInfo();
 
+    /**
+     * Updates the time step info and sets the data-dependent fundamental time step of the next update.
+     * The time step is truncated, if the next update would exceed the synchronization time.
+     *
+     * @param i_dTfun fundamental time step of the next update.
+     **/
+    void updateTsInfo( double i_dTfun );
+
+    /**
+     * Checks if the time step is data-dependent.
+     *
+     * @return true if dynamic, false otherwise.
+     **/
+    bool dynamic() const { return m_dynamic; }
+
+    /**
+     * Contributes to the thread-local minimum of the data-dependent time step.
+     *
+     * @param i_dT time step computed by the calling thread.
+     **/
+    void minDt( double i_dT );
+
+    /**
+     * Reduces the thread-local minima of the data-dependent time step and resets them.
+     * Has to be called once all contributing steps finished.
+     *
+     * @return minimum time step of all threads.
+     **/
+    double reduceDt();
+
     /**
      * Computes a step of the cluster.
      *
@@ -0,0 +1,380 @@
+#!/usr/bin/env python
+##
+# @file This file is part of EDGE.
+#
+# @author Alexander Breuer (anbreuer AT ucsd.edu)
+#
+# @section LICENSE
+# Copyright (c) 2018, Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+# @section DESCRIPTION
+# End-to-end throughput benchmarks of EDGE on generated regular meshes.
+#
+# The suite builds (or reuses) one binary per element type, order, precision and number of concurrent forward runs,
+# and runs every binary for the given mesh sizes, thread and rank counts on a single node.
+# Results are written as JSON, one entry per run.
+##
+import argparse
+import datetime
+import itertools
+import json
+import logging
+import os
+import platform
+import re
+import shutil
+import subprocess
+import time
+
+# regular expressions matching the log of EDGE
+LOG_PATTERNS = { 'init':       r'initialization phase took us (\S+) seconds',
+                 'compute':    r'that\'s the duration of the computations \((\d+) time steps\): (\S+) seconds',
+                 'throughput': r'throughput \(#elements, element updates/s, DOF updates/s\): (\S+), (\S+), (\S+)',
+                 'mem_hwm':    r'memory high-water mark \(min/ave/max/sum\): (\S+) / (\S+) / (\S+) / (\S+) GiB' }
+
+# initial setups of the equations on periodic, regular meshes
+SETUPS = { 'advection': 'sine',
+           'elastic':   'plane_waves' }
+
+# dimensions of the element types supported by the regular meshes
+DIMS = { 'line':   1,
+         'quad4r': 2,
+         'hex8r':  3,
+         'tet4':   3 }
+
+##
+# Splits a comma-separated list.
+#
+# @param i_str string holding the list.
+# @return list of entries.
+##
+def splitList( i_str ):
+  return [ l_en.strip() for l_en in i_str.split(',') if l_en.strip() != '' ]
+
+##
+# Derives the name of a binary, matching tools/build/build_bin_suite.sh.
+#
+# @param i_args command line arguments.
+# @param i_el element type.
+# @param i_or order.
+# @param i_cfr number of concurrent forward runs.
+# @return name of the binary.
+##
+def binName( i_args, i_el, i_or, i_cfr ):
+  return '_'.join( [ 'edge', i_args['arch'], i_args['parallel'], i_el, i_args['equations'],
+                     str(i_or), str(i_args['precision']), str(i_cfr) ] )
+
+##
+# Builds a binary through SCons.
+#
+# @param i_args command line arguments.
+# @param i_el element type.
+# @param i_or order.
+# @param i_cfr number of concurrent forward runs.
+# @param i_path path of the binary.
+##
+def build( i_args, i_el, i_or, i_cfr, i_path ):
+  l_buildDir = os.path.join( i_args['work_dir'], 'build', os.path.basename( i_path ) )
+  l_cmd = [ 'scons',
+            'equations='    + i_args['equations'],
+            'element_type=' + i_el,
+            'order='        + str(i_or),
+            'precision='    + str(i_args['precision']),
+            'cfr='          + str(i_cfr),
+            'parallel='     + i_args['parallel'],
+            'arch='         + i_args['arch'],
+            'build_dir='    + l_buildDir,
+            '-j', str(i_args['build_jobs']) ] + i_args['scons'].split()
+
+  logging.info( 'building ' + os.path.basename( i_path ) )
+  subprocess.check_call( l_cmd, cwd = i_args['edge_root'] )
+  shutil.copy( os.path.join( l_buildDir, 'edge' ), i_path )
+
+##
+# Writes the XML configuration of a run.
+#
+# @param i_args command line arguments.
+# @param i_el element type.
+# @param i_nEls number of elements in every dimension (hexahedrons for tet4).
+# @param i_path path of the configuration.
+##
+def writeConfig( i_args, i_el, i_nEls, i_path ):
+  l_dims = ['x', 'y', 'z'][:DIMS[i_el]]
+
+  # unit edge length of the elements keeps the time step independent of the mesh size
+  l_nEls = ''.join( [ '<' + l_di + '>' + str(i_nEls) + '</' + l_di + '>' for l_di in l_dims ] )
+  l_size = ''.join( [ '<' + l_di + '>' + str(float(i_nEls)) + '</' + l_di + '>' for l_di in l_dims ] )
+
+  l_waveField = ''
+  if i_args['wave_field']:
+    l_waveField = '<wave_field><type>vtk_binary</type><file>output/wf</file>' + \
+                  '<int>' + str(i_args['end_time']) + '</int></wave_field>'
+
+  l_xml  = '<?xml version="1.0"?>\n'
+  l_xml += '<edge>\n'
+  l_xml += '  <cfr>\n'
+  l_xml += '    <mesh>\n'
+  l_xml += '      <n_elements>' + l_nEls + '</n_elements>\n'
+  l_xml += '      <size>' + l_size + '</size>\n'
+  l_xml += '    </mesh>\n'
+  l_xml += '    <setups>\n'
+  l_xml += '      <type_default>' + SETUPS[i_args['equations']] + '</type_default>\n'
+  l_xml += '      <end_time>' + str(i_args['end_time']) + '</end_time>\n'
+  l_xml += '    </setups>\n'
+  l_xml += '    <output>' + l_waveField + '</output>\n'
+  l_xml += '  </cfr>\n'
+  l_xml += '</edge>\n'
+
+  with open( i_path, 'w' ) as l_file:
+    l_file.write( l_xml )
+
+##
+# Parses the metrics from the log of a run.
+#
+# @param i_log log of the run.
+# @return dictionary with the metrics, entries are None if not found.
+##
+def parseLog( i_log ):
+  l_mets = { 'init_time':          None,
+             'compute_time':       None,
+             'time_steps':         None,
+             'n_elements':         None,
+             'element_updates_s':  None,
+             'dof_updates_s':      None,
+             'mem_hwm_gib':        None }
+
+  l_ma = re.search( LOG_PATTERNS['init'], i_log )
+  if l_ma:
+    l_mets['init_time'] = float( l_ma.group(1) )
+
+  l_ma = re.search( LOG_PATTERNS['compute'], i_log )
+  if l_ma:
+    l_mets['time_steps']   = int( l_ma.group(1) )
+    l_mets['compute_time'] = float( l_ma.group(2) )
+
+  l_ma = re.search( LOG_PATTERNS['throughput'], i_log )
+  if l_ma:
+    l_mets['n_elements']        = int( float( l_ma.group(1) ) )
+    l_mets['element_updates_s'] = float( l_ma.group(2) )
+    l_mets['dof_updates_s']     = float( l_ma.group(3) )
+
+  l_ma = re.search( LOG_PATTERNS['mem_hwm'], i_log )
+  if l_ma:
+    l_mets['mem_hwm_gib'] = { 'min': float( l_ma.group(1) ),
+                              'ave': float( l_ma.group(2) ),
+                              'max': float( l_ma.group(3) ),
+                              'sum': float( l_ma.group(4) ) }
+
+  return l_mets
+
+##
+# Gets the size of all files in a directory.
+#
+# @param i_dir directory.
+# @return size in bytes.
+##
+def dirSize( i_dir ):
+  l_size = 0
+  for l_root, l_dirs, l_files in os.walk( i_dir ):
+    for l_fi in l_files:
+      l_size += os.path.getsize( os.path.join( l_root, l_fi ) )
+  return l_size
+
+##
+# Runs a single benchmark.
+#
+# @param i_args command line arguments.
+# @param i_bin path of the binary.
+# @param i_el element type.
+# @param i_nEls number of elements per dimension.
+# @param i_nThs number of threads per rank.
+# @param i_nRas number of ranks.
+# @param i_rep id of the repetition.
+# @return dictionary describing the run.
+##
+def run( i_args, i_bin, i_el, i_nEls, i_nThs, i_nRas, i_rep ):
+  l_tag = '_'.join( [ os.path.basename( i_bin ), str(i_nEls), str(i_nThs), str(i_nRas), str(i_rep) ] )
+  l_dir = os.path.join( i_args['work_dir'], 'runs', l_tag )
+  if os.path.exists( l_dir ):
+    shutil.rmtree( l_dir )
+  os.makedirs( os.path.join( l_dir, 'output' ) )
+
+  l_xml = os.path.join( l_dir, 'config.xml' )
+  writeConfig( i_args, i_el, i_nEls, l_xml )
+
+  l_cmd = [ os.path.abspath( i_bin ), '-x', l_xml ]
+  if 'mpi' in i_args['parallel']:
+    l_cmd = i_args['mpi_exec'].format( ranks = i_nRas, threads = i_nThs ).split() + l_cmd
+
+  l_env = dict( os.environ )
+  l_env['OMP_NUM_THREADS'] = str( i_nThs )
+
+  logging.info( 'running ' + l_tag )
+  l_start = time.time()
+  with open( os.path.join( l_dir, 'edge.log' ), 'w' ) as l_logFile:
+    l_ret = subprocess.call( l_cmd, cwd = l_dir, env = l_env, stdout = l_logFile, stderr = subprocess.STDOUT )
+  l_wall = time.time() - l_start
+
+  with open( os.path.join( l_dir, 'edge.log' ) ) as l_logFile:
+    l_mets = parseLog( l_logFile.read() )
+
+  l_res = { 'binary':       os.path.basename( i_bin ),
+            'element_type': i_el,
+            'n_elements_dim': i_nEls,
+            'threads':      i_nThs,
+            'ranks':        i_nRas,
+            'repetition':   i_rep,
+            'return_code':  l_ret,
+            'wall_time':    l_wall,
+            'output_bytes': dirSize( os.path.join( l_dir, 'output' ) ) }
+  l_res.update( l_mets )
+
+  if l_ret != 0:
+    logging.warning( 'run failed with return code ' + str(l_ret) + ', see ' + l_dir )
+  elif l_mets['element_updates_s'] is not None:
+    logging.info( '  element updates/s: ' + str(l_mets['element_updates_s']) +
+                  ', DOF updates/s: ' + str(l_mets['dof_updates_s']) )
+
+  return l_res
+
+##
+# Gathers information on the machine and the revision.
+#
+# @param i_args command line arguments.
+# @return dictionary with the information.
+##
+def meta( i_args ):
+  l_meta = { 'date':     datetime.datetime.now().isoformat(),
+             'host':     platform.node(),
+             'cpu':      platform.processor(),
+             'n_cpus':   os.cpu_count() if hasattr( os, 'cpu_count' ) else None,
+             'revision': None }
+
+  if os.path.exists( '/proc/cpuinfo' ):
+    with open( '/proc/cpuinfo' ) as l_file:
+      for l_line in l_file:
+        if l_line.startswith( 'model name' ):
+          l_meta['cpu'] = l_line.split( ':', 1 )[1].strip()
+          break
+
+  try:
+    l_meta['revision'] = subprocess.check_output( ['git', 'describe', '--always', '--dirty'],
+                                                  cwd = i_args['edge_root'] ).decode().strip()
+  except ( OSError, subprocess.CalledProcessError ):
+    pass
+
+  return l_meta
+
+# set up logger
+logging.basicConfig( level=logging.INFO,
+                     format='%(asctime)s - %(name)s - %(levelname)s - %(message)s' )
+
+# parse command line options
+l_parser = argparse.ArgumentParser( description='End-to-end throughput benchmarks of EDGE on generated regular meshes.' )
+
+l_parser.add_argument( '--edge_root',     dest='edge_root',   type=str, default='.',
+                       help='root directory of EDGE, used for builds and the revision' )
+l_parser.add_argument( '--bin_dir',       dest='bin_dir',     type=str, default='./bin',
+                       help='directory of the binaries, named as by tools/build/build_bin_suite.sh' )
+l_parser.add_argument( '--build',         dest='build',       action='store_true',
+                       help='build missing binaries through SCons' )
+l_parser.add_argument( '--build_jobs',    dest='build_jobs',  type=int, default=8,
+                       help='number of parallel build jobs' )
+l_parser.add_argument( '--scons',         dest='scons',       type=str, default='',
+                       help='additional arguments of SCons, e.g., "xsmm=./libs"' )
+l_parser.add_argument( '--work_dir',      dest='work_dir',    type=str, default='./bench',
+                       help='directory of the builds and runs' )
+l_parser.add_argument( '--arch',          dest='arch',        type=str, default='host' )
+l_parser.add_argument( '--parallel',      dest='parallel',    type=str, default='mpi+omp' )
+l_parser.add_argument( '--equations',     dest='equations',   type=str, default='elastic',
+                       choices=sorted( SETUPS.keys() ) )
+l_parser.add_argument( '--precision',     dest='precision',   type=int, default=64, choices=[32, 64] )
+l_parser.add_argument( '--element_types', dest='element_types', type=str, default='tet4',
+                       help='comma-separated element types: ' + ', '.join( sorted( DIMS.keys() ) ) )
+l_parser.add_argument( '--orders',        dest='orders',      type=str, default='2,3,4,5' )
+l_parser.add_argument( '--cfrs',          dest='cfrs',        type=str, default='1' )
+l_parser.add_argument( '--n_elements',    dest='n_elements',  type=str, default='16,32',
+                       help='comma-separated number of elements per dimension (hexahedrons for tet4)' )
+l_parser.add_argument( '--threads',       dest='threads',     type=str, default='1' )
+l_parser.add_argument( '--ranks',         dest='ranks',       type=str, default='1' )
+l_parser.add_argument( '--mpi_exec',      dest='mpi_exec',    type=str, default='mpirun -np {ranks}',
+                       help='launcher of MPI runs, {ranks} and {threads} are replaced' )
+l_parser.add_argument( '--end_time',      dest='end_time',    type=float, default=0.5,
+                       help='simulated time of every run' )
+l_parser.add_argument( '--wave_field',    dest='wave_field',  action='store_true',
+                       help='write the wave field at the end of the runs' )
+l_parser.add_argument( '--reps',          dest='reps',        type=int, default=1,
+                       help='repetitions of every run' )
+l_parser.add_argument( '-o', '--output',  dest='output',      type=str, default='bench.json',
+                       help='JSON file of the results' )
+l_args = vars( l_parser.parse_args() )
+
+for l_key in [ 'bin_dir', 'work_dir', 'edge_root' ]:
+  l_args[l_key] = os.path.abspath( l_args[l_key] )
+
+l_els = splitList( l_args['element_types'] )
+for l_el in l_els:
+  if l_el not in DIMS:
+    l_parser.error( 'element type not supported by the regular meshes: ' + l_el )
+
+l_results = { 'meta':   meta( l_args ),
+              'config': { 'arch':       l_args['arch'],
+                          'parallel':   l_args['parallel'],
+                          'equations':  l_args['equations'],
+                          'precision':  l_args['precision'],
+                          'end_time':   l_args['end_time'],
+                          'wave_field': l_args['wave_field'] },
+              'runs':   [] }
+
+if not os.path.exists( l_args['bin_dir'] ):
+  os.makedirs( l_args['bin_dir'] )
+
+# iterate over the builds
+for l_el, l_or, l_cfr in itertools.product( l_els,
+                                            [ int(l_en) for l_en in splitList( l_args['orders'] ) ],
+                                            [ int(l_en) for l_en in splitList( l_args['cfrs'] ) ] ):
+  l_bin = os.path.join( l_args['bin_dir'], binName( l_args, l_el, l_or, l_cfr ) )
+
+  if not os.path.exists( l_bin ):
+    if not l_args['build']:
+      logging.warning( 'skipping missing binary ' + l_bin )
+      continue
+    try:
+      build( l_args, l_el, l_or, l_cfr, l_bin )
+    except ( OSError, subprocess.CalledProcessError ) as l_err:
+      logging.warning( 'build of ' + l_bin + ' failed: ' + str(l_err) )
+      continue
+
+  # iterate over the runs
+  for l_nEls, l_nRas, l_nThs, l_rep in itertools.product( [ int(l_en) for l_en in splitList( l_args['n_elements'] ) ],
+                                                          [ int(l_en) for l_en in splitList( l_args['ranks'] ) ],
+                                                          [ int(l_en) for l_en in splitList( l_args['threads'] ) ],
+                                                          range( l_args['reps'] ) ):
+    # only the tetrahedral regular meshes are partitioned
+    if l_nRas > 1 and ( l_el != 'tet4' or 'mpi' not in l_args['parallel'] ):
+      logging.info( 'skipping ' + str(l_nRas) + ' ranks for ' + l_el + ' and ' + l_args['parallel'] )
+      continue
+
+    l_res = run( l_args, l_bin, l_el, l_nEls, l_nThs, l_nRas, l_rep )
+    l_res.update( { 'order': l_or, 'cfr': l_cfr } )
+    l_results['runs'].append( l_res )
+
+    # write intermediate results
+    with open( l_args['output'], 'w' ) as l_file:
+      json.dump( l_results, l_file, indent = 2, sort_keys = True )
+
+with open( l_args['output'], 'w' ) as l_file:
+  json.dump( l_results, l_file, indent = 2, sort_keys = True )
+
+logging.info( 'wrote ' + str( len( l_results['runs'] ) ) + ' results to ' + l_args['output'] )
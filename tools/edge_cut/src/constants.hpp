@@ -27,4 +27,7 @@
 //! maximum considered intersections of rays/segments and surface meshes
 const unsigned short C_MAX_SURF_INTER = 10;
 
+//! targeted average number of topography faces per cell of the acceleration grid
+const double C_TOPO_GRID_FACES_PER_CELL = 2.0;
+
 #endif
@@ -0,0 +1,113 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2017, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Runtime configuration of EDGEcut.
+ **/
+
+#include "Config.h"
+#include "io/logging.hpp"
+
+#include <pugixml.hpp>
+
+/**
+ * Gets the text of a required node, aborts if the node is missing.
+ *
+ * @param i_root root node.
+ * @param i_path path of the node, relative to the root.
+ * @return text of the node.
+ **/
+static pugi::xml_text getReq( pugi::xml_node const & i_root,
+                              char           const * i_path ) {
+  pugi::xml_node l_nd = i_root.first_element_by_path( i_path );
+  if( !l_nd ) EDGE_LOG_FATAL << "missing entry in the XML-configuration: " << i_path;
+  return l_nd.text();
+}
+
+edge_cut::io::Config::Config( std::string const & i_xml ) {
+  pugi::xml_document l_doc;
+  pugi::xml_parse_result l_parseResult = l_doc.load_file( i_xml.c_str() );
+
+  // inform user about errors in xml-file
+  if( !l_parseResult ) {
+    EDGE_LOG_FATAL << "XML [" << i_xml << "] parsed with errors: " << l_parseResult.description()
+                   << " (error at [" << i_xml << " " << l_parseResult.offset << "])";
+  }
+
+  pugi::xml_node l_root = l_doc.child("edge_cut");
+  if( !l_root ) EDGE_LOG_FATAL << "XML [" << i_xml << "] has no edge_cut root";
+
+  // input and output
+  m_topoIn  = getReq( l_root, "input/topography" ).as_string();
+  m_surfOut = getReq( l_root, "output/surface" ).as_string();
+
+  // surrounding box
+  m_box[0] = getReq( l_root, "domain/box/x/min" ).as_double();
+  m_box[1] = getReq( l_root, "domain/box/x/max" ).as_double();
+  m_box[2] = getReq( l_root, "domain/box/y/min" ).as_double();
+  m_box[3] = getReq( l_root, "domain/box/y/max" ).as_double();
+  m_box[4] = getReq( l_root, "domain/box/z/min" ).as_double();
+  EDGE_CHECK_LT( m_box[0], m_box[1] );
+  EDGE_CHECK_LT( m_box[2], m_box[3] );
+
+  // patches
+  pugi::xml_node l_patches = l_root.child("patches");
+  m_nPatches[0] = l_patches.child("n_x").text().as_uint(       m_nPatches[0] );
+  m_nPatches[1] = l_patches.child("n_y").text().as_uint(       m_nPatches[1] );
+  m_overlap     = l_patches.child("overlap").text().as_double( m_overlap     );
+  m_weld        = l_patches.child("weld").text().as_double(    m_weld        );
+  m_parallelPatches = l_patches.child("parallel").text().as_bool( m_parallelPatches );
+  EDGE_CHECK_GT( m_nPatches[0], 0 );
+  EDGE_CHECK_GT( m_nPatches[1], 0 );
+  EDGE_CHECK_GE( m_overlap, 0 );
+  EDGE_CHECK_GE( m_weld, 0 );
+
+  // the walls of the patches have to be outside of the neighbors' cores
+  if( m_nPatches[0] * m_nPatches[1] > 1 ) EDGE_CHECK_GT( m_overlap, 0 );
+
+  // refinement
+  pugi::xml_node l_ref = l_root.child("refinement");
+  m_errorBound = l_ref.child("error_bound").text().as_double( m_errorBound );
+  m_angle      = l_ref.child("angle").text().as_double(       m_angle      );
+  m_radius     = l_ref.child("radius").text().as_double(      m_radius     );
+  m_distance   = l_ref.child("distance").text().as_double(    m_distance   );
+
+  for( pugi::xml_node l_layer = l_ref.child("layer"); l_layer; l_layer = l_layer.next_sibling("layer") ) {
+    m_layerDepths.push_back( getReq( l_layer, "depth" ).as_double() );
+    m_layerScales.push_back( getReq( l_layer, "scale" ).as_double() );
+  }
+}
+
+void edge_cut::io::Config::print() const {
+  EDGE_LOG_INFO << "runtime configuration:";
+  EDGE_LOG_INFO << "  topography: " << m_topoIn;
+  EDGE_LOG_INFO << "  surface:    " << m_surfOut;
+  EDGE_LOG_INFO << "  box:        [" << m_box[0] << ", " << m_box[1] << "] x ["
+                                     << m_box[2] << ", " << m_box[3] << "] x ["
+                                     << m_box[4] << ", topography]";
+  EDGE_LOG_INFO << "  patches:    " << m_nPatches[0] << " x " << m_nPatches[1]
+                << ", overlap: " << m_overlap << ", weld: " << m_weld
+                << ", parallel: " << m_parallelPatches;
+  EDGE_LOG_INFO << "  refinement: error bound " << m_errorBound
+                << ", angle " << m_angle << ", radius " << m_radius << ", distance " << m_distance;
+  for( std::size_t l_la = 0; l_la < m_layerDepths.size(); l_la++ ) {
+    EDGE_LOG_INFO << "    layer #" << l_la << ": depth " << m_layerDepths[l_la]
+                  << ", scale " << m_layerScales[l_la];
+  }
+}
@@ -0,0 +1,122 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2017, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Runtime configuration of EDGEcut.
+ **/
+
+#ifndef EDGE_CUT_IO_CONFIG_H_
+#define EDGE_CUT_IO_CONFIG_H_
+
+#include <string>
+#include <vector>
+
+namespace edge_cut {
+  namespace io {
+    class Config;
+  }
+}
+
+/**
+ * Runtime configuration, parsed from an XML-file of the following form:
+ *
+ * <edge_cut>
+ *   <input>
+ *     <topography>data/map_proj.xyz</topography>
+ *   </input>
+ *   <output>
+ *     <surface>out.ply</surface>
+ *   </output>
+ *   <domain>
+ *     <box>
+ *       <x><min>335000</min><max>495000</max></x>
+ *       <y><min>3705000</min><max>3845000</max></y>
+ *       <z><min>-25000</min></z>
+ *     </box>
+ *   </domain>
+ *   <patches>
+ *     <n_x>1</n_x>
+ *     <n_y>1</n_y>
+ *     <overlap>5000</overlap>
+ *     <weld>5</weld>
+ *     <parallel>no</parallel>
+ *   </patches>
+ *   <refinement>
+ *     <error_bound>1E-5</error_bound>
+ *     <angle>30</angle>
+ *     <radius>75</radius>
+ *     <distance>75</distance>
+ *     <layer><depth>-500</depth><scale>4.0</scale></layer>
+ *     <layer><depth>-1000</depth><scale>5.333</scale></layer>
+ *   </refinement>
+ * </edge_cut>
+ *
+ * Everything but the input, output and box is optional.
+ * A positive overlap is required for more than one patch.
+ * The patches are meshed one after another, unless parallel meshing is enabled explicitly.
+ **/
+class edge_cut::io::Config {
+  public:
+    //! location of the topographic data
+    std::string m_topoIn;
+
+    //! location of the surface mesh (binary PLY)
+    std::string m_surfOut;
+
+    //! surrounding box: x-min, x-max, y-min, y-max, z-min
+    double m_box[5];
+
+    //! number of patches in x- and y-direction
+    unsigned int m_nPatches[2] = {1, 1};
+
+    //! overlap of the patches, has to be positive for more than one patch
+    double m_overlap = 0;
+
+    //! tolerance for welding vertices at the seams of the patches
+    double m_weld = 0;
+
+    //! true if the patches are meshed in parallel, which shares the topography among the threads
+    bool m_parallelPatches = false;
+
+    //! error bound of the implicit surface
+    double m_errorBound = 1E-5;
+
+    //! angle, radius and distance bounds of the facets
+    double m_angle = 30;
+    double m_radius = 75;
+    double m_distance = 75;
+
+    //! depths of the layers' interfaces and scaling of the layers' radius and distance bounds
+    std::vector< double > m_layerDepths;
+    std::vector< double > m_layerScales;
+
+    /**
+     * Constructor: Parses the given XML-file.
+     *
+     * @param i_xml location of the XML-file.
+     **/
+    Config( std::string const & i_xml );
+
+    /**
+     * Prints the configuration.
+     **/
+    void print() const;
+};
+
+#endif
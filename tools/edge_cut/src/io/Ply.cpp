@@ -0,0 +1,84 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2017, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Writer for binary PLY-files.
+ **/
+
+#include "Ply.h"
+#include "io/logging.hpp"
+
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+void edge_cut::io::Ply::write( std::string                                   const & i_path,
+                               std::vector< std::array< double, 3 > >        const & i_veCrds,
+                               std::vector< std::array< std::size_t, 3 > >   const & i_faVe ) {
+  EDGE_CHECK_LE( i_veCrds.size(), (std::size_t) std::numeric_limits< int32_t >::max() );
+
+  // detect the byte order
+  uint16_t l_endian = 1;
+  bool l_little = *reinterpret_cast< unsigned char * >( &l_endian ) == 1;
+
+  std::ofstream l_file( i_path, std::ios::out | std::ios::binary );
+  EDGE_CHECK( l_file.is_open() ) << "could not open " << i_path;
+
+  // write the header
+  l_file << "ply\n"
+         << "format " << ( l_little ? "binary_little_endian" : "binary_big_endian" ) << " 1.0\n"
+         << "comment written by EDGEcut\n"
+         << "element vertex " << i_veCrds.size() << "\n"
+         << "property double x\n"
+         << "property double y\n"
+         << "property double z\n"
+         << "element face " << i_faVe.size() << "\n"
+         << "property list uchar int vertex_indices\n"
+         << "end_header\n";
+
+  // write the vertices
+  l_file.write( reinterpret_cast< char const * >( i_veCrds.data() ),
+                i_veCrds.size() * sizeof(double) * 3 );
+
+  // write the faces in chunks
+  std::size_t const l_chunk = 65536;
+  std::vector< char > l_buffer( l_chunk * (1 + 3*sizeof(int32_t)) );
+
+  for( std::size_t l_f0 = 0; l_f0 < i_faVe.size(); l_f0 += l_chunk ) {
+    std::size_t l_f1 = std::min( l_f0 + l_chunk, i_faVe.size() );
+    char *l_pos = l_buffer.data();
+
+    for( std::size_t l_fa = l_f0; l_fa < l_f1; l_fa++ ) {
+      *l_pos = 3;
+      l_pos++;
+      for( unsigned short l_ve = 0; l_ve < 3; l_ve++ ) {
+        int32_t l_id = (int32_t) i_faVe[l_fa][l_ve];
+        std::copy( reinterpret_cast< char const * >( &l_id ),
+                   reinterpret_cast< char const * >( &l_id ) + sizeof(int32_t),
+                   l_pos );
+        l_pos += sizeof(int32_t);
+      }
+    }
+
+    l_file.write( l_buffer.data(), l_pos - l_buffer.data() );
+  }
+
+  EDGE_CHECK( l_file.good() ) << "failed writing " << i_path;
+}
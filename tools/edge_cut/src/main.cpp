@@ -24,18 +24,24 @@
 #include "io/logging.hpp"
 INITIALIZE_EASYLOGGINGPP
 
-#include <CGAL/Surface_mesh.h>
+#include <CGAL/Surface_mesh_default_triangulation_3.h>
+#include <CGAL/Complex_2_in_triangulation_3.h>
+#include <CGAL/make_surface_mesh.h>
 #include <CGAL/Implicit_surface_3.h>
-#include <CGAL/IO/Complex_2_in_triangulation_3_file_writer.h>
 
+#include <cstdlib>
+#include <string>
+#include <cmath>
+#include <algorithm>
 
+#include "io/Config.h"
 #include "surf/Oracle.h"
 #include "surf/Topo.h"
+#include "surf/Patches.h"
 #include "surf/LayeredCriteria.h"
 
 
 int main( int i_argc, char *i_argv[] ) {
-  
   EDGE_LOG_INFO << "##########################################################################";
   EDGE_LOG_INFO << "##############   ##############            ###############  ##############";
   EDGE_LOG_INFO << "##############   ###############         ################   ##############";
@@ -51,54 +57,93 @@ int main( int i_argc, char *i_argv[] ) {
   EDGE_LOG_INFO << "#######################################################################cut";
   EDGE_LOG_INFO << "";
 
+  // parse the command line
+  if( i_argc != 3 || ( std::string( i_argv[1] ) != "-x" && std::string( i_argv[1] ) != "--xml" ) ) {
+    EDGE_LOG_INFO << "Usage: " << i_argv[0] << " -x XML_CONFIG";
+    return EXIT_FAILURE;
+  }
+
+  edge_cut::io::Config l_config( i_argv[2] );
+  l_config.print();
+
   EDGE_LOG_INFO << "ready to go..";
-  // delaunay triangulation
-  CGAL::Surface_mesh_default_triangulation_3 l_delTria; 
-  // complex
-  CGAL::Complex_2_in_triangulation_3<
-    CGAL::Surface_mesh_default_triangulation_3
-  > l_compl(l_delTria);
-
-
-  // bounding sphere
-  CGAL::Surface_mesh_default_triangulation_3::Geom_traits::Point_3  l_bndSphereCenter(400000,3750000,-25000);
-  CGAL::Surface_mesh_default_triangulation_3::Geom_traits::FT       l_bndSphereRadiusSquared = 250000.0*250000.0;
-  CGAL::Surface_mesh_default_triangulation_3::Geom_traits::Sphere_3 l_bndSphere( l_bndSphereCenter,
-                                                                                 l_bndSphereRadiusSquared);
-
-  // surround box:     x1      x2    y1      y2      z1
-  // 330000/500000/3700000/3850000
-  double l_box[5] = {335000, 495000, 3705000, 3845000, -25000};
-  
-  // construct oracle
-  EDGE_LOG_INFO << "constructing oracle for implicit surface meshing";
-  edge_cut::surf::Oracle l_oracle( l_box, "data/map_proj.xyz" );
-
-  EDGE_LOG_INFO << "implicit surface constructor";
-  
-  CGAL::Implicit_surface_3<
-    CGAL::Surface_mesh_default_triangulation_3::Geom_traits,
-    edge_cut::surf::Oracle
-    > l_implSurf( l_oracle, l_bndSphere, 1e-5 ); 
-
-  EDGE_LOG_INFO << "mesh criteria constructor";
-  
-  edge_cut::surf::LayeredCriteria<
-    CGAL::Surface_mesh_default_triangulation_3
-    > l_criteria( 30., 75., 75., {-500, -1000, -3000, -6000, -11000, -21000, -31000}, {4.000, 5.333, 6.222, 8.000, 8.111, 8.444, 10.000});
-
-  
-  // derive surface mesh
-  EDGE_LOG_INFO << "deriving 3D surface mesh..";
-  CGAL::make_surface_mesh( l_compl, l_implSurf, l_criteria, CGAL::Non_manifold_tag() );
-  EDGE_LOG_INFO << "surface mesh stats:";
-  EDGE_LOG_INFO << "  #vertices: " << l_delTria.number_of_vertices();
-  EDGE_LOG_INFO << "  #faces:    " << l_delTria.number_of_facets(); // TODO: fix, this should be edges
+
+  // read the topography, which is shared by all patches
+  EDGE_LOG_INFO << "constructing topography";
+  edge_cut::surf::Topo l_topo( l_config.m_topoIn );
+  double l_topoBox[6];
+  l_topo.getBoundingBox( l_topoBox );
+
+  // tile the domain
+  edge_cut::surf::Patches l_patches( l_config.m_box,
+                                     l_config.m_nPatches,
+                                     l_config.m_overlap );
+
+  EDGE_LOG_INFO << "deriving 3D surface meshes of " << l_patches.getNPatches() << " patches..";
+
+  // parallel meshing is opt-in: all threads query the shared topography, whose thread-safety in CGAL's
+  // point location is unverified
+#ifdef PP_USE_OMP
+#pragma omp parallel for schedule(dynamic,1) if( l_config.m_parallelPatches )
+#endif
+  for( std::size_t l_pa = 0; l_pa < l_patches.getNPatches(); l_pa++ ) {
+    double l_box[5];
+    l_patches.getBox( l_pa, l_box );
+
+    // delaunay triangulation
+    CGAL::Surface_mesh_default_triangulation_3 l_delTria;
+    // complex
+    CGAL::Complex_2_in_triangulation_3<
+      CGAL::Surface_mesh_default_triangulation_3
+    > l_compl(l_delTria);
+
+    // bounding sphere, centered at the bottom of the patch and enclosing the topography
+    double l_extent[3] = { 0.5 * (l_box[1] - l_box[0]),
+                           0.5 * (l_box[3] - l_box[2]),
+                           std::max( l_topoBox[5], l_box[4] ) - l_box[4] };
+    double l_radius = 1.1 * std::sqrt( l_extent[0]*l_extent[0] + l_extent[1]*l_extent[1] + l_extent[2]*l_extent[2] );
+
+    CGAL::Surface_mesh_default_triangulation_3::Geom_traits::Point_3  l_bndSphereCenter( l_box[0] + l_extent[0],
+                                                                                        l_box[2] + l_extent[1],
+                                                                                        l_box[4] );
+    CGAL::Surface_mesh_default_triangulation_3::Geom_traits::Sphere_3 l_bndSphere( l_bndSphereCenter,
+                                                                                   l_radius*l_radius );
+
+    // oracle and implicit surface of the patch
+    edge_cut::surf::Oracle l_oracle( l_box, l_topo );
+
+    CGAL::Implicit_surface_3<
+      CGAL::Surface_mesh_default_triangulation_3::Geom_traits,
+      edge_cut::surf::Oracle
+      > l_implSurf( l_oracle, l_bndSphere, l_config.m_errorBound );
+
+    edge_cut::surf::LayeredCriteria<
+      CGAL::Surface_mesh_default_triangulation_3
+      > l_criteria( l_config.m_angle,
+                    l_config.m_radius,
+                    l_config.m_distance,
+                    l_config.m_layerDepths,
+                    std::vector< CGAL::Surface_mesh_default_triangulation_3::Geom_traits::FT >( l_config.m_layerScales.begin(),
+                                                                                               l_config.m_layerScales.end() ) );
+
+    // derive surface mesh
+    CGAL::make_surface_mesh( l_compl, l_implSurf, l_criteria, CGAL::Non_manifold_tag() );
+
+    EDGE_LOG_INFO << "  finished patch #" << l_pa << ": "
+                  << l_delTria.number_of_vertices() << " vertices, "
+                  << l_compl.number_of_facets() << " facets";
+
+    // extract the facets in the patch's core
+    l_patches.add( l_pa, l_compl, l_oracle );
+  }
+
+  // stitch the patches
+  EDGE_LOG_INFO << "stitching patches";
+  l_patches.stitch( l_config.m_weld );
 
   // write surface mesh
   EDGE_LOG_INFO << "writing surface mesh";
-  std::ofstream l_out("out.off");
-  CGAL::output_surface_facets_to_off( l_out, l_compl );
+  l_patches.write( l_config.m_surfOut );
 
   EDGE_LOG_INFO << "thank you for using EDGEcut!";
 }
@@ -24,8 +24,8 @@
 #include "Oracle.h"
 #include "io/logging.hpp"
 
-edge_cut::surf::Oracle::Oracle( double              i_box[5],
-                                std::string const & i_topoFile ): m_topo( i_topoFile ) {
+edge_cut::surf::Oracle::Oracle( double const   i_box[5],
+                                Topo   const & i_topo ): m_topo( i_topo ) {
   // copy box to member
   for( unsigned short l_bd = 0; l_bd < 5; l_bd++ ) m_box[l_bd] = i_box[l_bd];
 }
@@ -37,13 +37,16 @@ namespace edge_cut {
 
 class edge_cut::surf::Oracle {
   private:
-    //! topography
-    Topo const m_topo;
+    //! topography, shared among all oracles
+    Topo const & m_topo;
 
     //! surrounding box
     double m_box[5];
 
   public:
+    //! point type of the queries
+    typedef CGAL::Surface_mesh_default_triangulation_3::Geom_traits::Point_3 Point;
+
     /**
      * Oracle for a surface mesh with a surrounding box (top open) and topography.
      * For the top dimension the surface topography is considered as boundary,
@@ -66,11 +69,18 @@ class edge_cut::surf::Oracle {
      *                       outside
      *
      * @param i_box boundaries of the box [box[0], box[1]] x [box[2], box[3]] x [box[4], infinity (topo)]
-     * @param i_topoFile location of the topgraphic data.
+     * @param i_topo topography, which has to outlive the oracle.
      **/
-    Oracle( double              i_box[5],
-            std::string const & i_topoFile );
+    Oracle( double const   i_box[5],
+            Topo   const & i_topo );
 
+    /**
+     * Evaluates the implicit function at the given point.
+     * Remark: Thread-safe, multiple oracles may share the topography and be evaluated concurrently.
+     *
+     * @param i_pt point at which the function is evaluated.
+     * @return 1 if the point is inside the surface, 0 otherwise.
+     **/
     CGAL::Surface_mesh_default_triangulation_3::Geom_traits::FT operator() (
       CGAL::Surface_mesh_default_triangulation_3::Geom_traits::Point_3 i_pt
     ) const;
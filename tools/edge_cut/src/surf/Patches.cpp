@@ -0,0 +1,224 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2017, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Tiling of the domain into overlapping patches and stitching of the patches' surface meshes.
+ **/
+
+#include "Patches.h"
+#include "io/Ply.h"
+#include "io/logging.hpp"
+
+#include <limits>
+#include <cstdint>
+#include <unordered_map>
+#include <algorithm>
+
+edge_cut::surf::Patches::Patches( double       const i_box[5],
+                                  unsigned int const i_nPatches[2],
+                                  double             i_overlap ) {
+  for( unsigned short l_en = 0; l_en < 5; l_en++ ) m_box[l_en] = i_box[l_en];
+  m_nPatches[0] = i_nPatches[0];
+  m_nPatches[1] = i_nPatches[1];
+  m_overlap = i_overlap;
+
+  EDGE_CHECK_GT( m_nPatches[0], 0 );
+  EDGE_CHECK_GT( m_nPatches[1], 0 );
+
+  // without overlap, the facets on the patches' internal walls would be inside the neighbors' cores
+  if( m_nPatches[0] * m_nPatches[1] > 1 ) EDGE_CHECK_GT( m_overlap, 0 );
+
+  m_veCrdsPa.resize( m_nPatches[0] * m_nPatches[1] );
+  m_faVePa.resize(   m_nPatches[0] * m_nPatches[1] );
+}
+
+void edge_cut::surf::Patches::getCore( std::size_t i_pa,
+                                       double      o_core[4] ) const {
+  unsigned int l_pos[2];
+  l_pos[0] = i_pa % m_nPatches[0];
+  l_pos[1] = i_pa / m_nPatches[0];
+
+  for( unsigned short l_di = 0; l_di < 2; l_di++ ) {
+    double l_width = ( m_box[l_di*2+1] - m_box[l_di*2] ) / m_nPatches[l_di];
+
+    o_core[l_di*2+0] = m_box[l_di*2] +  l_pos[l_di]    * l_width;
+    o_core[l_di*2+1] = m_box[l_di*2] + (l_pos[l_di]+1) * l_width;
+
+    // extend the core to infinity at the boundaries of the domain
+    if( l_pos[l_di] == 0 )                   o_core[l_di*2+0] = -std::numeric_limits< double >::max();
+    if( l_pos[l_di] == m_nPatches[l_di]-1 )  o_core[l_di*2+1] =  std::numeric_limits< double >::max();
+  }
+}
+
+void edge_cut::surf::Patches::getBox( std::size_t i_pa,
+                                      double      o_box[5] ) const {
+  getCore( i_pa, o_box );
+
+  // add the overlap, but stay within the domain
+  for( unsigned short l_di = 0; l_di < 2; l_di++ ) {
+    o_box[l_di*2+0] = std::max( o_box[l_di*2+0] - m_overlap, m_box[l_di*2+0] );
+    o_box[l_di*2+1] = std::min( o_box[l_di*2+1] + m_overlap, m_box[l_di*2+1] );
+  }
+
+  o_box[4] = m_box[4];
+}
+
+void edge_cut::surf::Patches::stitch( double i_weld ) {
+  m_veCrds.clear();
+  m_faVe.clear();
+
+  // hash for the integer coordinates of welding cells
+  struct t_hash {
+    std::size_t operator()( std::array< int64_t, 3 > const & i_key ) const {
+      std::size_t l_hash = 0;
+      for( unsigned short l_di = 0; l_di < 3; l_di++ ) {
+        l_hash ^= std::hash< int64_t >()( i_key[l_di] ) + 0x9e3779b9 + (l_hash << 6) + (l_hash >> 2);
+      }
+      return l_hash;
+    }
+  };
+
+  // vertices in the welding cells, cells have the width of the tolerance
+  std::unordered_map< std::array< int64_t, 3 >, std::vector< std::size_t >, t_hash > l_cells;
+  double l_cellWidth = ( i_weld > 0 ) ? i_weld : 1;
+
+  auto l_getKey = [&]( std::array< double, 3 > const & i_crds ) {
+    std::array< int64_t, 3 > l_key;
+    for( unsigned short l_di = 0; l_di < 3; l_di++ ) l_key[l_di] = (int64_t) std::floor( i_crds[l_di] / l_cellWidth );
+    return l_key;
+  };
+
+  std::size_t l_nSeam = 0;
+  std::size_t l_nMerged = 0;
+  std::size_t l_nDegen = 0;
+
+  for( std::size_t l_pa = 0; l_pa < getNPatches(); l_pa++ ) {
+    // detect the seam vertices: the patch's surface is closed, thus edges with a single adjacent face are cut by the core
+    std::map< std::pair< std::size_t, std::size_t >, unsigned int > l_edgesPa;
+    for( std::size_t l_fa = 0; l_fa < m_faVePa[l_pa].size(); l_fa++ ) {
+      for( unsigned short l_ed = 0; l_ed < 3; l_ed++ ) {
+        std::size_t l_v0 = m_faVePa[l_pa][l_fa][l_ed];
+        std::size_t l_v1 = m_faVePa[l_pa][l_fa][(l_ed+1)%3];
+        l_edgesPa[ std::make_pair( std::min( l_v0, l_v1 ), std::max( l_v0, l_v1 ) ) ]++;
+      }
+    }
+    std::vector< bool > l_seam( m_veCrdsPa[l_pa].size(), false );
+    for( auto const & l_ed : l_edgesPa ) {
+      if( l_ed.second == 1 ) {
+        l_seam[l_ed.first.first]  = true;
+        l_seam[l_ed.first.second] = true;
+      }
+    }
+
+    // map patch-local vertices to stitched ones
+    std::vector< std::size_t > l_veMap( m_veCrdsPa[l_pa].size() );
+
+    for( std::size_t l_ve = 0; l_ve < m_veCrdsPa[l_pa].size(); l_ve++ ) {
+      std::array< double, 3 > const & l_crds = m_veCrdsPa[l_pa][l_ve];
+
+      // interior vertices of the patch are never welded
+      if( !l_seam[l_ve] ) {
+        l_veMap[l_ve] = m_veCrds.size();
+        m_veCrds.push_back( l_crds );
+        continue;
+      }
+      l_nSeam++;
+
+      std::array< int64_t, 3 > l_key = l_getKey( l_crds );
+
+      // search the neighboring cells for a vertex within the tolerance
+      std::size_t l_match = std::numeric_limits< std::size_t >::max();
+      std::array< int64_t, 3 > l_ne;
+      for( l_ne[2] = l_key[2]-1; l_ne[2] <= l_key[2]+1 && l_match == std::numeric_limits< std::size_t >::max(); l_ne[2]++ ) {
+        for( l_ne[1] = l_key[1]-1; l_ne[1] <= l_key[1]+1 && l_match == std::numeric_limits< std::size_t >::max(); l_ne[1]++ ) {
+          for( l_ne[0] = l_key[0]-1; l_ne[0] <= l_key[0]+1 && l_match == std::numeric_limits< std::size_t >::max(); l_ne[0]++ ) {
+            auto l_it = l_cells.find( l_ne );
+            if( l_it == l_cells.end() ) continue;
+
+            for( std::size_t l_ca : l_it->second ) {
+              double l_dist = 0;
+              for( unsigned short l_di = 0; l_di < 3; l_di++ )
+                l_dist = std::max( l_dist, std::abs( m_veCrds[l_ca][l_di] - l_crds[l_di] ) );
+
+              if( l_dist <= i_weld ) {
+                l_match = l_ca;
+                break;
+              }
+            }
+          }
+        }
+      }
+
+      if( l_match == std::numeric_limits< std::size_t >::max() ) {
+        l_veMap[l_ve] = m_veCrds.size();
+        l_cells[l_key].push_back( m_veCrds.size() );
+        m_veCrds.push_back( l_crds );
+      }
+      else {
+        l_veMap[l_ve] = l_match;
+        l_nMerged++;
+      }
+    }
+
+    // add the faces, ignoring degenerated ones
+    for( std::size_t l_fa = 0; l_fa < m_faVePa[l_pa].size(); l_fa++ ) {
+      std::array< std::size_t, 3 > l_faVe;
+      for( unsigned short l_ve = 0; l_ve < 3; l_ve++ ) l_faVe[l_ve] = l_veMap[ m_faVePa[l_pa][l_fa][l_ve] ];
+
+      if( l_faVe[0] == l_faVe[1] || l_faVe[1] == l_faVe[2] || l_faVe[0] == l_faVe[2] ) {
+        l_nDegen++;
+        continue;
+      }
+      m_faVe.push_back( l_faVe );
+    }
+
+    // free the patch's memory
+    std::vector< std::array< double, 3 > >().swap( m_veCrdsPa[l_pa] );
+    std::vector< std::array< std::size_t, 3 > >().swap( m_faVePa[l_pa] );
+  }
+
+  // count the edges with a single adjacent face (open seams or boundaries)
+  std::map< std::pair< std::size_t, std::size_t >, unsigned int > l_edges;
+  for( std::size_t l_fa = 0; l_fa < m_faVe.size(); l_fa++ ) {
+    for( unsigned short l_ed = 0; l_ed < 3; l_ed++ ) {
+      std::size_t l_v0 = m_faVe[l_fa][l_ed];
+      std::size_t l_v1 = m_faVe[l_fa][(l_ed+1)%3];
+      l_edges[ std::make_pair( std::min( l_v0, l_v1 ), std::max( l_v0, l_v1 ) ) ]++;
+    }
+  }
+  std::size_t l_nOpen = 0;
+  for( auto const & l_ed : l_edges ) if( l_ed.second == 1 ) l_nOpen++;
+
+  EDGE_LOG_INFO << "  stitched patches:";
+  EDGE_LOG_INFO << "    #vertices:         " << m_veCrds.size();
+  EDGE_LOG_INFO << "    #faces:            " << m_faVe.size();
+  EDGE_LOG_INFO << "    #seam vertices:    " << l_nSeam;
+  EDGE_LOG_INFO << "    #welded vertices:  " << l_nMerged;
+  EDGE_LOG_INFO << "    #degenerated faces: " << l_nDegen;
+  EDGE_LOG_INFO << "    #open edges:       " << l_nOpen;
+
+  // the patches are meshed independently, thus welding only closes the seams if the meshes conform there
+  if( getNPatches() > 1 && l_nOpen > 0 )
+    EDGE_LOG_FATAL << "stitching left " << l_nOpen << " open edges at the seams of the patches, "
+                   << "increase the weld tolerance or use a single patch";
+}
+
+void edge_cut::surf::Patches::write( std::string const & i_path ) const {
+  io::Ply::write( i_path, m_veCrds, m_faVe );
+}
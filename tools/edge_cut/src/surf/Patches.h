@@ -0,0 +1,210 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2017, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Tiling of the domain into overlapping patches and stitching of the patches' surface meshes.
+ **/
+
+#ifndef EDGE_CUT_SURF_PATCHES_H_
+#define EDGE_CUT_SURF_PATCHES_H_
+
+#include <string>
+#include <vector>
+#include <array>
+#include <map>
+#include <cmath>
+
+#include <CGAL/number_utils.h>
+
+namespace edge_cut {
+  namespace surf {
+    class Patches;
+  }
+}
+
+/**
+ * The surrounding box is split into n_x * n_y horizontal patches, which are extended by an overlap.
+ * Every patch is meshed independently; afterwards each patch contributes the facets whose centroids
+ * are inside its core (the patch without overlap). The remaining facets are stitched by welding
+ * vertices across the seams.
+ * The overlap has to be positive for more than one patch, since the patches' internal walls are part
+ * of their surfaces.
+ **/
+class edge_cut::surf::Patches {
+  private:
+    //! surrounding box: x-min, x-max, y-min, y-max, z-min
+    double m_box[5];
+
+    //! number of patches in x- and y-direction
+    unsigned int m_nPatches[2];
+
+    //! overlap of the patches
+    double m_overlap;
+
+    //! per-patch vertex coordinates
+    std::vector< std::vector< std::array< double, 3 > > > m_veCrdsPa;
+
+    //! per-patch vertices adjacent to the faces (patch-local ids)
+    std::vector< std::vector< std::array< std::size_t, 3 > > > m_faVePa;
+
+    //! stitched vertex coordinates
+    std::vector< std::array< double, 3 > > m_veCrds;
+
+    //! stitched vertices adjacent to the faces
+    std::vector< std::array< std::size_t, 3 > > m_faVe;
+
+    /**
+     * Gets the core of a patch, infinite at the boundaries of the domain.
+     *
+     * @param i_pa id of the patch.
+     * @param o_core will be set to the core: x-min, x-max, y-min, y-max.
+     **/
+    void getCore( std::size_t i_pa,
+                  double      o_core[4] ) const;
+
+  public:
+    /**
+     * Constructor.
+     *
+     * @param i_box surrounding box: x-min, x-max, y-min, y-max, z-min.
+     * @param i_nPatches number of patches in x- and y-direction.
+     * @param i_overlap overlap by which the patches are extended in x- and y-direction, positive for more than one patch.
+     **/
+    Patches( double       const i_box[5],
+             unsigned int const i_nPatches[2],
+             double             i_overlap );
+
+    /**
+     * Gets the number of patches.
+     *
+     * @return number of patches.
+     **/
+    std::size_t getNPatches() const { return m_veCrdsPa.size(); }
+
+    /**
+     * Gets the box of a patch, including the overlap.
+     *
+     * @param i_pa id of the patch.
+     * @param o_box will be set to the box: x-min, x-max, y-min, y-max, z-min.
+     **/
+    void getBox( std::size_t i_pa,
+                 double      o_box[5] ) const;
+
+    /**
+     * Adds the facets of a patch's surface mesh, which are inside the patch's core.
+     * The facets are oriented such that the normals point to the outside of the oracle's surface.
+     * Remark: Different patches may be added concurrently.
+     *
+     * @param i_pa id of the patch.
+     * @param i_compl 2D complex in the 3D triangulation, holding the patch's surface mesh.
+     * @param i_oracle oracle of the patch's implicit surface.
+     *
+     * @paramt TL_T_C2T3 type of the complex.
+     * @paramt TL_T_ORACLE type of the oracle.
+     **/
+    template< typename TL_T_C2T3,
+              typename TL_T_ORACLE >
+    void add( std::size_t         i_pa,
+              TL_T_C2T3         & i_compl,
+              TL_T_ORACLE const & i_oracle ) {
+      double l_core[4];
+      getCore( i_pa, l_core );
+
+      std::vector< std::array< double, 3 > >      & l_veCrds = m_veCrdsPa[i_pa];
+      std::vector< std::array< std::size_t, 3 > > & l_faVe   = m_faVePa[i_pa];
+      std::map< typename TL_T_C2T3::Vertex_handle, std::size_t > l_veIds;
+
+      for( typename TL_T_C2T3::Facet_iterator l_fa = i_compl.facets_begin(); l_fa != i_compl.facets_end(); ++l_fa ) {
+        typename TL_T_C2T3::Vertex_handle l_ves[3];
+        double l_crds[3][3];
+        double l_cen[3] = {0, 0, 0};
+
+        for( unsigned short l_ve = 0; l_ve < 3; l_ve++ ) {
+          l_ves[l_ve] = l_fa->first->vertex( (l_fa->second+l_ve+1)&3 );
+          l_crds[l_ve][0] = CGAL::to_double( l_ves[l_ve]->point().x() );
+          l_crds[l_ve][1] = CGAL::to_double( l_ves[l_ve]->point().y() );
+          l_crds[l_ve][2] = CGAL::to_double( l_ves[l_ve]->point().z() );
+          for( unsigned short l_di = 0; l_di < 3; l_di++ ) l_cen[l_di] += l_crds[l_ve][l_di] / 3;
+        }
+
+        // ignore facets outside of the core
+        if( l_cen[0] <  l_core[0] || l_cen[0] >= l_core[1] ||
+            l_cen[1] <  l_core[2] || l_cen[1] >= l_core[3] ) continue;
+
+        // derive the normal and probe the oracle on both sides of the facet
+        double l_e0[3], l_e1[3], l_nor[3];
+        for( unsigned short l_di = 0; l_di < 3; l_di++ ) {
+          l_e0[l_di] = l_crds[1][l_di] - l_crds[0][l_di];
+          l_e1[l_di] = l_crds[2][l_di] - l_crds[0][l_di];
+        }
+        l_nor[0] = l_e0[1]*l_e1[2] - l_e0[2]*l_e1[1];
+        l_nor[1] = l_e0[2]*l_e1[0] - l_e0[0]*l_e1[2];
+        l_nor[2] = l_e0[0]*l_e1[1] - l_e0[1]*l_e1[0];
+
+        // |n| is twice the area, we step 1% of the facet's size in normal direction
+        double l_len = std::sqrt( l_nor[0]*l_nor[0] + l_nor[1]*l_nor[1] + l_nor[2]*l_nor[2] );
+        double l_scale = ( l_len > 0 ) ? 0.01 / std::sqrt( l_len ) : 0;
+
+        typename TL_T_ORACLE::Point l_ptPos( l_cen[0] + l_scale * l_nor[0],
+                                             l_cen[1] + l_scale * l_nor[1],
+                                             l_cen[2] + l_scale * l_nor[2] );
+        typename TL_T_ORACLE::Point l_ptNeg( l_cen[0] - l_scale * l_nor[0],
+                                             l_cen[1] - l_scale * l_nor[1],
+                                             l_cen[2] - l_scale * l_nor[2] );
+
+        bool l_flip = i_oracle( l_ptPos ) > i_oracle( l_ptNeg );
+
+        // assign the facet
+        std::array< std::size_t, 3 > l_faVeLoc;
+        for( unsigned short l_ve = 0; l_ve < 3; l_ve++ ) {
+          auto l_it = l_veIds.find( l_ves[l_ve] );
+
+          if( l_it == l_veIds.end() ) {
+            l_it = l_veIds.insert( std::make_pair( l_ves[l_ve], l_veCrds.size() ) ).first;
+            l_veCrds.push_back( { l_crds[l_ve][0], l_crds[l_ve][1], l_crds[l_ve][2] } );
+          }
+
+          l_faVeLoc[l_ve] = l_it->second;
+        }
+        if( l_flip ) std::swap( l_faVeLoc[1], l_faVeLoc[2] );
+
+        l_faVe.push_back( l_faVeLoc );
+      }
+    }
+
+    /**
+     * Stitches the patches.
+     * Only the seam vertices, i.e., vertices of edges with a single adjacent facet in a patch, are welded:
+     * Seam vertices closer than the given tolerance (maximum norm) are merged; zero merges coinciding vertices only.
+     * Facets which degenerate by the merge are removed.
+     * The seams of independently meshed patches do not conform in general: stitching fails if open edges remain.
+     *
+     * @param i_weld tolerance for welding vertices.
+     **/
+    void stitch( double i_weld );
+
+    /**
+     * Writes the stitched surface mesh as binary PLY-file.
+     *
+     * @param i_path location of the output file.
+     **/
+    void write( std::string const & i_path ) const;
+};
+
+#endif
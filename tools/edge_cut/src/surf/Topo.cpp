@@ -25,6 +25,9 @@
 #include "io/logging.hpp"
 
 #include <fstream>
+#include <cmath>
+#include <algorithm>
+#include <limits>
 
 void edge_cut::surf::Topo::computeDelaunay( std::string const & i_topoFile ) {
   // parse the points
@@ -43,23 +46,138 @@ void edge_cut::surf::Topo::computeDelaunay( std::string const & i_topoFile ) {
   EDGE_LOG_INFO << "    #faces:    " << m_delTria.number_of_vertices();
 }
 
+void edge_cut::surf::Topo::computeGrid() {
+  // derive the bounding box
+  m_bBox[0] = m_bBox[2] = m_bBox[4] =  std::numeric_limits< double >::max();
+  m_bBox[1] = m_bBox[3] = m_bBox[5] = -std::numeric_limits< double >::max();
+
+  for( t_delTria::Finite_vertices_iterator l_ve = m_delTria.finite_vertices_begin();
+       l_ve != m_delTria.finite_vertices_end(); ++l_ve ) {
+    m_bBox[0] = std::min( m_bBox[0], l_ve->point().x() );
+    m_bBox[1] = std::max( m_bBox[1], l_ve->point().x() );
+    m_bBox[2] = std::min( m_bBox[2], l_ve->point().y() );
+    m_bBox[3] = std::max( m_bBox[3], l_ve->point().y() );
+    m_bBox[4] = std::min( m_bBox[4], l_ve->point().z() );
+    m_bBox[5] = std::max( m_bBox[5], l_ve->point().z() );
+  }
+
+  // derive the number of cells, aiming at square cells
+  std::size_t l_nFas = m_delTria.number_of_faces();
+  double l_nCells = std::max( 1.0, l_nFas / C_TOPO_GRID_FACES_PER_CELL );
+  double l_width[2] = { m_bBox[1] - m_bBox[0], m_bBox[3] - m_bBox[2] };
+
+  if( l_nFas == 0 || l_width[0] <= 0 || l_width[1] <= 0 ) {
+    m_gridN[0] = m_gridN[1] = 1;
+  }
+  else {
+    m_gridN[0] = (std::size_t) std::max( 1.0, std::ceil( std::sqrt( l_nCells * l_width[0] / l_width[1] ) ) );
+    m_gridN[1] = (std::size_t) std::max( 1.0, std::ceil( l_nCells / m_gridN[0] ) );
+  }
+
+  for( unsigned short l_di = 0; l_di < 2; l_di++ ) {
+    m_gridDxInv[l_di] = ( l_width[l_di] > 0 ) ? m_gridN[l_di] / l_width[l_di] : 0;
+  }
+
+  // lambda which derives the range of cells covered by a face's bounding box
+  auto l_cellRange = [&]( t_delTria::Face_handle const & i_fa,
+                          std::size_t                    o_range[2][2] ) {
+    double l_bbox[4] = {  std::numeric_limits< double >::max(),
+                         -std::numeric_limits< double >::max(),
+                          std::numeric_limits< double >::max(),
+                         -std::numeric_limits< double >::max() };
+
+    for( unsigned short l_ve = 0; l_ve < 3; l_ve++ ) {
+      l_bbox[0] = std::min( l_bbox[0], i_fa->vertex(l_ve)->point().x() );
+      l_bbox[1] = std::max( l_bbox[1], i_fa->vertex(l_ve)->point().x() );
+      l_bbox[2] = std::min( l_bbox[2], i_fa->vertex(l_ve)->point().y() );
+      l_bbox[3] = std::max( l_bbox[3], i_fa->vertex(l_ve)->point().y() );
+    }
+
+    for( unsigned short l_di = 0; l_di < 2; l_di++ ) {
+      for( unsigned short l_sd = 0; l_sd < 2; l_sd++ ) {
+        double l_pos = ( l_bbox[l_di*2+l_sd] - m_bBox[l_di*2] ) * m_gridDxInv[l_di];
+        o_range[l_di][l_sd] = std::min( (std::size_t) std::max( 0.0, l_pos ), m_gridN[l_di]-1 );
+      }
+    }
+  };
+
+  // count the faces per cell
+  m_gridFaOff.assign( m_gridN[0]*m_gridN[1] + 1, 0 );
+
+  for( t_delTria::Finite_faces_iterator l_fa = m_delTria.finite_faces_begin();
+       l_fa != m_delTria.finite_faces_end(); ++l_fa ) {
+    std::size_t l_range[2][2];
+    l_cellRange( l_fa, l_range );
+
+    for( std::size_t l_y = l_range[1][0]; l_y <= l_range[1][1]; l_y++ )
+      for( std::size_t l_x = l_range[0][0]; l_x <= l_range[0][1]; l_x++ )
+        m_gridFaOff[ l_y*m_gridN[0] + l_x + 1 ]++;
+  }
+
+  for( std::size_t l_ce = 0; l_ce < m_gridN[0]*m_gridN[1]; l_ce++ ) {
+    m_gridFaOff[l_ce+1] += m_gridFaOff[l_ce];
+  }
+
+  // assign the faces
+  m_gridFas.resize( m_gridFaOff.back() );
+  std::vector< std::size_t > l_fill( m_gridFaOff.begin(), m_gridFaOff.end()-1 );
+
+  for( t_delTria::Finite_faces_iterator l_fa = m_delTria.finite_faces_begin();
+       l_fa != m_delTria.finite_faces_end(); ++l_fa ) {
+    std::size_t l_range[2][2];
+    l_cellRange( l_fa, l_range );
+
+    for( std::size_t l_y = l_range[1][0]; l_y <= l_range[1][1]; l_y++ )
+      for( std::size_t l_x = l_range[0][0]; l_x <= l_range[0][1]; l_x++ )
+        m_gridFas[ l_fill[ l_y*m_gridN[0] + l_x ]++ ] = l_fa;
+  }
+
+  EDGE_LOG_INFO << "  computed acceleration grid:";
+  EDGE_LOG_INFO << "    #cells:         " << m_gridN[0] << " x " << m_gridN[1];
+  EDGE_LOG_INFO << "    #face-entries:  " << m_gridFas.size();
+}
+
+bool edge_cut::surf::Topo::getCell( double        i_x,
+                                    double        i_y,
+                                    std::size_t  &o_cell ) const {
+  if( i_x < m_bBox[0] || i_x > m_bBox[1] ||
+      i_y < m_bBox[2] || i_y > m_bBox[3] ) return false;
+
+  std::size_t l_x = std::min( (std::size_t) ( (i_x - m_bBox[0]) * m_gridDxInv[0] ), m_gridN[0]-1 );
+  std::size_t l_y = std::min( (std::size_t) ( (i_y - m_bBox[2]) * m_gridDxInv[1] ), m_gridN[1]-1 );
+
+  o_cell = l_y * m_gridN[0] + l_x;
+  return true;
+}
+
+edge_cut::surf::Topo::t_delTria::Face_handle edge_cut::surf::Topo::locate( CGAL::Point_3< CGAL::Cartesian<double> > const & i_pt ) const {
+  std::size_t l_ce;
+  if( getCell( i_pt.x(), i_pt.y(), l_ce ) ) {
+    // test the face candidates of the cell
+    for( std::size_t l_fa = m_gridFaOff[l_ce]; l_fa < m_gridFaOff[l_ce+1]; l_fa++ ) {
+      if( m_delTria.oriented_side( m_gridFas[l_fa], i_pt ) != CGAL::ON_NEGATIVE_SIDE ) return m_gridFas[l_fa];
+    }
+  }
+
+  return t_delTria::Face_handle();
+}
+
+void edge_cut::surf::Topo::getBoundingBox( double o_box[6] ) const {
+  for( unsigned short l_en = 0; l_en < 6; l_en++ ) o_box[l_en] = m_bBox[l_en];
+}
+
 edge_cut::surf::Topo::Topo( std::string const & i_topoFile ) {
   computeDelaunay( i_topoFile );
+  computeGrid();
 }
 
 bool edge_cut::surf::Topo::interRay( CGAL::Point_3< CGAL::Cartesian<double> > const & i_pt,
                                      bool                                             i_positive ) const {
-  CGAL::Delaunay_triangulation_2 <
-    CGAL::Projection_traits_xy_3 <
-      CGAL::Cartesian<double>
-    >
-  >::Face_handle l_faceHa;
-
-  // get the possible 2D face 
-  l_faceHa = m_delTria.locate( i_pt );
+  // get the possible 2D face
+  t_delTria::Face_handle l_faceHa = locate( i_pt );
 
   // return if no face qualifies
-  if( l_faceHa == NULL ) return false;
+  if( l_faceHa == t_delTria::Face_handle() ) return false;
   // do the 3D intersection otherwise and check the side w.r.t. to the face
   else {
       // set up the face
@@ -88,12 +206,10 @@ unsigned short edge_cut::surf::Topo::interSeg( CGAL::Point_3< CGAL::Cartesian<do
   // set up segment
   CGAL::Segment_3< CGAL::Cartesian<double> > l_seg( i_segPt1, i_segPt2 );
 
-  // get intersections in 2D
-  CGAL::Delaunay_triangulation_2 <
-    CGAL::Projection_traits_xy_3 <
-      CGAL::Cartesian<double>
-    >
-  >::Line_face_circulator l_lineWalk = m_delTria.line_walk( i_segPt1, i_segPt2 ), l_lineWalkDone(l_lineWalk);
+  // get intersections in 2D, starting at the face containing the first point (if available)
+  t_delTria::Line_face_circulator l_lineWalk = m_delTria.line_walk( i_segPt1,
+                                                                    i_segPt2,
+                                                                    locate( i_segPt1 ) ), l_lineWalkDone(l_lineWalk);
 
   unsigned int l_interCount = 0;
 
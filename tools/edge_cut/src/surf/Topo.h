@@ -25,6 +25,7 @@
 #define TOPO_H_
 
 #include <string>
+#include <vector>
 
 #include <CGAL/Cartesian.h>
 #include <CGAL/Delaunay_triangulation_2.h>
@@ -40,12 +41,30 @@ namespace edge_cut {
 
 class edge_cut::surf::Topo {
   private:
-    // 2.5D delaunay triangulation of the topographic data
-    CGAL::Delaunay_triangulation_2 <
+    //! 2.5D delaunay triangulation type
+    typedef CGAL::Delaunay_triangulation_2 <
       CGAL::Projection_traits_xy_3 <
         CGAL::Cartesian<double>
       >
-    > m_delTria;
+    > t_delTria;
+
+    // 2.5D delaunay triangulation of the topographic data
+    t_delTria m_delTria;
+
+    //! bounding box of the triangulation's vertices: x-min, x-max, y-min, y-max, z-min, z-max
+    double m_bBox[6];
+
+    //! number of grid cells in x- and y-direction
+    std::size_t m_gridN[2];
+
+    //! inverse widths of the grid cells in x- and y-direction
+    double m_gridDxInv[2];
+
+    //! faces of cell c are stored at [ m_gridFaOff[c], m_gridFaOff[c+1] ) in m_gridFas
+    std::vector< std::size_t > m_gridFaOff;
+
+    //! finite faces whose xy-bounding box overlaps the respective grid cell
+    std::vector< t_delTria::Face_handle > m_gridFas;
 
     /*
      * Computes the 2.5D delaynay triangulation from the given topographic data.
@@ -54,6 +73,33 @@ class edge_cut::surf::Topo {
      */
     void computeDelaunay( std::string const & i_topoFile );
 
+    /**
+     * Computes the uniform 2D grid of buckets over the finite faces of the triangulation.
+     * The grid replaces the triangulation's walk-based point location for our queries.
+     **/
+    void computeGrid();
+
+    /**
+     * Gets the cell of the grid containing the given point in the xy-plane.
+     *
+     * @param i_x x-coordinate of the point.
+     * @param i_y y-coordinate of the point.
+     * @param o_cell will be set to the id of the cell.
+     * @return true if the point is inside the grid, false otherwise.
+     **/
+    bool getCell( double        i_x,
+                  double        i_y,
+                  std::size_t  &o_cell ) const;
+
+    /**
+     * Locates the finite face of the triangulation containing the given point in the xy-plane.
+     * Remark: This is free of side-effects and may be called concurrently.
+     *
+     * @param i_pt point which is located.
+     * @return face containing the point, default-constructed handle if outside of the triangulation.
+     **/
+    t_delTria::Face_handle locate( CGAL::Point_3< CGAL::Cartesian<double> > const & i_pt ) const;
+
   public:
     /**
      * Constructor: Derives the delaunay triangulation of the topo data.
@@ -62,8 +108,16 @@ class edge_cut::surf::Topo {
      **/
     Topo( std::string const & i_topoFile );
 
+    /**
+     * Gets the bounding box of the topographic data.
+     *
+     * @param o_box will be set to the bounding box: x-min, x-max, y-min, y-max, z-min, z-max.
+     **/
+    void getBoundingBox( double o_box[6] ) const;
+
     /**
      * Check if the given vertical ray intersects with the topo mesh.
+     * Remark: Thread-safe, multiple threads may query the topography concurrently.
      *
      * @param i_pt point where the ray starts.
      * @return true if an intersection was found, false otherwise.
@@ -73,6 +127,7 @@ class edge_cut::surf::Topo {
 
     /**
      * Intersects the given segment with the topo mesh.
+     * Remark: The walk through the triangulation starts at the face located through the grid.
      *
      * @param i_segPt1 first point of the segment.
      * @param i_segPt2 second point of the segment.
@@ -21,7 +21,12 @@
  * This is the main file of Edge-V.
  **/
 
+#include <algorithm>
+#include <fstream>
+#include <omp.h>
+
 #include "vm_utility.h"
+#include "vm_grid.h"
 
 int main( int argc, char **argv ) {
   if( argc != 3 ) {
@@ -35,7 +40,6 @@ int main( int argc, char **argv ) {
   antn_cfg aCfg;
   std::string configFile = std::string( argv[2] );
   antnInit( aCfg, configFile );
-  ucvmInit( aCfg );
 
   moab_mesh mMsh;
   meshInit( mMsh, aCfg );
@@ -46,84 +50,112 @@ int main( int argc, char **argv ) {
   vmodel vModelNodes;
   vmNodeInit( vModelNodes, mMsh );
 
-  ucvm_point_t *ucvmPoints  = new ucvm_point_t[mMsh.num_nodes];
-  ucvm_data_t *ucvmProps    = new ucvm_data_t[mMsh.num_nodes];
+  //! Lattice mode: the nodes sample a cached lattice of the region, which is
+  //! built from the backend if the lattice file does not exist yet
+  vm_grid   vGrid;
+  ucvm_pool uPool;
+  bool      gridMode = false;
+
+  if( !aCfg.vm_lattice_fn.empty() ) {
+    std::ifstream iLatFs( aCfg.vm_lattice_fn.c_str(), std::ios::in );
+    bool latExists = iLatFs.good();
+    iLatFs.close();
+
+    //! A cached lattice is reused only if it was built from the same source
+    //! model and spacing, and covers the mesh
+    real bndMin[3], bndMax[3];
+    gridBounds( aCfg, mMsh, bndMin, bndMax );
+
+    if( latExists ) {
+      gridInit( vGrid, aCfg.vm_lattice_fn );
+      if( gridCheck( vGrid, aCfg, bndMin, bndMax ) != 0 ) {
+        gridFinalize( vGrid );
+        latExists = false;
+      }
+    }
+
+    if( !latExists ) {
+      vm_grid vSrc;
+      if( aCfg.vm_backend == VMBACKEND_GRID )
+        gridInit( vSrc, aCfg.vm_grid_fn );
+      else
+        ucvmPoolInit( uPool, aCfg );
+
+      gridBuild( vGrid, aCfg, bndMin, bndMax, vSrc, uPool );
+      gridWrite( vGrid, aCfg.vm_lattice_fn );
+
+      gridFinalize( vSrc );
+      ucvmPoolFinalize( uPool );
+    }
+    gridMode = true;
+  } else if( aCfg.vm_backend == VMBACKEND_GRID ) {
+    gridInit( vGrid, aCfg.vm_grid_fn );
+    gridMode = true;
+  } else {
+    ucvmPoolInit( uPool, aCfg );
+  }
+
+  //! Streaming pipeline over chunks of nodes: the projection of a chunk
+  //! overlaps with the query of the previous one. UCVM queries are issued by
+  //! thread 0 to the process pool, while the remaining threads project. The
+  //! gridded model is read-only and queried by all threads.
+  const int_v chunkSize   = aCfg.chunk_size;
+  const int_v numChunks   = (mMsh.num_nodes + chunkSize - 1) / chunkSize;
+  const bool  serialQuery = !gridMode;
+
+  geo_point_t *geoPoints  = new geo_point_t[2 * chunkSize];
+
+  std::cout << "Velocity Model Query (" << numChunks << " chunks) ... ";
+  std::cout.flush();
 
   #pragma omp parallel
   {
     worker_reg wrkRg;
-    workerInit( wrkRg, mMsh.num_nodes );
+    workerInit( wrkRg, 0 );
 
-    moab::EntityID      pEntId;
-    moab::EntityHandle  pHandle;
-    moab::ErrorCode     rval;
+    const int_v numThrds  = omp_get_num_threads();
+    const bool  qThrd     = serialQuery && (numThrds > 1);
+    const int_v pWrk      = qThrd ? wrkRg.worker_tid - 1 : wrkRg.worker_tid;
+    const int_v numPWrks  = qThrd ? numThrds - 1 : numThrds;
 
-    const int_v p_ofs = wrkRg.worker_tid * wrkRg.work_size;
-    for( int_v pid = 0; pid < wrkRg.num_prvt; pid++ ) {
-      pEntId = pid + p_ofs + 1;
-      rval = mMsh.intf->handle_from_id( moab::MBVERTEX, pEntId, pHandle );
-      assert( rval == moab::MB_SUCCESS );
+    int_v first, num;
 
-      rval = mMsh.intf->get_coords( &pHandle, 1, ucvmPoints[pid+p_ofs].coord );
-      assert( rval == moab::MB_SUCCESS );
-    }
+    for( int_v cid = 0; cid <= numChunks; cid++ ) {
+      //! Stage 1: Projection of chunk cid
+      if( cid < numChunks && pWrk >= 0 ) {
+        const int_v cFirst  = cid * chunkSize;
+        const int_v cSize   = std::min( chunkSize, mMsh.num_nodes - cFirst );
+        geo_point_t *cPts   = geoPoints + (cid % 2) * chunkSize;
 
-    //! Proj4 Transform: UTM->Long,Lat,Elv
-    double *xPtr  = &(ucvmPoints[p_ofs].coord[0]);
-    double *yPtr  = &(ucvmPoints[p_ofs].coord[1]);
-    double *zPtr  = &(ucvmPoints[p_ofs].coord[2]);
-    int pntOfs    = sizeof( ucvm_point_t ) / sizeof( double );
-    int pjstatus  = pj_transform( wrkRg.pj_utm, wrkRg.pj_geo, wrkRg.num_prvt,
-                                  pntOfs, xPtr, yPtr, zPtr );
-
-    //! Apply Rad to Degree
-    for( int_v pid = 0; pid < wrkRg.num_prvt; pid++ ) {
-      ucvmPoints[pid+p_ofs].coord[0] *= RAD_TO_DEG;
-      ucvmPoints[pid+p_ofs].coord[1] *= RAD_TO_DEG;
-      //! (Raj): Depth (m) does not need transformation from rad to deg
-      // ucvmPoints[pid+p_ofs].coord[2] *= RAD_TO_DEG;
-    }
+        workerSplit( cSize, pWrk, numPWrks, first, num );
+        projNodes( mMsh, wrkRg, cFirst + first, num, cPts + first );
+      }
 
-    //! UCVM Query
-#pragma omp master
-{
-    std::cout << "UCVM Query ... ";
-    std::cout.flush();
-    int ucvmStatus = ucvm_query( mMsh.num_nodes, ucvmPoints, ucvmProps );
-    if( ucvmStatus != 0 ) {
-      std::cout << "Failed." << std::endl;
-      std::cerr << "Error: cannot complete UCVM query." << std::endl;
-    }
-    std::cout << "Done!" << std::endl;
-}
-#pragma omp barrier
+      //! Stage 2: Query of chunk cid-1, written to the VM nodes array
+      if( cid > 0 ) {
+        const int_v cFirst  = (cid - 1) * chunkSize;
+        const int_v cSize   = std::min( chunkSize, mMsh.num_nodes - cFirst );
+        geo_point_t *cPts   = geoPoints + ((cid - 1) % 2) * chunkSize;
 
-    ucvm_prop_t *propPtr;
-
-    //! Move to VM Nodes Array
-    for( int_v pid = 0; pid < wrkRg.num_prvt; pid++ ) {
-      switch( aCfg.ucvm_type ) {
-        case 0:   //! Crustal
-          propPtr = &(ucvmProps[pid+p_ofs].crust);
-          break;
-        case 1:   //! Geotechnical layer
-          propPtr = &(ucvmProps[pid+p_ofs].gtl);
-          break;
-        case 2:   //! Combination
-          propPtr = &(ucvmProps[pid+p_ofs].cmb);
-          break;
-        default:
-          propPtr = &(ucvmProps[pid+p_ofs].cmb);
+        if( serialQuery ) {
+          if( wrkRg.worker_tid == 0 )
+            ucvmPoolQuery( uPool, cSize, cPts, vModelNodes.vm_list + cFirst );
+        } else {
+          workerSplit( cSize, wrkRg.worker_tid, numThrds, first, num );
+          gridQuery( vGrid, num, cPts + first,
+                     vModelNodes.vm_list + cFirst + first );
+        }
       }
 
-      vModelNodes.vm_list[pid+p_ofs].data[0] = propPtr->vp;
-      vModelNodes.vm_list[pid+p_ofs].data[1] = propPtr->vs;
-      vModelNodes.vm_list[pid+p_ofs].data[2] = propPtr->rho;
+#pragma omp barrier
     }
   } //! Exit Parallel Region
 
-  delete[] ucvmPoints;
-  delete[] ucvmProps;
+  std::cout << "Done!" << std::endl;
+
+  delete[] geoPoints;
+  gridFinalize( vGrid );
+  ucvmPoolFinalize( uPool );
 
   writeVMNodes( vModelNodes, aCfg, mMsh );
 
@@ -32,6 +32,13 @@
 #define UCVMCMODE UCVM_COORD_GEO_ELEV
 #define UCVMTYPE  2 //TODO
 
+//! Velocity model backends
+#define VMBACKEND_UCVM 0
+#define VMBACKEND_GRID 1
+
+//! Default number of nodes per chunk in the annotation pipeline
+#define CHUNKSIZE 65536
+
 #define MIN_VP          1500.0
 #define MIN_VS          500.0
 #define MIN_VS2         1200.0
@@ -0,0 +1,417 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2019, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Gridded velocity model, used as a local stand-in for UCVM and as cached
+ * lattice of a region.
+ **/
+
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <omp.h>
+
+#include "vm_grid.h"
+
+//! Number of points interpolated in one vectorized batch
+#define GRIDBATCH 64
+
+int gridInit( vm_grid &v_grid, const std::string &grid_f ) {
+  std::cout << "Reading Velocity Model Grid: " << grid_f << " ... ";
+  std::cout.flush();
+
+  std::ifstream iGridFs( grid_f.c_str(), std::ios::in | std::ios::binary );
+  if( !iGridFs.is_open() ) {
+    std::cout << "Failed." << std::endl;
+    std::cerr << "Error: cannot open the velocity model grid." << std::endl;
+    exit( -1 );
+  }
+
+  char    magic[8];
+  int64_t n[3];
+  double  origin[3], spacing[3];
+
+  iGridFs.read( magic,                           8 );
+  iGridFs.read( reinterpret_cast<char*>(n),       3*sizeof(int64_t) );
+  iGridFs.read( reinterpret_cast<char*>(origin),  3*sizeof(double) );
+  iGridFs.read( reinterpret_cast<char*>(spacing), 3*sizeof(double) );
+
+  bool lattice = iGridFs && std::memcmp( magic, "EDGEVLAT", 8 ) == 0;
+  if( !iGridFs || ( !lattice && std::memcmp( magic, "EDGEVGRD", 8 ) != 0 ) ) {
+    std::cout << "Failed." << std::endl;
+    std::cerr << "Error: invalid header of the velocity model grid." << std::endl;
+    exit( -1 );
+  }
+
+  //! Provenance of cached lattices
+  v_grid.source.clear();
+  if( lattice ) {
+    double  bbox[6];
+    int64_t srcLen;
+    iGridFs.read( reinterpret_cast<char*>(bbox),    6*sizeof(double) );
+    iGridFs.read( reinterpret_cast<char*>(&srcLen), sizeof(int64_t) );
+
+    if( !iGridFs || srcLen < 1 || srcLen > 65536 ) {
+      std::cout << "Failed." << std::endl;
+      std::cerr << "Error: invalid header of the velocity model lattice."
+                << std::endl;
+      exit( -1 );
+    }
+
+    v_grid.source.resize( srcLen );
+    iGridFs.read( &v_grid.source[0], srcLen );
+    for( int di = 0; di < 3; di++ ) {
+      v_grid.bbox[0][di] = bbox[di];
+      v_grid.bbox[1][di] = bbox[3+di];
+    }
+  }
+
+  for( int di = 0; di < 3; di++ ) {
+    if( n[di] < 1 || ( n[di] > 1 && !(spacing[di] > 0) ) ) {
+      std::cout << "Failed." << std::endl;
+      std::cerr << "Error: invalid dimensions of the velocity model grid."
+                << std::endl;
+      exit( -1 );
+    }
+    v_grid.n[di]       = n[di];
+    v_grid.origin[di]  = origin[di];
+    v_grid.spacing[di] = spacing[di];
+  }
+
+  std::size_t numVals = std::size_t(3) * n[0] * n[1] * n[2];
+  v_grid.data = new float[numVals];
+  iGridFs.read( reinterpret_cast<char*>(v_grid.data), numVals*sizeof(float) );
+
+  if( !iGridFs ) {
+    std::cout << "Failed." << std::endl;
+    std::cerr << "Error: truncated velocity model grid." << std::endl;
+    exit( -1 );
+  }
+
+  std::cout << "Done!" << std::endl;
+  std::cout << " | Grid points are " << n[0] << " x " << n[1] << " x " << n[2]
+            << std::endl;
+
+  return 0;
+}
+
+int gridWrite( const vm_grid &v_grid, const std::string &grid_f ) {
+  std::cout << "Writing Velocity Model Grid: " << grid_f << " ... ";
+  std::cout.flush();
+
+  std::ofstream oGridFs( grid_f.c_str(), std::ios::out | std::ios::binary );
+  if( !oGridFs.is_open() ) {
+    std::cout << "Failed." << std::endl;
+    std::cerr << "Error: cannot write the velocity model grid." << std::endl;
+    exit( -1 );
+  }
+
+  int64_t n[3];
+  double  origin[3], spacing[3];
+  for( int di = 0; di < 3; di++ ) {
+    n[di]       = v_grid.n[di];
+    origin[di]  = v_grid.origin[di];
+    spacing[di] = v_grid.spacing[di];
+  }
+
+  std::size_t numVals = std::size_t(3) * n[0] * n[1] * n[2];
+
+  const bool lattice = !v_grid.source.empty();
+
+  oGridFs.write( lattice ? "EDGEVLAT" : "EDGEVGRD",            8 );
+  oGridFs.write( reinterpret_cast<const char*>(n),              3*sizeof(int64_t) );
+  oGridFs.write( reinterpret_cast<const char*>(origin),         3*sizeof(double) );
+  oGridFs.write( reinterpret_cast<const char*>(spacing),        3*sizeof(double) );
+  if( lattice ) {
+    double  bbox[6];
+    int64_t srcLen = v_grid.source.size();
+    for( int di = 0; di < 3; di++ ) {
+      bbox[di]   = v_grid.bbox[0][di];
+      bbox[3+di] = v_grid.bbox[1][di];
+    }
+    oGridFs.write( reinterpret_cast<const char*>(bbox),         6*sizeof(double) );
+    oGridFs.write( reinterpret_cast<const char*>(&srcLen),      sizeof(int64_t) );
+    oGridFs.write( v_grid.source.c_str(),                       srcLen );
+  }
+  oGridFs.write( reinterpret_cast<const char*>(v_grid.data),    numVals*sizeof(float) );
+
+  if( !oGridFs ) {
+    std::cout << "Failed." << std::endl;
+    std::cerr << "Error: cannot write the velocity model grid." << std::endl;
+    exit( -1 );
+  }
+
+  std::cout << "Done!" << std::endl;
+
+  return 0;
+}
+
+int gridFinalize( vm_grid &v_grid ) {
+  if( v_grid.data != nullptr )
+    delete[] v_grid.data;
+  v_grid.data = nullptr;
+  v_grid.source.clear();
+
+  return 0;
+}
+
+std::string gridSource( const antn_cfg &a_cfg ) {
+  if( a_cfg.vm_backend == VMBACKEND_GRID )
+    return "grid:" + a_cfg.vm_grid_fn;
+  else
+    return "ucvm:" + a_cfg.ucvm_model_list;
+}
+
+int gridBounds( const antn_cfg &a_cfg, const moab_mesh &m_mesh,
+                real *bnd_min, real *bnd_max ) {
+  const int_v chunkSize   = a_cfg.chunk_size;
+  const int_v numChunks   = (m_mesh.num_nodes + chunkSize - 1) / chunkSize;
+
+  //! Bounding box of the mesh in geographic coordinates
+  for( int di = 0; di < 3; di++ ) {
+    bnd_min[di] =  std::numeric_limits< real >::max();
+    bnd_max[di] = -std::numeric_limits< real >::max();
+  }
+
+  #pragma omp parallel
+  {
+    worker_reg wrkRg;
+    workerInit( wrkRg, 0 );
+
+    geo_point_t *geoPoints = new geo_point_t[chunkSize];
+    real thrdMin[3], thrdMax[3];
+    for( int di = 0; di < 3; di++ ) {
+      thrdMin[di] = bnd_min[di];
+      thrdMax[di] = bnd_max[di];
+    }
+
+    #pragma omp for schedule(dynamic)
+    for( int_v cid = 0; cid < numChunks; cid++ ) {
+      const int_v cFirst  = cid * chunkSize;
+      const int_v cSize   = std::min( chunkSize, m_mesh.num_nodes - cFirst );
+
+      projNodes( m_mesh, wrkRg, cFirst, cSize, geoPoints );
+
+      for( int_v pid = 0; pid < cSize; pid++ ) {
+        real pt[3] = { geoPoints[pid].lon, geoPoints[pid].lat,
+                       geoPoints[pid].dep };
+        for( int di = 0; di < 3; di++ ) {
+          thrdMin[di] = std::min( thrdMin[di], pt[di] );
+          thrdMax[di] = std::max( thrdMax[di], pt[di] );
+        }
+      }
+    }
+
+    #pragma omp critical
+    for( int di = 0; di < 3; di++ ) {
+      bnd_min[di] = std::min( bnd_min[di], thrdMin[di] );
+      bnd_max[di] = std::max( bnd_max[di], thrdMax[di] );
+    }
+
+    delete[] geoPoints;
+  }
+
+  return 0;
+}
+
+int gridCheck( const vm_grid &v_lat, const antn_cfg &a_cfg,
+               const real *bnd_min, const real *bnd_max ) {
+  std::string reason;
+
+  if( v_lat.source.empty() )
+    reason = "no provenance in the header";
+  else if( v_lat.source != gridSource( a_cfg ) )
+    reason = "built from " + v_lat.source;
+
+  for( int di = 0; di < 3 && reason.empty(); di++ ) {
+    //! Tolerance w.r.t. the spacing, values are stored as doubles
+    const real tol = 1E-6 * v_lat.spacing[di];
+
+    if( a_cfg.vm_lattice_spacing[di] > 0 &&
+        std::abs( a_cfg.vm_lattice_spacing[di] - v_lat.spacing[di] ) > tol )
+      reason = "different spacing";
+    else if( bnd_min[di] < v_lat.bbox[0][di] - tol ||
+             bnd_max[di] > v_lat.bbox[1][di] + tol )
+      reason = "mesh exceeds the bounding box";
+  }
+
+  if( !reason.empty() ) {
+    std::cout << " | Lattice does not match (" << reason << "), rebuilding"
+              << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+int gridBuild( vm_grid &v_lat, const antn_cfg &a_cfg,
+               const real *bnd_min, const real *bnd_max,
+               const vm_grid &v_src, ucvm_pool &u_pool ) {
+  const int_v chunkSize   = a_cfg.chunk_size;
+
+  //! Setup of the lattice, covering the bounding box
+  v_lat.source = gridSource( a_cfg );
+  for( int di = 0; di < 3; di++ ) {
+    v_lat.bbox[0][di] = bnd_min[di];
+    v_lat.bbox[1][di] = bnd_max[di];
+  }
+
+  std::size_t numPts = 1;
+  for( int di = 0; di < 3; di++ ) {
+    if( !(a_cfg.vm_lattice_spacing[di] > 0) ) {
+      std::cerr << "Error: the lattice spacing has to be positive." << std::endl;
+      exit( -1 );
+    }
+    v_lat.origin[di]  = bnd_min[di];
+    v_lat.spacing[di] = a_cfg.vm_lattice_spacing[di];
+    v_lat.n[di]       = std::ceil( (bnd_max[di] - bnd_min[di]) /
+                                   v_lat.spacing[di] ) + 1;
+    numPts           *= v_lat.n[di];
+  }
+
+  if( numPts > (std::size_t) std::numeric_limits< int_v >::max() ) {
+    std::cerr << "Error: the lattice is too large, increase the spacing."
+              << std::endl;
+    exit( -1 );
+  }
+
+  std::cout << "Building Velocity Model Lattice ("
+            << v_lat.n[0] << " x " << v_lat.n[1] << " x " << v_lat.n[2]
+            << ") ... ";
+  std::cout.flush();
+
+  v_lat.data = new float[3 * numPts];
+
+  //! Query of the lattice points; UCVM chunks are issued by a single thread
+  //! and queried by the processes of the pool
+  const int_v numLatChunks = (numPts + chunkSize - 1) / chunkSize;
+  const bool  parQuery     = (a_cfg.vm_backend == VMBACKEND_GRID);
+
+  #pragma omp parallel if( parQuery )
+  {
+    geo_point_t *latPoints = new geo_point_t[chunkSize];
+    vm_datum    *latData   = new vm_datum[chunkSize];
+
+    #pragma omp for schedule(dynamic)
+    for( int_v cid = 0; cid < numLatChunks; cid++ ) {
+      const int_v cFirst  = cid * chunkSize;
+      const int_v cSize   = std::min( (std::size_t) chunkSize, numPts - cFirst );
+
+      for( int_v pid = 0; pid < cSize; pid++ ) {
+        int_v lid = cFirst + pid;
+        int_v id0 = lid % v_lat.n[0];
+        int_v id1 = (lid / v_lat.n[0]) % v_lat.n[1];
+        int_v id2 = lid / (v_lat.n[0] * v_lat.n[1]);
+
+        latPoints[pid].lon = v_lat.origin[0] + id0 * v_lat.spacing[0];
+        latPoints[pid].lat = v_lat.origin[1] + id1 * v_lat.spacing[1];
+        latPoints[pid].dep = v_lat.origin[2] + id2 * v_lat.spacing[2];
+      }
+
+      if( parQuery )
+        gridQuery( v_src, cSize, latPoints, latData );
+      else
+        ucvmPoolQuery( u_pool, cSize, latPoints, latData );
+
+      for( int_v pid = 0; pid < cSize; pid++ )
+        for( int va = 0; va < 3; va++ )
+          v_lat.data[ (std::size_t(cFirst) + pid) * 3 + va ] = latData[pid].data[va];
+    }
+
+    delete[] latPoints;
+    delete[] latData;
+  }
+
+  std::cout << "Done!" << std::endl;
+
+  return 0;
+}
+
+int gridQuery( const vm_grid &v_grid, int_v num_pts,
+               const geo_point_t *geo_pts, vm_datum *vm_data ) {
+  //! Per-dimension constants; degenerated dimensions get a zero step, such
+  //! that the interpolation is branch-free
+  real        invSp[3], posMax[3];
+  int_v       idMax[3];
+  std::size_t step[3];
+  std::size_t stride = 1;
+  for( int di = 0; di < 3; di++ ) {
+    invSp[di]  = (v_grid.n[di] > 1) ? real(1) / v_grid.spacing[di] : 0;
+    posMax[di] = v_grid.n[di] - 1;
+    idMax[di]  = std::max( v_grid.n[di] - 2, 0 );
+    step[di]   = (v_grid.n[di] > 1) ? stride : 0;
+    stride    *= v_grid.n[di];
+  }
+
+  //! Batches of points: the local coordinates are derived in SIMD loops, the
+  //! corner values are gathered
+  std::size_t base[GRIDBATCH];
+  real        xi[3][GRIDBATCH];
+
+  for( int_v bFirst = 0; bFirst < num_pts; bFirst += GRIDBATCH ) {
+    const int_v bSize = std::min( num_pts - bFirst, GRIDBATCH );
+    const geo_point_t *bPts = geo_pts + bFirst;
+    vm_datum          *bOut = vm_data + bFirst;
+
+    for( int_v pid = 0; pid < bSize; pid++ )
+      base[pid] = 0;
+
+    for( int di = 0; di < 3; di++ ) {
+#pragma omp simd
+      for( int_v pid = 0; pid < bSize; pid++ ) {
+        real coord = (di == 0) ? bPts[pid].lon :
+                     (di == 1) ? bPts[pid].lat : bPts[pid].dep;
+
+        //! Clamp to the grid
+        real pos = (coord - v_grid.origin[di]) * invSp[di];
+        pos = std::min( std::max( pos, real(0) ), posMax[di] );
+
+        int_v id = std::min( int_v( pos ), idMax[di] );
+        xi[di][pid] = pos - id;
+        base[pid]  += id * step[di];
+      }
+    }
+
+#pragma omp simd
+    for( int_v pid = 0; pid < bSize; pid++ ) {
+      const real x0 = xi[0][pid], x1 = xi[1][pid], x2 = xi[2][pid];
+      const real w[8] = { (1-x0)*(1-x1)*(1-x2), x0*(1-x1)*(1-x2),
+                          (1-x0)*   x1 *(1-x2), x0*   x1 *(1-x2),
+                          (1-x0)*(1-x1)*   x2 , x0*(1-x1)*   x2 ,
+                          (1-x0)*   x1 *   x2 , x0*   x1 *   x2  };
+      const std::size_t off[8] = { 0, step[0], step[1], step[0]+step[1],
+                                   step[2], step[0]+step[2], step[1]+step[2],
+                                   step[0]+step[1]+step[2] };
+
+      real vals[3] = { 0, 0, 0 };
+      for( int co = 0; co < 8; co++ )
+        for( int va = 0; va < 3; va++ )
+          vals[va] += w[co] * v_grid.data[ (base[pid] + off[co]) * 3 + va ];
+
+      bOut[pid].data[0] = vals[0];
+      bOut[pid].data[1] = vals[1];
+      bOut[pid].data[2] = vals[2];
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file This file is part of EDGE.
+ *
+ * @author Alexander Breuer (anbreuer AT ucsd.edu)
+ *
+ * @section LICENSE
+ * Copyright (c) 2019, Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Gridded velocity model, used as a local stand-in for UCVM and as cached
+ * lattice of a region.
+ *
+ * File format (native endianness):
+ *   char[8]   magic "EDGEVGRD"
+ *   int64[3]  number of grid points in longitude, latitude and elevation
+ *   double[3] origin (deg, deg, m)
+ *   double[3] spacing (deg, deg, m)
+ *   float[]   vp, vs, rho of all points; longitude runs fastest,
+ *             elevation slowest
+ *
+ * Cached lattices use the magic "EDGEVLAT" and carry their provenance between
+ * the spacing and the data:
+ *   double[6] bounding box of the mesh the lattice was built for (min, max)
+ *   int64     length of the source model string
+ *   char[]    source model, "ucvm:<model list>" or "grid:<grid file>"
+ **/
+
+#ifndef VM_GRID_H
+#define VM_GRID_H
+
+#include <string>
+#include "vm_utility.h"
+
+typedef struct vm_grid {
+  int_v n[3];
+  real  origin[3];
+  real  spacing[3];
+  //! Bounding box of the mesh and source model of a lattice, empty source
+  //! for plain grids
+  real  bbox[2][3];
+  std::string source;
+  float *data = nullptr;
+} vm_grid;
+
+int gridInit( vm_grid &, const std::string & );
+int gridWrite( const vm_grid &, const std::string & );
+int gridFinalize( vm_grid & );
+
+std::string gridSource( const antn_cfg & );
+
+int gridBounds( const antn_cfg &, const moab_mesh &, real *, real * );
+
+int gridCheck( const vm_grid &, const antn_cfg &, const real *, const real * );
+
+int gridBuild( vm_grid &, const antn_cfg &, const real *, const real *,
+               const vm_grid &, ucvm_pool & );
+
+int gridQuery( const vm_grid &, int_v, const geo_point_t *, vm_datum * );
+
+#endif //! VM_GRID_H
@@ -23,6 +23,13 @@
  **/
 
 #include <fstream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <unistd.h>
+#include <sys/wait.h>
 #include <omp.h>
 
 #include "vm_utility.h"
@@ -38,6 +45,13 @@ int antnInit( antn_cfg & a_cfg, const std::string &cfg_f ) {
   a_cfg.hypoc.lon = 0;
   a_cfg.hypoc.lat = 0;
 
+  a_cfg.vm_backend = VMBACKEND_UCVM;
+  a_cfg.chunk_size = CHUNKSIZE;
+  a_cfg.ucvm_procs = 0;
+  a_cfg.vm_lattice_spacing[0] = 0;
+  a_cfg.vm_lattice_spacing[1] = 0;
+  a_cfg.vm_lattice_spacing[2] = 0;
+
   std::cout << "Reading Annotation Config File: " << cfg_f << " ... ";
   std::cout.flush();
 
@@ -67,7 +81,33 @@ int antnInit( antn_cfg & a_cfg, const std::string &cfg_f ) {
     std::string varName   = lineBuf.substr( i, j - i );
     std::string varValue  = lineBuf.substr( j + 1 );
 
-    if( varName.compare( "ucvm_config" ) == 0 )
+    if( varName.compare( "vm_backend" ) == 0 ) {
+      if( varValue.compare( "ucvm" ) == 0 )
+        a_cfg.vm_backend    = VMBACKEND_UCVM;
+      else if( varValue.compare( "grid" ) == 0 )
+        a_cfg.vm_backend    = VMBACKEND_GRID;
+      else {
+        std::cout << "Failed." << std::endl;
+        std::cerr << "Error: unknown velocity model backend (" << varValue
+                  << ")." << std::endl;
+        exit( -1 );
+      }
+    }
+    else if( varName.compare( "vm_grid_file" ) == 0 )
+      a_cfg.vm_grid_fn      = varValue;
+    else if( varName.compare( "vm_lattice_file" ) == 0 )
+      a_cfg.vm_lattice_fn   = varValue;
+    else if( varName.compare( "vm_lattice_spacing" ) == 0 ) {
+      std::replace( varValue.begin(), varValue.end(), ',', ' ' );
+      std::istringstream iSpacing( varValue );
+      iSpacing >> a_cfg.vm_lattice_spacing[0] >> a_cfg.vm_lattice_spacing[1]
+               >> a_cfg.vm_lattice_spacing[2];
+    }
+    else if( varName.compare( "chunk_size" ) == 0 )
+      a_cfg.chunk_size      = std::stoi( varValue );
+    else if( varName.compare( "ucvm_procs" ) == 0 )
+      a_cfg.ucvm_procs      = std::stoi( varValue );
+    else if( varName.compare( "ucvm_config" ) == 0 )
       a_cfg.ucvm_cfg_fn     = varValue;
     else if( varName.compare( "ucvm_model_list" ) == 0 )
       a_cfg.ucvm_model_list = varValue;
@@ -83,9 +123,33 @@ int antnInit( antn_cfg & a_cfg, const std::string &cfg_f ) {
       std::cout << "\nUnknown setting (" << varName << "). Ignored." << std::endl;
   }
 
+#ifdef EDGE_V_UCVM
   a_cfg.ucvm_cmode  = UCVMCMODE;
+#else
+  if( a_cfg.vm_backend == VMBACKEND_UCVM && a_cfg.vm_lattice_fn.empty() ) {
+    std::cout << "Failed." << std::endl;
+    std::cerr << "Error: Edge-V was built without UCVM, use vm_backend=grid."
+              << std::endl;
+    exit( -1 );
+  }
+#endif
   a_cfg.ucvm_type   = UCVMTYPE;
 
+  if( a_cfg.chunk_size < 1 ) {
+    std::cout << "Failed." << std::endl;
+    std::cerr << "Error: the chunk size has to be positive." << std::endl;
+    exit( -1 );
+  }
+
+  if( a_cfg.ucvm_procs < 0 ) {
+    std::cout << "Failed." << std::endl;
+    std::cerr << "Error: the number of UCVM processes has to be positive."
+              << std::endl;
+    exit( -1 );
+  }
+  a_cfg.ucvm_procs = (a_cfg.ucvm_procs == 0) ? omp_get_max_threads() :
+                                               a_cfg.ucvm_procs;
+
   a_cfg.min_vp = (a_cfg.min_vp == 0) ? MIN_VP : a_cfg.min_vp;
   a_cfg.min_vs = (a_cfg.min_vs == 0) ? MIN_VS : a_cfg.min_vs;
   a_cfg.min_vs2 = (a_cfg.min_vs2 == 0) ? MIN_VS2 : a_cfg.min_vs2;
@@ -102,7 +166,8 @@ int antnInit( antn_cfg & a_cfg, const std::string &cfg_f ) {
   return 0;
 }
 
-int ucvmInit( const antn_cfg &a_cfg ) {
+#ifdef EDGE_V_UCVM
+static int ucvmInit( const antn_cfg &a_cfg ) {
   ucvm_init( a_cfg.ucvm_cfg_fn.c_str() );
   ucvm_add_model_list( a_cfg.ucvm_model_list.c_str() );
   ucvm_setparam( UCVM_PARAM_QUERY_MODE, a_cfg.ucvm_cmode );
@@ -110,6 +175,220 @@ int ucvmInit( const antn_cfg &a_cfg ) {
   return 0;
 }
 
+int ucvmQuery( const antn_cfg &a_cfg, int_v num_pts,
+               const geo_point_t *geo_pts, vm_datum *vm_data ) {
+  ucvm_point_t *ucvmPoints  = new ucvm_point_t[num_pts];
+  ucvm_data_t  *ucvmProps   = new ucvm_data_t[num_pts];
+
+  for( int_v pid = 0; pid < num_pts; pid++ ) {
+    ucvmPoints[pid].coord[0] = geo_pts[pid].lon;
+    ucvmPoints[pid].coord[1] = geo_pts[pid].lat;
+    ucvmPoints[pid].coord[2] = geo_pts[pid].dep;
+  }
+
+  int ucvmStatus = ucvm_query( num_pts, ucvmPoints, ucvmProps );
+  if( ucvmStatus != 0 ) {
+    std::cerr << "Error: cannot complete UCVM query." << std::endl;
+  }
+
+  ucvm_prop_t *propPtr;
+
+  for( int_v pid = 0; pid < num_pts; pid++ ) {
+    switch( a_cfg.ucvm_type ) {
+      case 0:   //! Crustal
+        propPtr = &(ucvmProps[pid].crust);
+        break;
+      case 1:   //! Geotechnical layer
+        propPtr = &(ucvmProps[pid].gtl);
+        break;
+      case 2:   //! Combination
+        propPtr = &(ucvmProps[pid].cmb);
+        break;
+      default:
+        propPtr = &(ucvmProps[pid].cmb);
+    }
+
+    vm_data[pid].data[0] = propPtr->vp;
+    vm_data[pid].data[1] = propPtr->vs;
+    vm_data[pid].data[2] = propPtr->rho;
+  }
+
+  delete[] ucvmPoints;
+  delete[] ucvmProps;
+
+  return ucvmStatus;
+}
+#endif
+
+//! Reads exactly num_bytes from the file descriptor, 0 on success
+static int pipeRead( int fd, void *buf, std::size_t num_bytes ) {
+  char *ptr = (char *) buf;
+  while( num_bytes > 0 ) {
+    ssize_t numRead = read( fd, ptr, num_bytes );
+    if( numRead < 0 && errno == EINTR ) continue;
+    if( numRead <= 0 ) return -1;
+    ptr       += numRead;
+    num_bytes -= numRead;
+  }
+
+  return 0;
+}
+
+//! Writes exactly num_bytes to the file descriptor, 0 on success
+static int pipeWrite( int fd, const void *buf, std::size_t num_bytes ) {
+  const char *ptr = (const char *) buf;
+  while( num_bytes > 0 ) {
+    ssize_t numWritten = write( fd, ptr, num_bytes );
+    if( numWritten < 0 && errno == EINTR ) continue;
+    if( numWritten <= 0 ) return -1;
+    ptr       += numWritten;
+    num_bytes -= numWritten;
+  }
+
+  return 0;
+}
+
+#ifdef EDGE_V_UCVM
+//! Main loop of a worker process: answers requests until it receives an
+//! empty one or the pipe is closed
+static void ucvmPoolWorker( const antn_cfg &a_cfg, int fd_req, int fd_res ) {
+  ucvmInit( a_cfg );
+
+  std::vector< geo_point_t > geoPts;
+  std::vector< vm_datum >    vmData;
+  int_v numPts;
+
+  while( pipeRead( fd_req, &numPts, sizeof(int_v) ) == 0 && numPts > 0 ) {
+    geoPts.resize( numPts );
+    vmData.resize( numPts );
+    if( pipeRead( fd_req, geoPts.data(), numPts * sizeof(geo_point_t) ) != 0 )
+      break;
+
+    int status = ucvmQuery( a_cfg, numPts, geoPts.data(), vmData.data() );
+
+    if(    pipeWrite( fd_res, &status, sizeof(int) ) != 0
+        || pipeWrite( fd_res, vmData.data(), numPts * sizeof(vm_datum) ) != 0 )
+      break;
+  }
+
+  close( fd_req );
+  close( fd_res );
+}
+#endif
+
+int ucvmPoolInit( ucvm_pool &u_pool, const antn_cfg &a_cfg ) {
+#ifndef EDGE_V_UCVM
+  std::cerr << "Error: Edge-V was built without UCVM, use vm_backend=grid."
+            << std::endl;
+  exit( -1 );
+#else
+  //! Failed workers are detected through the pipes
+  signal( SIGPIPE, SIG_IGN );
+
+  //! Flush the streams, such that the workers do not inherit pending output
+  std::cout.flush();
+  std::cerr.flush();
+
+  u_pool.num_procs  = a_cfg.ucvm_procs;
+  u_pool.pids       = new pid_t[u_pool.num_procs];
+  u_pool.fd_req     = new int[u_pool.num_procs];
+  u_pool.fd_res     = new int[u_pool.num_procs];
+
+  for( int_v wid = 0; wid < u_pool.num_procs; wid++ ) {
+    int pReq[2], pRes[2];
+    if( pipe( pReq ) != 0 || pipe( pRes ) != 0 ) {
+      std::cerr << "Error: cannot create the pipes of the UCVM processes."
+                << std::endl;
+      exit( -1 );
+    }
+
+    pid_t pid = fork();
+    if( pid < 0 ) {
+      std::cerr << "Error: cannot fork the UCVM processes." << std::endl;
+      exit( -1 );
+    }
+
+    if( pid == 0 ) {
+      //! The worker only keeps its own ends of its pipes
+      for( int_v pw = 0; pw < wid; pw++ ) {
+        close( u_pool.fd_req[pw] );
+        close( u_pool.fd_res[pw] );
+      }
+      close( pReq[1] );
+      close( pRes[0] );
+
+      ucvmPoolWorker( a_cfg, pReq[0], pRes[1] );
+      _exit( 0 );
+    }
+
+    close( pReq[0] );
+    close( pRes[1] );
+    u_pool.pids[wid]    = pid;
+    u_pool.fd_req[wid]  = pReq[1];
+    u_pool.fd_res[wid]  = pRes[0];
+  }
+#endif
+
+  return 0;
+}
+
+int ucvmPoolQuery( ucvm_pool &u_pool, int_v num_pts,
+                   const geo_point_t *geo_pts, vm_datum *vm_data ) {
+  int_v first, num;
+
+  //! Send all requests first, such that the workers query concurrently
+  for( int_v wid = 0; wid < u_pool.num_procs; wid++ ) {
+    workerSplit( num_pts, wid, u_pool.num_procs, first, num );
+    if( num == 0 ) continue;
+
+    if(    pipeWrite( u_pool.fd_req[wid], &num, sizeof(int_v) ) != 0
+        || pipeWrite( u_pool.fd_req[wid], geo_pts + first,
+                      num * sizeof(geo_point_t) ) != 0 ) {
+      std::cerr << "Error: UCVM process " << wid << " failed." << std::endl;
+      exit( -1 );
+    }
+  }
+
+  int ucvmStatus = 0;
+  for( int_v wid = 0; wid < u_pool.num_procs; wid++ ) {
+    workerSplit( num_pts, wid, u_pool.num_procs, first, num );
+    if( num == 0 ) continue;
+
+    int status;
+    if(    pipeRead( u_pool.fd_res[wid], &status, sizeof(int) ) != 0
+        || pipeRead( u_pool.fd_res[wid], vm_data + first,
+                     num * sizeof(vm_datum) ) != 0 ) {
+      std::cerr << "Error: UCVM process " << wid << " failed." << std::endl;
+      exit( -1 );
+    }
+    ucvmStatus = (status != 0) ? status : ucvmStatus;
+  }
+
+  return ucvmStatus;
+}
+
+int ucvmPoolFinalize( ucvm_pool &u_pool ) {
+  const int_v numEnd = 0;
+
+  for( int_v wid = 0; wid < u_pool.num_procs; wid++ ) {
+    pipeWrite( u_pool.fd_req[wid], &numEnd, sizeof(int_v) );
+    close( u_pool.fd_req[wid] );
+    close( u_pool.fd_res[wid] );
+  }
+  for( int_v wid = 0; wid < u_pool.num_procs; wid++ )
+    waitpid( u_pool.pids[wid], nullptr, 0 );
+
+  delete[] u_pool.pids;
+  delete[] u_pool.fd_req;
+  delete[] u_pool.fd_res;
+  u_pool.num_procs  = 0;
+  u_pool.pids       = nullptr;
+  u_pool.fd_req     = nullptr;
+  u_pool.fd_res     = nullptr;
+
+  return 0;
+}
+
 int meshInit( moab_mesh &m_mesh, antn_cfg &a_cfg ) {
   if( m_mesh.intf != nullptr ) {
     std::cout << "Failed." << std::endl;
@@ -203,7 +482,8 @@ int workerInit( worker_reg &wrk_rg, int_v totalNum ) {
   wrk_rg.worker_tid = tid;
 
   int_v workSize    = (totalNum + numThrds - 1) / numThrds;
-  int_v nPrivate    = std::min( workSize * (tid + 1), totalNum ) - workSize * tid;
+  int_v nPrivate    = std::max( std::min( workSize * (tid + 1), totalNum ) -
+                                workSize * tid, 0 );
   wrk_rg.work_size  = workSize;
   wrk_rg.num_prvt   = nPrivate;
 
@@ -215,6 +495,53 @@ int workerInit( worker_reg &wrk_rg, int_v totalNum ) {
   return 0;
 }
 
+int workerSplit( int_v totalNum, int_v wid, int_v numWrks, int_v &first,
+                 int_v &num ) {
+  int_v workSize  = (totalNum + numWrks - 1) / numWrks;
+  first           = std::min( workSize * wid, totalNum );
+  num             = std::min( workSize * (wid + 1), totalNum ) - first;
+
+  return 0;
+}
+
+int projNodes( const moab_mesh &m_mesh, const worker_reg &wrk_rg,
+               int_v first, int_v num_pts, geo_point_t *geo_pts ) {
+  moab::EntityHandle  pHandle;
+  moab::ErrorCode     rval;
+  double              coords[3];
+
+  for( int_v pid = 0; pid < num_pts; pid++ ) {
+    rval = m_mesh.intf->handle_from_id( moab::MBVERTEX, first + pid + 1,
+                                        pHandle );
+    assert( rval == moab::MB_SUCCESS );
+
+    rval = m_mesh.intf->get_coords( &pHandle, 1, coords );
+    assert( rval == moab::MB_SUCCESS );
+
+    geo_pts[pid].lon = coords[0];
+    geo_pts[pid].lat = coords[1];
+    geo_pts[pid].dep = coords[2];
+  }
+
+  if( num_pts == 0 )
+    return 0;
+
+  //! Proj4 Transform: UTM->Long,Lat,Elv
+  int pntOfs    = sizeof( geo_point_t ) / sizeof( real );
+  int pjstatus  = pj_transform( wrk_rg.pj_utm, wrk_rg.pj_geo, num_pts, pntOfs,
+                                &(geo_pts[0].lon), &(geo_pts[0].lat),
+                                &(geo_pts[0].dep) );
+
+  //! Apply Rad to Degree
+  for( int_v pid = 0; pid < num_pts; pid++ ) {
+    geo_pts[pid].lon *= RAD_TO_DEG;
+    geo_pts[pid].lat *= RAD_TO_DEG;
+    //! (Raj): Depth (m) does not need transformation from rad to deg
+  }
+
+  return pjstatus;
+}
+
 int writeVMNodes( vmodel &vm_nodes, const antn_cfg &a_cfg,
                   const moab_mesh &m_mesh ) {
   std::cout << "Write Velocity Model: " << a_cfg.vm_node_fn << " ... ";
@@ -230,7 +557,8 @@ int writeVMNodes( vmodel &vm_nodes, const antn_cfg &a_cfg,
   
   //! Write down the headers
   oVmNodeFs << "$UcvmModel\n";
-  oVmNodeFs << a_cfg.ucvm_model_list << std::endl;
+  oVmNodeFs << ( (a_cfg.vm_backend == VMBACKEND_GRID) ? a_cfg.vm_grid_fn
+                 : a_cfg.ucvm_model_list ) << std::endl;
   oVmNodeFs << "$EndUcvmModel\n";
 
   //! Write down the velocity model data
@@ -244,8 +572,7 @@ int writeVMNodes( vmodel &vm_nodes, const antn_cfg &a_cfg,
     real data2 = vm_nodes.vm_list[pid].data[2];
 
     oVmNodeFs << (pid + 1) << " " << data0 << " " << data1 << " " << data2
-              << std::endl;
-    oVmNodeFs.flush();
+              << '\n';
   }
   oVmNodeFs << "$NodesVelocityModel\n";
 
@@ -270,7 +597,8 @@ int writeVMElmts( vmodel &vm_elmts, const antn_cfg &a_cfg,
 
   //! Write down the headers
   oVmElmtFs << "$UcvmModel\n";
-  oVmElmtFs << a_cfg.ucvm_model_list << std::endl;
+  oVmElmtFs << ( (a_cfg.vm_backend == VMBACKEND_GRID) ? a_cfg.vm_grid_fn
+                 : a_cfg.ucvm_model_list ) << std::endl;
   oVmElmtFs << "$EndUcvmModel\n";
 
   //! Write down the velocity model data
@@ -284,8 +612,7 @@ int writeVMElmts( vmodel &vm_elmts, const antn_cfg &a_cfg,
     real data2 = vm_elmts.vm_list[eid].data[2];
 
     oVmElmtFs << (eid + 1) << " " << data0 << " " << data1 << " " << data2
-              << std::endl;
-    oVmElmtFs.flush();
+              << '\n';
   }
   oVmElmtFs << "$ElementsVelocityModel\n";
 
@@ -325,29 +652,46 @@ int writeVMTags( vmodel &vm_elmts, const antn_cfg &a_cfg,
                     moab::MB_TAG_CREAT|moab::MB_TAG_DENSE|moab::MB_TAG_BYTES );
   assert( rval == moab::MB_SUCCESS );
 
-  //! Set Tags
-  int_v eid;
+  //! Set Tags, chunk-wise as single-precision floats
   int_v numElmts = m_mesh.num_elmts;
-  real l_lambda, l_mu, l_rho;
-
-  for( moab::Range::iterator rit = elems.begin(); rit != elems.end(); ++rit ) {
-    moab::EntityID entId = iface->id_from_handle( *rit );
-
-    eid = entId - 1;
-    assert( eid < numElmts );
-
-    l_lambda  = vm_elmts.vm_list[eid].data[0];
-    l_mu      = vm_elmts.vm_list[eid].data[1];
-    l_rho     = vm_elmts.vm_list[eid].data[2];
-
-
-    iface->tag_set_data( tag_lambda, &(*rit), 1, &l_lambda );
+  int_v chunkSize = a_cfg.chunk_size;
+
+  std::vector< moab::EntityHandle > cHandles;
+  std::vector< float > cLambda, cMu, cRho;
+  cHandles.reserve( chunkSize );
+  cLambda.reserve( chunkSize );
+  cMu.reserve( chunkSize );
+  cRho.reserve( chunkSize );
+
+  moab::Range::iterator rit = elems.begin();
+  while( rit != elems.end() ) {
+    cHandles.clear();
+    cLambda.clear();
+    cMu.clear();
+    cRho.clear();
+
+    for( ; rit != elems.end() && (int_v) cHandles.size() < chunkSize; ++rit ) {
+      moab::EntityID entId = iface->id_from_handle( *rit );
+
+      int_v eid = entId - 1;
+      assert( eid < numElmts );
+
+      cHandles.push_back( *rit );
+      cLambda.push_back( vm_elmts.vm_list[eid].data[0] );
+      cMu.push_back(     vm_elmts.vm_list[eid].data[1] );
+      cRho.push_back(    vm_elmts.vm_list[eid].data[2] );
+    }
+
+    rval = iface->tag_set_data( tag_lambda, cHandles.data(), cHandles.size(),
+                                cLambda.data() );
     assert( rval == moab::MB_SUCCESS );
 
-    rval = iface->tag_set_data( tag_mu, &(*rit), 1, &l_mu );
+    rval = iface->tag_set_data( tag_mu, cHandles.data(), cHandles.size(),
+                                cMu.data() );
     assert( rval == moab::MB_SUCCESS );
 
-    rval = iface->tag_set_data( tag_rho, &(*rit), 1, &l_rho );
+    rval = iface->tag_set_data( tag_rho, cHandles.data(), cHandles.size(),
+                                cRho.data() );
     assert( rval == moab::MB_SUCCESS );
   }
 
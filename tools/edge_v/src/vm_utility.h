@@ -28,10 +28,13 @@
 #include <iostream>
 #include <cassert>
 #include <string>
+#include <sys/types.h>
 
+#ifdef EDGE_V_UCVM
 extern "C" {
 #include "ucvm.h"
 }
+#endif
 
 #include "proj_api.h"
 #include "moab/Core.hpp"
@@ -60,9 +63,16 @@ typedef struct geo_point_t {
 typedef struct antn_cfg {
   std::string antn_cfg_fn;
 
+  unsigned int vm_backend;
+  std::string vm_grid_fn;
+  std::string vm_lattice_fn;
+  real vm_lattice_spacing[3];
+
   std::string ucvm_cfg_fn;
   std::string ucvm_model_list;
+#ifdef EDGE_V_UCVM
   ucvm_ctype_t ucvm_cmode;
+#endif
   int ucvm_type;
 
   real min_vp;
@@ -81,12 +91,12 @@ typedef struct antn_cfg {
 
   unsigned int parallel_mode;
   unsigned int num_worker;
+  int_v chunk_size;
+  int_v ucvm_procs;
 } antn_cfg;
 
 int antnInit( antn_cfg &, const std::string & );
 
-int ucvmInit( const antn_cfg & );
-
 // // ***************************
 
 
@@ -111,6 +121,7 @@ typedef struct worker_reg {
 } worker_reg;
 
 int workerInit( worker_reg &, int_v );
+int workerSplit( int_v, int_v, int_v, int_v &, int_v & );
 
 // int pjUtmInit(projPJ **);
 // int pjUtmFinalize(projPJ *);
@@ -172,6 +183,26 @@ int vmElmtInit( vmodel &, const moab_mesh & );
 int vmNodeFinalize( vmodel & );
 int vmElmtFinalize( vmodel & );
 
+int projNodes( const moab_mesh &, const worker_reg &, int_v, int_v,
+               geo_point_t * );
+#ifdef EDGE_V_UCVM
+int ucvmQuery( const antn_cfg &, int_v, const geo_point_t *, vm_datum * );
+#endif
+
+//! UCVM keeps global state and is not thread-safe. The pool forks worker
+//! processes, which initialize UCVM on their own and query parts of every
+//! request; requests and results are exchanged through pipes.
+typedef struct ucvm_pool {
+  int_v num_procs = 0;
+  pid_t *pids     = nullptr;
+  int   *fd_req   = nullptr;
+  int   *fd_res   = nullptr;
+} ucvm_pool;
+
+int ucvmPoolInit( ucvm_pool &, const antn_cfg & );
+int ucvmPoolQuery( ucvm_pool &, int_v, const geo_point_t *, vm_datum * );
+int ucvmPoolFinalize( ucvm_pool & );
+
 int writeVMNodes( vmodel &, const antn_cfg &, const moab_mesh & );
 int writeVMElmts( vmodel &, const antn_cfg &, const moab_mesh & );
 int writeVMTags(  vmodel &, const antn_cfg &, const moab_mesh & );